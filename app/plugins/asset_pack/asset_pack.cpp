@@ -0,0 +1,69 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "asset_pack.h"
+
+#include "filesystem/filesystem.hpp"
+#include "timer.h"
+
+namespace plugins
+{
+AssetPack::AssetPack() :
+    AssetPackTags("Asset Pack",
+                  "Serve the data files from an asset pack.",
+                  {vkb::Hook::OnAppStart},
+                  {},
+                  {{"asset-pack", "Asset pack written by vkb__pack_assets"}})
+{
+}
+
+bool AssetPack::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "asset-pack")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"asset-pack\" is missing the path of the pack!");
+			return false;
+		}
+		std::string pack_path = arguments[1];
+
+		vkb::Timer timer;
+		timer.start();
+
+		try
+		{
+			vkb::filesystem::mount_asset_pack(pack_path);
+		}
+		catch (const std::exception &e)
+		{
+			LOGE("Failed to mount asset pack: {}", e.what());
+			return false;
+		}
+
+		// Compare the load times logged by the samples with and without the pack
+		LOGI("Time spent mounting the asset pack: {} ms", timer.stop<vkb::Timer::Milliseconds>());
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
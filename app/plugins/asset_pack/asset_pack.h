@@ -0,0 +1,43 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using AssetPackTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Asset pack
+ *
+ * Serves the data files from an asset pack written by vkb__pack_assets, instead of opening every file
+ *
+ * Usage: vulkan_sample sample afbc --asset-pack <pack>
+ *
+ */
+class AssetPack : public AssetPackTags
+{
+  public:
+	AssetPack();
+
+	virtual ~AssetPack() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
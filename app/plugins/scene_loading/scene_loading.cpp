@@ -0,0 +1,102 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_loading.h"
+
+#include "platform/platform.h"
+
+namespace plugins
+{
+SceneLoading::SceneLoading() :
+    SceneLoadingTags("Scene loading",
+                     "A collection of flags to configure how the samples load their scenes",
+                     {},
+                     {},
+                     {{"mesh-arenas", "If flag is set, packs the submeshes into shared vertex and index arenas (only drawn by the samples using GeometrySubpass)"},
+                      {"vertex-layout", "Vertex data layout of the meshes: separate, interleaved or separate-position"},
+                      {"optimize-meshes", "If flag is set, reorders the indices and vertices of the meshes for the vertex cache, overdraw and vertex fetch"},
+                      {"scene-cache", "If flag is set, stores the processed scenes in the temporary directory and loads them from there next time"},
+                      {"stream-textures", "If flag is set, draws the scenes with placeholder textures while their images are streamed in"}})
+{
+}
+
+bool SceneLoading::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "mesh-arenas")
+	{
+		platform->get_mutable_scene_load_options().mesh_arenas = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "optimize-meshes")
+	{
+		platform->get_mutable_scene_load_options().mesh_optimization = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "scene-cache")
+	{
+		platform->get_mutable_scene_load_options().scene_cache = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "stream-textures")
+	{
+		platform->get_mutable_scene_load_options().texture_streaming = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "vertex-layout")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"vertex-layout\" is missing the layout!");
+			return false;
+		}
+
+		const std::string &layout = arguments[1];
+		if (layout == "separate")
+		{
+			platform->get_mutable_scene_load_options().vertex_layout = vkb::VertexLayout::Separate;
+		}
+		else if (layout == "interleaved")
+		{
+			platform->get_mutable_scene_load_options().vertex_layout = vkb::VertexLayout::Interleaved;
+		}
+		else if (layout == "separate-position")
+		{
+			platform->get_mutable_scene_load_options().vertex_layout = vkb::VertexLayout::SeparatePosition;
+		}
+		else
+		{
+			LOGE("Unknown vertex layout \"{}\"!", layout);
+			return false;
+		}
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+}        // namespace plugins
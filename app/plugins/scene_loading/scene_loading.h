@@ -0,0 +1,44 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+using SceneLoadingTags = vkb::PluginBase<vkb::tags::Passive>;
+
+/**
+ * @brief Scene loading
+ *
+ * Sets the GLTFLoader options of the scenes loaded by the samples that do not pass their own, through the
+ * ApplicationOptions the platform prepares each sample with
+ *
+ * Usage: vulkan_sample sample afbc --mesh-arenas --vertex-layout interleaved --optimize-meshes
+ *
+ */
+class SceneLoading : public SceneLoadingTags
+{
+  public:
+	SceneLoading();
+
+	virtual ~SceneLoading() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+};
+}        // namespace plugins
@@ -1,4 +1,4 @@
-/* Copyright (c) 2024, Thomas Atkinson
+/* Copyright (c) 2024-2025, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,7 +18,10 @@
 #pragma once
 
 #include <filesystem>
+#include <future>
+#include <limits>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -31,15 +34,59 @@ namespace filesystem
 {
 struct FileStat
 {
-	bool   is_file;
-	bool   is_directory;
-	size_t size;
+	bool     is_file;
+	bool     is_directory;
+	size_t   size;
+	uint64_t last_write_time;        // Opaque, only meaningful when compared to another stat of the same file
 };
 
 using Path = std::filesystem::path;
 
+/**
+ * @brief A read-only view of the content of a file, memory mapped where the platform supports it
+ *        and read to memory otherwise. The content remains valid for the lifetime of the object.
+ */
+class MappedFile
+{
+  public:
+	MappedFile() = default;
+
+	MappedFile(const MappedFile &) = delete;
+
+	virtual ~MappedFile() = default;
+
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	std::span<const uint8_t> get_data() const
+	{
+		return {mapped_data, mapped_size};
+	}
+
+  protected:
+	const uint8_t *mapped_data{nullptr};
+
+	size_t mapped_size{0};
+};
+
+using MappedFilePtr = std::shared_ptr<const MappedFile>;
+
+/**
+ * @brief A read of a range of a file, queued in a batch with FileSystem::read_async
+ */
+struct ReadRequest
+{
+	static constexpr size_t TO_END = std::numeric_limits<size_t>::max();
+
+	Path path;
+
+	size_t offset{0};
+
+	// The number of bytes to read, or TO_END to read the rest of the file
+	size_t size{TO_END};
+};
+
 // A thin filesystem wrapper
-class FileSystem
+class FileSystem : public std::enable_shared_from_this<FileSystem>
 {
   public:
 	FileSystem()          = default;
@@ -60,11 +107,22 @@ class FileSystem
 
 	void write_file(const Path &path, const std::string &data);
 
+	// Write the file through a temporary file moved into place, so that concurrent readers see either the old or the new content
+	// Throws if the file can't be written or moved into place
+	void write_file_atomic(const Path &path, const std::vector<uint8_t> &data);
+
 	// Read the entire file into a string
 	std::string read_file_string(const Path &path);
 
 	// Read the entire file into a vector of bytes
 	std::vector<uint8_t> read_file_binary(const Path &path);
+
+	// Map the entire file read-only, without copying it where the file system supports it
+	virtual MappedFilePtr map_file(const Path &path);
+
+	// Queue a batch of reads on worker threads, the futures complete in any order and rethrow read errors
+	// The queued reads keep the file system alive, so it may be replaced, e.g. by mount_asset_pack, while they run
+	virtual std::vector<std::future<std::vector<uint8_t>>> read_async(const std::vector<ReadRequest> &requests);
 };
 
 using FileSystemPtr = std::shared_ptr<FileSystem>;
@@ -77,6 +135,18 @@ void init_with_context(const PlatformContext &context);
 // Get the filesystem instance
 FileSystemPtr get();
 
+// Serve the files of an asset pack from a single mapping, the other paths are still served by the current filesystem
+// Throws if the pack can't be read or is invalid
+void mount_asset_pack(const Path &pack_path);
+
+// Whether the current filesystem serves an asset pack mounted with mount_asset_pack
+bool is_asset_pack_mounted();
+
+// Write an asset pack of every file under the given directories, with paths relative to root
+// With compress, the files which shrink with LZ4 are stored compressed, the others are stored as is
+// Returns the number of packed files
+size_t create_asset_pack(const Path &root, const std::vector<Path> &directories, const Path &output, bool compress = false);
+
 namespace helpers
 {
 std::string filename(const std::string &path);
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <sys/stat.h>
 #include <unordered_map>
@@ -28,6 +29,11 @@
 
 namespace vkb
 {
+namespace filesystem
+{
+class MappedFile;
+}        // namespace filesystem
+
 namespace fs
 {
 namespace path
@@ -95,6 +101,14 @@ void create_path(const std::string &root, const std::string &path);
  */
 std::vector<uint8_t> read_asset(const std::string &filename);
 
+/**
+ * @brief Helper to map an asset file read-only, without copying it where the platform supports it
+ *
+ * @param filename The path to the file (relative to the assets directory)
+ * @return The mapped file, its data remains valid as long as it is alive
+ */
+std::shared_ptr<const filesystem::MappedFile> map_asset(const std::string &filename);
+
 /**
  * @brief Helper to read a shader file into a single string
  *
@@ -1,4 +1,4 @@
-/* Copyright (c) 2024, Thomas Atkinson
+/* Copyright (c) 2024-2025, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,9 +17,18 @@
 
 #include "filesystem/filesystem.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
 #include "core/platform/context.hpp"
 #include "core/util/error.hpp"
 
+#include "pack_filesystem.hpp"
 #include "std_filesystem.hpp"
 
 namespace vkb
@@ -28,6 +37,111 @@ namespace filesystem
 {
 static FileSystemPtr fs = nullptr;
 
+namespace
+{
+/// The content of a file read to memory, for file systems which can't map files
+class CopiedFile final : public MappedFile
+{
+  public:
+	CopiedFile(std::vector<uint8_t> &&data) :
+	    data{std::move(data)}
+	{
+		mapped_data = this->data.data();
+		mapped_size = this->data.size();
+	}
+
+  private:
+	std::vector<uint8_t> data;
+};
+
+using ReadTask = std::packaged_task<std::vector<uint8_t>()>;
+
+/// Worker threads shared by the asynchronous reads of every file system
+class ReadQueue
+{
+  public:
+	ReadQueue()
+	{
+		// The reads mostly wait on the storage device, a few threads are enough to keep several requests in flight
+		auto thread_count = std::clamp(std::thread::hardware_concurrency(), 2u, MAX_READ_THREADS);
+
+		for (uint32_t i = 0; i < thread_count; ++i)
+		{
+			threads.emplace_back([this]() { run(); });
+		}
+	}
+
+	~ReadQueue()
+	{
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+			stopping = true;
+		}
+
+		condition.notify_all();
+
+		// The queued reads are completed first, so that no future is left without a value
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	void push(std::vector<ReadTask> &&batch)
+	{
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+			std::ranges::move(batch, std::back_inserter(tasks));
+		}
+
+		condition.notify_all();
+	}
+
+  private:
+	static constexpr uint32_t MAX_READ_THREADS = 4;
+
+	void run()
+	{
+		while (true)
+		{
+			ReadTask task;
+
+			{
+				std::unique_lock<std::mutex> lock{mutex};
+				condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+				if (tasks.empty())
+				{
+					return;
+				}
+
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	std::mutex mutex;
+
+	std::condition_variable condition;
+
+	std::deque<ReadTask> tasks;
+
+	bool stopping{false};
+
+	std::vector<std::thread> threads;
+};
+
+ReadQueue &get_read_queue()
+{
+	// Created on first use, and destroyed before the file system instance
+	static ReadQueue queue;
+	return queue;
+}
+}        // namespace
+
 void init()
 {
 	fs = std::make_shared<StdFileSystem>();
@@ -46,11 +160,41 @@ FileSystemPtr get()
 	return fs;
 }
 
+void mount_asset_pack(const Path &pack_path)
+{
+	fs = std::make_shared<PackFileSystem>(get(), pack_path);
+}
+
+bool is_asset_pack_mounted()
+{
+	return std::dynamic_pointer_cast<PackFileSystem>(get()) != nullptr;
+}
+
 void FileSystem::write_file(const Path &path, const std::string &data)
 {
 	write_file(path, std::vector<uint8_t>(data.begin(), data.end()));
 }
 
+void FileSystem::write_file_atomic(const Path &path, const std::vector<uint8_t> &data)
+{
+	// The temporary file is unique to this writer, so that concurrent writers of the same path don't interleave
+	size_t unique_id = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+	                   static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+	Path temp_path = path;
+	temp_path += fmt::format(".{:x}.tmp", unique_id);
+
+	write_file(temp_path, data);
+
+	std::error_code ec;
+	std::filesystem::rename(temp_path, path, ec);
+	if (ec)
+	{
+		std::filesystem::remove(temp_path, ec);
+		throw std::runtime_error("Failed to move file into place at path: " + path.string());
+	}
+}
+
 std::string FileSystem::read_file_string(const Path &path)
 {
 	auto bin = read_file_binary(path);
@@ -63,5 +207,43 @@ std::vector<uint8_t> FileSystem::read_file_binary(const Path &path)
 	return read_chunk(path, 0, stat.size);
 }
 
+MappedFilePtr FileSystem::map_file(const Path &path)
+{
+	return std::make_shared<CopiedFile>(read_file_binary(path));
+}
+
+std::vector<std::future<std::vector<uint8_t>>> FileSystem::read_async(const std::vector<ReadRequest> &requests)
+{
+	std::vector<ReadTask>                          tasks;
+	std::vector<std::future<std::vector<uint8_t>>> futures;
+
+	tasks.reserve(requests.size());
+	futures.reserve(requests.size());
+
+	// The file system is only referenced through shared pointers, see init and mount_asset_pack
+	auto self = shared_from_this();
+
+	for (auto &request : requests)
+	{
+		tasks.emplace_back([self, request]() {
+			auto size = request.size;
+			if (size == ReadRequest::TO_END)
+			{
+				auto file_size = self->stat_file(request.path).size;
+				size           = file_size - std::min(file_size, request.offset);
+			}
+
+			return self->read_chunk(request.path, request.offset, size);
+		});
+
+		futures.push_back(tasks.back().get_future());
+	}
+
+	// Queue the whole batch at once, so that the workers start on it together
+	get_read_queue().push(std::move(tasks));
+
+	return futures;
+}
+
 }        // namespace filesystem
 }        // namespace vkb
\ No newline at end of file
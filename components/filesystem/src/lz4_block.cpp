@@ -0,0 +1,229 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lz4_block.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vkb
+{
+namespace filesystem
+{
+namespace
+{
+/*
+ * A block is a list of sequences, each made of:
+ *   token: literal length in the high 4 bits, match length minus MIN_MATCH in the low 4 bits
+ *   literal length extension bytes, if the literal length field is 15
+ *   literals
+ *   uint16_t match offset, little-endian
+ *   match length extension bytes, if the match length field is 15
+ * The last sequence only holds literals. Its last LAST_LITERALS bytes are always literals,
+ * and no match starts within the last MATCH_FIND_LIMIT bytes.
+ */
+constexpr size_t MIN_MATCH        = 4;
+constexpr size_t LAST_LITERALS    = 5;
+constexpr size_t MATCH_FIND_LIMIT = 12;
+constexpr size_t MAX_OFFSET       = 65535;
+constexpr size_t LENGTH_FIELD_MAX = 15;
+
+constexpr uint32_t HASH_BITS = 16;
+
+uint32_t read_u32(const uint8_t *data)
+{
+	uint32_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+uint32_t hash_sequence(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void write_length(std::vector<uint8_t> &block, size_t length)
+{
+	for (; length >= 255; length -= 255)
+	{
+		block.push_back(255);
+	}
+	block.push_back(static_cast<uint8_t>(length));
+}
+
+/// Appends a sequence, a match length of 0 ends the block with the literals
+void write_sequence(std::vector<uint8_t> &block, std::span<const uint8_t> literals, size_t offset, size_t match_length)
+{
+	size_t match_field = match_length ? match_length - MIN_MATCH : 0;
+
+	block.push_back(static_cast<uint8_t>((std::min(literals.size(), LENGTH_FIELD_MAX) << 4) | std::min(match_field, LENGTH_FIELD_MAX)));
+
+	if (literals.size() >= LENGTH_FIELD_MAX)
+	{
+		write_length(block, literals.size() - LENGTH_FIELD_MAX);
+	}
+
+	block.insert(block.end(), literals.begin(), literals.end());
+
+	if (match_length == 0)
+	{
+		return;
+	}
+
+	block.push_back(static_cast<uint8_t>(offset & 0xff));
+	block.push_back(static_cast<uint8_t>(offset >> 8));
+
+	if (match_field >= LENGTH_FIELD_MAX)
+	{
+		write_length(block, match_field - LENGTH_FIELD_MAX);
+	}
+}
+
+bool read_length(std::span<const uint8_t> block, size_t &cursor, size_t &length)
+{
+	uint8_t byte;
+
+	do
+	{
+		if (cursor >= block.size())
+		{
+			return false;
+		}
+
+		byte = block[cursor++];
+		length += byte;
+	} while (byte == 255);
+
+	return true;
+}
+}        // namespace
+
+std::vector<uint8_t> lz4_compress(std::span<const uint8_t> data)
+{
+	std::vector<uint8_t> block;
+	block.reserve(data.size() + data.size() / 255 + 16);
+
+	size_t anchor   = 0;
+	size_t position = 0;
+
+	if (data.size() > MATCH_FIND_LIMIT)
+	{
+		// Positions plus one, zero marks an empty slot
+		std::vector<uint32_t> table(size_t{1} << HASH_BITS, 0);
+
+		size_t match_end_limit = data.size() - LAST_LITERALS;
+
+		while (position + MATCH_FIND_LIMIT < data.size())
+		{
+			uint32_t sequence = read_u32(data.data() + position);
+			auto    &slot     = table[hash_sequence(sequence)];
+
+			size_t candidate = slot;
+			slot             = static_cast<uint32_t>(position + 1);
+
+			if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read_u32(data.data() + candidate - 1) != sequence)
+			{
+				position++;
+				continue;
+			}
+
+			size_t match        = candidate - 1;
+			size_t match_length = MIN_MATCH;
+			while (position + match_length < match_end_limit && data[match + match_length] == data[position + match_length])
+			{
+				match_length++;
+			}
+
+			write_sequence(block, data.subspan(anchor, position - anchor), position - match, match_length);
+
+			position += match_length;
+			anchor = position;
+		}
+	}
+
+	write_sequence(block, data.subspan(anchor), 0, 0);
+
+	return block;
+}
+
+bool lz4_decompress(std::span<const uint8_t> block, std::span<uint8_t> data)
+{
+	size_t cursor = 0;
+	size_t output = 0;
+
+	while (cursor < block.size())
+	{
+		uint8_t token = block[cursor++];
+
+		size_t literal_length = token >> 4;
+		if (literal_length == LENGTH_FIELD_MAX && !read_length(block, cursor, literal_length))
+		{
+			return false;
+		}
+
+		if (literal_length > block.size() - cursor || literal_length > data.size() - output)
+		{
+			return false;
+		}
+
+		std::memcpy(data.data() + output, block.data() + cursor, literal_length);
+		cursor += literal_length;
+		output += literal_length;
+
+		// The last sequence has no match
+		if (cursor == block.size())
+		{
+			break;
+		}
+
+		if (block.size() - cursor < 2)
+		{
+			return false;
+		}
+
+		size_t offset = block[cursor] | (static_cast<size_t>(block[cursor + 1]) << 8);
+		cursor += 2;
+
+		if (offset == 0 || offset > output)
+		{
+			return false;
+		}
+
+		size_t match_length = token & 0xf;
+		if (match_length == LENGTH_FIELD_MAX && !read_length(block, cursor, match_length))
+		{
+			return false;
+		}
+		match_length += MIN_MATCH;
+
+		if (match_length > data.size() - output)
+		{
+			return false;
+		}
+
+		// The match may overlap the bytes it produces, so it is copied byte by byte
+		for (size_t i = 0; i < match_length; ++i)
+		{
+			data[output + i] = data[output - offset + i];
+		}
+		output += match_length;
+	}
+
+	return output == data.size();
+}
+}        // namespace filesystem
+}        // namespace vkb
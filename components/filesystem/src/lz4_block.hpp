@@ -0,0 +1,44 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vkb
+{
+namespace filesystem
+{
+/**
+ * @brief Compresses data to a single LZ4 block, in the block format of the LZ4 reference implementation
+ *
+ * Matches are found with a greedy single-entry hash table, which favours compression speed over ratio.
+ * The block does not record the size of the data, it must be stored alongside it.
+ */
+std::vector<uint8_t> lz4_compress(std::span<const uint8_t> data);
+
+/**
+ * @brief Decompresses a single LZ4 block
+ * @param block The compressed block
+ * @param[out] data Sized to the size of the uncompressed data, which is written to it
+ * @return False if the block is malformed or does not decompress to exactly the size of data
+ */
+bool lz4_decompress(std::span<const uint8_t> block, std::span<uint8_t> data);
+}        // namespace filesystem
+}        // namespace vkb
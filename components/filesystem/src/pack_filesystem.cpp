@@ -0,0 +1,511 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pack_filesystem.hpp"
+
+#include "lz4_block.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace vkb
+{
+namespace filesystem
+{
+namespace
+{
+/*
+ * Layout of an asset pack, in host byte order:
+ *
+ *   PackHeader
+ *   Entry data, each entry starting at a multiple of ENTRY_ALIGNMENT
+ *   Index, starting at PackHeader::index_offset and ending at the end of the file, one record per entry sorted by path:
+ *     uint32_t path size, path characters, uint32_t compression, uint64_t offset, uint64_t size in the pack,
+ *     uint64_t uncompressed size, Hash128 hash of the data in the pack
+ *
+ * A compressed entry is a single LZ4 block.
+ */
+constexpr uint32_t PACK_MAGIC   = 0x50424b56;        // "VKBP"
+constexpr uint32_t PACK_VERSION = 2;
+
+// Keeps the entries readable in place by decoders which expect aligned data
+constexpr uint64_t ENTRY_ALIGNMENT = 16;
+
+struct PackHeader
+{
+	uint32_t magic;
+
+	uint32_t version;
+
+	uint64_t entry_count;
+
+	uint64_t index_offset;
+
+	Hash128 index_hash;
+};
+
+static_assert(sizeof(PackHeader) == 48, "PackHeader must not contain padding");
+
+/// A file served from the mapping of its pack, which it keeps alive
+class PackedFile final : public MappedFile
+{
+  public:
+	PackedFile(MappedFilePtr pack, std::span<const uint8_t> data) :
+	    pack{std::move(pack)}
+	{
+		mapped_data = data.data();
+		mapped_size = data.size();
+	}
+
+  private:
+	MappedFilePtr pack;
+};
+
+/// The content of a compressed file, decompressed to memory
+class DecompressedFile final : public MappedFile
+{
+  public:
+	DecompressedFile(std::vector<uint8_t> &&data) :
+	    data{std::move(data)}
+	{
+		mapped_data = this->data.data();
+		mapped_size = this->data.size();
+	}
+
+  private:
+	std::vector<uint8_t> data;
+};
+
+Hash128 get_hash(const uint8_t *data, size_t size)
+{
+	Hasher hasher;
+	hasher.update(data, size);
+	return hasher.get_hash();
+}
+
+template <class T>
+void append(std::vector<uint8_t> &buffer, const T &value)
+{
+	auto bytes = reinterpret_cast<const uint8_t *>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void pad(std::ofstream &file)
+{
+	static const char zeros[ENTRY_ALIGNMENT] = {};
+
+	auto position = static_cast<uint64_t>(file.tellp());
+	file.write(zeros, (ENTRY_ALIGNMENT - position % ENTRY_ALIGNMENT) % ENTRY_ALIGNMENT);
+}
+}        // namespace
+
+PackFileSystem::PackFileSystem(FileSystemPtr base, const Path &pack_path) :
+    base{std::move(base)}
+{
+	auto invalid = [&pack_path](const std::string &reason) {
+		return std::runtime_error("Invalid asset pack " + pack_path.string() + ": " + reason);
+	};
+
+	pack            = this->base->map_file(pack_path);
+	pack_write_time = this->base->stat_file(pack_path).last_write_time;
+
+	auto data = pack->get_data();
+
+	PackHeader header{};
+	if (data.size() < sizeof(PackHeader))
+	{
+		throw invalid("truncated header");
+	}
+
+	std::memcpy(&header, data.data(), sizeof(PackHeader));
+
+	if (header.magic != PACK_MAGIC || header.version != PACK_VERSION)
+	{
+		throw invalid("unsupported format");
+	}
+
+	if (header.index_offset < sizeof(PackHeader) || header.index_offset > data.size())
+	{
+		throw invalid("index out of bounds");
+	}
+
+	auto index = data.subspan(header.index_offset);
+
+	if (get_hash(index.data(), index.size()) != header.index_hash)
+	{
+		throw invalid("corrupted index");
+	}
+
+	size_t cursor = 0;
+
+	auto read = [&](void *dst, size_t size) {
+		if (size > index.size() - cursor)
+		{
+			throw invalid("truncated index");
+		}
+
+		std::memcpy(dst, index.data() + cursor, size);
+		cursor += size;
+	};
+
+	for (uint64_t i = 0; i < header.entry_count; ++i)
+	{
+		Entry    entry{};
+		uint32_t path_size{};
+
+		read(&path_size, sizeof(path_size));
+		if (path_size > index.size() - cursor)
+		{
+			throw invalid("truncated index");
+		}
+
+		entry.path.resize(path_size);
+		read(entry.path.data(), path_size);
+		read(&entry.compression, sizeof(entry.compression));
+		read(&entry.offset, sizeof(entry.offset));
+		read(&entry.size, sizeof(entry.size));
+		read(&entry.uncompressed_size, sizeof(entry.uncompressed_size));
+		read(&entry.hash, sizeof(entry.hash));
+
+		if (entry.compression != Compression::None && entry.compression != Compression::LZ4)
+		{
+			throw invalid("unsupported compression of " + entry.path);
+		}
+
+		if (entry.compression == Compression::None && entry.uncompressed_size != entry.size)
+		{
+			throw invalid("size mismatch of " + entry.path);
+		}
+
+		if (entry.offset < sizeof(PackHeader) || entry.offset > header.index_offset || entry.size > header.index_offset - entry.offset)
+		{
+			throw invalid("entry out of bounds " + entry.path);
+		}
+
+		// Lookups are binary searches
+		if (!entries.empty() && entries.back().path >= entry.path)
+		{
+			throw invalid("unsorted index");
+		}
+
+		entries.push_back(std::move(entry));
+	}
+
+	if (cursor != index.size())
+	{
+		throw invalid("trailing index data");
+	}
+
+	verified = std::vector<std::atomic<bool>>(entries.size());
+
+	auto compressed_count = std::ranges::count(entries, Compression::LZ4, &Entry::compression);
+
+	LOGI("Mounted asset pack {} with {} files, {} of them compressed", pack_path.string(), entries.size(), compressed_count);
+}
+
+FileStat PackFileSystem::stat_file(const Path &path)
+{
+	if (auto entry = find_entry(path))
+	{
+		return FileStat{true, false, entry->uncompressed_size, pack_write_time};
+	}
+
+	if (is_packed_directory(path))
+	{
+		return FileStat{false, true, 0, pack_write_time};
+	}
+
+	return base->stat_file(path);
+}
+
+bool PackFileSystem::is_file(const Path &path)
+{
+	return find_entry(path) || base->is_file(path);
+}
+
+bool PackFileSystem::is_directory(const Path &path)
+{
+	return is_packed_directory(path) || base->is_directory(path);
+}
+
+bool PackFileSystem::exists(const Path &path)
+{
+	return find_entry(path) || is_packed_directory(path) || base->exists(path);
+}
+
+bool PackFileSystem::create_directory(const Path &path)
+{
+	return base->create_directory(path);
+}
+
+std::vector<uint8_t> PackFileSystem::read_chunk(const Path &path, size_t offset, size_t count)
+{
+	auto entry = find_entry(path);
+	if (!entry)
+	{
+		return base->read_chunk(path, offset, count);
+	}
+
+	if (offset + count > entry->uncompressed_size)
+	{
+		return {};
+	}
+
+	if (entry->compression == Compression::None)
+	{
+		auto data = get_entry_data(*entry);
+		return {data.begin() + offset, data.begin() + offset + count};
+	}
+
+	if (offset == 0 && count == entry->uncompressed_size)
+	{
+		return decompress_entry(*entry);
+	}
+
+	auto data = get_decompressed_file(*entry)->get_data();
+	return {data.begin() + offset, data.begin() + offset + count};
+}
+
+MappedFilePtr PackFileSystem::map_file(const Path &path)
+{
+	auto entry = find_entry(path);
+	if (!entry)
+	{
+		return base->map_file(path);
+	}
+
+	if (entry->compression == Compression::None)
+	{
+		return std::make_shared<PackedFile>(pack, get_entry_data(*entry));
+	}
+
+	return get_decompressed_file(*entry);
+}
+
+void PackFileSystem::write_file(const Path &path, const std::vector<uint8_t> &data)
+{
+	base->write_file(path, data);
+}
+
+void PackFileSystem::remove(const Path &path)
+{
+	base->remove(path);
+}
+
+void PackFileSystem::set_external_storage_directory(const std::string &dir)
+{
+	base->set_external_storage_directory(dir);
+}
+
+const Path &PackFileSystem::external_storage_directory() const
+{
+	return base->external_storage_directory();
+}
+
+const Path &PackFileSystem::temp_directory() const
+{
+	return base->temp_directory();
+}
+
+std::optional<std::string> PackFileSystem::get_key(const Path &path) const
+{
+	// The pack holds the paths relative to the data directory it was created from
+	auto relative = path.lexically_normal().lexically_relative(base->external_storage_directory().lexically_normal());
+
+	if (relative.empty() || *relative.begin() == "..")
+	{
+		return std::nullopt;
+	}
+
+	auto key = relative.generic_string();
+
+	// Directories may be given with a trailing separator
+	if (key.ends_with('/'))
+	{
+		key.pop_back();
+	}
+
+	return key;
+}
+
+const PackFileSystem::Entry *PackFileSystem::find_entry(const Path &path) const
+{
+	auto key = get_key(path);
+	if (!key)
+	{
+		return nullptr;
+	}
+
+	auto it = std::ranges::lower_bound(entries, *key, {}, &Entry::path);
+
+	return it != entries.end() && it->path == *key ? &*it : nullptr;
+}
+
+bool PackFileSystem::is_packed_directory(const Path &path) const
+{
+	auto key = get_key(path);
+	if (!key)
+	{
+		return false;
+	}
+
+	// A directory is packed if a packed path starts with it
+	auto prefix = *key + '/';
+	auto it     = std::ranges::lower_bound(entries, prefix, {}, &Entry::path);
+
+	return it != entries.end() && it->path.starts_with(prefix);
+}
+
+std::span<const uint8_t> PackFileSystem::get_entry_data(const Entry &entry)
+{
+	auto  data    = pack->get_data().subspan(entry.offset, entry.size);
+	auto &checked = verified[&entry - entries.data()];
+
+	if (!checked.load(std::memory_order_acquire))
+	{
+		if (get_hash(data.data(), data.size()) != entry.hash)
+		{
+			throw std::runtime_error("Corrupted asset pack entry: " + entry.path);
+		}
+
+		checked.store(true, std::memory_order_release);
+	}
+
+	return data;
+}
+
+std::vector<uint8_t> PackFileSystem::decompress_entry(const Entry &entry)
+{
+	std::vector<uint8_t> data(entry.uncompressed_size);
+
+	if (!lz4_decompress(get_entry_data(entry), data))
+	{
+		throw std::runtime_error("Corrupted asset pack entry: " + entry.path);
+	}
+
+	return data;
+}
+
+MappedFilePtr PackFileSystem::get_decompressed_file(const Entry &entry)
+{
+	{
+		std::lock_guard<std::mutex> guard(decompressed_mutex);
+
+		if (decompressed_entry == &entry)
+		{
+			return decompressed_file;
+		}
+	}
+
+	// Decompressed outside of the lock, so that reads of other entries don't wait for it
+	MappedFilePtr file = std::make_shared<DecompressedFile>(decompress_entry(entry));
+
+	std::lock_guard<std::mutex> guard(decompressed_mutex);
+
+	decompressed_entry = &entry;
+	decompressed_file  = file;
+
+	return file;
+}
+
+size_t create_asset_pack(const Path &root, const std::vector<Path> &directories, const Path &output, bool compress)
+{
+	auto output_path = std::filesystem::absolute(output).lexically_normal();
+
+	std::vector<std::string> paths;
+
+	for (auto &directory : directories)
+	{
+		for (auto &item : std::filesystem::recursive_directory_iterator(root / directory))
+		{
+			if (item.is_regular_file() && std::filesystem::absolute(item.path()).lexically_normal() != output_path)
+			{
+				paths.push_back(item.path().lexically_relative(root).generic_string());
+			}
+		}
+	}
+
+	std::ranges::sort(paths);
+	auto duplicates = std::ranges::unique(paths);
+	paths.erase(duplicates.begin(), duplicates.end());
+
+	std::ofstream file{output, std::ios::binary | std::ios::trunc};
+
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open file for writing at path: " + output.string());
+	}
+
+	// The header is written last, once the index is known
+	PackHeader header{PACK_MAGIC, PACK_VERSION, paths.size(), 0, {}};
+	file.write(reinterpret_cast<const char *>(&header), sizeof(PackHeader));
+
+	std::vector<uint8_t> index;
+
+	for (auto &path : paths)
+	{
+		pad(file);
+
+		auto offset = static_cast<uint64_t>(file.tellp());
+		auto data   = vkb::filesystem::get()->read_file_binary(root / path);
+
+		auto uncompressed_size = static_cast<uint64_t>(data.size());
+		auto compression       = Compression::None;
+
+		// Files which don't shrink, e.g. already compressed textures, are stored so that they are served in place
+		if (compress)
+		{
+			auto block = lz4_compress(data);
+			if (block.size() < data.size())
+			{
+				data        = std::move(block);
+				compression = Compression::LZ4;
+			}
+		}
+
+		file.write(reinterpret_cast<const char *>(data.data()), data.size());
+
+		append(index, static_cast<uint32_t>(path.size()));
+		index.insert(index.end(), path.begin(), path.end());
+		append(index, compression);
+		append(index, offset);
+		append(index, static_cast<uint64_t>(data.size()));
+		append(index, uncompressed_size);
+		append(index, get_hash(data.data(), data.size()));
+	}
+
+	pad(file);
+
+	header.index_offset = static_cast<uint64_t>(file.tellp());
+	header.index_hash   = get_hash(index.data(), index.size());
+
+	file.write(reinterpret_cast<const char *>(index.data()), index.size());
+
+	file.seekp(0);
+	file.write(reinterpret_cast<const char *>(&header), sizeof(PackHeader));
+
+	if (!file.good())
+	{
+		throw std::runtime_error("Failed to write asset pack at path: " + output.string());
+	}
+
+	return paths.size();
+}
+}        // namespace filesystem
+}        // namespace vkb
@@ -0,0 +1,140 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "filesystem/filesystem.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+
+#include "core/util/hash.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+/// Encoding of the data of an asset pack entry
+enum class Compression : uint32_t
+{
+	None = 0,
+	LZ4  = 1
+};
+
+/**
+ * @brief A read-only file system serving the files of an asset pack, see create_asset_pack
+ *
+ * The pack is mapped once, reads and mappings of packed files are then served from that mapping without
+ * opening or stat-ing any file. Stored entries are served in place. LZ4 entries are decompressed by whole
+ * file reads, and the last one mapped or read in chunks is kept decompressed, so that reading a file in
+ * chunks decompresses it once. The hash of an entry is checked the first time the entry is accessed.
+ * Paths which are not in the pack, and every write, are forwarded to the base file system.
+ */
+class PackFileSystem final : public FileSystem
+{
+  public:
+	/**
+	 * @brief Mounts an asset pack
+	 * @param base The file system the pack is read from, and which serves the paths that are not in the pack
+	 * @param pack_path The path of the pack
+	 * @throws std::runtime_error if the pack can't be read or is invalid
+	 */
+	PackFileSystem(FileSystemPtr base, const Path &pack_path);
+
+	virtual ~PackFileSystem() = default;
+
+	FileStat stat_file(const Path &path) override;
+
+	bool is_file(const Path &path) override;
+
+	bool is_directory(const Path &path) override;
+
+	bool exists(const Path &path) override;
+
+	bool create_directory(const Path &path) override;
+
+	std::vector<uint8_t> read_chunk(const Path &path, size_t offset, size_t count) override;
+
+	MappedFilePtr map_file(const Path &path) override;
+
+	void write_file(const Path &path, const std::vector<uint8_t> &data) override;
+
+	void remove(const Path &path) override;
+
+	void set_external_storage_directory(const std::string &dir) override;
+
+	const Path &external_storage_directory() const override;
+
+	const Path &temp_directory() const override;
+
+  private:
+	struct Entry
+	{
+		/// Path relative to the external storage directory, with '/' separators
+		std::string path;
+
+		Compression compression;
+
+		uint64_t offset;
+
+		/// Size of the data in the pack
+		uint64_t size;
+
+		/// Size of the file, once decompressed
+		uint64_t uncompressed_size;
+
+		/// Hash of the data in the pack
+		Hash128 hash;
+	};
+
+	/// The key of a path in the pack, or nothing if the path is outside of the external storage directory
+	std::optional<std::string> get_key(const Path &path) const;
+
+	const Entry *find_entry(const Path &path) const;
+
+	bool is_packed_directory(const Path &path) const;
+
+	/// The data of an entry as stored in the pack, checked against its hash on first access
+	std::span<const uint8_t> get_entry_data(const Entry &entry);
+
+	/// The content of a compressed entry
+	std::vector<uint8_t> decompress_entry(const Entry &entry);
+
+	/// The content of a compressed entry, shared with the previous mapping or chunk read of the same entry
+	MappedFilePtr get_decompressed_file(const Entry &entry);
+
+	FileSystemPtr base;
+
+	MappedFilePtr pack;
+
+	uint64_t pack_write_time{0};
+
+	/// Sorted by path
+	std::vector<Entry> entries;
+
+	std::vector<std::atomic<bool>> verified;
+
+	/// Guards the last decompressed entry
+	std::mutex decompressed_mutex;
+
+	const Entry *decompressed_entry{nullptr};
+
+	MappedFilePtr decompressed_file;
+};
+}        // namespace filesystem
+}        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2024, Thomas Atkinson
+/* Copyright (c) 2024-2025, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -22,10 +22,116 @@
 #include <filesystem>
 #include <fstream>
 
+#if defined(_WIN32)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
 namespace vkb
 {
 namespace filesystem
 {
+namespace
+{
+/// A read-only mapping of a whole file, unmapped on destruction
+class SystemMappedFile final : public MappedFile
+{
+  public:
+	SystemMappedFile(void *address, size_t size) :
+	    address{address}
+	{
+		mapped_data = static_cast<const uint8_t *>(address);
+		mapped_size = size;
+	}
+
+	~SystemMappedFile() override
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(address);
+#else
+		munmap(address, mapped_size);
+#endif
+	}
+
+  private:
+	void *address;
+};
+
+/**
+ * @brief Maps a whole file read-only
+ * @return The address of the mapping, or nullptr if the file couldn't be mapped
+ */
+void *map_whole_file(const Path &path, size_t &size)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Failed to open file for reading at path: " + path.string());
+	}
+
+	LARGE_INTEGER file_size{};
+	HANDLE        mapping = nullptr;
+
+	if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+	{
+		mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+
+	// The view keeps the file and the mapping object referenced
+	CloseHandle(file);
+
+	if (!mapping)
+	{
+		return nullptr;
+	}
+
+	void *address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	size = static_cast<size_t>(file_size.QuadPart);
+	return address;
+#else
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		throw std::runtime_error("Failed to open file for reading at path: " + path.string());
+	}
+
+	struct stat file_stat{};
+
+	void *address = MAP_FAILED;
+
+	// Empty files can't be mapped
+	if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+	{
+		address = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+
+	// The mapping keeps the file referenced
+	close(fd);
+
+	if (address == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	size = static_cast<size_t>(file_stat.st_size);
+	return address;
+#endif
+}
+}        // namespace
+
 FileStat StdFileSystem::stat_file(const Path &path)
 {
 	std::error_code ec;
@@ -37,6 +143,7 @@ FileStat StdFileSystem::stat_file(const Path &path)
 		    false,
 		    false,
 		    0,
+		    0,
 		};
 	}
 
@@ -46,10 +153,13 @@ FileStat StdFileSystem::stat_file(const Path &path)
 		size = 0;
 	}
 
+	auto last_write_time = std::filesystem::last_write_time(path, ec);
+
 	return FileStat{
 	    fs_stat.type() == std::filesystem::file_type::regular,
 	    fs_stat.type() == std::filesystem::file_type::directory,
 	    size,
+	    ec ? 0 : static_cast<uint64_t>(last_write_time.time_since_epoch().count()),
 	};
 }
 
@@ -94,7 +204,8 @@ std::vector<uint8_t> StdFileSystem::read_chunk(const Path &path, size_t offset,
 		throw std::runtime_error("Failed to open file for reading at path: " + path.string());
 	}
 
-	auto size = stat_file(path).size;
+	// The file was opened at its end, no need to stat it again
+	auto size = static_cast<size_t>(file.tellg());
 
 	if (offset + count > size)
 	{
@@ -109,6 +220,19 @@ std::vector<uint8_t> StdFileSystem::read_chunk(const Path &path, size_t offset,
 	return data;
 }
 
+MappedFilePtr StdFileSystem::map_file(const Path &path)
+{
+	size_t size    = 0;
+	void  *address = map_whole_file(path, size);
+
+	if (!address)
+	{
+		return FileSystem::map_file(path);
+	}
+
+	return std::make_shared<SystemMappedFile>(address, size);
+}
+
 void StdFileSystem::write_file(const Path &path, const std::vector<uint8_t> &data)
 {
 	// create directory if it doesn't exist
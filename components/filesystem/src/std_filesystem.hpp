@@ -1,4 +1,4 @@
-/* Copyright (c) 2024, Thomas Atkinson
+/* Copyright (c) 2024-2025, Thomas Atkinson
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -45,6 +45,8 @@ class StdFileSystem final : public FileSystem
 
 	std::vector<uint8_t> read_chunk(const Path &path, size_t offset, size_t count) override;
 
+	MappedFilePtr map_file(const Path &path) override;
+
 	void write_file(const Path &path, const std::vector<uint8_t> &data) override;
 
 	virtual void remove(const Path &path) override;
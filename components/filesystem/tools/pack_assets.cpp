@@ -0,0 +1,69 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "filesystem/filesystem.hpp"
+
+/*
+ * Writes an asset pack, to be served by the samples with --asset-pack <pack>
+ *
+ * Usage: vkb__pack_assets [--lz4] <data path> <pack> [directories...]
+ *
+ * The directories are relative to the data path, the assets and shaders directories by default.
+ * With --lz4, the files which shrink are stored LZ4 compressed and decompressed on each read.
+ */
+int main(int argc, char *argv[])
+{
+	std::vector<std::string> arguments{argv + 1, argv + argc};
+
+	bool compress = !arguments.empty() && arguments[0] == "--lz4";
+	if (compress)
+	{
+		arguments.erase(arguments.begin());
+	}
+
+	if (arguments.size() < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--lz4] <data path> <pack> [directories...]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	vkb::filesystem::init();
+
+	std::vector<vkb::filesystem::Path> directories{arguments.begin() + 2, arguments.end()};
+	if (directories.empty())
+	{
+		directories = {"assets", "shaders"};
+	}
+
+	try
+	{
+		auto count = vkb::filesystem::create_asset_pack(arguments[0], directories, arguments[1], compress);
+		std::cout << "Packed " << count << " files into " << arguments[1] << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Failed to pack assets: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -22,6 +22,11 @@
 #include "core/buffer.h"
 #include "core/hpp_physical_device.h"
 
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <span>
+
 namespace vkb
 {
 /**
@@ -51,7 +56,26 @@ class BufferAllocation
 	template <typename T>
 	void update(const T &value, uint32_t offset = 0);
 
+	/**
+	 * @brief Typed view on the mapped memory of the allocation, to write to it without any intermediate copy
+	 * @param count The number of elements
+	 * @param offset The offset in bytes from the start of the allocation
+	 * @return The elements, on non-coherent memory writes are only visible to the device after a call to flush
+	 * @throws std::runtime_error if the elements do not fit in the allocation
+	 */
+	template <typename T>
+	std::span<T> map(size_t count = 1, uint32_t offset = 0);
+
+	/**
+	 * @brief Flushes a range of the allocation, this is a no-op on coherent memory
+	 * @param offset The offset in bytes from the start of the allocation
+	 * @param size The number of bytes to flush, defaults to the rest of the allocation
+	 */
+	void flush(uint32_t offset = 0, DeviceSizeType size = VK_WHOLE_SIZE);
+
   private:
+	void write(const void *data, size_t data_size, uint32_t offset);
+
 	vkb::core::BufferCpp *buffer = nullptr;
 	vk::DeviceSize        offset = 0;
 	vk::DeviceSize        size   = 0;
@@ -123,23 +147,60 @@ typename BufferAllocation<bindingType>::DeviceSizeType BufferAllocation<bindingT
 template <vkb::BindingType bindingType>
 void BufferAllocation<bindingType>::update(const std::vector<uint8_t> &data, uint32_t offset)
 {
+	write(data.data(), data.size(), offset);
+}
+
+template <vkb::BindingType bindingType>
+template <typename T>
+void BufferAllocation<bindingType>::update(const T &value, uint32_t offset)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	write(&value, sizeof(T), offset);
+}
+
+template <vkb::BindingType bindingType>
+template <typename T>
+std::span<T> BufferAllocation<bindingType>::map(size_t count, uint32_t offset)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
 	assert(buffer && "Invalid buffer pointer");
 
-	if (offset + data.size() <= size)
+	if (offset + count * sizeof(T) > size)
 	{
-		buffer->update(data, to_u32(this->offset) + offset);
-	}
-	else
-	{
-		LOGE("Ignore buffer allocation update");
+		throw std::runtime_error("Buffer allocation map out of range");
 	}
+
+	// Buffer pool memory is persistently mapped, so this only returns the mapped pointer
+	auto data = buffer->map() + this->offset + offset;
+	assert(reinterpret_cast<uintptr_t>(data) % alignof(T) == 0 && "Misaligned buffer allocation map");
+
+	return {reinterpret_cast<T *>(data), count};
 }
 
 template <vkb::BindingType bindingType>
-template <typename T>
-void BufferAllocation<bindingType>::update(const T &value, uint32_t offset)
+void BufferAllocation<bindingType>::flush(uint32_t offset, DeviceSizeType size)
+{
+	assert(buffer && "Invalid buffer pointer");
+
+	vk::DeviceSize flush_size = (size == VK_WHOLE_SIZE) ? this->size - offset : static_cast<vk::DeviceSize>(size);
+	buffer->flush(this->offset + offset, flush_size);
+}
+
+template <vkb::BindingType bindingType>
+void BufferAllocation<bindingType>::write(const void *data, size_t data_size, uint32_t offset)
 {
-	update(to_bytes(value), offset);
+	assert(buffer && "Invalid buffer pointer");
+
+	if (offset + data_size <= size)
+	{
+		// Only the written range is flushed, Buffer::update would flush the whole block
+		std::memcpy(buffer->map() + this->offset + offset, data, data_size);
+		flush(offset, data_size);
+	}
+	else
+	{
+		LOGE("Ignore buffer allocation update");
+	}
 }
 
 /**
@@ -178,13 +239,17 @@ class BufferBlock
 	DeviceSizeType get_size() const;
 	void           reset();
 
+	/**
+	 * @brief Determine the alignment of the allocations of a buffer with the given usage
+	 */
+	static vk::DeviceSize determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits);
+
   private:
 	/**
 	 * @ brief Determine the current aligned offset.
 	 * @return The current aligned offset.
 	 */
 	vk::DeviceSize aligned_offset() const;
-	vk::DeviceSize determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits) const;
 
   private:
 	vkb::core::BufferCpp buffer;
@@ -258,7 +323,7 @@ vk::DeviceSize BufferBlock<bindingType>::aligned_offset() const
 }
 
 template <vkb::BindingType bindingType>
-vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits) const
+vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits)
 {
 	if (usage == vk::BufferUsageFlagBits::eUniformBuffer)
 	{
@@ -284,6 +349,370 @@ vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlag
 	}
 }
 
+/**
+ * @brief A single buffer sub-allocated with a bump pointer, and reset as a whole once none of its allocations are in use.
+ *
+ * Allocations are O(1) and never search for a block. The buffer is resized on reset: it grows as soon as the
+ * allocations requested since the previous reset did not fit, and shrinks once the high-water mark stayed
+ * below a quarter of its size for SHRINK_RESET_COUNT resets. It never shrinks below its initial size.
+ * The buffer is only created by the first allocation.
+ */
+template <vkb::BindingType bindingType>
+class BufferArena
+{
+  public:
+	using BufferUsageFlagsType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::BufferUsageFlags, VkBufferUsageFlags>::type;
+	using DeviceSizeType       = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::DeviceSize, VkDeviceSize>::type;
+
+	using DeviceType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::core::HPPDevice, vkb::Device>::type;
+
+	static constexpr uint32_t SHRINK_RESET_COUNT = 120;
+
+  public:
+	BufferArena(DeviceType &device, DeviceSizeType initial_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage = VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+	/**
+	 * @return An usable view on a portion of the buffer, empty if the buffer is full
+	 */
+	BufferAllocation<bindingType> allocate(DeviceSizeType size);
+
+	/**
+	 * @brief Makes the whole buffer available again, and resizes it according to the high-water marks
+	 *        None of the previous allocations may still be in use
+	 */
+	void reset();
+
+	DeviceSizeType get_size() const;
+
+	/**
+	 * @return The number of bytes requested since the previous reset, including those that did not fit
+	 */
+	DeviceSizeType get_high_water_mark() const;
+
+  private:
+	vkb::core::HPPDevice           &device;
+	std::unique_ptr<BufferBlockCpp> block;
+	vk::BufferUsageFlags            usage;
+	VmaMemoryUsage                  memory_usage{};
+	vk::DeviceSize                  minimum_size      = 0;
+	vk::DeviceSize                  high_water_mark   = 0;        // Bytes requested since the last reset
+	vk::DeviceSize                  window_high_water = 0;        // Highest high_water_mark since the last resize
+	uint32_t                        window_resets     = 0;        // Resets since the last resize
+};
+
+using BufferArenaC   = BufferArena<vkb::BindingType::C>;
+using BufferArenaCpp = BufferArena<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+BufferArena<bindingType>::BufferArena(DeviceType &device, DeviceSizeType initial_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage) :
+    device{reinterpret_cast<vkb::core::HPPDevice &>(device)}, usage{usage}, memory_usage{memory_usage}, minimum_size{initial_size}
+{
+}
+
+template <vkb::BindingType bindingType>
+BufferAllocation<bindingType> BufferArena<bindingType>::allocate(DeviceSizeType size)
+{
+	if (!block)
+	{
+		block = std::make_unique<BufferBlockCpp>(device, minimum_size, usage, memory_usage);
+	}
+
+	if (!block->can_allocate(size))
+	{
+		// Account for the overflow so that the next reset grows the buffer enough to fit it
+		high_water_mark = std::max(high_water_mark, block->get_size()) + size;
+		return BufferAllocation<bindingType>{};
+	}
+
+	auto allocation = block->allocate(static_cast<vk::DeviceSize>(size));
+	high_water_mark = std::max(high_water_mark, allocation.get_offset() + allocation.get_size());
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return allocation;
+	}
+	else
+	{
+		return *reinterpret_cast<BufferAllocationC *>(&allocation);
+	}
+}
+
+template <vkb::BindingType bindingType>
+void BufferArena<bindingType>::reset()
+{
+	if (!block)
+	{
+		return;
+	}
+
+	vk::DeviceSize size     = block->get_size();
+	vk::DeviceSize new_size = size;
+
+	window_high_water = std::max(window_high_water, high_water_mark);
+	window_resets++;
+
+	if (high_water_mark > size)
+	{
+		// Leave some headroom so that a slowly growing workload does not resize on every reset
+		new_size = std::bit_ceil(high_water_mark + high_water_mark / 4);
+	}
+	else if (window_resets >= SHRINK_RESET_COUNT && window_high_water * 4 <= size && size > minimum_size)
+	{
+		new_size = std::max(minimum_size, std::bit_ceil(window_high_water * 2));
+	}
+
+	if (new_size != size)
+	{
+		LOGD("Resizing buffer arena ({}) from {} to {} bytes", vk::to_string(usage), size, new_size);
+
+		block             = std::make_unique<BufferBlockCpp>(device, new_size, usage, memory_usage);
+		window_high_water = 0;
+		window_resets     = 0;
+	}
+	else
+	{
+		block->reset();
+
+		if (window_resets >= SHRINK_RESET_COUNT)
+		{
+			window_high_water = 0;
+			window_resets     = 0;
+		}
+	}
+
+	high_water_mark = 0;
+}
+
+template <vkb::BindingType bindingType>
+typename BufferArena<bindingType>::DeviceSizeType BufferArena<bindingType>::get_size() const
+{
+	return block ? static_cast<DeviceSizeType>(block->get_size()) : 0;
+}
+
+template <vkb::BindingType bindingType>
+typename BufferArena<bindingType>::DeviceSizeType BufferArena<bindingType>::get_high_water_mark() const
+{
+	return static_cast<DeviceSizeType>(high_water_mark);
+}
+
+/**
+ * @brief Blocks of a single usage that any number of threads can sub-allocate from concurrently.
+ *
+ * Sizes are rounded up to the usage alignment, so a single atomic add on the offset of the current block
+ * reserves an aligned range. A thread whose range does not fit takes over a spare block, or creates one,
+ * and publishes it as the current block with a compare-and-swap: no allocation ever takes a lock.
+ * Blocks are kept across resets and become the spares of the next cycle.
+ */
+template <vkb::BindingType bindingType>
+class SharedBufferPool
+{
+  public:
+	using BufferUsageFlagsType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::BufferUsageFlags, VkBufferUsageFlags>::type;
+	using DeviceSizeType       = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::DeviceSize, VkDeviceSize>::type;
+
+	using DeviceType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::core::HPPDevice, vkb::Device>::type;
+
+  public:
+	SharedBufferPool(DeviceType &device, DeviceSizeType block_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage = VMA_MEMORY_USAGE_CPU_TO_GPU);
+	SharedBufferPool(SharedBufferPool const &)            = delete;
+	SharedBufferPool(SharedBufferPool &&)                 = delete;
+	SharedBufferPool &operator=(SharedBufferPool const &) = delete;
+	SharedBufferPool &operator=(SharedBufferPool &&)      = delete;
+	~SharedBufferPool();
+
+	/**
+	 * @brief Allocates a range of a block, it can be called from any thread
+	 * @return An usable view on a portion of one of the blocks
+	 */
+	BufferAllocation<bindingType> allocate(DeviceSizeType size);
+
+	/**
+	 * @brief Makes all the blocks available again, it must not run concurrently with allocate
+	 */
+	void reset();
+
+	/**
+	 * @return The total size of the blocks
+	 */
+	DeviceSizeType get_size() const;
+
+  private:
+	struct Block
+	{
+		Block(vkb::core::HPPDevice &device, vk::DeviceSize size, vk::BufferUsageFlags usage, VmaMemoryUsage memory_usage) :
+		    buffer{device, size, usage, memory_usage}
+		{}
+
+		vkb::core::BufferCpp buffer;
+
+		std::atomic<vk::DeviceSize> offset{0};
+
+		Block *next_created = nullptr;
+	};
+
+	/// Reserves an aligned range of a block, returns false if it does not fit
+	static bool try_allocate(Block &block, vk::DeviceSize size, vk::DeviceSize &offset);
+
+	/// Takes the block returned by a thread that lost the race to publish it, a spare block,
+	/// or creates one if all of them are in use, with room for at least the given size
+	Block &acquire_block(vk::DeviceSize minimum_size);
+
+	vkb::core::HPPDevice &device;
+	vk::DeviceSize        block_size = 0;
+	vk::BufferUsageFlags  usage;
+	VmaMemoryUsage        memory_usage{};
+	vk::DeviceSize        alignment = 0;
+
+	std::vector<std::unique_ptr<Block>> spare_blocks;              // Blocks of the previous cycles, only modified by reset
+	std::atomic<size_t>                 next_spare_block{0};
+	std::atomic<Block *>                created_blocks{nullptr};        // Blocks created during this cycle, linked through next_created
+	std::atomic<Block *>                current_block{nullptr};
+	std::atomic<Block *>                returned_block{nullptr};        // Partially used block that was never published as current
+	std::atomic<vk::DeviceSize>         size{0};
+};
+
+using SharedBufferPoolC   = SharedBufferPool<vkb::BindingType::C>;
+using SharedBufferPoolCpp = SharedBufferPool<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+SharedBufferPool<bindingType>::SharedBufferPool(DeviceType &device, DeviceSizeType block_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage) :
+    device{reinterpret_cast<vkb::core::HPPDevice &>(device)}, block_size{block_size}, usage{usage}, memory_usage{memory_usage}
+{
+	if constexpr (bindingType == BindingType::Cpp)
+	{
+		alignment = BufferBlockCpp::determine_alignment(usage, device.get_gpu().get_properties().limits);
+	}
+	else
+	{
+		alignment = BufferBlockCpp::determine_alignment(static_cast<vk::BufferUsageFlags>(usage),
+		                                                static_cast<vk::PhysicalDeviceLimits>(device.get_gpu().get_properties().limits));
+	}
+}
+
+template <vkb::BindingType bindingType>
+SharedBufferPool<bindingType>::~SharedBufferPool()
+{
+	reset();
+}
+
+template <vkb::BindingType bindingType>
+BufferAllocation<bindingType> SharedBufferPool<bindingType>::allocate(DeviceSizeType size)
+{
+	assert(size > 0 && "Allocation size must be greater than zero");
+
+	vk::DeviceSize aligned_size = (static_cast<vk::DeviceSize>(size) + alignment - 1) & ~(alignment - 1);
+	vk::DeviceSize offset       = 0;
+
+	Block *block = current_block.load(std::memory_order_acquire);
+
+	if (!block || !try_allocate(*block, aligned_size, offset))
+	{
+		Block &new_block = acquire_block(aligned_size);
+
+		// The new block is not shared yet, so this reservation cannot fail
+		[[maybe_unused]] bool allocated = try_allocate(new_block, aligned_size, offset);
+		assert(allocated);
+
+		// Publish it unless another thread already replaced the full block
+		if (!current_block.compare_exchange_strong(block, &new_block, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			// Hand the rest of the block to the next thread that runs out of space, a block it replaces
+			// there stays unused until the next cycle
+			returned_block.store(&new_block, std::memory_order_release);
+		}
+
+		block = &new_block;
+	}
+
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return BufferAllocationCpp{block->buffer, size, offset};
+	}
+	else
+	{
+		return BufferAllocationC{reinterpret_cast<vkb::core::BufferC &>(block->buffer), size, offset};
+	}
+}
+
+template <vkb::BindingType bindingType>
+void SharedBufferPool<bindingType>::reset()
+{
+	// Adopt the blocks created during this cycle
+	for (Block *block = created_blocks.exchange(nullptr); block;)
+	{
+		Block *next = block->next_created;
+		spare_blocks.emplace_back(block);
+		block = next;
+	}
+
+	for (auto &block : spare_blocks)
+	{
+		block->offset.store(0, std::memory_order_relaxed);
+	}
+
+	// Blocks created for large allocations are not worth keeping
+	std::erase_if(spare_blocks, [this](auto const &block) { return block->buffer.get_size() != block_size; });
+
+	size.store(spare_blocks.size() * block_size, std::memory_order_relaxed);
+	next_spare_block.store(0, std::memory_order_relaxed);
+	current_block.store(nullptr, std::memory_order_release);
+	returned_block.store(nullptr, std::memory_order_relaxed);
+}
+
+template <vkb::BindingType bindingType>
+typename SharedBufferPool<bindingType>::DeviceSizeType SharedBufferPool<bindingType>::get_size() const
+{
+	return static_cast<DeviceSizeType>(size.load(std::memory_order_relaxed));
+}
+
+template <vkb::BindingType bindingType>
+bool SharedBufferPool<bindingType>::try_allocate(Block &block, vk::DeviceSize size, vk::DeviceSize &offset)
+{
+	if (block.offset.load(std::memory_order_relaxed) + size > block.buffer.get_size())
+	{
+		// Avoid pushing the offset of a full block further
+		return false;
+	}
+
+	offset = block.offset.fetch_add(size, std::memory_order_relaxed);
+	return offset + size <= block.buffer.get_size();
+}
+
+template <vkb::BindingType bindingType>
+typename SharedBufferPool<bindingType>::Block &SharedBufferPool<bindingType>::acquire_block(vk::DeviceSize minimum_size)
+{
+	// A returned block was never shared, so taking it hands it over to this thread alone
+	Block *returned = returned_block.exchange(nullptr, std::memory_order_acquire);
+	if (returned && returned->offset.load(std::memory_order_relaxed) + minimum_size <= returned->buffer.get_size())
+	{
+		return *returned;
+	}
+
+	if (minimum_size <= block_size)
+	{
+		size_t index = next_spare_block.fetch_add(1, std::memory_order_relaxed);
+		if (index < spare_blocks.size())
+		{
+			return *spare_blocks[index];
+		}
+	}
+
+	vk::DeviceSize new_block_size = std::max(block_size, minimum_size);
+
+	LOGD("Building shared buffer block ({}, {} bytes)", vk::to_string(usage), new_block_size);
+
+	auto block = new Block{device, new_block_size, usage, memory_usage};
+	size.fetch_add(new_block_size, std::memory_order_relaxed);
+
+	// Lock-free push, the list is only walked by reset
+	block->next_created = created_blocks.load(std::memory_order_relaxed);
+	while (!created_blocks.compare_exchange_weak(block->next_created, block, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+
+	return *block;
+}
+
 /**
  * @brief A pool of buffer blocks for a specific usage.
  * It may contain inactive blocks that can be recycled.
@@ -316,6 +745,11 @@ class BufferPool
 
 	void reset();
 
+	/**
+	 * @return The total size of the blocks
+	 */
+	DeviceSizeType get_size() const;
+
   private:
 	vkb::core::HPPDevice                        &device;
 	std::vector<std::unique_ptr<BufferBlockCpp>> buffer_blocks;         /// List of blocks requested (need to be pointers in order to keep their address constant on vector resizing)
@@ -374,4 +808,15 @@ void BufferPool<bindingType>::reset()
 	}
 }
 
+template <vkb::BindingType bindingType>
+typename BufferPool<bindingType>::DeviceSizeType BufferPool<bindingType>::get_size() const
+{
+	vk::DeviceSize total_size = 0;
+	for (auto &buffer_block : buffer_blocks)
+	{
+		total_size += buffer_block->get_size();
+	}
+	return static_cast<DeviceSizeType>(total_size);
+}
+
 }        // namespace vkb
@@ -0,0 +1,125 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace vkb
+{
+/// Number of buckets of a creation time histogram, bucket i counts creations taking less than 2^i microseconds
+/// and the last bucket counts every slower creation
+constexpr size_t CREATION_TIME_BUCKET_COUNT = 20;
+
+/**
+ * @brief Snapshot of CacheCounters
+ */
+struct CacheStats
+{
+	/// Requests served by an object that was already cached
+	uint64_t hits{0};
+
+	/// Requests that did not find their object, including those that waited for another thread to create it
+	uint64_t misses{0};
+
+	/// Objects created
+	uint64_t creations{0};
+
+	/// Time spent creating objects, in milliseconds
+	double creation_time{0.0};
+
+	std::array<uint64_t, CREATION_TIME_BUCKET_COUNT> creation_time_histogram{};
+
+	CacheStats &operator+=(const CacheStats &other)
+	{
+		hits += other.hits;
+		misses += other.misses;
+		creations += other.creations;
+		creation_time += other.creation_time;
+
+		for (size_t i = 0; i < CREATION_TIME_BUCKET_COUNT; ++i)
+		{
+			creation_time_histogram[i] += other.creation_time_histogram[i];
+		}
+
+		return *this;
+	}
+};
+
+/**
+ * @brief Hit, miss and creation counters of a cache, they can be updated from any thread without locking
+ */
+class CacheCounters
+{
+  public:
+	void hit()
+	{
+		hits.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void miss()
+	{
+		misses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Counts the creation of an object
+	 * @param time Time spent creating the object, in milliseconds
+	 */
+	void created(double time)
+	{
+		auto   microseconds = static_cast<uint64_t>(time * 1000.0);
+		size_t bucket       = std::min<size_t>(std::bit_width(microseconds), CREATION_TIME_BUCKET_COUNT - 1);
+
+		creations.fetch_add(1, std::memory_order_relaxed);
+		creation_time.fetch_add(static_cast<uint64_t>(time * 1000000.0), std::memory_order_relaxed);
+		creation_time_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	CacheStats get_stats() const
+	{
+		CacheStats stats;
+		stats.hits          = hits.load(std::memory_order_relaxed);
+		stats.misses        = misses.load(std::memory_order_relaxed);
+		stats.creations     = creations.load(std::memory_order_relaxed);
+		stats.creation_time = static_cast<double>(creation_time.load(std::memory_order_relaxed)) / 1000000.0;
+
+		for (size_t i = 0; i < CREATION_TIME_BUCKET_COUNT; ++i)
+		{
+			stats.creation_time_histogram[i] = creation_time_histogram[i].load(std::memory_order_relaxed);
+		}
+
+		return stats;
+	}
+
+  private:
+	std::atomic<uint64_t> hits{0};
+
+	std::atomic<uint64_t> misses{0};
+
+	std::atomic<uint64_t> creations{0};
+
+	/// In nanoseconds
+	std::atomic<uint64_t> creation_time{0};
+
+	std::array<std::atomic<uint64_t>, CREATION_TIME_BUCKET_COUNT> creation_time_histogram{};
+};
+}        // namespace vkb
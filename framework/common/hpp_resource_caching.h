@@ -27,267 +27,118 @@
 #include "resource_caching.h"
 #include <vulkan/vulkan_hash.hpp>
 
-namespace std
+namespace vkb
 {
-template <typename Key, typename Value>
-struct hash<std::map<Key, Value>>
+namespace common
 {
-	size_t operator()(std::map<Key, Value> const &bindings) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, bindings.size());
-		for (auto const &binding : bindings)
-		{
-			vkb::hash_combine(result, binding.first);
-			vkb::hash_combine(result, binding.second);
-		}
-		return result;
-	}
-};
+/**
+ * @brief facade helper functions and structs around the functions and structs in common/resource_caching, providing a vulkan.hpp-based interface
+ */
 
+namespace
+{
 template <typename T>
-struct hash<std::vector<T>>
+inline void hash_param(Hasher &hasher, const T &value)
 {
-	size_t operator()(std::vector<T> const &values) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, values.size());
-		for (auto const &value : values)
-		{
-			vkb::hash_combine(result, value);
-		}
-		return result;
-	}
-};
+	vkb::hash_param(hasher, value);
+}
 
-template <>
-struct hash<vkb::common::HPPLoadStoreInfo>
+inline void hash_param(Hasher & /*hasher*/, const vk::PipelineCache & /*value*/)
 {
-	size_t operator()(vkb::common::HPPLoadStoreInfo const &lsi) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, lsi.load_op);
-		vkb::hash_combine(result, lsi.store_op);
-		return result;
-	}
-};
+}
 
-template <vkb::BindingType bindingType, typename T>
-struct hash<vkb::core::VulkanResource<bindingType, T>>
+inline void hash_param(Hasher &hasher, const vkb::core::HPPShaderSource &value)
 {
-	size_t operator()(const vkb::core::VulkanResource<bindingType, T> &vulkan_resource) const
-	{
-		return std::hash<T>()(vulkan_resource.get_handle());
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::ShaderSource const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPDescriptorPool>
+inline void hash_param(Hasher &hasher, const vkb::core::HPPShaderVariant &value)
 {
-	size_t operator()(const vkb::core::HPPDescriptorPool &descriptor_pool) const
-	{
-		return std::hash<vkb::DescriptorPool>()(reinterpret_cast<vkb::DescriptorPool const &>(descriptor_pool));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::ShaderVariant const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPDescriptorSet>
+inline void hash_param(Hasher &hasher, const vkb::core::HPPDescriptorSetLayout &value)
 {
-	size_t operator()(vkb::core::HPPDescriptorSet &descriptor_set) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, descriptor_set.get_layout());
-		// descriptor_pool ?
-		vkb::hash_combine(result, descriptor_set.get_buffer_infos());
-		vkb::hash_combine(result, descriptor_set.get_image_infos());
-		vkb::hash_combine(result, descriptor_set.get_handle());
-		// write_descriptor_sets ?
-
-		return result;
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::DescriptorSetLayout const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPDescriptorSetLayout>
+inline void hash_param(Hasher &hasher, const vkb::core::HPPDescriptorPool &value)
 {
-	size_t operator()(const vkb::core::HPPDescriptorSetLayout &descriptor_set_layout) const
-	{
-		return std::hash<vkb::DescriptorSetLayout>()(reinterpret_cast<vkb::DescriptorSetLayout const &>(descriptor_set_layout));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::DescriptorPool const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPImage>
+inline void hash_param(Hasher &hasher, const vkb::core::HPPRenderPass &value)
 {
-	size_t operator()(const vkb::core::HPPImage &image) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, image.get_memory());
-		vkb::hash_combine(result, image.get_type());
-		vkb::hash_combine(result, image.get_extent());
-		vkb::hash_combine(result, image.get_format());
-		vkb::hash_combine(result, image.get_usage());
-		vkb::hash_combine(result, image.get_sample_count());
-		vkb::hash_combine(result, image.get_tiling());
-		vkb::hash_combine(result, image.get_subresource());
-		vkb::hash_combine(result, image.get_array_layer_count());
-		return result;
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::RenderPass const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPImageView>
+inline void hash_param(Hasher &hasher, const vkb::rendering::HPPRenderTarget &value)
 {
-	size_t operator()(const vkb::core::HPPImageView &image_view) const
+	hasher.update(value.get_views().size());
+
+	for (auto &view : value.get_views())
 	{
-		size_t result = std::hash<vkb::core::VulkanResourceCpp<vk::ImageView>>()(image_view);
-		vkb::hash_combine(result, image_view.get_image());
-		vkb::hash_combine(result, image_view.get_format());
-		vkb::hash_combine(result, image_view.get_subresource_range());
-		return result;
+		hasher.update(view.get_handle());
+		hasher.update(view.get_image().get_handle());
 	}
-};
+}
 
-template <>
-struct hash<vkb::core::HPPRenderPass>
+inline void hash_param(Hasher &hasher, const vkb::rendering::HPPPipelineState &value)
 {
-	size_t operator()(const vkb::core::HPPRenderPass &render_pass) const
-	{
-		return std::hash<vkb::RenderPass>()(reinterpret_cast<vkb::RenderPass const &>(render_pass));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<vkb::PipelineState const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPShaderModule>
+inline void hash_param(Hasher &hasher, const std::vector<vkb::rendering::HPPAttachment> &value)
 {
-	size_t operator()(const vkb::core::HPPShaderModule &shader_module) const
-	{
-		return std::hash<vkb::ShaderModule>()(reinterpret_cast<vkb::ShaderModule const &>(shader_module));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<std::vector<vkb::Attachment> const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPShaderResource>
+inline void hash_param(Hasher &hasher, const std::vector<vkb::common::HPPLoadStoreInfo> &value)
 {
-	size_t operator()(vkb::core::HPPShaderResource const &shader_resource) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, shader_resource.stages);
-		vkb::hash_combine(result, shader_resource.type);
-		vkb::hash_combine(result, shader_resource.mode);
-		vkb::hash_combine(result, shader_resource.set);
-		vkb::hash_combine(result, shader_resource.binding);
-		vkb::hash_combine(result, shader_resource.location);
-		vkb::hash_combine(result, shader_resource.input_attachment_index);
-		vkb::hash_combine(result, shader_resource.vec_size);
-		vkb::hash_combine(result, shader_resource.columns);
-		vkb::hash_combine(result, shader_resource.array_size);
-		vkb::hash_combine(result, shader_resource.offset);
-		vkb::hash_combine(result, shader_resource.size);
-		vkb::hash_combine(result, shader_resource.constant_id);
-		vkb::hash_combine(result, shader_resource.qualifiers);
-		vkb::hash_combine(result, shader_resource.name);
-		return result;
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<std::vector<vkb::LoadStoreInfo> const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPShaderSource>
+inline void hash_param(Hasher &hasher, const std::vector<vkb::core::HPPSubpassInfo> &value)
 {
-	size_t operator()(const vkb::core::HPPShaderSource &shader_source) const
-	{
-		return std::hash<vkb::ShaderSource>()(reinterpret_cast<vkb::ShaderSource const &>(shader_source));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<std::vector<vkb::SubpassInfo> const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPShaderVariant>
+inline void hash_param(Hasher &hasher, const std::vector<vkb::core::HPPShaderModule *> &value)
 {
-	size_t operator()(const vkb::core::HPPShaderVariant &shader_variant) const
-	{
-		return std::hash<vkb::ShaderVariant>()(reinterpret_cast<vkb::ShaderVariant const &>(shader_variant));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(value));
+}
 
-template <>
-struct hash<vkb::core::HPPSubpassInfo>
+inline void hash_param(Hasher &hasher, const std::vector<vkb::core::HPPShaderResource> &value)
 {
-	size_t operator()(vkb::core::HPPSubpassInfo const &subpass_info) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, subpass_info.input_attachments);
-		vkb::hash_combine(result, subpass_info.output_attachments);
-		vkb::hash_combine(result, subpass_info.color_resolve_attachments);
-		vkb::hash_combine(result, subpass_info.disable_depth_stencil_attachment);
-		vkb::hash_combine(result, subpass_info.depth_stencil_resolve_attachment);
-		vkb::hash_combine(result, subpass_info.depth_stencil_resolve_mode);
-		vkb::hash_combine(result, subpass_info.debug_name);
-		return result;
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<std::vector<vkb::ShaderResource> const &>(value));
+}
 
-template <>
-struct hash<vkb::rendering::HPPAttachment>
+inline void hash_param(Hasher &hasher, const BindingMap<vk::DescriptorBufferInfo> &value)
 {
-	size_t operator()(const vkb::rendering::HPPAttachment &attachment) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, attachment.format);
-		vkb::hash_combine(result, attachment.samples);
-		vkb::hash_combine(result, attachment.usage);
-		vkb::hash_combine(result, attachment.initial_layout);
-		return result;
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<BindingMap<VkDescriptorBufferInfo> const &>(value));
+}
 
-template <>
-struct hash<vkb::rendering::HPPPipelineState>
+inline void hash_param(Hasher &hasher, const BindingMap<vk::DescriptorImageInfo> &value)
 {
-	size_t operator()(const vkb::rendering::HPPPipelineState &pipeline_state) const
-	{
-		return std::hash<vkb::PipelineState>()(reinterpret_cast<vkb::PipelineState const &>(pipeline_state));
-	}
-};
+	vkb::hash_param(hasher, reinterpret_cast<BindingMap<VkDescriptorImageInfo> const &>(value));
+}
 
-template <>
-struct hash<vkb::rendering::HPPRenderTarget>
+template <typename T, typename... Args>
+inline void hash_param(Hasher &hasher, const T &first_arg, const Args &...args)
 {
-	size_t operator()(const vkb::rendering::HPPRenderTarget &render_target) const
-	{
-		size_t result = 0;
-		vkb::hash_combine(result, render_target.get_extent());
-		for (auto const &view : render_target.get_views())
-		{
-			vkb::hash_combine(result, view);
-		}
-		for (auto const &attachment : render_target.get_attachments())
-		{
-			vkb::hash_combine(result, attachment);
-		}
-		for (auto const &input : render_target.get_input_attachments())
-		{
-			vkb::hash_combine(result, input);
-		}
-		for (auto const &output : render_target.get_output_attachments())
-		{
-			vkb::hash_combine(result, output);
-		}
-		return result;
-	}
-};
+	hash_param(hasher, first_arg);
 
-}        // namespace std
+	hash_param(hasher, args...);
+}
 
-namespace vkb
-{
-namespace common
+template <typename... Args>
+inline Hash128 hash_params(const Args &...args)
 {
-/**
- * @brief facade helper functions and structs around the functions and structs in common/resource_caching, providing a vulkan.hpp-based interface
- */
+	Hasher hasher;
+	hash_param(hasher, args...);
+	return hasher.get_hash();
+}
 
-namespace
-{
 template <class T, class... A>
 struct HPPRecordHelper
 {
@@ -328,6 +179,20 @@ struct HPPRecordHelper<vkb::core::HPPPipelineLayout, A...>
 	}
 };
 
+template <class... A>
+struct HPPRecordHelper<vkb::core::HPPDescriptorSetLayout, A...>
+{
+	size_t record(HPPResourceRecord &recorder, A &...args)
+	{
+		return recorder.register_descriptor_set_layout(args...);
+	}
+
+	void index(HPPResourceRecord &recorder, size_t index, vkb::core::HPPDescriptorSetLayout &descriptor_set_layout)
+	{
+		recorder.set_descriptor_set_layout(index, descriptor_set_layout);
+	}
+};
+
 template <class... A>
 struct HPPRecordHelper<vkb::core::HPPRenderPass, A...>
 {
@@ -355,15 +220,28 @@ struct HPPRecordHelper<vkb::core::HPPGraphicsPipeline, A...>
 		recorder.set_graphics_pipeline(index, graphics_pipeline);
 	}
 };
+
+template <class... A>
+struct HPPRecordHelper<vkb::core::HPPComputePipeline, A...>
+{
+	size_t record(HPPResourceRecord &recorder, A &...args)
+	{
+		return recorder.register_compute_pipeline(args...);
+	}
+
+	void index(HPPResourceRecord &recorder, size_t index, vkb::core::HPPComputePipeline &compute_pipeline)
+	{
+		recorder.set_compute_pipeline(index, compute_pipeline);
+	}
+};
 }        // namespace
 
 template <class T, class... A>
-T &request_resource(vkb::core::HPPDevice &device, vkb::HPPResourceRecord *recorder, std::unordered_map<size_t, T> &resources, A &...args)
+T &request_resource(vkb::core::HPPDevice &device, vkb::HPPResourceRecord *recorder, std::unordered_map<Hash128, T> &resources, A &...args)
 {
 	HPPRecordHelper<T, A...> record_helper;
 
-	size_t hash{0U};
-	hash_param(hash, args...);
+	Hash128 hash = hash_params(args...);
 
 	auto res_it = resources.find(hash);
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -28,203 +28,9 @@
 
 #include "common/helpers.h"
 
+// Resource cache keys are built by hash_param below, these only hash the write operations tracked by DescriptorSet::update
 namespace std
 {
-template <>
-struct hash<vkb::ShaderSource>
-{
-	std::size_t operator()(const vkb::ShaderSource &shader_source) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, shader_source.get_id());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::ShaderVariant>
-{
-	std::size_t operator()(const vkb::ShaderVariant &shader_variant) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, shader_variant.get_id());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::ShaderModule>
-{
-	std::size_t operator()(const vkb::ShaderModule &shader_module) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, shader_module.get_id());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::DescriptorSetLayout>
-{
-	std::size_t operator()(const vkb::DescriptorSetLayout &descriptor_set_layout) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, descriptor_set_layout.get_handle());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::DescriptorPool>
-{
-	std::size_t operator()(const vkb::DescriptorPool &descriptor_pool) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, descriptor_pool.get_descriptor_set_layout());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::PipelineLayout>
-{
-	std::size_t operator()(const vkb::PipelineLayout &pipeline_layout) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, pipeline_layout.get_handle());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::RenderPass>
-{
-	std::size_t operator()(const vkb::RenderPass &render_pass) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, render_pass.get_handle());
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::Attachment>
-{
-	std::size_t operator()(const vkb::Attachment &attachment) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkFormat>::type>(attachment.format));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkSampleCountFlagBits>::type>(attachment.samples));
-		vkb::hash_combine(result, attachment.usage);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkImageLayout>::type>(attachment.initial_layout));
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::LoadStoreInfo>
-{
-	std::size_t operator()(const vkb::LoadStoreInfo &load_store_info) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkAttachmentLoadOp>::type>(load_store_info.load_op));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkAttachmentStoreOp>::type>(load_store_info.store_op));
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::SubpassInfo>
-{
-	std::size_t operator()(const vkb::SubpassInfo &subpass_info) const
-	{
-		std::size_t result = 0;
-
-		for (uint32_t output_attachment : subpass_info.output_attachments)
-		{
-			vkb::hash_combine(result, output_attachment);
-		}
-
-		for (uint32_t input_attachment : subpass_info.input_attachments)
-		{
-			vkb::hash_combine(result, input_attachment);
-		}
-
-		for (uint32_t resolve_attachment : subpass_info.color_resolve_attachments)
-		{
-			vkb::hash_combine(result, resolve_attachment);
-		}
-
-		vkb::hash_combine(result, subpass_info.disable_depth_stencil_attachment);
-		vkb::hash_combine(result, subpass_info.depth_stencil_resolve_attachment);
-		vkb::hash_combine(result, subpass_info.depth_stencil_resolve_mode);
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::SpecializationConstantState>
-{
-	std::size_t operator()(const vkb::SpecializationConstantState &specialization_constant_state) const
-	{
-		std::size_t result = 0;
-
-		for (auto constants : specialization_constant_state.get_specialization_constant_state())
-		{
-			vkb::hash_combine(result, constants.first);
-			for (const auto data : constants.second)
-			{
-				vkb::hash_combine(result, data);
-			}
-		}
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::ShaderResource>
-{
-	std::size_t operator()(const vkb::ShaderResource &shader_resource) const
-	{
-		std::size_t result = 0;
-
-		if (shader_resource.type == vkb::ShaderResourceType::Input ||
-		    shader_resource.type == vkb::ShaderResourceType::Output ||
-		    shader_resource.type == vkb::ShaderResourceType::PushConstant ||
-		    shader_resource.type == vkb::ShaderResourceType::SpecializationConstant)
-		{
-			return result;
-		}
-
-		vkb::hash_combine(result, shader_resource.set);
-		vkb::hash_combine(result, shader_resource.binding);
-		vkb::hash_combine(result, static_cast<std::underlying_type<vkb::ShaderResourceType>::type>(shader_resource.type));
-		vkb::hash_combine(result, shader_resource.mode);
-
-		return result;
-	}
-};
-
 template <>
 struct hash<VkDescriptorBufferInfo>
 {
@@ -307,351 +113,218 @@ struct hash<VkWriteDescriptorSet>
 		return result;
 	}
 };
+}        // namespace std
 
-template <>
-struct hash<VkVertexInputAttributeDescription>
-{
-	std::size_t operator()(const VkVertexInputAttributeDescription &vertex_attrib) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, vertex_attrib.binding);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkFormat>::type>(vertex_attrib.format));
-		vkb::hash_combine(result, vertex_attrib.location);
-		vkb::hash_combine(result, vertex_attrib.offset);
-
-		return result;
-	}
-};
-
-template <>
-struct hash<VkVertexInputBindingDescription>
-{
-	std::size_t operator()(const VkVertexInputBindingDescription &vertex_binding) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, vertex_binding.binding);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkVertexInputRate>::type>(vertex_binding.inputRate));
-		vkb::hash_combine(result, vertex_binding.stride);
-
-		return result;
-	}
-};
-
-template <>
-struct hash<vkb::StencilOpState>
+namespace vkb
 {
-	std::size_t operator()(const vkb::StencilOpState &stencil) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(stencil.compare_op));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.depth_fail_op));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.fail_op));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.pass_op));
-
-		return result;
-	}
-};
-
-template <>
-struct hash<VkExtent2D>
+namespace
 {
-	size_t operator()(const VkExtent2D &extent) const
-	{
-		size_t result = 0;
-
-		vkb::hash_combine(result, extent.width);
-		vkb::hash_combine(result, extent.height);
-
-		return result;
-	}
-};
-
-template <>
-struct hash<VkOffset2D>
+template <typename T>
+inline void hash_param(Hasher &hasher, const T &value)
 {
-	size_t operator()(const VkOffset2D &offset) const
-	{
-		size_t result = 0;
-
-		vkb::hash_combine(result, offset.x);
-		vkb::hash_combine(result, offset.y);
-
-		return result;
-	}
-};
+	hasher.update(value);
+}
 
-template <>
-struct hash<VkRect2D>
+inline void hash_param(Hasher & /*hasher*/, const VkPipelineCache & /*value*/)
 {
-	size_t operator()(const VkRect2D &rect) const
-	{
-		size_t result = 0;
-
-		vkb::hash_combine(result, rect.extent);
-		vkb::hash_combine(result, rect.offset);
-
-		return result;
-	}
-};
+}
 
-template <>
-struct hash<VkViewport>
+inline void hash_param(Hasher &hasher, const std::string &value)
 {
-	size_t operator()(const VkViewport &viewport) const
-	{
-		size_t result = 0;
-
-		vkb::hash_combine(result, viewport.width);
-		vkb::hash_combine(result, viewport.height);
-		vkb::hash_combine(result, viewport.maxDepth);
-		vkb::hash_combine(result, viewport.minDepth);
-		vkb::hash_combine(result, viewport.x);
-		vkb::hash_combine(result, viewport.y);
-
-		return result;
-	}
-};
+	hasher.update(value);
+}
 
-template <>
-struct hash<vkb::ColorBlendAttachmentState>
+inline void hash_param(Hasher &hasher, const std::vector<uint8_t> &value)
 {
-	std::size_t operator()(const vkb::ColorBlendAttachmentState &color_blend_attachment) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendOp>::type>(color_blend_attachment.alpha_blend_op));
-		vkb::hash_combine(result, color_blend_attachment.blend_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendOp>::type>(color_blend_attachment.color_blend_op));
-		vkb::hash_combine(result, color_blend_attachment.color_write_mask);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.dst_alpha_blend_factor));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.dst_color_blend_factor));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.src_alpha_blend_factor));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.src_color_blend_factor));
-
-		return result;
-	}
-};
+	hasher.update(value.data(), value.size());
+}
 
-template <>
-struct hash<vkb::RenderTarget>
+inline void hash_param(Hasher &hasher, const ShaderSource &value)
 {
-	std::size_t operator()(const vkb::RenderTarget &render_target) const
-	{
-		std::size_t result = 0;
-
-		for (auto &view : render_target.get_views())
-		{
-			vkb::hash_combine(result, view.get_handle());
-			vkb::hash_combine(result, view.get_image().get_handle());
-		}
-
-		return result;
-	}
-};
+	hasher.update(value.get_id());
+}
 
-template <>
-struct hash<vkb::PipelineState>
+inline void hash_param(Hasher &hasher, const ShaderVariant &value)
 {
-	std::size_t operator()(const vkb::PipelineState &pipeline_state) const
-	{
-		std::size_t result = 0;
-
-		vkb::hash_combine(result, pipeline_state.get_pipeline_layout().get_handle());
-
-		// For graphics only
-		if (auto render_pass = pipeline_state.get_render_pass())
-		{
-			vkb::hash_combine(result, render_pass->get_handle());
-		}
-
-		vkb::hash_combine(result, pipeline_state.get_specialization_constant_state());
-
-		vkb::hash_combine(result, pipeline_state.get_subpass_index());
-
-		for (auto shader_module : pipeline_state.get_pipeline_layout().get_shader_modules())
-		{
-			vkb::hash_combine(result, shader_module->get_id());
-		}
-
-		// VkPipelineVertexInputStateCreateInfo
-		for (auto &attribute : pipeline_state.get_vertex_input_state().attributes)
-		{
-			vkb::hash_combine(result, attribute);
-		}
-
-		for (auto &binding : pipeline_state.get_vertex_input_state().bindings)
-		{
-			vkb::hash_combine(result, binding);
-		}
-
-		// VkPipelineInputAssemblyStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_input_assembly_state().primitive_restart_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkPrimitiveTopology>::type>(pipeline_state.get_input_assembly_state().topology));
-
-		//VkPipelineViewportStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_viewport_state().viewport_count);
-		vkb::hash_combine(result, pipeline_state.get_viewport_state().scissor_count);
-
-		// VkPipelineRasterizationStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_rasterization_state().cull_mode);
-		vkb::hash_combine(result, pipeline_state.get_rasterization_state().depth_bias_enable);
-		vkb::hash_combine(result, pipeline_state.get_rasterization_state().depth_clamp_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkFrontFace>::type>(pipeline_state.get_rasterization_state().front_face));
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkPolygonMode>::type>(pipeline_state.get_rasterization_state().polygon_mode));
-		vkb::hash_combine(result, pipeline_state.get_rasterization_state().rasterizer_discard_enable);
-
-		// VkPipelineMultisampleStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_multisample_state().alpha_to_coverage_enable);
-		vkb::hash_combine(result, pipeline_state.get_multisample_state().alpha_to_one_enable);
-		vkb::hash_combine(result, pipeline_state.get_multisample_state().min_sample_shading);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkSampleCountFlagBits>::type>(pipeline_state.get_multisample_state().rasterization_samples));
-		vkb::hash_combine(result, pipeline_state.get_multisample_state().sample_shading_enable);
-		vkb::hash_combine(result, pipeline_state.get_multisample_state().sample_mask);
-
-		// VkPipelineDepthStencilStateCreateInfo
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().back);
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_bounds_test_enable);
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(pipeline_state.get_depth_stencil_state().depth_compare_op));
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_test_enable);
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().depth_write_enable);
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().front);
-		vkb::hash_combine(result, pipeline_state.get_depth_stencil_state().stencil_test_enable);
-
-		// VkPipelineColorBlendStateCreateInfo
-		vkb::hash_combine(result, static_cast<std::underlying_type<VkLogicOp>::type>(pipeline_state.get_color_blend_state().logic_op));
-		vkb::hash_combine(result, pipeline_state.get_color_blend_state().logic_op_enable);
-
-		for (auto &attachment : pipeline_state.get_color_blend_state().attachments)
-		{
-			vkb::hash_combine(result, attachment);
-		}
-
-		return result;
-	}
-};
-}        // namespace std
+	hasher.update(value.get_id());
+}
 
-namespace vkb
-{
-namespace
+inline void hash_param(Hasher &hasher, const DescriptorSetLayout &value)
 {
-template <typename T>
-inline void hash_param(size_t &seed, const T &value)
-{
-	hash_combine(seed, value);
+	hasher.update(value.get_handle());
 }
 
-template <>
-inline void hash_param(size_t & /*seed*/, const VkPipelineCache & /*value*/)
+inline void hash_param(Hasher &hasher, const DescriptorPool &value)
 {
+	hasher.update(value.get_descriptor_set_layout().get_handle());
 }
 
-template <>
-inline void hash_param<std::vector<uint8_t>>(
-    size_t &                    seed,
-    const std::vector<uint8_t> &value)
+inline void hash_param(Hasher &hasher, const RenderPass &value)
 {
-	hash_combine(seed, std::string{value.begin(), value.end()});
+	hasher.update(value.get_handle());
 }
 
-template <>
-inline void hash_param<std::vector<Attachment>>(
-    size_t &                       seed,
-    const std::vector<Attachment> &value)
+inline void hash_param(Hasher &hasher, const RenderTarget &value)
 {
-	for (auto &attachment : value)
+	hasher.update(value.get_views().size());
+
+	for (auto &view : value.get_views())
 	{
-		hash_combine(seed, attachment);
+		hasher.update(view.get_handle());
+		hasher.update(view.get_image().get_handle());
 	}
 }
 
-template <>
-inline void hash_param<std::vector<LoadStoreInfo>>(
-    size_t &                          seed,
-    const std::vector<LoadStoreInfo> &value)
+inline void hash_param(Hasher &hasher, const std::vector<Attachment> &value)
 {
-	for (auto &load_store_info : value)
-	{
-		hash_combine(seed, load_store_info);
-	}
+	hasher.update(value.data(), value.size() * sizeof(Attachment));
 }
 
-template <>
-inline void hash_param<std::vector<SubpassInfo>>(
-    size_t &                        seed,
-    const std::vector<SubpassInfo> &value)
+inline void hash_param(Hasher &hasher, const std::vector<LoadStoreInfo> &value)
 {
+	hasher.update(value.data(), value.size() * sizeof(LoadStoreInfo));
+}
+
+inline void hash_param(Hasher &hasher, const std::vector<SubpassInfo> &value)
+{
+	hasher.update(value.size());
+
 	for (auto &subpass_info : value)
 	{
-		hash_combine(seed, subpass_info);
+		hasher.update(subpass_info.input_attachments.data(), subpass_info.input_attachments.size() * sizeof(uint32_t));
+		hasher.update(subpass_info.output_attachments.data(), subpass_info.output_attachments.size() * sizeof(uint32_t));
+		hasher.update(subpass_info.color_resolve_attachments.data(), subpass_info.color_resolve_attachments.size() * sizeof(uint32_t));
+		hasher.update(subpass_info.disable_depth_stencil_attachment);
+		hasher.update(subpass_info.depth_stencil_resolve_attachment);
+		hasher.update(subpass_info.depth_stencil_resolve_mode);
 	}
 }
 
-template <>
-inline void hash_param<std::vector<ShaderModule *>>(
-    size_t &                           seed,
-    const std::vector<ShaderModule *> &value)
+inline void hash_param(Hasher &hasher, const std::vector<ShaderModule *> &value)
 {
+	hasher.update(value.size());
+
 	for (auto &shader_module : value)
 	{
-		hash_combine(seed, shader_module->get_id());
+		hasher.update(shader_module->get_id());
 	}
 }
 
-template <>
-inline void hash_param<std::vector<ShaderResource>>(
-    size_t &                           seed,
-    const std::vector<ShaderResource> &value)
+inline void hash_param(Hasher &hasher, const std::vector<ShaderResource> &value)
 {
+	hasher.update(value.size());
+
 	for (auto &resource : value)
 	{
-		hash_combine(seed, resource);
+		// Only resources backed by descriptors affect the layout
+		if (resource.type == ShaderResourceType::Input ||
+		    resource.type == ShaderResourceType::Output ||
+		    resource.type == ShaderResourceType::PushConstant ||
+		    resource.type == ShaderResourceType::SpecializationConstant)
+		{
+			continue;
+		}
+
+		hasher.update(resource.set);
+		hasher.update(resource.binding);
+		hasher.update(resource.type);
+		hasher.update(resource.mode);
 	}
 }
 
-template <>
-inline void hash_param<std::map<uint32_t, std::map<uint32_t, VkDescriptorBufferInfo>>>(
-    size_t &                                                              seed,
-    const std::map<uint32_t, std::map<uint32_t, VkDescriptorBufferInfo>> &value)
+inline void hash_param(Hasher &hasher, const BindingMap<VkDescriptorBufferInfo> &value)
 {
+	hasher.update(value.size());
+
 	for (auto &binding_set : value)
 	{
-		hash_combine(seed, binding_set.first);
+		hasher.update(binding_set.first);
+		hasher.update(binding_set.second.size());
 
 		for (auto &binding_element : binding_set.second)
 		{
-			hash_combine(seed, binding_element.first);
-			hash_combine(seed, binding_element.second);
+			// VkDescriptorBufferInfo is a handle and two VkDeviceSize, without padding
+			hasher.update(binding_element.first);
+			hasher.update(binding_element.second);
 		}
 	}
 }
 
-template <>
-inline void hash_param<std::map<uint32_t, std::map<uint32_t, VkDescriptorImageInfo>>>(
-    size_t &                                                             seed,
-    const std::map<uint32_t, std::map<uint32_t, VkDescriptorImageInfo>> &value)
+inline void hash_param(Hasher &hasher, const BindingMap<VkDescriptorImageInfo> &value)
 {
+	hasher.update(value.size());
+
 	for (auto &binding_set : value)
 	{
-		hash_combine(seed, binding_set.first);
+		hasher.update(binding_set.first);
+		hasher.update(binding_set.second.size());
 
 		for (auto &binding_element : binding_set.second)
 		{
-			hash_combine(seed, binding_element.first);
-			hash_combine(seed, binding_element.second);
+			hasher.update(binding_element.first);
+			hasher.update(binding_element.second.sampler);
+			hasher.update(binding_element.second.imageView);
+			hasher.update(binding_element.second.imageLayout);
 		}
 	}
 }
 
+inline void hash_param(Hasher &hasher, const PipelineState &value)
+{
+	hasher.update(value.get_pipeline_layout().get_handle());
+
+	// For graphics only
+	if (auto render_pass = value.get_render_pass())
+	{
+		hasher.update(render_pass->get_handle());
+	}
+
+	auto &specialization_constants = value.get_specialization_constant_state().get_specialization_constant_state();
+	hasher.update(specialization_constants.size());
+	for (auto &constant : specialization_constants)
+	{
+		hasher.update(constant.first);
+		hasher.update(constant.second.data(), constant.second.size());
+	}
+
+	hasher.update(value.get_subpass_index());
+
+	hash_param(hasher, value.get_pipeline_layout().get_shader_modules());
+
+	// The fixed-function state structs only hold 32-bit members, so they are hashed as packed bytes
+	auto &vertex_input_state = value.get_vertex_input_state();
+	hasher.update(vertex_input_state.attributes.data(), vertex_input_state.attributes.size() * sizeof(VkVertexInputAttributeDescription));
+	hasher.update(vertex_input_state.bindings.data(), vertex_input_state.bindings.size() * sizeof(VkVertexInputBindingDescription));
+
+	hasher.update(value.get_input_assembly_state());
+	hasher.update(value.get_viewport_state());
+	hasher.update(value.get_rasterization_state());
+	hasher.update(value.get_multisample_state());
+	hasher.update(value.get_depth_stencil_state());
+
+	auto &color_blend_state = value.get_color_blend_state();
+	hasher.update(color_blend_state.logic_op_enable);
+	hasher.update(color_blend_state.logic_op);
+	hasher.update(color_blend_state.attachments.data(), color_blend_state.attachments.size() * sizeof(ColorBlendAttachmentState));
+}
+
 template <typename T, typename... Args>
-inline void hash_param(size_t &seed, const T &first_arg, const Args &... args)
+inline void hash_param(Hasher &hasher, const T &first_arg, const Args &...args)
 {
-	hash_param(seed, first_arg);
+	hash_param(hasher, first_arg);
 
-	hash_param(seed, args...);
+	hash_param(hasher, args...);
+}
+
+/**
+ * @brief Computes the key of a cached resource from the arguments used to create it
+ */
+template <typename... Args>
+inline Hash128 hash_params(const Args &...args)
+{
+	Hasher hasher;
+	hash_param(hasher, args...);
+	return hasher.get_hash();
 }
 
 template <class T, class... A>
@@ -695,6 +368,20 @@ struct RecordHelper<PipelineLayout, A...>
 	}
 };
 
+template <class... A>
+struct RecordHelper<DescriptorSetLayout, A...>
+{
+	size_t record(ResourceRecord &recorder, A &... args)
+	{
+		return recorder.register_descriptor_set_layout(args...);
+	}
+
+	void index(ResourceRecord &recorder, size_t index, DescriptorSetLayout &descriptor_set_layout)
+	{
+		recorder.set_descriptor_set_layout(index, descriptor_set_layout);
+	}
+};
+
 template <class... A>
 struct RecordHelper<RenderPass, A...>
 {
@@ -722,15 +409,28 @@ struct RecordHelper<GraphicsPipeline, A...>
 		recorder.set_graphics_pipeline(index, graphics_pipeline);
 	}
 };
+
+template <class... A>
+struct RecordHelper<ComputePipeline, A...>
+{
+	size_t record(ResourceRecord &recorder, A &... args)
+	{
+		return recorder.register_compute_pipeline(args...);
+	}
+
+	void index(ResourceRecord &recorder, size_t index, ComputePipeline &compute_pipeline)
+	{
+		recorder.set_compute_pipeline(index, compute_pipeline);
+	}
+};
 }        // namespace
 
 template <class T, class... A>
-T &request_resource(Device &device, ResourceRecord *recorder, std::unordered_map<std::size_t, T> &resources, A &... args)
+T &request_resource(Device &device, ResourceRecord *recorder, std::unordered_map<Hash128, T> &resources, A &... args)
 {
 	RecordHelper<T, A...> record_helper;
 
-	std::size_t hash{0U};
-	hash_param(hash, args...);
+	Hash128 hash = hash_params(args...);
 
 	auto res_it = resources.find(hash);
 
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 
 #include "core/shader_module.h"
+#include "resource_record.h"
 #include "scene_graph/components/material.h"
 
 namespace vkb
@@ -1508,6 +1509,33 @@ const std::string to_string(ShaderResourceType type)
 	}
 }
 
+const std::string to_string(ResourceType type)
+{
+	switch (type)
+	{
+		case ResourceType::ShaderModule:
+			return "ShaderModule";
+		case ResourceType::PipelineLayout:
+			return "PipelineLayout";
+		case ResourceType::RenderPass:
+			return "RenderPass";
+		case ResourceType::GraphicsPipeline:
+			return "GraphicsPipeline";
+		case ResourceType::DescriptorSetLayout:
+			return "DescriptorSetLayout";
+		case ResourceType::ComputePipeline:
+			return "ComputePipeline";
+		case ResourceType::DescriptorPool:
+			return "DescriptorPool";
+		case ResourceType::DescriptorSet:
+			return "DescriptorSet";
+		case ResourceType::Framebuffer:
+			return "Framebuffer";
+		default:
+			return "Unknown Type";
+	}
+}
+
 const std::string buffer_usage_to_string(VkBufferUsageFlags flags)
 {
 	return to_string<VkBufferUsageFlagBits>(flags,
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -27,6 +27,7 @@
 
 namespace vkb
 {
+enum class ResourceType : uint32_t;
 enum class ShaderResourceType;
 
 namespace sg
@@ -212,6 +213,13 @@ const std::string to_string(bool flag);
  */
 const std::string to_string(ShaderResourceType type);
 
+/**
+ * @brief Helper function to convert ResourceType to a string
+ * @param type ResourceType to convert
+ * @return The string to return
+ */
+const std::string to_string(ResourceType type);
+
 /**
  * @brief Helper generic function to convert a bitmask to a string of its components
  * @param bitmask The bitmask to convert
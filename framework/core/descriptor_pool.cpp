@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -137,6 +137,11 @@ VkResult DescriptorPool::free(VkDescriptorSet descriptor_set)
 
 	auto desc_pool_index = it->second;
 
+	if (!pool_free_sets[desc_pool_index])
+	{
+		return VK_ERROR_FEATURE_NOT_PRESENT;
+	}
+
 	// Free descriptor set from the pool
 	vkFreeDescriptorSets(device.get_handle(), pools[desc_pool_index], 1, &descriptor_set);
 
@@ -152,6 +157,18 @@ VkResult DescriptorPool::free(VkDescriptorSet descriptor_set)
 	return VK_SUCCESS;
 }
 
+void DescriptorPool::set_free_descriptor_sets(bool new_free_descriptor_sets)
+{
+	free_descriptor_sets = new_free_descriptor_sets;
+}
+
+bool DescriptorPool::can_free(VkDescriptorSet descriptor_set) const
+{
+	auto it = set_pool_mapping.find(descriptor_set);
+
+	return it != set_pool_mapping.end() && pool_free_sets[it->second];
+}
+
 std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
 {
 	// Create a new pool
@@ -163,9 +180,14 @@ std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
 		create_info.pPoolSizes    = pool_sizes.data();
 		create_info.maxSets       = pool_max_sets;
 
-		// We do not set FREE_DESCRIPTOR_SET_BIT as we do not need to free individual descriptor sets
 		create_info.flags = 0;
 
+		// Individual descriptor sets are only freed when the resource cache has a descriptor set budget
+		if (free_descriptor_sets)
+		{
+			create_info.flags |= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		}
+
 		// Check descriptor set layout and enable the required flags
 		auto &binding_flags = descriptor_set_layout->get_binding_flags();
 		for (auto binding_flag : binding_flags)
@@ -192,6 +214,8 @@ std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
 		// Add set count for the descriptor pool
 		pool_sets_count.push_back(0);
 
+		pool_free_sets.push_back(free_descriptor_sets);
+
 		return search_index;
 	}
 	else if (pool_sets_count[search_index] < pool_max_sets)
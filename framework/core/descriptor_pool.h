@@ -59,6 +59,17 @@ class DescriptorPool
 
 	VkResult free(VkDescriptorSet descriptor_set);
 
+	/**
+	 * @brief Creates the pools added from now on with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+	 *        sets allocated from pools created before cannot be freed individually
+	 */
+	void set_free_descriptor_sets(bool free_descriptor_sets);
+
+	/**
+	 * @return Whether a descriptor set was allocated from a pool that allows freeing it individually
+	 */
+	bool can_free(VkDescriptorSet descriptor_set) const;
+
   private:
 	Device &device;
 
@@ -76,6 +87,12 @@ class DescriptorPool
 	// Count sets for each pool
 	std::vector<uint32_t> pool_sets_count;
 
+	// Whether each pool was created with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT
+	std::vector<bool> pool_free_sets;
+
+	// Create new pools with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT
+	bool free_descriptor_sets{false};
+
 	// Current pool index to allocate descriptor set
 	uint32_t pool_index{0};
 
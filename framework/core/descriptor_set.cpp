@@ -160,7 +160,7 @@ void DescriptorSet::update(const std::vector<uint32_t> &bindings_to_update)
 			const auto &write_operation = write_descriptor_sets[i];
 
 			size_t write_operation_hash = 0;
-			hash_param(write_operation_hash, write_operation);
+			hash_combine(write_operation_hash, write_operation);
 
 			auto update_pair_it = updated_bindings.find(write_operation.dstBinding);
 			if (update_pair_it == updated_bindings.end() || update_pair_it->second != write_operation_hash)
@@ -181,7 +181,7 @@ void DescriptorSet::update(const std::vector<uint32_t> &bindings_to_update)
 			if (std::ranges::find(bindings_to_update, write_operation.dstBinding) != bindings_to_update.end())
 			{
 				size_t write_operation_hash = 0;
-				hash_param(write_operation_hash, write_operation);
+				hash_combine(write_operation_hash, write_operation);
 
 				auto update_pair_it = updated_bindings.find(write_operation.dstBinding);
 				if (update_pair_it == updated_bindings.end() || update_pair_it->second != write_operation_hash)
@@ -22,6 +22,7 @@
 #include "core/physical_device.h"
 #include "core/queue.h"
 #include "fence_pool.h"
+#include "staging_uploader.h"
 
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
@@ -207,6 +208,8 @@ Device::Device(PhysicalDevice &gpu, VkDevice &vulkan_device, VkSurfaceKHR surfac
 
 Device::~Device()
 {
+	staging_uploader.reset();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -484,6 +487,9 @@ void Device::flush_command_buffer(VkCommandBuffer command_buffer, VkQueue queue,
 
 	VK_CHECK(vkEndCommandBuffer(command_buffer));
 
+	// The command buffer may use resources written by the staging uploader
+	wait_for_staging_uploads();
+
 	VkSubmitInfo submit_info{};
 	submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	submit_info.commandBufferCount = 1;
@@ -559,4 +565,22 @@ ResourceCache &Device::get_resource_cache()
 {
 	return resource_cache;
 }
+
+StagingUploader &Device::get_staging_uploader()
+{
+	if (!staging_uploader)
+	{
+		staging_uploader = std::make_unique<StagingUploader>(*this);
+	}
+
+	return *staging_uploader;
+}
+
+void Device::wait_for_staging_uploads() const
+{
+	if (staging_uploader && staging_uploader->has_pending_uploads())
+	{
+		staging_uploader->wait_idle();
+	}
+}
 }        // namespace vkb
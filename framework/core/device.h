@@ -44,6 +44,13 @@
 
 namespace vkb
 {
+class StagingUploader;
+
+namespace core
+{
+class HPPDevice;
+}
+
 struct DriverVersion
 {
 	uint16_t major;
@@ -213,7 +220,20 @@ class Device : public vkb::core::VulkanResourceC<VkDevice>
 
 	ResourceCache &get_resource_cache();
 
+	/**
+	 * @brief Returns the service uploading data to device local memory, it is created on first use
+	 */
+	StagingUploader &get_staging_uploader();
+
+	/**
+	 * @brief Waits for the data recorded or submitted by the staging uploader to be uploaded, if there is any
+	 */
+	void wait_for_staging_uploads() const;
+
   private:
+	// HPPDevice mirrors the layout of this class, which it checks against these members
+	friend class vkb::core::HPPDevice;
+
 	const PhysicalDevice &gpu;
 
 	VkSurfaceKHR surface{VK_NULL_HANDLE};
@@ -231,5 +251,7 @@ class Device : public vkb::core::VulkanResourceC<VkDevice>
 	std::unique_ptr<FencePool> fence_pool;
 
 	ResourceCache resource_cache;
+
+	std::unique_ptr<StagingUploader> staging_uploader;
 };
 }        // namespace vkb
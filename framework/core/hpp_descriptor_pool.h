@@ -35,10 +35,21 @@ class HPPDescriptorPool : private vkb::DescriptorPool
 {
   public:
 	using vkb::DescriptorPool::reset;
+	using vkb::DescriptorPool::set_free_descriptor_sets;
 
 	HPPDescriptorPool(vkb::core::HPPDevice &device, const vkb::core::HPPDescriptorSetLayout &descriptor_set_layout, uint32_t pool_size = MAX_SETS_PER_POOL) :
 	    vkb::DescriptorPool(reinterpret_cast<vkb::Device &>(device), reinterpret_cast<vkb::DescriptorSetLayout const &>(descriptor_set_layout), pool_size)
 	{}
+
+	bool can_free(vk::DescriptorSet descriptor_set) const
+	{
+		return vkb::DescriptorPool::can_free(static_cast<VkDescriptorSet>(descriptor_set));
+	}
+
+	vk::Result free(vk::DescriptorSet descriptor_set)
+	{
+		return static_cast<vk::Result>(vkb::DescriptorPool::free(static_cast<VkDescriptorSet>(descriptor_set)));
+	}
 };
 }        // namespace core
 }        // namespace vkb
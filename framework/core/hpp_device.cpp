@@ -18,8 +18,10 @@
 #include "core/hpp_device.h"
 #include "core/buffer.h"
 #include "core/command_pool.h"
+#include "core/device.h"
 #include "core/hpp_physical_device.h"
 #include "core/hpp_queue.h"
+#include "staging_uploader.h"
 
 namespace vkb
 {
@@ -181,8 +183,22 @@ HPPDevice::HPPDevice(vkb::core::HPPPhysicalDevice               &gpu,
 	fence_pool = std::make_unique<vkb::HPPFencePool>(*this);
 }
 
+#if defined(__GNUC__)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
 HPPDevice::~HPPDevice()
 {
+	// HPPGLTFLoader loads scenes through the vkb::Device code, which must find every member at the same offset
+	static_assert(sizeof(HPPDevice) == sizeof(vkb::Device), "HPPDevice must mirror the layout of vkb::Device");
+	static_assert(offsetof(HPPDevice, surface) == offsetof(vkb::Device, surface));
+	static_assert(offsetof(HPPDevice, queues) == offsetof(vkb::Device, queues));
+	static_assert(offsetof(HPPDevice, command_pool) == offsetof(vkb::Device, command_pool));
+	static_assert(offsetof(HPPDevice, resource_cache) == offsetof(vkb::Device, resource_cache));
+	static_assert(offsetof(HPPDevice, staging_uploader) == offsetof(vkb::Device, staging_uploader));
+
+	staging_uploader.reset();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -195,6 +211,9 @@ HPPDevice::~HPPDevice()
 		get_handle().destroy();
 	}
 }
+#if defined(__GNUC__)
+#	pragma GCC diagnostic pop
+#endif
 
 bool HPPDevice::is_extension_supported(std::string const &requested_extension) const
 {
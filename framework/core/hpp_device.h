@@ -23,6 +23,8 @@
 
 namespace vkb
 {
+class StagingUploader;
+
 namespace core
 {
 template <vkb::BindingType bindingType>
@@ -147,6 +149,9 @@ class HPPDevice : public vkb::core::VulkanResourceCpp<vk::Device>
 	std::unique_ptr<vkb::HPPFencePool> fence_pool;
 
 	vkb::HPPResourceCache resource_cache;
+
+	/// Only created through the vkb::Device interface, as HPPGLTFLoader loads scenes through it
+	std::unique_ptr<vkb::StagingUploader> staging_uploader;
 };
 }        // namespace core
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2023, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -92,6 +92,7 @@ class HPPShaderModule : private vkb::ShaderModule
 {
   public:
 	using vkb::ShaderModule::get_id;
+	using vkb::ShaderModule::get_include_dependencies;
 
   public:
 	HPPShaderModule(vkb::core::HPPDevice              &device,
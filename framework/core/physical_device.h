@@ -144,6 +144,19 @@ class PhysicalDevice
 		return *static_cast<T *>(it->second.get());
 	}
 
+	/**
+	 * @brief Get an extension features struct of the structure chain used for device creation
+	 * @param type The VkStructureType for the extension
+	 * @returns The struct with the requested flags set, or nullptr if none of its features were requested
+	 */
+	template <typename T>
+	const T *get_requested_extension_features(VkStructureType type) const
+	{
+		auto it = extension_features.find(type);
+
+		return it != extension_features.end() ? static_cast<const T *>(it->second.get()) : nullptr;
+	}
+
 	/**
 	 * @brief Request an optional features flag
 	 *
@@ -21,62 +21,12 @@
 #include "device.h"
 #include "filesystem/legacy.h"
 #include "glsl_compiler.h"
+#include "shader_include_cache.h"
+#include "spirv_cache.h"
 #include "spirv_reflection.h"
 
 namespace vkb
 {
-/**
- * @brief Pre-compiles project shader files to include header code
- * @param source The shader file
- * @returns A byte array of the final shader
- */
-inline std::vector<std::string> precompile_shader(const std::string &source)
-{
-	std::vector<std::string> final_file;
-
-	auto lines = split(source, '\n');
-
-	for (auto &line : lines)
-	{
-		if (line.find("#include \"") == 0)
-		{
-			// Include paths are relative to the base shader directory
-			std::string include_path = line.substr(10);
-			size_t      last_quote   = include_path.find("\"");
-			if (!include_path.empty() && last_quote != std::string::npos)
-			{
-				include_path = include_path.substr(0, last_quote);
-			}
-
-			auto include_file = precompile_shader(fs::read_shader(include_path));
-			for (auto &include_file_line : include_file)
-			{
-				final_file.push_back(include_file_line);
-			}
-		}
-		else
-		{
-			final_file.push_back(line);
-		}
-	}
-
-	return final_file;
-}
-
-inline std::vector<uint8_t> convert_to_bytes(std::vector<std::string> &lines)
-{
-	std::vector<uint8_t> bytes;
-
-	for (auto &line : lines)
-	{
-		line += "\n";
-		std::vector<uint8_t> line_bytes(line.begin(), line.end());
-		bytes.insert(bytes.end(), line_bytes.begin(), line_bytes.end());
-	}
-
-	return bytes;
-}
-
 ShaderModule::ShaderModule(Device &device, VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant) :
     device{device},
     stage{stage},
@@ -99,25 +49,43 @@ ShaderModule::ShaderModule(Device &device, VkShaderStageFlagBits stage, const Sh
 		throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
 	}
 
-	// Precompile source into the final spirv bytecode
-	auto glsl_final_source = precompile_shader(source);
+	// Expand the included files into the final source
+	auto glsl_bytes = ShaderIncludeCache::expand(source, include_dependencies);
 
-	// Compile the GLSL source
-	GLSLCompiler glsl_compiler;
+	// Skip compilation and reflection entirely if a previous run already produced them
+	SPIRVCache::Key cache_key{};
+	bool            cached = false;
 
-	if (!glsl_compiler.compile_to_spirv(stage, convert_to_bytes(glsl_final_source), entry_point, shader_variant, spirv, info_log))
+	if (SPIRVCache::is_enabled())
 	{
-		LOGE("Shader compilation failed for shader \"{}\"", glsl_source.get_filename());
-		LOGE("{}", info_log);
-		throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
+		cache_key = SPIRVCache::compute_key(stage, glsl_bytes, entry_point, shader_variant);
+		cached    = SPIRVCache::load(cache_key, spirv, resources);
 	}
 
-	SPIRVReflection spirv_reflection;
-
-	// Reflect all shader resources
-	if (!spirv_reflection.reflect_shader_resources(stage, spirv, resources, shader_variant))
+	if (!cached)
 	{
-		throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
+		// Compile the GLSL source
+		GLSLCompiler glsl_compiler;
+
+		if (!glsl_compiler.compile_to_spirv(stage, glsl_bytes, entry_point, shader_variant, spirv, info_log))
+		{
+			LOGE("Shader compilation failed for shader \"{}\"", glsl_source.get_filename());
+			LOGE("{}", info_log);
+			throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
+		}
+
+		SPIRVReflection spirv_reflection;
+
+		// Reflect all shader resources
+		if (!spirv_reflection.reflect_shader_resources(stage, spirv, resources, shader_variant))
+		{
+			throw VulkanException{VK_ERROR_INITIALIZATION_FAILED};
+		}
+
+		if (SPIRVCache::is_enabled())
+		{
+			SPIRVCache::store(cache_key, spirv, resources);
+		}
 	}
 
 	// Generate a unique id, determined by source and variant
@@ -134,7 +102,8 @@ ShaderModule::ShaderModule(ShaderModule &&other) :
     debug_name{other.debug_name},
     spirv{other.spirv},
     resources{other.resources},
-    info_log{other.info_log}
+    info_log{other.info_log},
+    include_dependencies{other.include_dependencies}
 {
 	other.stage = {};
 }
@@ -169,6 +138,11 @@ const std::vector<uint32_t> &ShaderModule::get_binary() const
 	return spirv;
 }
 
+const std::vector<ShaderInclude> &ShaderModule::get_include_dependencies() const
+{
+	return include_dependencies;
+}
+
 void ShaderModule::set_resource_mode(const std::string &resource_name, const ShaderResourceMode &resource_mode)
 {
 	auto it = std::ranges::find_if(resources, [&resource_name](const ShaderResource &resource) { return resource.name == resource_name; });
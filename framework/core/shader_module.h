@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2021, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,6 +19,7 @@
 
 #include "common/helpers.h"
 #include "common/vk_common.h"
+#include "shader_include_cache.h"
 
 #if defined(VK_USE_PLATFORM_XLIB_KHR)
 #	undef None
@@ -221,6 +222,11 @@ class ShaderModule
 
 	const std::vector<uint32_t> &get_binary() const;
 
+	/**
+	 * @brief Files included by the source, they can be checked with ShaderIncludeCache::is_modified
+	 */
+	const std::vector<ShaderInclude> &get_include_dependencies() const;
+
 	inline const std::string &get_debug_name() const
 	{
 		return debug_name;
@@ -259,5 +265,7 @@ class ShaderModule
 	std::vector<ShaderResource> resources;
 
 	std::string info_log;
+
+	std::vector<ShaderInclude> include_dependencies;
 };
 }        // namespace vkb
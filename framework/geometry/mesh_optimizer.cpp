@@ -0,0 +1,531 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mesh_optimizer.h"
+
+#include <cmath>
+#include <limits>
+
+#include "common/helpers.h"
+#include "core/util/hash.hpp"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t MESH_CACHE_MAGIC   = 0x54504f4d;        // "MOPT"
+constexpr uint32_t MESH_CACHE_VERSION = 1;
+
+// Scoring parameters of Tom Forsyth's algorithm
+constexpr uint32_t SCORING_CACHE_SIZE  = 32;
+constexpr float    CACHE_DECAY_POWER   = 1.5f;
+constexpr float    LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float    VALENCE_BOOST_SCALE = 2.0f;
+constexpr float    VALENCE_BOOST_POWER = 0.5f;
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+float get_vertex_score(int32_t cache_position, uint32_t live_triangle_count)
+{
+	if (live_triangle_count == 0)
+	{
+		// No triangle left to emit with this vertex
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+
+	if (cache_position >= 0)
+	{
+		if (cache_position < 3)
+		{
+			// The vertices of the last triangle are scored alike, whatever their order
+			score = LAST_TRIANGLE_SCORE;
+		}
+		else
+		{
+			score = std::pow(1.0f - static_cast<float>(cache_position - 3) / (SCORING_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+		}
+	}
+
+	// Favor the vertices with few triangles left, to avoid leaving isolated triangles behind
+	score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(live_triangle_count), -VALENCE_BOOST_POWER);
+
+	return score;
+}
+
+std::string get_cache_path(const Hash128 &key)
+{
+	auto path = vkb::filesystem::get()->temp_directory() / "mesh_cache" / fmt::format("{:016x}{:016x}{:016x}.meshopt", key.high, key.low, key.check);
+	return path.string();
+}
+
+Hash128 get_checksum(const uint8_t *data, size_t size)
+{
+	Hasher hasher;
+	hasher.update(data, size);
+	return hasher.get_hash();
+}
+
+bool load_cached(const Hash128 &key, size_t vertex_count, std::vector<uint32_t> &indices, std::vector<uint32_t> &remap)
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_cache_path(key);
+
+	if (!fs->is_file(path))
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+
+	try
+	{
+		data = fs->read_file_binary(path);
+	}
+	catch (const std::exception &e)
+	{
+		LOGW("Failed to read mesh cache entry {}: {}", path, e.what());
+		return false;
+	}
+
+	size_t header_size  = 2 * sizeof(uint32_t) + 2 * sizeof(Hash128);
+	size_t payload_size = 2 * sizeof(size_t) + (indices.size() + vertex_count) * sizeof(uint32_t);
+
+	if (data.size() != header_size + payload_size)
+	{
+		LOGW("Discarding invalid mesh cache entry {}", path);
+		return false;
+	}
+
+	std::istringstream is{std::string{data.begin(), data.end()}};
+
+	uint32_t magic{};
+	uint32_t version{};
+	Hash128  stored_key{};
+	Hash128  checksum{};
+	read(is, magic, version, stored_key, checksum);
+
+	if (magic != MESH_CACHE_MAGIC || version != MESH_CACHE_VERSION || stored_key != key ||
+	    checksum != get_checksum(data.data() + header_size, payload_size))
+	{
+		LOGW("Discarding invalid mesh cache entry {}", path);
+		return false;
+	}
+
+	std::vector<uint32_t> cached_indices;
+	std::vector<uint32_t> cached_remap;
+	read(is, cached_indices, cached_remap);
+
+	if (cached_indices.size() != indices.size() || cached_remap.size() != vertex_count ||
+	    std::ranges::any_of(cached_indices, [vertex_count](uint32_t index) { return index >= vertex_count; }) ||
+	    std::ranges::any_of(cached_remap, [vertex_count](uint32_t index) { return index >= vertex_count; }))
+	{
+		LOGW("Discarding invalid mesh cache entry {}", path);
+		return false;
+	}
+
+	indices = std::move(cached_indices);
+	remap   = std::move(cached_remap);
+
+	return true;
+}
+
+void store_cached(const Hash128 &key, const std::vector<uint32_t> &indices, const std::vector<uint32_t> &remap)
+{
+	std::ostringstream payload;
+	write(payload, indices, remap);
+
+	std::string payload_data = payload.str();
+
+	std::ostringstream entry;
+	write(entry,
+	      MESH_CACHE_MAGIC,
+	      MESH_CACHE_VERSION,
+	      key,
+	      get_checksum(reinterpret_cast<const uint8_t *>(payload_data.data()), payload_data.size()));
+	entry.write(payload_data.data(), payload_data.size());
+
+	std::string entry_data = entry.str();
+
+	auto path = get_cache_path(key);
+
+	try
+	{
+		vkb::filesystem::get()->write_file_atomic(path, std::vector<uint8_t>{entry_data.begin(), entry_data.end()});
+	}
+	catch (const std::exception &e)
+	{
+		LOGW("Failed to write mesh cache entry {}: {}", path, e.what());
+	}
+}
+}        // namespace
+
+float VertexCacheStats::get_acmr() const
+{
+	return triangle_count > 0 ? static_cast<float>(transformed_vertex_count) / triangle_count : 0.0f;
+}
+
+float VertexCacheStats::get_atvr() const
+{
+	return referenced_vertex_count > 0 ? static_cast<float>(transformed_vertex_count) / referenced_vertex_count : 0.0f;
+}
+
+VertexCacheStats &VertexCacheStats::operator+=(const VertexCacheStats &other)
+{
+	triangle_count += other.triangle_count;
+	transformed_vertex_count += other.transformed_vertex_count;
+	referenced_vertex_count += other.referenced_vertex_count;
+
+	return *this;
+}
+
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t> &indices, size_t vertex_count, uint32_t cache_size)
+{
+	VertexCacheStats stats;
+	stats.triangle_count = indices.size() / 3;
+
+	// A vertex is in the FIFO cache while fewer than cache_size vertices were inserted after it
+	std::vector<size_t> insertion_times(vertex_count, 0);
+	std::vector<bool>   referenced(vertex_count, false);
+	size_t              time = cache_size + 1;
+
+	for (auto index : indices)
+	{
+		if (!referenced[index])
+		{
+			referenced[index] = true;
+			stats.referenced_vertex_count++;
+		}
+
+		if (time - insertion_times[index] > cache_size)
+		{
+			insertion_times[index] = time++;
+			stats.transformed_vertex_count++;
+		}
+	}
+
+	return stats;
+}
+
+void optimize_vertex_cache(std::vector<uint32_t> &indices, size_t vertex_count)
+{
+	size_t triangle_count = indices.size() / 3;
+
+	if (triangle_count == 0)
+	{
+		return;
+	}
+
+	// Triangles using each vertex, the first live_triangle_counts[vertex] ones are not emitted yet
+	std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+	for (auto index : indices)
+	{
+		adjacency_offsets[index + 1]++;
+	}
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		adjacency_offsets[vertex + 1] += adjacency_offsets[vertex];
+	}
+
+	std::vector<uint32_t> adjacency(triangle_count * 3);
+	std::vector<uint32_t> live_triangle_counts(vertex_count, 0);
+
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t vertex = indices[triangle * 3 + corner];
+			adjacency[adjacency_offsets[vertex] + live_triangle_counts[vertex]++] = to_u32(triangle);
+		}
+	}
+
+	std::vector<int32_t> cache_positions(vertex_count, -1);
+	std::vector<float>   vertex_scores(vertex_count);
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		vertex_scores[vertex] = get_vertex_score(-1, live_triangle_counts[vertex]);
+	}
+
+	std::vector<bool>     emitted(triangle_count, false);
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> new_cache;
+
+	std::vector<uint32_t> result;
+	result.reserve(triangle_count * 3);
+
+	size_t   next_input_triangle = 0;
+	uint32_t best_triangle       = INVALID_INDEX;
+
+	while (result.size() < triangle_count * 3)
+	{
+		if (best_triangle == INVALID_INDEX)
+		{
+			// No triangle left around the cached vertices, continue with the next one in input order
+			while (emitted[next_input_triangle])
+			{
+				next_input_triangle++;
+			}
+			best_triangle = to_u32(next_input_triangle);
+		}
+
+		emitted[best_triangle] = true;
+		new_cache.clear();
+
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t vertex = indices[best_triangle * 3 + corner];
+			result.push_back(vertex);
+
+			// Remove the triangle from the live triangles of the vertex
+			auto begin = adjacency.begin() + adjacency_offsets[vertex];
+			auto end   = begin + live_triangle_counts[vertex];
+			std::iter_swap(std::find(begin, end, best_triangle), end - 1);
+			live_triangle_counts[vertex]--;
+
+			if (std::ranges::find(new_cache, vertex) == new_cache.end())
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		// The emitted vertices move to the front of the cache, pushing the others back
+		auto emitted_end = new_cache.size();
+
+		for (auto vertex : cache)
+		{
+			if (std::find(new_cache.begin(), new_cache.begin() + emitted_end, vertex) == new_cache.begin() + emitted_end)
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		for (size_t i = SCORING_CACHE_SIZE; i < new_cache.size(); ++i)
+		{
+			cache_positions[new_cache[i]] = -1;
+			vertex_scores[new_cache[i]]   = get_vertex_score(-1, live_triangle_counts[new_cache[i]]);
+		}
+
+		new_cache.resize(std::min<size_t>(new_cache.size(), SCORING_CACHE_SIZE));
+		std::swap(cache, new_cache);
+
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			cache_positions[cache[i]] = static_cast<int32_t>(i);
+			vertex_scores[cache[i]]   = get_vertex_score(static_cast<int32_t>(i), live_triangle_counts[cache[i]]);
+		}
+
+		// Only the triangles around the cached vertices had their score changed
+		best_triangle    = INVALID_INDEX;
+		float best_score = -1.0f;
+
+		for (auto vertex : cache)
+		{
+			for (uint32_t i = 0; i < live_triangle_counts[vertex]; ++i)
+			{
+				uint32_t triangle = adjacency[adjacency_offsets[vertex] + i];
+
+				float score = vertex_scores[indices[triangle * 3]] + vertex_scores[indices[triangle * 3 + 1]] + vertex_scores[indices[triangle * 3 + 2]];
+
+				if (score > best_score)
+				{
+					best_score    = score;
+					best_triangle = triangle;
+				}
+			}
+		}
+	}
+
+	indices = std::move(result);
+}
+
+void optimize_overdraw(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, uint32_t cache_size)
+{
+	size_t triangle_count = indices.size() / 3;
+
+	if (triangle_count == 0)
+	{
+		return;
+	}
+
+	struct Cluster
+	{
+		size_t first_triangle{0};
+
+		size_t end_triangle{0};
+
+		glm::vec3 centroid{0.0f};
+
+		glm::vec3 normal{0.0f};
+
+		float sort_key{0.0f};
+	};
+
+	// Start a cluster wherever the simulated cache misses every vertex of a triangle
+	std::vector<Cluster> clusters;
+	std::vector<size_t>  insertion_times(positions.size(), 0);
+	size_t               time = cache_size + 1;
+
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		uint32_t misses = 0;
+
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t vertex = indices[triangle * 3 + corner];
+
+			if (time - insertion_times[vertex] > cache_size)
+			{
+				insertion_times[vertex] = time++;
+				misses++;
+			}
+		}
+
+		if (misses == 3 || clusters.empty())
+		{
+			if (!clusters.empty())
+			{
+				clusters.back().end_triangle = triangle;
+			}
+
+			clusters.push_back({triangle});
+		}
+	}
+
+	clusters.back().end_triangle = triangle_count;
+
+	// Area weighted centroid and normal of each cluster, and of the whole mesh
+	glm::vec3 mesh_centroid{0.0f};
+	float     mesh_area = 0.0f;
+
+	for (auto &cluster : clusters)
+	{
+		float cluster_area = 0.0f;
+
+		for (size_t triangle = cluster.first_triangle; triangle < cluster.end_triangle; ++triangle)
+		{
+			const glm::vec3 &p0 = positions[indices[triangle * 3]];
+			const glm::vec3 &p1 = positions[indices[triangle * 3 + 1]];
+			const glm::vec3 &p2 = positions[indices[triangle * 3 + 2]];
+
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float     area   = glm::length(normal);
+
+			cluster.centroid += (p0 + p1 + p2) * (area / 3.0f);
+			cluster.normal += normal;
+			cluster_area += area;
+		}
+
+		mesh_centroid += cluster.centroid;
+		mesh_area += cluster_area;
+
+		cluster.centroid = cluster_area > 0.0f ? cluster.centroid / cluster_area : positions[indices[cluster.first_triangle * 3]];
+	}
+
+	mesh_centroid = mesh_area > 0.0f ? mesh_centroid / mesh_area : glm::vec3{0.0f};
+
+	for (auto &cluster : clusters)
+	{
+		float normal_length = glm::length(cluster.normal);
+
+		cluster.sort_key = normal_length > 0.0f ? glm::dot(cluster.centroid - mesh_centroid, cluster.normal / normal_length) : 0.0f;
+	}
+
+	// Clusters facing outwards are drawn first, as they tend to occlude the ones facing inwards
+	std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &a, const Cluster &b) { return a.sort_key > b.sort_key; });
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	for (auto &cluster : clusters)
+	{
+		result.insert(result.end(), indices.begin() + cluster.first_triangle * 3, indices.begin() + cluster.end_triangle * 3);
+	}
+
+	indices = std::move(result);
+}
+
+std::vector<uint32_t> optimize_vertex_fetch(std::vector<uint32_t> &indices, size_t vertex_count)
+{
+	std::vector<uint32_t> remap(vertex_count, INVALID_INDEX);
+	uint32_t              next_vertex = 0;
+
+	for (auto &index : indices)
+	{
+		if (remap[index] == INVALID_INDEX)
+		{
+			remap[index] = next_vertex++;
+		}
+
+		index = remap[index];
+	}
+
+	for (auto &new_index : remap)
+	{
+		if (new_index == INVALID_INDEX)
+		{
+			new_index = next_vertex++;
+		}
+	}
+
+	return remap;
+}
+
+std::vector<uint8_t> remap_vertex_data(const std::vector<uint8_t> &data, size_t stride, const std::vector<uint32_t> &remap)
+{
+	std::vector<uint8_t> result(data.size());
+
+	for (size_t vertex = 0; vertex < remap.size() && (vertex + 1) * stride <= data.size(); ++vertex)
+	{
+		std::copy_n(data.begin() + vertex * stride, stride, result.begin() + remap[vertex] * stride);
+	}
+
+	return result;
+}
+
+bool optimize_mesh(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, std::vector<uint32_t> &remap)
+{
+	size_t vertex_count = positions.size();
+
+	if (indices.size() % 3 != 0 || std::ranges::any_of(indices, [vertex_count](uint32_t index) { return index >= vertex_count; }))
+	{
+		return false;
+	}
+
+	Hasher hasher;
+	hasher.update(MESH_CACHE_VERSION);
+	hasher.update(indices.data(), indices.size() * sizeof(uint32_t));
+	hasher.update(positions.data(), positions.size() * sizeof(glm::vec3));
+
+	Hash128 key = hasher.get_hash();
+
+	if (load_cached(key, vertex_count, indices, remap))
+	{
+		return true;
+	}
+
+	optimize_vertex_cache(indices, vertex_count);
+	optimize_overdraw(indices, positions);
+	remap = optimize_vertex_fetch(indices, vertex_count);
+
+	store_cached(key, indices, remap);
+
+	return true;
+}
+}        // namespace vkb
@@ -0,0 +1,107 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Post-transform vertex cache efficiency of a triangle list, simulated with a FIFO cache
+ */
+struct VertexCacheStats
+{
+	size_t triangle_count{0};
+
+	size_t transformed_vertex_count{0};
+
+	size_t referenced_vertex_count{0};
+
+	/**
+	 * @return The average cache miss ratio, the number of vertices transformed per triangle, between 0.5 and 3
+	 */
+	float get_acmr() const;
+
+	/**
+	 * @return The average transform to vertex ratio, 1 when every vertex is transformed once
+	 */
+	float get_atvr() const;
+
+	VertexCacheStats &operator+=(const VertexCacheStats &other);
+};
+
+/**
+ * @brief Simulates the post-transform vertex cache on a triangle list
+ * @param indices The triangle list
+ * @param vertex_count The number of vertices referenced by the indices
+ * @param cache_size The number of entries of the simulated FIFO cache
+ */
+VertexCacheStats analyze_vertex_cache(const std::vector<uint32_t> &indices, size_t vertex_count, uint32_t cache_size = 16);
+
+/**
+ * @brief Reorders the triangles to reuse the post-transform vertex cache, using Tom Forsyth's linear-speed algorithm
+ * @param[in,out] indices The triangle list
+ * @param vertex_count The number of vertices referenced by the indices
+ */
+void optimize_vertex_cache(std::vector<uint32_t> &indices, size_t vertex_count);
+
+/**
+ * @brief Reorders clusters of triangles so that those facing away from the mesh center are drawn first
+ *
+ * Clusters are split where the simulated vertex cache misses all vertices of a triangle, so the
+ * reordering preserves most of the efficiency of a triangle list optimized with optimize_vertex_cache.
+ *
+ * @param[in,out] indices The triangle list
+ * @param positions The position of each vertex
+ * @param cache_size The number of entries of the simulated FIFO cache
+ */
+void optimize_overdraw(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, uint32_t cache_size = 16);
+
+/**
+ * @brief Renumbers the vertices in the order they are first referenced, so that vertex fetch reads memory linearly
+ * @param[in,out] indices The triangle list, rewritten with the new vertex indices
+ * @param vertex_count The number of vertices, unreferenced vertices are moved after the referenced ones
+ * @return The new index of each vertex
+ */
+std::vector<uint32_t> optimize_vertex_fetch(std::vector<uint32_t> &indices, size_t vertex_count);
+
+/**
+ * @brief Reorders vertex data following a remap table returned by optimize_vertex_fetch
+ * @param data The vertex data
+ * @param stride The distance between two vertices in the data
+ * @param remap The new index of each vertex
+ * @return The reordered vertex data
+ */
+std::vector<uint8_t> remap_vertex_data(const std::vector<uint8_t> &data, size_t stride, const std::vector<uint32_t> &remap);
+
+/**
+ * @brief Runs the vertex cache, overdraw and vertex fetch optimizations on a triangle list
+ *
+ * The result is persisted in the temporary directory, keyed on the indices and positions,
+ * so that loading the same mesh again only reads it back.
+ *
+ * @param[in,out] indices The triangle list
+ * @param positions The position of each vertex
+ * @param[out] remap The new index of each vertex, to be applied to every vertex attribute with remap_vertex_data
+ * @return False if the triangle list references vertices out of range, in which case it is left untouched
+ */
+bool optimize_mesh(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, std::vector<uint32_t> &remap);
+}        // namespace vkb
@@ -0,0 +1,212 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "meshlet_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "common/helpers.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t MAX_MESHLET_VERTICES = 256;
+
+constexpr uint16_t INVALID_LOCAL_INDEX = std::numeric_limits<uint16_t>::max();
+
+MeshletBounds compute_bounds(const MeshletData &data, const MeshletDescription &meshlet, const std::vector<glm::vec3> &positions)
+{
+	MeshletBounds bounds{};
+
+	// Sphere around the center of the bounding box
+	glm::vec3 min_position{std::numeric_limits<float>::max()};
+	glm::vec3 max_position{std::numeric_limits<float>::lowest()};
+
+	for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+	{
+		const auto &position = positions[data.vertices[meshlet.vertex_offset + i]];
+
+		min_position = glm::min(min_position, position);
+		max_position = glm::max(max_position, position);
+	}
+
+	bounds.center = (min_position + max_position) * 0.5f;
+
+	for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+	{
+		bounds.radius = std::max(bounds.radius, glm::distance(bounds.center, positions[data.vertices[meshlet.vertex_offset + i]]));
+	}
+
+	// Cone around the triangle normals
+	std::vector<glm::vec3> normals;
+	normals.reserve(meshlet.triangle_count);
+
+	glm::vec3 normal_sum{0.0f};
+
+	for (uint32_t i = 0; i < meshlet.triangle_count; ++i)
+	{
+		const uint8_t *triangle = data.triangles.data() + meshlet.triangle_offset + i * 3;
+
+		const auto &p0 = positions[data.vertices[meshlet.vertex_offset + triangle[0]]];
+		const auto &p1 = positions[data.vertices[meshlet.vertex_offset + triangle[1]]];
+		const auto &p2 = positions[data.vertices[meshlet.vertex_offset + triangle[2]]];
+
+		glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+		float     length = glm::length(normal);
+
+		// Degenerate triangles are never rasterized
+		if (length > 0.0f)
+		{
+			normals.push_back(normal / length);
+			normal_sum += normals.back();
+		}
+	}
+
+	float axis_length = glm::length(normal_sum);
+
+	if (normals.empty() || axis_length == 0.0f)
+	{
+		bounds.cone_axis   = glm::vec3{0.0f, 0.0f, 1.0f};
+		bounds.cone_cutoff = 1.0f;
+		return bounds;
+	}
+
+	bounds.cone_axis = normal_sum / axis_length;
+
+	float min_dot = 1.0f;
+	for (auto &normal : normals)
+	{
+		min_dot = std::min(min_dot, glm::dot(bounds.cone_axis, normal));
+	}
+
+	// Past a hemisphere, some triangles face the camera from every direction
+	bounds.cone_cutoff = min_dot <= 0.0f ? 1.0f : std::sqrt(1.0f - min_dot * min_dot);
+
+	return bounds;
+}
+}        // namespace
+
+MeshletLimits MeshletLimits::from_device(const VkPhysicalDeviceMeshShaderPropertiesEXT &properties, uint32_t max_vertices, uint32_t max_triangles)
+{
+	MeshletLimits limits;
+	limits.max_vertices  = std::min({max_vertices, properties.maxMeshOutputVertices, MAX_MESHLET_VERTICES});
+	limits.max_triangles = std::min(max_triangles, properties.maxMeshOutputPrimitives);
+
+	return limits;
+}
+
+glm::vec2 MeshletData::get_fill_rate(const MeshletLimits &limits) const
+{
+	if (meshlets.empty())
+	{
+		return glm::vec2{0.0f};
+	}
+
+	size_t vertex_count   = 0;
+	size_t triangle_count = 0;
+
+	for (auto &meshlet : meshlets)
+	{
+		vertex_count += meshlet.vertex_count;
+		triangle_count += meshlet.triangle_count;
+	}
+
+	return glm::vec2{static_cast<float>(vertex_count) / (meshlets.size() * limits.max_vertices),
+	                 static_cast<float>(triangle_count) / (meshlets.size() * limits.max_triangles)};
+}
+
+MeshletData build_meshlets(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, const MeshletLimits &limits)
+{
+	assert(limits.max_vertices >= 3 && limits.max_vertices <= MAX_MESHLET_VERTICES && limits.max_triangles >= 1);
+
+	MeshletData data;
+
+	size_t triangle_count = indices.size() / 3;
+
+	data.vertices.reserve(indices.size());
+	data.triangles.reserve(indices.size() + triangle_count / limits.max_triangles * 4);
+
+	// Index of each vertex in the current meshlet, only the entries of the meshlet vertices are reset between meshlets
+	std::vector<uint16_t> local_indices(positions.size(), INVALID_LOCAL_INDEX);
+
+	MeshletDescription meshlet{};
+
+	auto finish_meshlet = [&]() {
+		for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+		{
+			local_indices[data.vertices[meshlet.vertex_offset + i]] = INVALID_LOCAL_INDEX;
+		}
+
+		data.meshlets.push_back(meshlet);
+		data.bounds.push_back(compute_bounds(data, meshlet, positions));
+
+		// Keep the triangles of every meshlet 4-byte aligned, so that shaders can read them as words
+		data.triangles.resize((data.triangles.size() + 3) & ~size_t(3));
+
+		meshlet                 = {};
+		meshlet.vertex_offset   = to_u32(data.vertices.size());
+		meshlet.triangle_offset = to_u32(data.triangles.size());
+	};
+
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		const uint32_t *corners = indices.data() + triangle * 3;
+
+		uint32_t new_vertex_count = 0;
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			// Corners of degenerate triangles can share a vertex
+			bool repeated = (corner > 0 && corners[corner] == corners[0]) || (corner > 1 && corners[corner] == corners[1]);
+
+			if (local_indices[corners[corner]] == INVALID_LOCAL_INDEX && !repeated)
+			{
+				new_vertex_count++;
+			}
+		}
+
+		if (meshlet.vertex_count + new_vertex_count > limits.max_vertices || meshlet.triangle_count == limits.max_triangles)
+		{
+			finish_meshlet();
+		}
+
+		for (size_t corner = 0; corner < 3; ++corner)
+		{
+			uint32_t vertex = corners[corner];
+
+			if (local_indices[vertex] == INVALID_LOCAL_INDEX)
+			{
+				local_indices[vertex] = static_cast<uint16_t>(meshlet.vertex_count++);
+				data.vertices.push_back(vertex);
+			}
+
+			data.triangles.push_back(static_cast<uint8_t>(local_indices[vertex]));
+		}
+
+		meshlet.triangle_count++;
+	}
+
+	if (meshlet.triangle_count > 0)
+	{
+		finish_meshlet();
+	}
+
+	return data;
+}
+}        // namespace vkb
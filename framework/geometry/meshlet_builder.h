@@ -0,0 +1,110 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Maximum size of a meshlet, matching the outputs of a mesh shader workgroup
+ */
+struct MeshletLimits
+{
+	/// At most 256, as meshlet triangles index the meshlet vertices with 8 bits
+	uint32_t max_vertices{64};
+
+	uint32_t max_triangles{124};
+
+	/**
+	 * @brief Gets the limits for the mesh shader outputs of a device
+	 * @param properties The mesh shader properties of the device
+	 * @param max_vertices The preferred maximum number of vertices, lowered to the device limit
+	 * @param max_triangles The preferred maximum number of triangles, lowered to the device limit
+	 */
+	static MeshletLimits from_device(const VkPhysicalDeviceMeshShaderPropertiesEXT &properties, uint32_t max_vertices = 64, uint32_t max_triangles = 124);
+};
+
+/**
+ * @brief A meshlet, as stored in the meshlet storage buffer
+ */
+struct MeshletDescription
+{
+	/// Offset of the first vertex index of the meshlet in MeshletData::vertices
+	uint32_t vertex_offset;
+
+	/// Offset of the first triangle of the meshlet in MeshletData::triangles, in bytes and 4-byte aligned
+	uint32_t triangle_offset;
+
+	uint32_t vertex_count;
+
+	uint32_t triangle_count;
+};
+
+/**
+ * @brief Culling bounds of a meshlet, in the space of the vertex positions
+ *
+ * The meshlet can be culled when it is outside of the view frustum, or when all of its triangles face away
+ * from the camera, which is the case if: dot(center - camera, cone_axis) >= cone_cutoff * length(center - camera) + radius
+ */
+struct MeshletBounds
+{
+	glm::vec3 center;
+
+	float radius;
+
+	/// Average normal of the meshlet triangles
+	glm::vec3 cone_axis;
+
+	/// Sine of the cone half angle, 1 if the triangle normals span more than a hemisphere and the meshlet can't be back-face culled
+	float cone_cutoff;
+};
+
+/**
+ * @brief The meshlets of a triangle list
+ */
+struct MeshletData
+{
+	std::vector<MeshletDescription> meshlets;
+
+	std::vector<MeshletBounds> bounds;
+
+	/// Indices of the vertices of each meshlet in the vertex buffers of the mesh
+	std::vector<uint32_t> vertices;
+
+	/// Indices of the triangle corners of each meshlet in its vertices
+	std::vector<uint8_t> triangles;
+
+	/**
+	 * @return The average number of vertices and triangles of the meshlets, relative to the limits they were built with
+	 */
+	glm::vec2 get_fill_rate(const MeshletLimits &limits) const;
+};
+
+/**
+ * @brief Splits a triangle list into meshlets, keeping the triangle order
+ * @param indices The triangle list, best optimized for the vertex cache first so that meshlets share few vertices
+ * @param positions The position of each vertex
+ * @param limits The maximum size of a meshlet
+ */
+MeshletData build_meshlets(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, const MeshletLimits &limits);
+}        // namespace vkb
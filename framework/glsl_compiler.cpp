@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,6 +24,8 @@
 #include <glslang/OSDependent/osinclude.h>
 #include <glslang/Public/ResourceLimits.h>
 
+#include <ctpl_stl.h>
+
 namespace vkb
 {
 namespace
@@ -78,33 +80,35 @@ inline EShLanguage FindShaderLanguage(VkShaderStageFlagBits stage)
 			return EShLangVertex;
 	}
 }
-}        // namespace
-
-glslang::EShTargetLanguage        GLSLCompiler::env_target_language         = glslang::EShTargetLanguage::EShTargetNone;
-glslang::EShTargetLanguageVersion GLSLCompiler::env_target_language_version = static_cast<glslang::EShTargetLanguageVersion>(0);
-
-void GLSLCompiler::set_target_environment(glslang::EShTargetLanguage target_language, glslang::EShTargetLanguageVersion target_language_version)
-{
-	GLSLCompiler::env_target_language         = target_language;
-	GLSLCompiler::env_target_language_version = target_language_version;
-}
 
-void GLSLCompiler::reset_target_environment()
+/**
+ * @brief Initializes glslang once per process, it is finalized at exit
+ */
+void initialize_glslang()
 {
-	GLSLCompiler::env_target_language         = glslang::EShTargetLanguage::EShTargetNone;
-	GLSLCompiler::env_target_language_version = static_cast<glslang::EShTargetLanguageVersion>(0);
+	static struct GlslangProcess
+	{
+		GlslangProcess()
+		{
+			glslang::InitializeProcess();
+		}
+
+		~GlslangProcess()
+		{
+			glslang::FinalizeProcess();
+		}
+	} glslang_process;
 }
 
-bool GLSLCompiler::compile_to_spirv(VkShaderStageFlagBits       stage,
-                                    const std::vector<uint8_t> &glsl_source,
-                                    const std::string          &entry_point,
-                                    const ShaderVariant        &shader_variant,
-                                    std::vector<std::uint32_t> &spirv,
-                                    std::string                &info_log)
+bool compile(VkShaderStageFlagBits             stage,
+             const std::vector<uint8_t>       &glsl_source,
+             const std::string                &entry_point,
+             const ShaderVariant              &shader_variant,
+             glslang::EShTargetLanguage        target_language,
+             glslang::EShTargetLanguageVersion target_language_version,
+             std::vector<std::uint32_t>       &spirv,
+             std::string                      &info_log)
 {
-	// Initialize glslang library.
-	glslang::InitializeProcess();
-
 	EShMessages messages = static_cast<EShMessages>(EShMsgDefault | EShMsgVulkanRules | EShMsgSpvRules);
 
 	EShLanguage language = FindShaderLanguage(stage);
@@ -119,9 +123,9 @@ bool GLSLCompiler::compile_to_spirv(VkShaderStageFlagBits       stage,
 	shader.setSourceEntryPoint(entry_point.c_str());
 	shader.setPreamble(shader_variant.get_preamble().c_str());
 	shader.addProcesses(shader_variant.get_processes());
-	if (GLSLCompiler::env_target_language != glslang::EShTargetLanguage::EShTargetNone)
+	if (target_language != glslang::EShTargetLanguage::EShTargetNone)
 	{
-		shader.setEnvTarget(GLSLCompiler::env_target_language, GLSLCompiler::env_target_language_version);
+		shader.setEnvTarget(target_language, target_language_version);
 	}
 
 	DirStackFileIncluder includeDir;
@@ -170,9 +174,90 @@ bool GLSLCompiler::compile_to_spirv(VkShaderStageFlagBits       stage,
 
 	info_log += logger.getAllMessages() + "\n";
 
-	// Shutdown glslang library.
-	glslang::FinalizeProcess();
-
 	return true;
 }
+}        // namespace
+
+glslang::EShTargetLanguage        GLSLCompiler::env_target_language         = glslang::EShTargetLanguage::EShTargetNone;
+glslang::EShTargetLanguageVersion GLSLCompiler::env_target_language_version = static_cast<glslang::EShTargetLanguageVersion>(0);
+
+void GLSLCompiler::set_target_environment(glslang::EShTargetLanguage target_language, glslang::EShTargetLanguageVersion target_language_version)
+{
+	GLSLCompiler::env_target_language         = target_language;
+	GLSLCompiler::env_target_language_version = target_language_version;
+}
+
+void GLSLCompiler::reset_target_environment()
+{
+	GLSLCompiler::env_target_language         = glslang::EShTargetLanguage::EShTargetNone;
+	GLSLCompiler::env_target_language_version = static_cast<glslang::EShTargetLanguageVersion>(0);
+}
+
+void GLSLCompiler::get_target_environment(glslang::EShTargetLanguage &target_language, glslang::EShTargetLanguageVersion &target_language_version)
+{
+	target_language         = GLSLCompiler::env_target_language;
+	target_language_version = GLSLCompiler::env_target_language_version;
+}
+
+bool GLSLCompiler::compile_to_spirv(VkShaderStageFlagBits       stage,
+                                    const std::vector<uint8_t> &glsl_source,
+                                    const std::string          &entry_point,
+                                    const ShaderVariant        &shader_variant,
+                                    std::vector<std::uint32_t> &spirv,
+                                    std::string                &info_log)
+{
+	initialize_glslang();
+
+	return compile(stage, glsl_source, entry_point, shader_variant, GLSLCompiler::env_target_language, GLSLCompiler::env_target_language_version, spirv, info_log);
+}
+
+std::vector<GLSLCompileResult> GLSLCompiler::compile_batch(const std::vector<GLSLCompileJob> &jobs, uint32_t thread_count)
+{
+	initialize_glslang();
+
+	auto target_language         = GLSLCompiler::env_target_language;
+	auto target_language_version = GLSLCompiler::env_target_language_version;
+
+	std::vector<GLSLCompileResult> results(jobs.size());
+
+	auto run_job = [&](size_t job_index) {
+		auto &job    = jobs[job_index];
+		auto &result = results[job_index];
+
+		result.success = compile(job.stage, job.glsl_source, job.entry_point, job.shader_variant, target_language, target_language_version, result.spirv, result.info_log);
+	};
+
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	thread_count = std::min(thread_count, static_cast<uint32_t>(jobs.size()));
+
+	if (thread_count <= 1)
+	{
+		for (size_t job_index = 0; job_index < jobs.size(); ++job_index)
+		{
+			run_job(job_index);
+		}
+	}
+	else
+	{
+		ctpl::thread_pool thread_pool(static_cast<int>(thread_count));
+
+		std::vector<std::future<void>> futures;
+		futures.reserve(jobs.size());
+
+		for (size_t job_index = 0; job_index < jobs.size(); ++job_index)
+		{
+			futures.push_back(thread_pool.push([&run_job, job_index](size_t) { run_job(job_index); }));
+		}
+
+		for (auto &future : futures)
+		{
+			future.get();
+		}
+	}
+
+	return results;
+}
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -29,6 +29,33 @@
 
 namespace vkb
 {
+/**
+ * @brief A single compilation of GLSLCompiler::compile_batch
+ */
+struct GLSLCompileJob
+{
+	VkShaderStageFlagBits stage{VK_SHADER_STAGE_VERTEX_BIT};
+
+	std::vector<uint8_t> glsl_source;
+
+	std::string entry_point{"main"};
+
+	ShaderVariant shader_variant;
+};
+
+/**
+ * @brief Outcome of a GLSLCompileJob
+ */
+struct GLSLCompileResult
+{
+	bool success{false};
+
+	std::vector<std::uint32_t> spirv;
+
+	/// Log messages of this job only
+	std::string info_log;
+};
+
 /// Helper class to generate SPIRV code from GLSL source
 /// A very simple version of the glslValidator application
 class GLSLCompiler
@@ -51,6 +78,14 @@ class GLSLCompiler
 	 */
 	static void reset_target_environment();
 
+	/**
+	 * @brief Get the glslang target environment currently used when generating code
+	 * @param[out] target_language The language to translate to
+	 * @param[out] target_language_version The version of the language to translate to
+	 */
+	static void get_target_environment(glslang::EShTargetLanguage        &target_language,
+	                                   glslang::EShTargetLanguageVersion &target_language_version);
+
 	/**
 	 * @brief Compiles GLSL to SPIRV code
 	 * @param stage The Vulkan shader stage flag
@@ -66,5 +101,15 @@ class GLSLCompiler
 	                      const ShaderVariant        &shader_variant,
 	                      std::vector<std::uint32_t> &spirv,
 	                      std::string                &info_log);
+
+	/**
+	 * @brief Compiles a set of GLSL shaders to SPIRV code in parallel
+	 *        Each worker thread uses its own glslang shader and program objects, the glslang
+	 *        process state is shared. The target environment is read once, before any job starts.
+	 * @param jobs The shaders to compile
+	 * @param thread_count The number of worker threads, 0 to use the hardware concurrency
+	 * @return One result per job, in the order of the jobs
+	 */
+	std::vector<GLSLCompileResult> compile_batch(const std::vector<GLSLCompileJob> &jobs, uint32_t thread_count = 0);
 };
 }        // namespace vkb
@@ -19,8 +19,14 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <future>
 #include <limits>
+#include <numeric>
 #include <queue>
+#include <span>
 
 #include "common/error.h"
 
@@ -35,7 +41,11 @@
 #include "core/device.h"
 #include "core/image.h"
 #include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
+#include "geometry/mesh_optimizer.h"
+#include "geometry/meshlet_builder.h"
+#include "scene_cache.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/image/astc.h"
@@ -50,6 +60,8 @@
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
 #include "scene_graph/scripts/animation.h"
+#include "scene_graph/scripts/texture_streamer.h"
+#include "staging_uploader.h"
 
 #include <ctpl_stl.h>
 
@@ -285,23 +297,283 @@ inline std::vector<uint8_t> convert_underlying_data_stride(const std::vector<uin
 	return result;
 }
 
-inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::core::BufferC &staging_buffer, sg::Image &image)
+/// Vertex and index data of a primitive, read on a worker thread before its buffers are created
+struct PrimitiveData : SceneCache::Primitive
 {
-	// Clean up the image data, as they are copied in the staging buffer
-	image.clear_data();
+	/// Whether the index and vertex data were reordered by optimize_primitive
+	bool optimized{false};
 
+	VertexCacheStats cache_stats_before;
+
+	VertexCacheStats cache_stats_after;
+
+	double meshlet_build_time{0.0};
+};
+
+/// An image created from the processed data stored in the scene cache, its pixels are uploaded from the mapped entry
+class CachedImage : public sg::Image
+{
+  public:
+	CachedImage(SceneCache::Image &&image) :
+	    sg::Image{image.name, {}, std::move(image.mipmaps)}
+	{
+		set_format(image.format);
+		set_layers(image.layers);
+		set_offsets(image.offsets);
+	}
+};
+
+/**
+ * @brief Interleaves the data of several attributes into a single stream
+ * @param attribute_data The data of each attribute
+ * @param attributes The format and stride of each attribute, offsets and strides are updated to the interleaved layout
+ * @return The interleaved data
+ */
+inline std::vector<uint8_t> interleave_attributes(const std::vector<const std::vector<uint8_t> *> &attribute_data, const std::vector<sg::VertexAttribute *> &attributes)
+{
+	// Keep each attribute 4-byte aligned, as vertex fetch would otherwise straddle words
+	std::vector<uint32_t> element_sizes(attributes.size());
+	uint32_t              vertex_stride = 0;
+
+	for (size_t i = 0; i < attributes.size(); ++i)
+	{
+		element_sizes[i]      = to_u32(get_bits_per_pixel(attributes[i]->format)) / 8;
+		attributes[i]->offset = vertex_stride;
+		vertex_stride += (element_sizes[i] + 3) & ~3u;
+	}
+
+	size_t vertex_count = attribute_data[0]->size() / attributes[0]->stride;
+
+	std::vector<uint8_t> result(vertex_count * vertex_stride);
+
+	for (size_t i = 0; i < attributes.size(); ++i)
+	{
+		const uint8_t *src = attribute_data[i]->data();
+		uint8_t       *dst = result.data() + attributes[i]->offset;
+
+		for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+		{
+			std::copy_n(src + vertex * attributes[i]->stride, element_sizes[i], dst + vertex * vertex_stride);
+		}
+
+		attributes[i]->stride = vertex_stride;
+	}
+
+	return result;
+}
+
+/**
+ * @brief Replaces the attribute streams of a primitive following a vertex layout
+ */
+inline void apply_vertex_layout(PrimitiveData &primitive, VertexLayout vertex_layout)
+{
+	if (vertex_layout == VertexLayout::Separate)
+	{
+		return;
+	}
+
+	std::vector<PrimitiveData::Stream> streams;
+	PrimitiveData::Stream              interleaved_stream{"interleaved"};
+
+	std::vector<const std::vector<uint8_t> *> attribute_data;
+	std::vector<sg::VertexAttribute *>        attributes;
+
+	for (auto &stream : primitive.streams)
+	{
+		if (vertex_layout == VertexLayout::SeparatePosition && stream.name == "position")
+		{
+			streams.push_back(std::move(stream));
+			continue;
+		}
+
+		interleaved_stream.attribute_names.push_back(stream.name);
+		attribute_data.push_back(&stream.data);
+		attributes.push_back(&primitive.attributes[stream.name]);
+	}
+
+	if (!attributes.empty())
+	{
+		interleaved_stream.data = interleave_attributes(attribute_data, attributes);
+		streams.push_back(std::move(interleaved_stream));
+	}
+
+	primitive.streams = std::move(streams);
+}
+
+inline const char *to_string(VertexLayout vertex_layout)
+{
+	switch (vertex_layout)
+	{
+		case VertexLayout::Interleaved:
+			return "interleaved";
+		case VertexLayout::SeparatePosition:
+			return "separate position";
+		default:
+			return "separate";
+	}
+}
+
+/**
+ * @brief Reads the positions of a primitive for mesh processing
+ * @return False if the primitive has no indices or no 32-bit float positions
+ */
+inline bool get_positions_and_indices(const PrimitiveData &primitive, std::vector<glm::vec3> &positions, std::vector<uint32_t> &indices)
+{
+	auto position_it = primitive.attributes.find("position");
+
+	if (primitive.index_data.empty() || position_it == primitive.attributes.end() || position_it->second.format != VK_FORMAT_R32G32B32_SFLOAT)
+	{
+		return false;
+	}
+
+	auto position_stream = std::ranges::find_if(primitive.streams, [](const PrimitiveData::Stream &stream) { return stream.name == "position"; });
+
+	positions.resize(primitive.vertices_count);
+	for (size_t i = 0; i < positions.size(); ++i)
 	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_UNDEFINED;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.src_access_mask = 0;
-		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		std::memcpy(&positions[i], position_stream->data.data() + i * position_it->second.stride, sizeof(glm::vec3));
+	}
 
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
+	indices.resize(primitive.vertex_indices);
+	if (primitive.index_type == VK_INDEX_TYPE_UINT16)
+	{
+		auto index_data = reinterpret_cast<const uint16_t *>(primitive.index_data.data());
+		std::copy_n(index_data, indices.size(), indices.begin());
+	}
+	else
+	{
+		std::memcpy(indices.data(), primitive.index_data.data(), indices.size() * sizeof(uint32_t));
 	}
 
+	return true;
+}
+
+/**
+ * @brief Reorders the triangles and vertices of an indexed triangle list primitive for the post-transform
+ *        vertex cache, overdraw and vertex fetch, see optimize_mesh
+ * @return Whether the primitive could be optimized
+ */
+inline bool optimize_primitive(PrimitiveData &primitive, std::vector<glm::vec3> &positions, std::vector<uint32_t> &indices)
+{
+	primitive.cache_stats_before = analyze_vertex_cache(indices, positions.size());
+
+	std::vector<uint32_t> remap;
+	if (!optimize_mesh(indices, positions, remap))
+	{
+		return false;
+	}
+
+	primitive.cache_stats_after = analyze_vertex_cache(indices, positions.size());
+
+	for (auto &stream : primitive.streams)
+	{
+		stream.data = remap_vertex_data(stream.data, primitive.attributes[stream.name].stride, remap);
+	}
+
+	std::vector<glm::vec3> remapped_positions(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		remapped_positions[remap[i]] = positions[i];
+	}
+	positions = std::move(remapped_positions);
+
+	if (primitive.index_type == VK_INDEX_TYPE_UINT16)
+	{
+		auto index_data = reinterpret_cast<uint16_t *>(primitive.index_data.data());
+		std::ranges::transform(indices, index_data, [](uint32_t index) { return static_cast<uint16_t>(index); });
+	}
+	else
+	{
+		std::memcpy(primitive.index_data.data(), indices.data(), indices.size() * sizeof(uint32_t));
+	}
+
+	return true;
+}
+
+inline PrimitiveData read_primitive_data(const tinygltf::Model &model, const tinygltf::Primitive &gltf_primitive, VertexLayout vertex_layout, bool optimize, const MeshletLimits *meshlet_limits)
+{
+	PrimitiveData primitive;
+
+	for (auto &attribute : gltf_primitive.attributes)
+	{
+		std::string attrib_name = attribute.first;
+		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+
+		if (attrib_name == "position")
+		{
+			assert(attribute.second < model.accessors.size());
+			primitive.vertices_count = to_u32(model.accessors[attribute.second].count);
+		}
+
+		sg::VertexAttribute attrib;
+		attrib.format = get_attribute_format(&model, attribute.second);
+		attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
+
+		primitive.attributes[attrib_name] = attrib;
+		primitive.streams.push_back({attrib_name, get_attribute_data(&model, attribute.second), {attrib_name}});
+	}
+
+	if (gltf_primitive.indices >= 0)
+	{
+		primitive.vertex_indices = to_u32(get_attribute_size(&model, gltf_primitive.indices));
+
+		auto format = get_attribute_format(&model, gltf_primitive.indices);
+
+		primitive.index_data = get_attribute_data(&model, gltf_primitive.indices);
+
+		switch (format)
+		{
+			case VK_FORMAT_R8_UINT:
+				// Converts uint8 data into uint16 data, still represented by a uint8 vector
+				primitive.index_data = convert_underlying_data_stride(primitive.index_data, 1, 2);
+				primitive.index_type = VK_INDEX_TYPE_UINT16;
+				break;
+			case VK_FORMAT_R16_UINT:
+				primitive.index_type = VK_INDEX_TYPE_UINT16;
+				break;
+			case VK_FORMAT_R32_UINT:
+				primitive.index_type = VK_INDEX_TYPE_UINT32;
+				break;
+			default:
+				LOGE("gltf primitive has invalid format type");
+				break;
+		}
+	}
+	else
+	{
+		primitive.vertices_count = to_u32(get_attribute_size(&model, gltf_primitive.attributes.at("POSITION")));
+	}
+
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t>  indices;
+
+	if ((optimize || meshlet_limits) && (gltf_primitive.mode == TINYGLTF_MODE_TRIANGLES || gltf_primitive.mode == -1) &&
+	    get_positions_and_indices(primitive, positions, indices) &&
+	    std::ranges::all_of(indices, [&positions](uint32_t index) { return index < positions.size(); }))
+	{
+		if (optimize)
+		{
+			primitive.optimized = optimize_primitive(primitive, positions, indices);
+		}
+
+		if (meshlet_limits)
+		{
+			Timer timer;
+			timer.start();
+
+			primitive.meshlets = build_meshlets(indices, positions, *meshlet_limits);
+
+			primitive.meshlet_build_time = timer.stop();
+		}
+	}
+
+	apply_vertex_layout(primitive, vertex_layout);
+
+	return primitive;
+}
+
+inline void upload_image_to_gpu(StagingUploader &uploader, sg::Image &image, std::span<const uint8_t> data)
+{
 	// Create a buffer image copy for every mip level
 	auto &mipmaps = image.get_mipmaps();
 
@@ -319,69 +591,306 @@ inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::
 		copy_region.imageExtent               = mipmap.extent;
 	}
 
-	command_buffer.copy_buffer_to_image(staging_buffer, image.get_vk_image(), buffer_copy_regions);
+	uploader.upload_image(data,
+	                      image.get_vk_image(),
+	                      buffer_copy_regions,
+	                      image.get_vk_image_view().get_subresource_range(),
+	                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
+
+/**
+ * @brief Decodes an image of a glTF file and creates its Vulkan image
+ * @param device The device, ASTC images are decoded if it does not support their format
+ * @param name The name of the image
+ * @param data The pixels of an image embedded in the glTF file, if empty the image is decoded from file_data
+ * @param width The width of an embedded image
+ * @param height The height of an embedded image
+ * @param uri The path of the image file, relative to the assets directory
+ * @param file_data The content of the image file
+ */
+inline std::unique_ptr<sg::Image> load_image(Device &device, const std::string &name, std::vector<uint8_t> &&data, int width, int height, const std::string &uri,
+                                             std::span<const uint8_t> file_data)
+{
+	std::unique_ptr<sg::Image> image{nullptr};
 
+	if (!data.empty())
 	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		// Image embedded in gltf file
+		auto mipmap = sg::Mipmap{
+		    /* .level = */ 0,
+		    /* .offset = */ 0,
+		    /* .extent = */ {/* .width = */ static_cast<uint32_t>(width),
+		                     /* .height = */ static_cast<uint32_t>(height),
+		                     /* .depth = */ 1u}};
+		std::vector<sg::Mipmap> mipmaps{mipmap};
+		image = std::make_unique<sg::Image>(name, std::move(data), std::move(mipmaps));
+	}
+	else
+	{
+		// Decode image file
+		image = sg::Image::load(name, uri, file_data, vkb::sg::Image::Unknown);
+	}
 
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
+	// Check whether the format is supported by the GPU
+	if (sg::is_astc(image->get_format()))
+	{
+		if (!device.is_image_format_supported(image->get_format()))
+		{
+			LOGW("ASTC not supported: decoding {}", image->get_name());
+			image = std::make_unique<sg::Astc>(*image);
+			image->generate_mipmaps();
+		}
 	}
+
+	image->create_vk_image(device);
+
+	return image;
+}
+
+/**
+ * @brief Creates a 1x1 image, bound to the textures of a streamed scene until their image is uploaded
+ */
+inline std::unique_ptr<sg::Image> create_placeholder_image(Device &device, const std::string &name, const glm::u8vec4 &color)
+{
+	std::vector<uint8_t>    data{color.r, color.g, color.b, color.a};
+	std::vector<sg::Mipmap> mipmaps{{0, 0, {1, 1, 1}}};
+
+	auto image = std::make_unique<sg::Image>(name, std::move(data), std::move(mipmaps));
+	image->create_vk_image(device);
+
+	return image;
 }
 
-inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::unique_ptr<vkb::sg::SubMesh> &submesh, std::vector<unsigned char> &index_data)
+inline void prepare_meshlets(std::vector<Meshlet> &meshlets, const std::vector<glm::vec3> &positions, std::vector<unsigned char> &index_data)
 {
-	Meshlet meshlet;
-	meshlet.vertex_count = 0;
-	meshlet.index_count  = 0;
+	std::vector<uint32_t> indices(index_data.size() / sizeof(uint32_t));
+	std::memcpy(indices.data(), index_data.data(), indices.size() * sizeof(uint32_t));
 
-	std::set<uint32_t> vertices;                  // set for unique vertices
-	uint32_t           triangle_check = 0;        // each meshlet needs to contain full primitives
+	// 32 triangles because for each triangle we draw a line in a mesh shader sample, 32 triangles/lines per meshlet = 64 vertices on output
+	MeshletLimits limits;
+	limits.max_vertices  = 64;
+	limits.max_triangles = 32;
 
-	for (uint32_t i = 0; i < submesh->vertex_indices; i++)
+	auto data = build_meshlets(indices, positions, limits);
+
+	// The sample meshlets store the mesh vertex indices of their triangles, rather than indices in their vertices
+	meshlets.resize(data.meshlets.size());
+
+	for (size_t i = 0; i < data.meshlets.size(); ++i)
 	{
-		// index_data is unsigned char type, casting to uint32_t* will give proper value
-		meshlet.indices[meshlet.index_count] = *(reinterpret_cast<uint32_t *>(index_data.data()) + i);
+		auto &description = data.meshlets[i];
+		auto &meshlet     = meshlets[i];
+
+		meshlet.vertex_count = description.vertex_count;
+		meshlet.index_count  = description.triangle_count * 3;
+
+		std::copy_n(data.vertices.begin() + description.vertex_offset, description.vertex_count, meshlet.vertices);
 
-		if (vertices.insert(meshlet.indices[meshlet.index_count]).second)
+		for (uint32_t j = 0; j < meshlet.index_count; ++j)
 		{
-			++meshlet.vertex_count;
+			meshlet.indices[j] = data.vertices[description.vertex_offset + data.triangles[description.triangle_offset + j]];
 		}
+	}
+}
+
+/**
+ * @brief Sub-allocates mesh data from a few large device local buffers
+ *
+ * Each arena is sized for the data still to be packed, up to a maximum size, so that a scene
+ * usually ends up with a single vertex buffer and a single index buffer.
+ */
+class MeshArenaAllocator
+{
+  public:
+	static constexpr VkDeviceSize ALIGNMENT = 16;
+
+	static constexpr VkDeviceSize MAX_ARENA_SIZE = 256 * 1024 * 1024;
+
+	MeshArenaAllocator(Device &device, VkBufferUsageFlags usage, VkDeviceSize total_size, std::string name) :
+	    device{device},
+	    usage{usage},
+	    remaining_size{total_size},
+	    name{std::move(name)}
+	{
+	}
 
-		meshlet.index_count++;
-		triangle_check = triangle_check < 3 ? ++triangle_check : 1;
+	sg::SharedBufferRange allocate(const std::vector<uint8_t> &data)
+	{
+		VkDeviceSize size = aligned_size(data.size());
 
-		// 96 because for each traingle we draw a line in a mesh shader sample, 32 triangles/lines per meshlet = 64 vertices on output
-		if (meshlet.vertex_count == 64 || meshlet.index_count == 96 || i == submesh->vertex_indices - 1)
+		if (!arena || arena_offset + size > arena->get_size())
 		{
-			if (i == submesh->vertex_indices - 1)
-			{
-				assert(triangle_check == 3);
-			}
+			VkDeviceSize arena_size = std::max(std::min(remaining_size, MAX_ARENA_SIZE), size);
+
+			arena = std::make_shared<vkb::core::BufferC>(device,
+			                                             arena_size,
+			                                             usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			                                             VMA_MEMORY_USAGE_GPU_ONLY);
+			arena->set_debug_name(fmt::format("{} arena #{}", name, arena_count));
+
+			arena_offset = 0;
+			arena_count++;
+		}
+
+		sg::SharedBufferRange range{arena, arena_offset};
+
+		device.get_staging_uploader().upload_buffer(data, *arena, arena_offset);
+
+		arena_offset += size;
+		remaining_size -= std::min(remaining_size, size);
+		allocated_size += data.size();
+
+		return range;
+	}
+
+	static VkDeviceSize aligned_size(VkDeviceSize size)
+	{
+		return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
 
-			uint32_t counter = 0;
-			for (auto v : vertices)
+	uint32_t get_arena_count() const
+	{
+		return arena_count;
+	}
+
+	VkDeviceSize get_allocated_size() const
+	{
+		return allocated_size;
+	}
+
+  private:
+	Device &device;
+
+	VkBufferUsageFlags usage;
+
+	VkDeviceSize remaining_size;
+
+	std::string name;
+
+	std::shared_ptr<vkb::core::BufferC> arena;
+
+	VkDeviceSize arena_offset{0};
+
+	uint32_t arena_count{0};
+
+	VkDeviceSize allocated_size{0};
+};
+
+/**
+ * @brief Reads the image files of a model ahead of their decoding
+ *
+ * The reads are queued in image order, with at most a given number of read files waiting for their decode, so that
+ * the raw content of every image is never held at once. Each decode takes the content of its file, which is then
+ * released along with the decoded data.
+ */
+class ImageFileReader
+{
+  public:
+	/**
+	 * @param requests The reads indexed like the images of the model, with an empty path for the embedded images
+	 * @param max_reads_ahead The maximum number of reads queued ahead of the decodes
+	 */
+	ImageFileReader(std::vector<filesystem::ReadRequest> &&requests, size_t max_reads_ahead) :
+	    requests{std::move(requests)},
+	    reads(this->requests.size()),
+	    max_reads_ahead{max_reads_ahead}
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		queue_reads(0);
+	}
+
+	/**
+	 * @brief Waits for the file of an image, and queues the next reads
+	 * @return The content of the file, empty for an embedded image
+	 */
+	std::vector<uint8_t> take(size_t image_index)
+	{
+		std::future<std::vector<uint8_t>> read;
+
+		{
+			std::lock_guard<std::mutex> lock{mutex};
+
+			// An image decoded out of order is read right away
+			queue_reads(image_index + 1);
+
+			read = std::move(reads[image_index]);
+			if (read.valid())
 			{
-				meshlet.vertices[counter++] = v;
+				pending_count--;
 			}
-			if (triangle_check != 3)
+
+			queue_reads(0);
+		}
+
+		return read.valid() ? read.get() : std::vector<uint8_t>{};
+	}
+
+  private:
+	void queue_reads(size_t min_next_read)
+	{
+		std::vector<filesystem::ReadRequest> batch;
+		std::vector<size_t>                  batch_images;
+
+		for (; next_read < requests.size() && (next_read < min_next_read || pending_count < max_reads_ahead); next_read++)
+		{
+			if (requests[next_read].path.empty())
 			{
-				meshlet.index_count -= triangle_check;
-				i -= triangle_check;
-				triangle_check = 0;
+				continue;
 			}
 
-			meshlets.push_back(meshlet);
-			meshlet.vertex_count = 0;
-			meshlet.index_count  = 0;
-			vertices.clear();
+			batch.push_back(requests[next_read]);
+			batch_images.push_back(next_read);
+			pending_count++;
+		}
+
+		if (batch.empty())
+		{
+			return;
+		}
+
+		// The whole window is queued as one batch, so that its reads are in flight together
+		auto batch_reads = vkb::filesystem::get()->read_async(batch);
+
+		for (size_t i = 0; i < batch_images.size(); i++)
+		{
+			reads[batch_images[i]] = std::move(batch_reads[i]);
 		}
 	}
+
+	std::mutex mutex;
+
+	std::vector<filesystem::ReadRequest> requests;
+
+	std::vector<std::future<std::vector<uint8_t>>> reads;
+
+	size_t next_read{0};
+
+	/// Reads queued and not yet taken
+	size_t pending_count{0};
+
+	size_t max_reads_ahead;
+};
+
+/**
+ * @brief Starts reading the image files of a model
+ */
+std::shared_ptr<ImageFileReader> read_image_files(const tinygltf::Model &model, const std::string &model_path, size_t max_reads_ahead)
+{
+	std::vector<filesystem::ReadRequest> requests(model.images.size());
+
+	for (size_t image_index = 0; image_index < model.images.size(); image_index++)
+	{
+		auto &gltf_image = model.images[image_index];
+
+		// Embedded images were already decoded by tinygltf
+		if (gltf_image.image.empty())
+		{
+			requests[image_index].path = vkb::fs::path::get(vkb::fs::path::Type::Assets) + model_path + "/" + gltf_image.uri;
+		}
+	}
+
+	return std::make_shared<ImageFileReader>(std::move(requests), max_reads_ahead);
 }
 
 static inline bool texture_needs_srgb_colorspace(const std::string &name)
@@ -398,6 +907,189 @@ static inline bool texture_needs_srgb_colorspace(const std::string &name)
 	return false;
 }
 
+/**
+ * @brief Sets the callback of the tinygltf versions that check the size of an external file before reading it
+ */
+template <typename Callbacks>
+inline void set_file_size_callback(Callbacks &callbacks)
+{
+	if constexpr (requires { callbacks.GetFileSizeInBytes; })
+	{
+		callbacks.GetFileSizeInBytes = [](size_t *file_size, std::string *err, const std::string &abs_filename, void *) {
+			auto stat = vkb::filesystem::get()->stat_file(abs_filename);
+
+			if (!stat.is_file)
+			{
+				if (err)
+				{
+					*err += fmt::format("File does not exist: {}\n", abs_filename);
+				}
+				return false;
+			}
+
+			*file_size = stat.size;
+			return true;
+		};
+	}
+}
+
+/**
+ * @brief Gets the file system callbacks of tinygltf, which read the external buffers of a glTF file through
+ *        vkb::filesystem so that they are served from the asset pack when one is mounted
+ */
+inline tinygltf::FsCallbacks get_fs_callbacks()
+{
+	tinygltf::FsCallbacks callbacks{};
+
+	callbacks.FileExists = [](const std::string &abs_filename, void *) {
+		return vkb::filesystem::get()->is_file(abs_filename);
+	};
+
+	// The paths are already joined to the assets directory, there are no environment variables to expand
+	callbacks.ExpandFilePath = [](const std::string &filepath, void *) {
+		return filepath;
+	};
+
+	callbacks.ReadWholeFile = [](std::vector<unsigned char> *out, std::string *err, const std::string &filepath, void *) {
+		try
+		{
+			*out = vkb::filesystem::get()->read_file_binary(filepath);
+		}
+		catch (const std::exception &e)
+		{
+			if (err)
+			{
+				*err += fmt::format("File read error: {}: {}\n", filepath, e.what());
+			}
+			return false;
+		}
+
+		return true;
+	};
+
+	// The loader doesn't write glTF files
+	callbacks.WriteWholeFile = &tinygltf::WriteWholeFile;
+
+	set_file_size_callback(callbacks);
+
+	return callbacks;
+}
+
+/**
+ * @brief Gets the directory of a glTF file, which the paths of its buffer and image files are relative to
+ * @param file_name The path of the glTF file, relative to the assets directory
+ */
+inline std::string get_model_path(const std::string &file_name)
+{
+	size_t pos = file_name.find_last_of('/');
+
+	return pos == std::string::npos ? std::string{} : file_name.substr(0, pos);
+}
+
+/**
+ * @brief Lists the files a model was read from: the glTF file, and the buffer and image files it references.
+ *        Data URIs are part of the glTF file.
+ */
+inline std::vector<std::string> get_source_files(const tinygltf::Model &model, const std::string &file_name)
+{
+	auto assets_path = vkb::fs::path::get(vkb::fs::path::Type::Assets);
+	auto model_path  = get_model_path(file_name);
+
+	std::vector<std::string> sources{assets_path + file_name};
+
+	auto add_uri = [&](const std::string &uri) {
+		if (!uri.empty() && uri.rfind("data:", 0) != 0)
+		{
+			sources.push_back(assets_path + model_path + "/" + uri);
+		}
+	};
+
+	for (auto &buffer : model.buffers)
+	{
+		add_uri(buffer.uri);
+	}
+
+	for (auto &gltf_image : model.images)
+	{
+		add_uri(gltf_image.uri);
+	}
+
+	return sources;
+}
+
+/**
+ * @brief Reads the keyframes of the samplers of an animation from their accessors
+ */
+inline std::vector<sg::AnimationSampler> read_animation_samplers(const tinygltf::Model &model, const tinygltf::Animation &gltf_animation)
+{
+	std::vector<sg::AnimationSampler> samplers;
+
+	for (size_t sampler_index = 0; sampler_index < gltf_animation.samplers.size(); ++sampler_index)
+	{
+		auto gltf_sampler = gltf_animation.samplers[sampler_index];
+
+		sg::AnimationSampler sampler;
+		if (gltf_sampler.interpolation == "LINEAR")
+		{
+			sampler.type = sg::AnimationType::Linear;
+		}
+		else if (gltf_sampler.interpolation == "STEP")
+		{
+			sampler.type = sg::AnimationType::Step;
+		}
+		else if (gltf_sampler.interpolation == "CUBICSPLINE")
+		{
+			sampler.type = sg::AnimationType::CubicSpline;
+		}
+		else
+		{
+			LOGW("Gltf animation sampler #{} has unknown interpolation value", sampler_index);
+		}
+
+		auto input_accessor      = model.accessors[gltf_sampler.input];
+		auto input_accessor_data = get_attribute_data(&model, gltf_sampler.input);
+
+		const float *data = reinterpret_cast<const float *>(input_accessor_data.data());
+		for (size_t i = 0; i < input_accessor.count; ++i)
+		{
+			sampler.inputs.push_back(data[i]);
+		}
+
+		auto output_accessor      = model.accessors[gltf_sampler.output];
+		auto output_accessor_data = get_attribute_data(&model, gltf_sampler.output);
+
+		switch (output_accessor.type)
+		{
+			case TINYGLTF_TYPE_VEC3:
+			{
+				const glm::vec3 *data = reinterpret_cast<const glm::vec3 *>(output_accessor_data.data());
+				for (size_t i = 0; i < output_accessor.count; ++i)
+				{
+					sampler.outputs.push_back(glm::vec4(data[i], 0.0f));
+				}
+				break;
+			}
+			case TINYGLTF_TYPE_VEC4:
+			{
+				const glm::vec4 *data = reinterpret_cast<const glm::vec4 *>(output_accessor_data.data());
+				for (size_t i = 0; i < output_accessor.count; ++i)
+				{
+					sampler.outputs.push_back(glm::vec4(data[i]));
+				}
+				break;
+			}
+			default:
+			{
+				LOGW("Gltf animation sampler #{} has unknown output data type", sampler_index);
+				continue;
+			}
+		}
+
+		samplers.push_back(sampler);
+	}
+
+	return samplers;
+}
 }        // namespace
 
 std::unordered_map<std::string, bool> GLTFLoader::supported_extensions = {
@@ -408,30 +1100,136 @@ GLTFLoader::GLTFLoader(Device &device) :
 {
 }
 
-std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &file_name, int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
+void GLTFLoader::set_mesh_arenas(bool enabled)
 {
-	PROFILE_SCOPE("Load GLTF Scene");
+	mesh_arenas = enabled;
+}
+
+void GLTFLoader::set_vertex_layout(VertexLayout layout)
+{
+	vertex_layout = layout;
+}
+
+void GLTFLoader::set_mesh_optimization(bool enabled)
+{
+	mesh_optimization = enabled;
+}
+
+void GLTFLoader::set_meshlet_generation(bool enabled, const MeshletLimits &limits)
+{
+	meshlet_generation = enabled;
+	meshlet_limits     = limits;
+}
+
+void GLTFLoader::upload_meshlets(sg::SubMesh &submesh, const MeshletData &meshlets)
+{
+	auto &uploader = device.get_staging_uploader();
+
+	auto upload = [&](const std::string &name, const auto &values) {
+		std::span<const uint8_t> data{reinterpret_cast<const uint8_t *>(values.data()), values.size() * sizeof(values[0])};
+
+		// Empty storage buffers are not allowed
+		vkb::core::BufferC buffer{device,
+		                          std::max<VkDeviceSize>(data.size(), 4),
+		                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		                          VMA_MEMORY_USAGE_GPU_ONLY};
+		buffer.set_debug_name(fmt::format("{}: {}", submesh.get_name(), name));
+
+		uploader.upload_buffer(data, buffer, 0, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+		submesh.meshlet_buffers.insert(std::make_pair(name, std::move(buffer)));
+	};
+
+	upload("meshlets", meshlets.meshlets);
+	upload("meshlet_bounds", meshlets.bounds);
+	upload("meshlet_vertices", meshlets.vertices);
+	upload("meshlet_triangles", meshlets.triangles);
+
+	submesh.meshlet_count = to_u32(meshlets.meshlets.size());
+}
+
+void GLTFLoader::set_scene_cache(bool enabled)
+{
+	scene_cache = enabled;
+}
+
+void GLTFLoader::set_texture_streaming(bool enabled)
+{
+	texture_streaming = enabled;
+}
+
+void GLTFLoader::set_options(const SceneLoadOptions &options)
+{
+	set_mesh_arenas(options.mesh_arenas);
+	set_vertex_layout(options.vertex_layout);
+	set_mesh_optimization(options.mesh_optimization);
+	set_scene_cache(options.scene_cache);
+	set_texture_streaming(options.texture_streaming);
+}
+
+Hash128 GLTFLoader::get_scene_cache_key(const std::string &file_name) const
+{
+	auto gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
+	auto stat      = vkb::filesystem::get()->stat_file(gltf_file);
+
+	// Only the metadata of the glTF file is hashed, the files it references are checked by SceneCache::load
+	Hasher hasher;
+	hasher.update(gltf_file);
+	hasher.update(static_cast<uint64_t>(stat.size));
+	hasher.update(stat.last_write_time);
+
+	// The processed data also depends on the loader options and on whether ASTC images have to be decoded
+	hasher.update(vertex_layout);
+	hasher.update(mesh_optimization);
+	hasher.update(meshlet_generation);
+	hasher.update(meshlet_limits.max_vertices);
+	hasher.update(meshlet_limits.max_triangles);
+	hasher.update(device.is_image_format_supported(VK_FORMAT_ASTC_4x4_UNORM_BLOCK));
+
+	return hasher.get_hash();
+}
+
+bool GLTFLoader::load_gltf_file(const std::string &file_name)
+{
+	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
+
+	filesystem::MappedFilePtr gltf_data;
+
+	try
+	{
+		gltf_data = vkb::filesystem::get()->map_file(gltf_file);
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to load gltf file {}: {}", gltf_file, e.what());
+
+		return false;
+	}
 
 	std::string err;
 	std::string warn;
 
 	tinygltf::TinyGLTF gltf_loader;
+	gltf_loader.SetFsCallbacks(get_fs_callbacks());
 
-	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
+	// Parse the JSON straight from the mapped file, tinygltf reads the external buffers through the callbacks
+	auto json     = gltf_data->get_data();
+	auto base_dir = std::filesystem::path(gltf_file).parent_path().string();
 
-	bool importResult = gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file.c_str());
+	bool importResult = gltf_loader.LoadASCIIFromString(&model, &err, &warn, reinterpret_cast<const char *>(json.data()), to_u32(json.size()), base_dir);
 
 	if (!importResult)
 	{
 		LOGE("Failed to load gltf file {}.", gltf_file.c_str());
 
-		return nullptr;
+		return false;
 	}
 
 	if (!err.empty())
 	{
 		LOGE("Error loading gltf model: {}.", err.c_str());
-		return nullptr;
+
+		return false;
 	}
 
 	if (!warn.empty())
@@ -439,63 +1237,73 @@ std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &f
 		LOGI("{}", warn.c_str());
 	}
 
-	size_t pos = file_name.find_last_of('/');
-
-	model_path = file_name.substr(0, pos);
+	model_path = get_model_path(file_name);
 
-	if (pos == std::string::npos)
-	{
-		model_path.clear();
-	}
-
-	return std::make_unique<sg::Scene>(load_scene(scene_index, additional_buffer_usage_flags));
+	return true;
 }
 
-std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer, VkBufferUsageFlags additional_buffer_usage_flags)
+std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &file_name, int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
 {
-	PROFILE_SCOPE("Load GLTF Model");
+	PROFILE_SCOPE("Load GLTF Scene");
 
-	std::string err;
-	std::string warn;
+	Timer timer;
+	timer.start();
 
-	tinygltf::TinyGLTF gltf_loader;
+	// The images of a streamed scene are decoded from their files while it is rendered, so it isn't cached
+	bool use_scene_cache = scene_cache && !texture_streaming;
 
-	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
+	Hash128           scene_cache_key;
+	SceneCache::Entry scene_data;
 
-	bool importResult = gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file.c_str());
+	scene_cache_hit = false;
 
-	if (!importResult)
+	if (use_scene_cache)
 	{
-		LOGE("Failed to load gltf file {}.", gltf_file.c_str());
-
-		return nullptr;
+		scene_cache_key = get_scene_cache_key(file_name);
+		scene_cache_hit = SceneCache::load(scene_cache_key, model, scene_data);
 	}
 
-	if (!err.empty())
+	if (scene_cache_hit)
 	{
-		LOGE("Error loading gltf model: {}.", err.c_str());
-
-		return nullptr;
+		// The scene is built from the cached model and data, the glTF file isn't parsed
+		model_path = get_model_path(file_name);
 	}
-
-	if (!warn.empty())
+	else
 	{
-		LOGI("{}", warn.c_str());
+		if (!load_gltf_file(file_name))
+		{
+			return nullptr;
+		}
+
+		if (use_scene_cache)
+		{
+			scene_data.sources = get_source_files(model, file_name);
+		}
 	}
 
-	size_t pos = file_name.find_last_of('/');
+	auto scene = std::make_unique<sg::Scene>(load_scene(scene_index, additional_buffer_usage_flags, use_scene_cache ? &scene_cache_key : nullptr, scene_data));
+
+	// Compare against a run with --asset-pack to measure the pack
+	LOGI("Time spent loading {}: {} seconds{}, {}", file_name, vkb::to_string(timer.stop()),
+	     use_scene_cache ? (scene_cache_hit ? " from a warm scene cache" : " with a cold scene cache") : "",
+	     vkb::filesystem::is_asset_pack_mounted() ? "served from the asset pack" : "served from loose files");
+
+	return scene;
+}
 
-	model_path = file_name.substr(0, pos);
+std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer, VkBufferUsageFlags additional_buffer_usage_flags)
+{
+	PROFILE_SCOPE("Load GLTF Model");
 
-	if (pos == std::string::npos)
+	if (!load_gltf_file(file_name))
 	{
-		model_path.clear();
+		return nullptr;
 	}
 
 	return std::move(load_model(index, storage_buffer, additional_buffer_usage_flags));
 }
 
-sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
+sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_buffer_usage_flags, const Hash128 *scene_cache_key, SceneCache::Entry &scene_data)
 {
 	PROFILE_SCOPE("Process Scene");
 
@@ -524,17 +1332,50 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		}
 		else
 		{
-			// Extension is supported, so enable it
-			LOGI("glTF file contains extension: {}", used_extension);
-			it->second = true;
+			// Extension is supported, so enable it
+			LOGI("glTF file contains extension: {}", used_extension);
+			it->second = true;
+		}
+	}
+
+	// Load lights
+	std::vector<std::unique_ptr<sg::Light>> light_components;
+
+	if (scene_cache_hit)
+	{
+		for (auto &cached_light : scene_data.lights)
+		{
+			auto light = std::make_unique<sg::Light>(cached_light.name);
+			light->set_light_type(cached_light.type);
+			light->set_properties(cached_light.properties);
+
+			light_components.push_back(std::move(light));
 		}
 	}
+	else
+	{
+		light_components = parse_khr_lights_punctual();
 
-	// Load lights
-	std::vector<std::unique_ptr<sg::Light>> light_components = parse_khr_lights_punctual();
+		if (scene_cache_key)
+		{
+			for (auto &light : light_components)
+			{
+				scene_data.lights.push_back({light->get_name(), light->get_light_type(), light->get_properties()});
+			}
+		}
+	}
 
 	scene.set_components(std::move(light_components));
 
+	// Read the keyframes of the animations, they are cached with the rest of the scene
+	if (!scene_cache_hit)
+	{
+		for (auto &gltf_animation : model.animations)
+		{
+			scene_data.animation_samplers.push_back(read_animation_samplers(model, gltf_animation));
+		}
+	}
+
 	// Load samplers
 	std::vector<std::unique_ptr<sg::Sampler>>
 	    sampler_components(model.samplers.size());
@@ -550,19 +1391,57 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	Timer timer;
 	timer.start();
 
+	auto primitive_count = std::accumulate(model.meshes.begin(), model.meshes.end(), size_t{0},
+	                                       [](size_t count, const tinygltf::Mesh &gltf_mesh) { return count + gltf_mesh.primitives.size(); });
+
 	// Load images
 	auto thread_count = std::thread::hardware_concurrency();
 	thread_count      = thread_count == 0 ? 1 : thread_count;
 	ctpl::thread_pool thread_pool(thread_count);
 
-	auto image_count = to_u32(model.images.size());
+	// Read the image files ahead of the decoding threads, so that reading overlaps with decoding
+	std::shared_ptr<ImageFileReader> image_file_reader;
+
+	if (!scene_cache_hit)
+	{
+		image_file_reader = read_image_files(model, model_path, 2 * thread_count);
+	}
+
+	// In streaming mode the images are decoded and uploaded while the scene is rendered
+	std::unique_ptr<sg::TextureStreamer> texture_streamer;
+
+	if (texture_streaming && !model.images.empty())
+	{
+		texture_streamer = std::make_unique<sg::TextureStreamer>(device, thread_count);
+
+		for (size_t image_index = 0; image_index < model.images.size(); image_index++)
+		{
+			auto &gltf_image = model.images[image_index];
+
+			texture_streamer->add_image(
+			    [&device = device, image_index, name = gltf_image.name, data = std::move(gltf_image.image), width = gltf_image.width,
+			     height = gltf_image.height, uri = model_path + "/" + gltf_image.uri, image_file_reader]() mutable {
+				    auto file_data = image_file_reader->take(image_index);
+
+				    auto image = load_image(device, name, std::move(data), width, height, uri, file_data);
+
+				    LOGI("Streamed gltf image #{} ({})", image_index, uri);
+
+				    return image;
+			    });
+		}
+	}
+
+	auto image_count = texture_streamer ? 0 : to_u32(model.images.size());
 
 	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures;
-	for (size_t image_index = 0; image_index < image_count; image_index++)
+	for (size_t image_index = 0; image_index < image_count && !scene_cache_hit; image_index++)
 	{
 		auto fut = thread_pool.push(
-		    [this, image_index](size_t) {
-			    auto image = parse_image(model.images[image_index]);
+		    [this, image_index, image_file_reader](size_t) {
+			    auto file_data = image_file_reader->take(image_index);
+
+			    auto image = parse_image(model.images[image_index], file_data);
 
 			    LOGI("Loaded gltf image #{} ({})", image_index, model.images[image_index].uri.c_str());
 
@@ -574,59 +1453,81 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 
 	std::vector<std::unique_ptr<sg::Image>> image_components;
 
-	// Upload images to GPU. We do this in batches of 64MB of data to avoid needing
-	// double the amount of memory (all the images and all the corresponding buffers).
-	// This helps keep memory footprint lower which is helpful on smaller devices.
-	size_t image_index = 0;
-	while (image_index < image_count)
-	{
-		std::vector<vkb::core::BufferC> transient_buffers;
-
-		auto command_buffer = device.request_command_buffer();
+	// Upload images to GPU as soon as they are decoded. The uploader copies them to its staging ring and submits
+	// the copies in batches, so the GPU copies a batch while the next images are being decoded. The image data
+	// is released once staged, which helps keep memory footprint low on smaller devices.
+	auto &uploader = device.get_staging_uploader();
 
-		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
+	for (size_t image_index = 0; image_index < image_count; image_index++)
+	{
+		std::span<const uint8_t> image_data;
 
-		size_t batch_size = 0;
+		if (scene_cache_hit)
+		{
+			// The pixels are staged straight from the mapped entry
+			image_data = scene_data.images[image_index].mapped_data;
 
-		// Deal with 64MB of image data at a time to keep memory footprint low
-		while (image_index < image_count && batch_size < 64 * 1024 * 1024)
+			image_components.push_back(std::make_unique<CachedImage>(std::move(scene_data.images[image_index])));
+			image_components.back()->create_vk_image(device);
+		}
+		else
 		{
 			// Wait for this image to complete loading, then stage for upload
 			image_components.push_back(image_component_futures[image_index].get());
+			image_data = image_components.back()->get_data();
+		}
 
-			auto &image = image_components[image_index];
-
-			core::Buffer stage_buffer = vkb::core::BufferC::create_staging_buffer(device, image->get_data());
-
-			batch_size += image->get_data().size();
-
-			upload_image_to_gpu(*command_buffer, stage_buffer, *image);
+		auto &image = *image_components.back();
 
-			transient_buffers.push_back(std::move(stage_buffer));
+		upload_image_to_gpu(uploader, image, image_data);
 
-			image_index++;
+		if (scene_cache_key && !scene_cache_hit)
+		{
+			// The staged data are moved to the scene cache entry rather than copied, it holds them until it is written
+			scene_data.images.push_back({image.get_name(), image.get_format(), image.get_layers(), image.get_mipmaps(), image.get_offsets(), image.take_data()});
 		}
+		else
+		{
+			// Clean up the image data, as they are copied in the staging memory
+			image.clear_data();
+		}
+	}
 
-		command_buffer->end();
-
-		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	// Every image is staged, the mapping of a cached entry is no longer needed
+	scene_data.file.reset();
 
-		queue.submit(*command_buffer, device.request_fence());
+	sg::Image *color_placeholder  = nullptr;
+	sg::Image *normal_placeholder = nullptr;
 
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
-		device.wait_idle();
+	if (texture_streamer)
+	{
+		image_components.push_back(create_placeholder_image(device, "Color placeholder", glm::u8vec4{255, 255, 255, 255}));
+		color_placeholder = image_components.back().get();
+		upload_image_to_gpu(uploader, *color_placeholder, color_placeholder->get_data());
 
-		// Remove the staging buffers for the batch we just processed
-		transient_buffers.clear();
+		image_components.push_back(create_placeholder_image(device, "Normal placeholder", glm::u8vec4{128, 128, 255, 255}));
+		normal_placeholder = image_components.back().get();
+		upload_image_to_gpu(uploader, *normal_placeholder, normal_placeholder->get_data());
 	}
 
+	uploader.flush();
+
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
 
-	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), thread_count);
+	if (texture_streamer)
+	{
+		LOGI("Started streaming {} images.", model.images.size());
+	}
+	else if (scene_cache_hit)
+	{
+		LOGI("Time spent loading images from the scene cache: {} seconds.", vkb::to_string(elapsed_time));
+	}
+	else
+	{
+		LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(elapsed_time), thread_count);
+	}
 
 	// Load textures
 	auto images                  = scene.get_components<sg::Image>();
@@ -639,12 +1540,31 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	{
 		auto texture = parse_texture(gltf_texture);
 
-		assert(gltf_texture.source < images.size());
-		texture->set_image(*images[gltf_texture.source]);
+		if (texture_streamer)
+		{
+			texture->set_image(*color_placeholder);
+		}
+		else
+		{
+			assert(gltf_texture.source < images.size());
+			texture->set_image(*images[gltf_texture.source]);
+		}
 
 		if (gltf_texture.sampler >= 0 && gltf_texture.sampler < static_cast<int>(samplers.size()))
 		{
 			texture->set_sampler(*samplers[gltf_texture.sampler]);
+
+			if (texture_streamer)
+			{
+				texture_streamer->add_texture(gltf_texture.source, *texture);
+			}
+		}
+		else if (texture_streamer)
+		{
+			// The image format is only known once decoded, the streamer then falls back to the nearest sampler if needed
+			texture->set_sampler(*default_sampler_linear);
+			texture_streamer->add_texture(gltf_texture.source, *texture, default_sampler_nearest.get());
+			used_nearest_sampler = true;
 		}
 		else
 		{
@@ -697,7 +1617,15 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 				assert(gltf_value.second.TextureIndex() < textures.size());
 				vkb::sg::Texture *tex = textures[gltf_value.second.TextureIndex()];
 
-				if (texture_needs_srgb_colorspace(gltf_value.first))
+				if (texture_streamer)
+				{
+					// Normal maps sample a flat normal until their image is streamed in
+					if (tex_name == "normal_texture")
+					{
+						tex->set_image(*normal_placeholder);
+					}
+				}
+				else if (texture_needs_srgb_colorspace(gltf_value.first))
 				{
 					tex->get_image()->coerce_format_to_srgb();
 				}
@@ -715,7 +1643,15 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 				assert(gltf_value.second.TextureIndex() < textures.size());
 				vkb::sg::Texture *tex = textures[gltf_value.second.TextureIndex()];
 
-				if (texture_needs_srgb_colorspace(gltf_value.first))
+				if (texture_streamer)
+				{
+					// Normal maps sample a flat normal until their image is streamed in
+					if (tex_name == "normal_texture")
+					{
+						tex->set_image(*normal_placeholder);
+					}
+				}
+				else if (texture_needs_srgb_colorspace(gltf_value.first))
 				{
 					tex->get_image()->coerce_format_to_srgb();
 				}
@@ -727,92 +1663,240 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		scene.add_component(std::move(material));
 	}
 
+	if (texture_streamer)
+	{
+		scene.add_component(std::move(texture_streamer));
+	}
+
 	auto default_material = create_default_material();
 
 	// Load meshes
 	auto materials = scene.get_components<sg::PBRMaterial>();
 
+	// Read and convert the primitive data in parallel, the Vulkan objects are then created serially
+	timer.start();
+
+	std::vector<std::future<PrimitiveData>> primitive_data_futures;
+	for (auto &gltf_mesh : model.meshes)
+	{
+		if (scene_cache_hit)
+		{
+			break;
+		}
+
+		for (auto &gltf_primitive : gltf_mesh.primitives)
+		{
+			auto fut = thread_pool.push(
+			    [this, &gltf_primitive](size_t) {
+				    return read_primitive_data(model, gltf_primitive, vertex_layout, mesh_optimization, meshlet_generation ? &meshlet_limits : nullptr);
+			    });
+
+			primitive_data_futures.push_back(std::move(fut));
+		}
+	}
+
+	std::vector<PrimitiveData> primitive_data;
+	primitive_data.reserve(primitive_count);
+
+	for (auto &fut : primitive_data_futures)
+	{
+		primitive_data.push_back(fut.get());
+	}
+
+	for (auto &cached_primitive : scene_data.primitives)
+	{
+		PrimitiveData primitive;
+		static_cast<SceneCache::Primitive &>(primitive) = std::move(cached_primitive);
+		primitive_data.push_back(std::move(primitive));
+	}
+
+	scene_data.primitives.clear();
+
+	elapsed_time = timer.stop();
+
+	if (scene_cache_hit)
+	{
+		LOGI("Time spent loading {} primitives from the scene cache: {} seconds.", primitive_data.size(), vkb::to_string(elapsed_time));
+	}
+	else
+	{
+		LOGI("Time spent processing {} primitives: {} seconds across {} threads.", primitive_data.size(), vkb::to_string(elapsed_time), thread_count);
+	}
+
+	if (scene_cache_key && !scene_cache_hit)
+	{
+		timer.start();
+
+		// The primitive data are moved to the entry while it is written, then back to create the buffers
+		for (auto &primitive : primitive_data)
+		{
+			scene_data.primitives.push_back(std::move(static_cast<SceneCache::Primitive &>(primitive)));
+		}
+
+		SceneCache::store(*scene_cache_key, model, scene_data);
+
+		for (size_t i = 0; i < primitive_data.size(); ++i)
+		{
+			static_cast<SceneCache::Primitive &>(primitive_data[i]) = std::move(scene_data.primitives[i]);
+		}
+
+		// The image data are only kept for the scene cache
+		scene_data.images.clear();
+		scene_data.primitives.clear();
+
+		LOGI("Time spent writing the scene cache: {} seconds.", vkb::to_string(timer.stop()));
+	}
+
+	timer.start();
+
+	std::unique_ptr<MeshArenaAllocator> vertex_arenas;
+	std::unique_ptr<MeshArenaAllocator> index_arenas;
+
+	if (mesh_arenas)
+	{
+		// Size the arenas for the whole scene, so that the meshes share as few buffers as possible
+		VkDeviceSize total_vertex_size = 0;
+		VkDeviceSize total_index_size  = 0;
+
+		for (auto &primitive : primitive_data)
+		{
+			for (auto &stream : primitive.streams)
+			{
+				total_vertex_size += MeshArenaAllocator::aligned_size(stream.data.size());
+			}
+
+			total_index_size += MeshArenaAllocator::aligned_size(primitive.index_data.size());
+		}
+
+		vertex_arenas = std::make_unique<MeshArenaAllocator>(device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags, total_vertex_size, "Scene vertex");
+		index_arenas  = std::make_unique<MeshArenaAllocator>(device, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags, total_index_size, "Scene index");
+	}
+
+	uint32_t     mesh_buffer_count = 0;
+	VkDeviceSize mesh_buffer_size  = 0;
+
+	// Vertex buffer bindings of the primitives, each one is fetched from a separate stream by the draws
+	size_t vertex_stream_count = 0;
+
+	size_t    meshlet_count      = 0;
+	double    meshlet_build_time = 0.0;
+	glm::vec2 meshlet_fill{0.0f};
+
+	auto primitive_it = primitive_data.begin();
+
 	for (auto &gltf_mesh : model.meshes)
 	{
 		PROFILE_SCOPE("Processing Mesh");
 
 		auto mesh = parse_mesh(gltf_mesh);
 
-		for (size_t i_primitive = 0; i_primitive < gltf_mesh.primitives.size(); i_primitive++)
+		VertexCacheStats cache_stats_before;
+		VertexCacheStats cache_stats_after;
+
+		for (size_t i_primitive = 0; i_primitive < gltf_mesh.primitives.size(); i_primitive++, primitive_it++)
 		{
 			const auto &gltf_primitive = gltf_mesh.primitives[i_primitive];
 
+			// Release the primitive data once its buffers are created
+			auto primitive = std::move(*primitive_it);
+
 			auto submesh_name = fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive);
 			auto submesh      = std::make_unique<sg::SubMesh>(std::move(submesh_name));
 
-			for (auto &attribute : gltf_primitive.attributes)
+			submesh->vertices_count = primitive.vertices_count;
+
+			if (primitive.optimized)
+			{
+				cache_stats_before += primitive.cache_stats_before;
+				cache_stats_after += primitive.cache_stats_after;
+			}
+
+			if (!primitive.meshlets.meshlets.empty())
 			{
-				std::string attrib_name = attribute.first;
-				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+				upload_meshlets(*submesh, primitive.meshlets);
 
-				auto vertex_data = get_attribute_data(&model, attribute.second);
+				meshlet_count += primitive.meshlets.meshlets.size();
+				meshlet_build_time += primitive.meshlet_build_time;
+				meshlet_fill += primitive.meshlets.get_fill_rate(meshlet_limits) * static_cast<float>(primitive.meshlets.meshlets.size());
+			}
 
-				if (attrib_name == "position")
-				{
-					assert(attribute.second < model.accessors.size());
-					submesh->vertices_count = to_u32(model.accessors[attribute.second].count);
-				}
+			vertex_stream_count += primitive.streams.size();
 
-				vkb::core::BufferC buffer{device,
-				                          vertex_data.size(),
-				                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
-				                          VMA_MEMORY_USAGE_CPU_TO_GPU};
-				buffer.update(vertex_data);
-				buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
-				                                  gltf_mesh.name, i_primitive, attrib_name));
+			for (auto &stream : primitive.streams)
+			{
+				if (vertex_arenas)
+				{
+					auto range = vertex_arenas->allocate(stream.data);
 
-				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
+					for (auto &attrib_name : stream.attribute_names)
+					{
+						submesh->shared_vertex_buffers[attrib_name] = range;
+					}
+				}
+				else if (stream.attribute_names.size() == 1)
+				{
+					vkb::core::BufferC buffer{device,
+					                          stream.data.size(),
+					                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                          VMA_MEMORY_USAGE_CPU_TO_GPU};
+					buffer.update(stream.data);
+					buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
+					                                  gltf_mesh.name, i_primitive, stream.name));
+
+					submesh->vertex_buffers.insert(std::make_pair(stream.name, std::move(buffer)));
+				}
+				else
+				{
+					// Interleaved attributes share the buffer
+					auto buffer = std::make_shared<vkb::core::BufferC>(device,
+					                                                   stream.data.size(),
+					                                                   VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                                                   VMA_MEMORY_USAGE_CPU_TO_GPU);
+					buffer->update(stream.data);
+					buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
+					                                   gltf_mesh.name, i_primitive, stream.name));
+
+					for (auto &attrib_name : stream.attribute_names)
+					{
+						submesh->shared_vertex_buffers[attrib_name] = {buffer, 0};
+					}
+				}
 
-				sg::VertexAttribute attrib;
-				attrib.format = get_attribute_format(&model, attribute.second);
-				attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
+				if (!vertex_arenas)
+				{
+					mesh_buffer_count++;
+					mesh_buffer_size += stream.data.size();
+				}
+			}
 
-				submesh->set_attribute(attrib_name, attrib);
+			for (auto &attribute : primitive.attributes)
+			{
+				submesh->set_attribute(attribute.first, attribute.second);
 			}
 
 			if (gltf_primitive.indices >= 0)
 			{
-				submesh->vertex_indices = to_u32(get_attribute_size(&model, gltf_primitive.indices));
+				submesh->vertex_indices = primitive.vertex_indices;
+				submesh->index_type     = primitive.index_type;
 
-				auto format = get_attribute_format(&model, gltf_primitive.indices);
-
-				auto index_data = get_attribute_data(&model, gltf_primitive.indices);
-
-				switch (format)
+				if (index_arenas)
 				{
-					case VK_FORMAT_R8_UINT:
-						// Converts uint8 data into uint16 data, still represented by a uint8 vector
-						index_data          = convert_underlying_data_stride(index_data, 1, 2);
-						submesh->index_type = VK_INDEX_TYPE_UINT16;
-						break;
-					case VK_FORMAT_R16_UINT:
-						submesh->index_type = VK_INDEX_TYPE_UINT16;
-						break;
-					case VK_FORMAT_R32_UINT:
-						submesh->index_type = VK_INDEX_TYPE_UINT32;
-						break;
-					default:
-						LOGE("gltf primitive has invalid format type");
-						break;
+					submesh->shared_index_buffer = index_arenas->allocate(primitive.index_data);
 				}
+				else
+				{
+					submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
+					                                                             primitive.index_data.size(),
+					                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
+					                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
+					submesh->index_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: index buffer",
+					                                                  gltf_mesh.name, i_primitive));
 
-				submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
-				                                                             index_data.size(),
-				                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
-				                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
-				submesh->index_buffer->set_debug_name(fmt::format("'{}' mesh, primitive #{}: index buffer",
-				                                                  gltf_mesh.name, i_primitive));
+					submesh->index_buffer->update(primitive.index_data);
 
-				submesh->index_buffer->update(index_data);
-			}
-			else
-			{
-				submesh->vertices_count = to_u32(get_attribute_size(&model, gltf_primitive.attributes.at("POSITION")));
+					mesh_buffer_count++;
+					mesh_buffer_size += primitive.index_data.size();
+				}
 			}
 
 			if (gltf_primitive.material < 0)
@@ -830,9 +1914,45 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 			scene.add_component(std::move(submesh));
 		}
 
+		if (cache_stats_before.triangle_count > 0)
+		{
+			LOGI("Optimized '{}' mesh: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+			     gltf_mesh.name,
+			     cache_stats_before.get_acmr(), cache_stats_after.get_acmr(),
+			     cache_stats_before.get_atvr(), cache_stats_after.get_atvr());
+		}
+
 		scene.add_component(std::move(mesh));
 	}
 
+	// Submit the copies of the arena and meshlet data
+	if (vertex_arenas || meshlet_count > 0)
+	{
+		device.get_staging_uploader().flush();
+	}
+
+	if (vertex_arenas)
+	{
+		mesh_buffer_count = vertex_arenas->get_arena_count() + index_arenas->get_arena_count();
+		mesh_buffer_size  = vertex_arenas->get_allocated_size() + index_arenas->get_allocated_size();
+	}
+
+	elapsed_time = timer.stop();
+
+	LOGI("Time spent creating mesh buffers: {} seconds.", vkb::to_string(elapsed_time));
+
+	if (meshlet_count > 0)
+	{
+		meshlet_fill /= static_cast<float>(meshlet_count);
+
+		LOGI("Built {} meshlets in {} seconds of CPU time, {:.1f}% vertex fill, {:.1f}% triangle fill.",
+		     meshlet_count, vkb::to_string(meshlet_build_time), meshlet_fill.x * 100.0f, meshlet_fill.y * 100.0f);
+	}
+
+	LOGI("Mesh data: {} buffers, {} KB, {} layout with {:.2f} vertex buffer bindings per primitive",
+	     mesh_buffer_count, mesh_buffer_size / 1024, to_string(vertex_layout),
+	     primitive_data.empty() ? 0.0f : static_cast<float>(vertex_stream_count) / static_cast<float>(primitive_data.size()));
+
 	device.get_fence_pool().wait();
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
@@ -898,72 +2018,7 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	for (size_t animation_index = 0; animation_index < model.animations.size(); ++animation_index)
 	{
 		auto &gltf_animation = model.animations[animation_index];
-
-		std::vector<sg::AnimationSampler> samplers;
-
-		for (size_t sampler_index = 0; sampler_index < gltf_animation.samplers.size(); ++sampler_index)
-		{
-			auto gltf_sampler = gltf_animation.samplers[sampler_index];
-
-			sg::AnimationSampler sampler;
-			if (gltf_sampler.interpolation == "LINEAR")
-			{
-				sampler.type = sg::AnimationType::Linear;
-			}
-			else if (gltf_sampler.interpolation == "STEP")
-			{
-				sampler.type = sg::AnimationType::Step;
-			}
-			else if (gltf_sampler.interpolation == "CUBICSPLINE")
-			{
-				sampler.type = sg::AnimationType::CubicSpline;
-			}
-			else
-			{
-				LOGW("Gltf animation sampler #{} has unknown interpolation value", sampler_index);
-			}
-
-			auto input_accessor      = model.accessors[gltf_sampler.input];
-			auto input_accessor_data = get_attribute_data(&model, gltf_sampler.input);
-
-			const float *data = reinterpret_cast<const float *>(input_accessor_data.data());
-			for (size_t i = 0; i < input_accessor.count; ++i)
-			{
-				sampler.inputs.push_back(data[i]);
-			}
-
-			auto output_accessor      = model.accessors[gltf_sampler.output];
-			auto output_accessor_data = get_attribute_data(&model, gltf_sampler.output);
-
-			switch (output_accessor.type)
-			{
-				case TINYGLTF_TYPE_VEC3:
-				{
-					const glm::vec3 *data = reinterpret_cast<const glm::vec3 *>(output_accessor_data.data());
-					for (size_t i = 0; i < output_accessor.count; ++i)
-					{
-						sampler.outputs.push_back(glm::vec4(data[i], 0.0f));
-					}
-					break;
-				}
-				case TINYGLTF_TYPE_VEC4:
-				{
-					const glm::vec4 *data = reinterpret_cast<const glm::vec4 *>(output_accessor_data.data());
-					for (size_t i = 0; i < output_accessor.count; ++i)
-					{
-						sampler.outputs.push_back(glm::vec4(data[i]));
-					}
-					break;
-				}
-				default:
-				{
-					LOGW("Gltf animation sampler #{} has unknown output data type", sampler_index);
-					continue;
-				}
-			}
-
-			samplers.push_back(sampler);
-		}
+		auto &samplers       = scene_data.animation_samplers[animation_index];
 
 		auto animation = std::make_unique<sg::Animation>(gltf_animation.name);
 
@@ -1096,6 +2151,9 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		vkb::add_directional_light(scene, glm::quat({glm::radians(-90.0f), 0.0f, glm::radians(30.0f)}));
 	}
 
+	// The images were uploaded while the rest of the scene was processed
+	device.wait_for_staging_uploads();
+
 	return scene;
 }
 
@@ -1282,8 +2340,14 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 		if (storage_buffer)
 		{
 			// prepare meshlets
+			std::vector<glm::vec3> positions(vertex_count);
+			for (size_t v = 0; v < vertex_count; v++)
+			{
+				positions[v] = glm::make_vec3(&pos[v * 3]);
+			}
+
 			std::vector<Meshlet> meshlets;
-			prepare_meshlets(meshlets, submesh, index_data);
+			prepare_meshlets(meshlets, positions, index_data);
 
 			// vertex_indices and index_buffer are used for meshlets now
 			submesh->vertex_indices = static_cast<uint32_t>(meshlets.size());
@@ -1458,43 +2522,9 @@ std::unique_ptr<sg::PBRMaterial> GLTFLoader::parse_material(const tinygltf::Mate
 	return material;
 }
 
-std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image) const
+std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image, std::span<const uint8_t> file_data) const
 {
-	std::unique_ptr<sg::Image> image{nullptr};
-
-	if (!gltf_image.image.empty())
-	{
-		// Image embedded in gltf file
-		auto mipmap = sg::Mipmap{
-		    /* .level = */ 0,
-		    /* .offset = */ 0,
-		    /* .extent = */ {/* .width = */ static_cast<uint32_t>(gltf_image.width),
-		                     /* .height = */ static_cast<uint32_t>(gltf_image.height),
-		                     /* .depth = */ 1u}};
-		std::vector<sg::Mipmap> mipmaps{mipmap};
-		image = std::make_unique<sg::Image>(gltf_image.name, std::move(gltf_image.image), std::move(mipmaps));
-	}
-	else
-	{
-		// Load image from uri
-		auto image_uri = model_path + "/" + gltf_image.uri;
-		image          = sg::Image::load(gltf_image.name, image_uri, vkb::sg::Image::Unknown);
-	}
-
-	// Check whether the format is supported by the GPU
-	if (sg::is_astc(image->get_format()))
-	{
-		if (!device.is_image_format_supported(image->get_format()))
-		{
-			LOGW("ASTC not supported: decoding {}", image->get_name());
-			image = std::make_unique<sg::Astc>(*image);
-			image->generate_mipmaps();
-		}
-	}
-
-	image->create_vk_image(device);
-
-	return image;
+	return load_image(device, gltf_image.name, std::move(gltf_image.image), gltf_image.width, gltf_image.height, model_path + "/" + gltf_image.uri, file_data);
 }
 
 std::unique_ptr<sg::Sampler> GLTFLoader::parse_sampler(const tinygltf::Sampler &gltf_sampler) const
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  * Copyright (c) 2019-2024, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -20,12 +20,17 @@
 
 #include <memory>
 #include <mutex>
+#include <span>
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
 #define TINYGLTF_NO_EXTERNAL_IMAGE
 #include <tiny_gltf.h>
 
+#include "core/util/hash.hpp"
+#include "geometry/meshlet_builder.h"
+#include "scene_cache.h"
+#include "scene_load_options.h"
 #include "timer.h"
 
 #include "vulkan/vulkan.h"
@@ -83,6 +88,49 @@ class GLTFLoader
 	 */
 	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
+	/**
+	 * @brief Packs the mesh data of the scenes loaded next into a few large device local buffers,
+	 *        instead of creating host visible buffers for every primitive attribute and index set.
+	 *        The packed data is only available through SubMesh::get_vertex_buffer and SubMesh::get_index_buffer.
+	 */
+	void set_mesh_arenas(bool enabled);
+
+	/**
+	 * @brief Sets the vertex data layout of the scenes loaded next. Interleaved attributes share a SubMesh::shared_vertex_buffers
+	 *        range, only attributes stored in their own buffer are found in SubMesh::vertex_buffers.
+	 */
+	void set_vertex_layout(VertexLayout layout);
+
+	/**
+	 * @brief Reorders the index and vertex data of the triangle lists of the scenes loaded next for the post-transform
+	 *        vertex cache, overdraw and vertex fetch. The result is persisted, so a mesh is only optimized on its first load.
+	 */
+	void set_mesh_optimization(bool enabled);
+
+	/**
+	 * @brief Splits the triangle lists of the scenes loaded next into meshlets, with their culling bounds. The meshlets are
+	 *        uploaded to the SubMesh::meshlet_buffers storage buffers, in the layout described by MeshletData.
+	 */
+	void set_meshlet_generation(bool enabled, const MeshletLimits &limits = {});
+
+	/**
+	 * @brief Stores the scenes loaded next in the temporary directory once processed, and builds later loads of the same
+	 *        unchanged source files with the same options from the stored entry, without parsing the glTF file.
+	 *        Scenes loaded with texture streaming are not cached, as their images are decoded from their files.
+	 */
+	void set_scene_cache(bool enabled);
+
+	/**
+	 * @brief Streams the images of the scenes loaded next in while they are rendered. Textures are bound to placeholder
+	 *        images until their image is decoded and uploaded, by the sg::TextureStreamer script added to the scene.
+	 */
+	void set_texture_streaming(bool enabled);
+
+	/**
+	 * @brief Sets every option of a SceneLoadOptions at once, for the scenes loaded next
+	 */
+	void set_options(const SceneLoadOptions &options);
+
   protected:
 	virtual std::unique_ptr<sg::Node> parse_node(const tinygltf::Node &gltf_node, size_t index) const;
 
@@ -92,7 +140,12 @@ class GLTFLoader
 
 	virtual std::unique_ptr<sg::PBRMaterial> parse_material(const tinygltf::Material &gltf_material) const;
 
-	virtual std::unique_ptr<sg::Image> parse_image(tinygltf::Image &gltf_image) const;
+	/**
+	 * @brief Decodes an image of the model
+	 * @param gltf_image The image, its pixels are moved from it if it is embedded in the glTF file
+	 * @param file_data The content of the image file, empty for an embedded image
+	 */
+	virtual std::unique_ptr<sg::Image> parse_image(tinygltf::Image &gltf_image, std::span<const uint8_t> file_data) const;
 
 	virtual std::unique_ptr<sg::Sampler> parse_sampler(const tinygltf::Sampler &gltf_sampler) const;
 
@@ -133,9 +186,47 @@ class GLTFLoader
 	/// The extensions that the GLTFLoader can load mapped to whether they should be enabled or not
 	static std::unordered_map<std::string, bool> supported_extensions;
 
+	bool mesh_arenas{false};
+
+	VertexLayout vertex_layout{VertexLayout::Separate};
+
+	bool mesh_optimization{false};
+
+	bool meshlet_generation{false};
+
+	MeshletLimits meshlet_limits;
+
+	bool scene_cache{false};
+
+	bool texture_streaming{false};
+
   private:
-	sg::Scene load_scene(int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
+	/**
+	 * @brief Parses a glTF file into the model, and sets the model path
+	 * @param file_name The path of the glTF file, relative to the assets directory
+	 * @return False if the file could not be parsed, the error is logged
+	 */
+	bool load_gltf_file(const std::string &file_name);
+
+	/**
+	 * @brief Builds a scene from the model
+	 * @param scene_cache_key The key the processed scene is stored with on a scene cache miss, nullptr to not store it
+	 * @param scene_data On a scene cache hit, the cached data the scene is built from, with the model read from the same entry.
+	 *                   Otherwise the data stored in the scene cache, of which the sources are set by the caller.
+	 */
+	sg::Scene load_scene(int scene_index, VkBufferUsageFlags additional_buffer_usage_flags, const Hash128 *scene_cache_key, SceneCache::Entry &scene_data);
+
+	/**
+	 * @brief Computes the scene cache key of a glTF file, from its path, size and last write time and the loader options
+	 * @param file_name The path of the glTF file, relative to the assets directory
+	 */
+	Hash128 get_scene_cache_key(const std::string &file_name) const;
+
+	/// Whether the last scene was read from the scene cache
+	bool scene_cache_hit{false};
 
 	std::unique_ptr<sg::SubMesh> load_model(uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
+
+	void upload_meshlets(sg::SubMesh &submesh, const MeshletData &meshlets);
 };
 }        // namespace vkb
@@ -457,14 +457,13 @@ vkb::BufferAllocationC Gui::update_buffers(vkb::core::CommandBufferC &command_bu
 		return vkb::BufferAllocationC{};
 	}
 
-	std::vector<uint8_t> vertex_data(vertex_buffer_size);
-	std::vector<uint8_t> index_data(index_buffer_size);
-
-	upload_draw_data(draw_data, vertex_data.data(), index_data.data());
-
 	auto vertex_allocation = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertex_buffer_size);
+	auto index_allocation  = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, index_buffer_size);
+
+	upload_draw_data(draw_data, vertex_allocation.map<uint8_t>(vertex_buffer_size).data(), index_allocation.map<uint8_t>(index_buffer_size).data());
 
-	vertex_allocation.update(vertex_data);
+	vertex_allocation.flush();
+	index_allocation.flush();
 
 	std::vector<std::reference_wrapper<const vkb::core::BufferC>> buffers;
 	buffers.emplace_back(std::ref(vertex_allocation.get_buffer()));
@@ -473,10 +472,6 @@ vkb::BufferAllocationC Gui::update_buffers(vkb::core::CommandBufferC &command_bu
 
 	command_buffer.bind_vertex_buffers(0, buffers, offsets);
 
-	auto index_allocation = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, index_buffer_size);
-
-	index_allocation.update(index_data);
-
 	command_buffer.bind_index_buffer(index_allocation.get_buffer(), index_allocation.get_offset(), VK_INDEX_TYPE_UINT16);
 
 	return vertex_allocation;
@@ -1,4 +1,4 @@
-/* Copyright (c) 2021-2024, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2021-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -48,5 +48,19 @@ class HPPGLTFLoader : private vkb::GLTFLoader
 	{
 		return std::unique_ptr<vkb::scene_graph::HPPScene>(reinterpret_cast<vkb::scene_graph::HPPScene *>(vkb::GLTFLoader::read_scene_from_file(file_name, scene_index).release()));
 	}
+
+	using vkb::GLTFLoader::set_mesh_arenas;
+
+	using vkb::GLTFLoader::set_vertex_layout;
+
+	using vkb::GLTFLoader::set_mesh_optimization;
+
+	using vkb::GLTFLoader::set_meshlet_generation;
+
+	using vkb::GLTFLoader::set_scene_cache;
+
+	using vkb::GLTFLoader::set_texture_streaming;
+
+	using vkb::GLTFLoader::set_options;
 };
 }        // namespace vkb
@@ -425,24 +425,19 @@ vkb::BufferAllocationCpp HPPGui::update_buffers(vkb::core::CommandBufferCpp &com
 	size_t vertex_buffer_size = draw_data->TotalVtxCount * sizeof(ImDrawVert);
 	size_t index_buffer_size  = draw_data->TotalIdxCount * sizeof(ImDrawIdx);
 
-	std::vector<uint8_t> vertex_data(vertex_buffer_size);
-	std::vector<uint8_t> index_data(index_buffer_size);
-
-	upload_draw_data(draw_data, vertex_data.data(), index_data.data());
-
 	auto vertex_allocation = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eVertexBuffer, vertex_buffer_size);
+	auto index_allocation  = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eIndexBuffer, index_buffer_size);
+
+	upload_draw_data(draw_data, vertex_allocation.map<uint8_t>(vertex_buffer_size).data(), index_allocation.map<uint8_t>(index_buffer_size).data());
 
-	vertex_allocation.update(vertex_data);
+	vertex_allocation.flush();
+	index_allocation.flush();
 
 	std::vector<std::reference_wrapper<const vkb::core::BufferCpp>> buffers;
 	buffers.emplace_back(std::ref(vertex_allocation.get_buffer()));
 
 	command_buffer.bind_vertex_buffers(0, buffers, {vertex_allocation.get_offset()});
 
-	auto index_allocation = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eIndexBuffer, index_buffer_size);
-
-	index_allocation.update(index_data);
-
 	command_buffer.bind_index_buffer(index_allocation.get_buffer(), index_allocation.get_offset(), vk::IndexType::eUint16);
 
 	return vertex_allocation;
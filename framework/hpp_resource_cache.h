@@ -1,4 +1,4 @@
-/* Copyright (c) 2022-2023, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2022-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,8 +21,8 @@
 #include <core/hpp_framebuffer.h>
 #include <core/hpp_pipeline_layout.h>
 #include <core/hpp_render_pass.h>
-#include <hpp_resource_record.h>
-#include <hpp_resource_replay.h>
+#include <core/util/hash.hpp>
+#include <resource_cache.h>
 #include <vulkan/vulkan.hpp>
 
 namespace vkb
@@ -45,25 +45,37 @@ class HPPRenderTarget;
  */
 struct HPPResourceCacheState
 {
-	std::unordered_map<std::size_t, vkb::core::HPPShaderModule>        shader_modules;
-	std::unordered_map<std::size_t, vkb::core::HPPPipelineLayout>      pipeline_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>      descriptor_pools;
-	std::unordered_map<std::size_t, vkb::core::HPPRenderPass>          render_passes;
-	std::unordered_map<std::size_t, vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPComputePipeline>     compute_pipelines;
-	std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>       descriptor_sets;
-	std::unordered_map<std::size_t, vkb::core::HPPFramebuffer>         framebuffers;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPShaderModule>        shader_modules;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPPipelineLayout>      pipeline_layouts;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPDescriptorSetLayout> descriptor_set_layouts;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPDescriptorPool>      descriptor_pools;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPRenderPass>          render_passes;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPGraphicsPipeline>    graphics_pipelines;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPComputePipeline>     compute_pipelines;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPDescriptorSet>       descriptor_sets;
+	std::unordered_map<vkb::Hash128, vkb::core::HPPFramebuffer>         framebuffers;
 };
 
 /**
- * @brief vulkan.hpp version of the vkb::ResourceCache class
+ * @brief facade class around vkb::ResourceCache, providing a vulkan.hpp-based interface
  *
  * See vkb::ResourceCache for documentation
  */
-class HPPResourceCache
+class HPPResourceCache : private vkb::ResourceCache
 {
   public:
+	using vkb::ResourceCache::begin_frame;
+	using vkb::ResourceCache::clear;
+	using vkb::ResourceCache::clear_framebuffers;
+	using vkb::ResourceCache::clear_pipelines;
+	using vkb::ResourceCache::get_descriptor_set_update_stats;
+	using vkb::ResourceCache::get_stats;
+	using vkb::ResourceCache::get_warmup_stats;
+	using vkb::ResourceCache::release_frame;
+	using vkb::ResourceCache::serialize;
+	using vkb::ResourceCache::set_budget;
+	using vkb::ResourceCache::warmup;
+
 	HPPResourceCache(vkb::core::HPPDevice &device);
 
 	HPPResourceCache(const HPPResourceCache &)            = delete;
@@ -71,9 +83,6 @@ class HPPResourceCache
 	HPPResourceCache &operator=(const HPPResourceCache &) = delete;
 	HPPResourceCache &operator=(HPPResourceCache &&)      = delete;
 
-	void                               clear();
-	void                               clear_framebuffers();
-	void                               clear_pipelines();
 	const HPPResourceCacheState       &get_internal_state() const;
 	vkb::core::HPPComputePipeline     &request_compute_pipeline(vkb::rendering::HPPPipelineState &pipeline_state);
 	vkb::core::HPPDescriptorSet       &request_descriptor_set(vkb::core::HPPDescriptorSetLayout          &descriptor_set_layout,
@@ -90,29 +99,11 @@ class HPPResourceCache
 	                                                       const std::vector<vkb::core::HPPSubpassInfo>     &subpasses);
 	vkb::core::HPPShaderModule        &request_shader_module(
 	           vk::ShaderStageFlagBits stage, const vkb::core::HPPShaderSource &glsl_source, const vkb::core::HPPShaderVariant &shader_variant = {});
-	std::vector<uint8_t> serialize();
-	void                 set_pipeline_cache(vk::PipelineCache pipeline_cache);
+	void set_pipeline_cache(vk::PipelineCache pipeline_cache);
 
 	/// @brief Update those descriptor sets referring to old views
 	/// @param old_views Old image views referred by descriptor sets
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<vkb::core::HPPImageView> &old_views, const std::vector<vkb::core::HPPImageView> &new_views);
-
-	void warmup(const std::vector<uint8_t> &data);
-
-  private:
-	vkb::core::HPPDevice  &device;
-	vkb::HPPResourceRecord recorder                    = {};
-	vkb::HPPResourceReplay replayer                    = {};
-	vk::PipelineCache      pipeline_cache              = nullptr;
-	HPPResourceCacheState  state                       = {};
-	std::mutex             descriptor_set_mutex        = {};
-	std::mutex             pipeline_layout_mutex       = {};
-	std::mutex             shader_module_mutex         = {};
-	std::mutex             descriptor_set_layout_mutex = {};
-	std::mutex             graphics_pipeline_mutex     = {};
-	std::mutex             render_pass_mutex           = {};
-	std::mutex             compute_pipeline_mutex      = {};
-	std::mutex             framebuffer_mutex           = {};
 };
 }        // namespace vkb
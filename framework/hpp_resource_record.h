@@ -1,4 +1,4 @@
-/* Copyright (c) 2023, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -34,11 +34,13 @@ struct HPPAttachment;
 
 namespace core
 {
+class HPPDescriptorSetLayout;
 class HPPPipelineLayout;
 class HPPRenderPass;
 class HPPShaderModule;
 class HPPShaderSource;
 class HPPShaderVariant;
+struct HPPShaderResource;
 struct HPPSubpassInfo;
 }        // namespace core
 
@@ -51,7 +53,27 @@ class HPPResourceRecord : private vkb::ResourceRecord
 {
   public:
 	using vkb::ResourceRecord::get_data;
-	using vkb::ResourceRecord::set_data;
+	using vkb::ResourceRecord::reset;
+
+	void set_device_properties(const vk::PhysicalDeviceProperties &properties)
+	{
+		vkb::ResourceRecord::set_device_properties(static_cast<VkPhysicalDeviceProperties const &>(properties));
+	}
+
+	size_t register_compute_pipeline(vk::PipelineCache pipeline_cache, vkb::rendering::HPPPipelineState &pipeline_state)
+	{
+		return vkb::ResourceRecord::register_compute_pipeline(static_cast<VkPipelineCache>(pipeline_cache),
+		                                                      reinterpret_cast<vkb::PipelineState &>(pipeline_state));
+	}
+
+	size_t register_descriptor_set_layout(const uint32_t                                   set_index,
+	                                      const std::vector<vkb::core::HPPShaderModule *> &shader_modules,
+	                                      const std::vector<vkb::core::HPPShaderResource> &set_resources)
+	{
+		return vkb::ResourceRecord::register_descriptor_set_layout(set_index,
+		                                                           reinterpret_cast<std::vector<vkb::ShaderModule *> const &>(shader_modules),
+		                                                           reinterpret_cast<std::vector<vkb::ShaderResource> const &>(set_resources));
+	}
 
 	size_t register_graphics_pipeline(vk::PipelineCache pipeline_cache, vkb::rendering::HPPPipelineState &pipeline_state)
 	{
@@ -84,6 +106,16 @@ class HPPResourceRecord : private vkb::ResourceRecord
 		                                                   reinterpret_cast<vkb::ShaderVariant const &>(shader_variant));
 	}
 
+	void set_compute_pipeline(size_t index, const vkb::core::HPPComputePipeline &compute_pipeline)
+	{
+		vkb::ResourceRecord::set_compute_pipeline(index, reinterpret_cast<vkb::ComputePipeline const &>(compute_pipeline));
+	}
+
+	void set_descriptor_set_layout(size_t index, const vkb::core::HPPDescriptorSetLayout &descriptor_set_layout)
+	{
+		vkb::ResourceRecord::set_descriptor_set_layout(index, reinterpret_cast<vkb::DescriptorSetLayout const &>(descriptor_set_layout));
+	}
+
 	void set_graphics_pipeline(size_t index, const vkb::core::HPPGraphicsPipeline &graphics_pipeline)
 	{
 		vkb::ResourceRecord::set_graphics_pipeline(index, reinterpret_cast<vkb::GraphicsPipeline const &>(graphics_pipeline));
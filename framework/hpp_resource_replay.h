@@ -1,4 +1,4 @@
-/* Copyright (c) 2023, NVIDIA CORPORATION. All rights reserved.
+/* Copyright (c) 2023-2025, NVIDIA CORPORATION. All rights reserved.
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -22,7 +22,6 @@
 namespace vkb
 {
 class HPPResourceCache;
-class HPPResourceRecord;
 
 /**
  * @brief facade class around vkb::ResourceReplay, providing a vulkan.hpp-based interface
@@ -32,9 +31,16 @@ class HPPResourceRecord;
 class HPPResourceReplay : private vkb::ResourceReplay
 {
   public:
-	void play(vkb::HPPResourceCache &resource_cache, vkb::HPPResourceRecord &recorder)
+	using vkb::ResourceReplay::get_stats;
+
+	void set_device_properties(const vk::PhysicalDeviceProperties &properties)
+	{
+		vkb::ResourceReplay::set_device_properties(static_cast<VkPhysicalDeviceProperties const &>(properties));
+	}
+
+	void play(vkb::HPPResourceCache &resource_cache, const std::vector<uint8_t> &data, uint32_t thread_count = 0)
 	{
-		vkb::ResourceReplay::play(reinterpret_cast<vkb::ResourceCache &>(resource_cache), reinterpret_cast<vkb::ResourceRecord &>(recorder));
+		vkb::ResourceReplay::play(reinterpret_cast<vkb::ResourceCache &>(resource_cache), data, thread_count);
 	}
 };
 }        // namespace vkb
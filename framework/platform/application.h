@@ -23,6 +23,7 @@
 #include "drawer.h"
 #include "platform/configuration.h"
 #include "platform/input_events.h"
+#include "scene_load_options.h"
 #include "timer.h"
 
 namespace vkb
@@ -31,8 +32,9 @@ class Window;
 
 struct ApplicationOptions
 {
-	bool    benchmark_enabled{false};
-	Window *window{nullptr};
+	bool             benchmark_enabled{false};
+	Window          *window{nullptr};
+	SceneLoadOptions scene_load_options;
 };
 
 class Application
@@ -414,6 +414,11 @@ void Platform::set_window_properties(const Window::OptionalProperties &propertie
 	window_properties.extent.height = properties.extent.height.has_value() ? properties.extent.height.value() : window_properties.extent.height;
 }
 
+SceneLoadOptions &Platform::get_mutable_scene_load_options()
+{
+	return scene_load_options;
+}
+
 std::string &Platform::get_last_error()
 {
 	return last_error;
@@ -487,7 +492,7 @@ bool Platform::start_app()
 	auto sample_info = static_cast<const apps::SampleInfo *>(requested_app_info);
 	active_app->set_name(sample_info->name);
 
-	if (!active_app->prepare({false, window.get()}))
+	if (!active_app->prepare({false, window.get(), scene_load_options}))
 	{
 		LOGE("Failed to prepare vulkan app.");
 		return false;
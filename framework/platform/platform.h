@@ -130,6 +130,11 @@ class Platform
 
 	void set_window_properties(const Window::OptionalProperties &properties);
 
+	/**
+	 * @brief The options of the scenes loaded by the applications started next, set by the scene loading plugin
+	 */
+	SceneLoadOptions &get_mutable_scene_load_options();
+
 	void on_post_draw(RenderContext &context);
 
 	static const uint32_t MIN_WINDOW_WIDTH;
@@ -163,6 +168,7 @@ class Platform
 	void on_update_ui_overlay(vkb::Drawer &drawer);
 
 	Window::Properties window_properties;              /* Source of truth for window state */
+	SceneLoadOptions   scene_load_options;             /* Passed to every app in its ApplicationOptions */
 	bool               fixed_simulation_fps{false};    /* Delta time should be fixed with a fabricated value */
 	bool               always_render{false};           /* App should always render even if not in focus */
 	float              simulation_frame_time = 0.016f; /* A fabricated delta time */
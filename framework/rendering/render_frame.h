@@ -18,11 +18,13 @@
 #pragma once
 
 #include "buffer_pool.h"
+#include "common/cache_counters.h"
 #include "common/hpp_resource_caching.h"
 #include "core/command_pool.h"
 #include "core/hpp_queue.h"
 #include "core/queue.h"
 #include "hpp_semaphore_pool.h"
+#include "timer.h"
 
 namespace vkb
 {
@@ -31,7 +33,9 @@ namespace rendering
 enum BufferAllocationStrategy
 {
 	OneAllocationPerBuffer,
-	MultipleAllocationsPerBuffer
+	MultipleAllocationsPerBuffer,
+	OneBufferPerFrame,                        // A single BufferArena per usage and thread, sized from its high-water marks
+	MultipleAllocationsPerSharedBuffer        // Blocks per usage shared by all threads, allocate_buffer is then thread-safe
 };
 
 enum DescriptorManagementStrategy
@@ -108,6 +112,9 @@ class RenderFrame
 	RenderTargetType const  &get_render_target() const;
 	SemaphorePoolType       &get_semaphore_pool();
 	SemaphorePoolType const &get_semaphore_pool() const;
+	vkb::CacheStats          get_descriptor_pool_stats() const;
+	vkb::CacheStats          get_descriptor_set_stats() const;
+	DeviceSizeType           get_buffer_memory_size() const;
 	DescriptorSetType        request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
 	                                                BindingMap<DescriptorBufferInfoType> const &buffer_infos,
 	                                                BindingMap<DescriptorImageInfoType> const  &image_infos,
@@ -151,6 +158,12 @@ class RenderFrame
 	 */
 	std::vector<vkb::core::CommandPoolCpp> &get_command_pools(const vkb::core::HPPQueue &queue, vkb::CommandBufferResetMode reset_mode);
 
+	/**
+	 * @brief Requests an object from one of the per-frame caches, only misses are timed
+	 */
+	template <class T, class... A>
+	T &request_frame_resource(vkb::CacheCounters &counters, std::unordered_map<vkb::Hash128, T> &resources, A &...args);
+
 	vk::DescriptorSet request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
 	                                              BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
 	                                              BindingMap<vk::DescriptorImageInfo> const  &image_infos,
@@ -160,15 +173,20 @@ class RenderFrame
   private:
 	vkb::core::HPPDevice                                                                             &device;
 	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
-	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;           // Commands pools per queue family index
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;        // Descriptor pools per thread
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;         // Descriptor sets per thread
+	std::map<vk::BufferUsageFlags, std::vector<vkb::BufferArenaCpp>>                                  buffer_arenas;              // Buffer arenas per usage per thread, only used by OneBufferPerFrame
+	std::map<vk::BufferUsageFlags, vkb::SharedBufferPoolCpp>                                          shared_buffer_pools;        // Only used by MultipleAllocationsPerSharedBuffer
+	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;              // Commands pools per queue family index
+	std::vector<std::unordered_map<vkb::Hash128, vkb::core::HPPDescriptorPool>>                       descriptor_pools;           // Descriptor pools per thread
+	std::vector<std::unordered_map<vkb::Hash128, vkb::core::HPPDescriptorSet>>                        descriptor_sets;            // Descriptor sets per thread
 	vkb::HPPFencePool                                                                                 fence_pool;
 	vkb::HPPSemaphorePool                                                                             semaphore_pool;
 	std::unique_ptr<vkb::rendering::HPPRenderTarget>                                                  swapchain_render_target;
 	size_t                                                                                            thread_count;
 	BufferAllocationStrategy                                                                          buffer_allocation_strategy     = BufferAllocationStrategy::MultipleAllocationsPerBuffer;
 	DescriptorManagementStrategy                                                                      descriptor_management_strategy = DescriptorManagementStrategy::StoreInCache;
+	uint64_t                                                                                          resource_cache_frame           = 0;        // Resource cache frame this frame was last started as
+	vkb::CacheCounters                                                                                descriptor_pool_counters;
+	vkb::CacheCounters                                                                                descriptor_set_counters;
 };
 
 using RenderFrameC   = RenderFrame<vkb::BindingType::C>;
@@ -196,10 +214,18 @@ inline RenderFrame<bindingType>::RenderFrame(DeviceType &device_, std::unique_pt
 			throw std::runtime_error("Failed to insert buffer pool");
 		}
 
+		auto &buffer_arenas_per_thread = buffer_arenas[usage_it.first];
+
+		// Shared pools only create blocks on first use
+		shared_buffer_pools.try_emplace(usage_it.first, device, BUFFER_POOL_BLOCK_SIZE * 1024 * usage_it.second, usage_it.first);
+
 		for (size_t i = 0; i < thread_count; ++i)
 		{
 			buffer_pools_it->second.push_back(
 			    std::make_pair(vkb::BufferPoolCpp{device, BUFFER_POOL_BLOCK_SIZE * 1024 * usage_it.second, usage_it.first}, nullptr));
+
+			// Arenas only create their buffer on first use
+			buffer_arenas_per_thread.emplace_back(device, BUFFER_POOL_BLOCK_SIZE * 1024 * usage_it.second, usage_it.first);
 		}
 	}
 }
@@ -232,10 +258,26 @@ inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_buffer_impl(v
 		return vkb::BufferAllocationCpp{};
 	}
 
+	if (buffer_allocation_strategy == BufferAllocationStrategy::MultipleAllocationsPerSharedBuffer)
+	{
+		return shared_buffer_pools.at(usage).allocate(size);
+	}
+
 	assert(thread_index < buffer_pool_it->second.size());
 	auto &buffer_pool  = buffer_pool_it->second[thread_index].first;
 	auto &buffer_block = buffer_pool_it->second[thread_index].second;
 
+	if (buffer_allocation_strategy == BufferAllocationStrategy::OneBufferPerFrame)
+	{
+		auto allocation = buffer_arenas.at(usage)[thread_index].allocate(size);
+		if (!allocation.empty())
+		{
+			return allocation;
+		}
+
+		// The arena grows on the next reset, until then the allocation falls back to the buffer pool
+	}
+
 	bool want_minimal_block = (buffer_allocation_strategy == BufferAllocationStrategy::OneAllocationPerBuffer);
 
 	if (want_minimal_block || !buffer_block || !buffer_block->can_allocate(size))
@@ -423,6 +465,57 @@ inline typename RenderFrame<bindingType>::SemaphorePoolType const &RenderFrame<b
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline vkb::CacheStats RenderFrame<bindingType>::get_descriptor_pool_stats() const
+{
+	return descriptor_pool_counters.get_stats();
+}
+
+template <vkb::BindingType bindingType>
+inline vkb::CacheStats RenderFrame<bindingType>::get_descriptor_set_stats() const
+{
+	return descriptor_set_counters.get_stats();
+}
+
+template <vkb::BindingType bindingType>
+inline typename RenderFrame<bindingType>::DeviceSizeType RenderFrame<bindingType>::get_buffer_memory_size() const
+{
+	// Only the blocks of the current buffer allocation strategy are counted
+	vk::DeviceSize total_size = 0;
+
+	if (buffer_allocation_strategy == BufferAllocationStrategy::MultipleAllocationsPerSharedBuffer)
+	{
+		for (auto &shared_buffer_pool : shared_buffer_pools)
+		{
+			total_size += shared_buffer_pool.second.get_size();
+		}
+
+		return static_cast<DeviceSizeType>(total_size);
+	}
+
+	// The other strategies use the per-thread pools, OneBufferPerFrame only when an arena overflows
+	for (auto &buffer_pools_per_usage : buffer_pools)
+	{
+		for (auto &buffer_pool : buffer_pools_per_usage.second)
+		{
+			total_size += buffer_pool.first.get_size();
+		}
+	}
+
+	if (buffer_allocation_strategy == BufferAllocationStrategy::OneBufferPerFrame)
+	{
+		for (auto &buffer_arenas_per_usage : buffer_arenas)
+		{
+			for (auto &buffer_arena : buffer_arenas_per_usage.second)
+			{
+				total_size += buffer_arena.get_size();
+			}
+		}
+	}
+
+	return static_cast<DeviceSizeType>(total_size);
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingType>::request_descriptor_set(DescriptorSetLayoutType const              &descriptor_set_layout,
                                                                                                              BindingMap<DescriptorBufferInfoType> const &buffer_infos,
@@ -447,6 +540,29 @@ inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingT
 	}
 }
 
+template <vkb::BindingType bindingType>
+template <class T, class... A>
+inline T &RenderFrame<bindingType>::request_frame_resource(vkb::CacheCounters &counters, std::unordered_map<vkb::Hash128, T> &resources, A &...args)
+{
+	auto res_it = resources.find(vkb::common::hash_params(args...));
+	if (res_it != resources.end())
+	{
+		counters.hit();
+		return res_it->second;
+	}
+
+	counters.miss();
+
+	vkb::Timer timer;
+	timer.start();
+
+	auto &resource = vkb::common::request_resource(device, nullptr, resources, args...);
+
+	counters.created(timer.stop<vkb::Timer::Milliseconds>());
+
+	return resource;
+}
+
 template <vkb::BindingType bindingType>
 inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(vkb::core::HPPDescriptorSetLayout const    &descriptor_set_layout,
                                                                                BindingMap<vk::DescriptorBufferInfo> const &buffer_infos,
@@ -454,7 +570,7 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
                                                                                bool                                        update_after_bind,
                                                                                size_t                                      thread_index)
 {
-	auto &descriptor_pool = vkb::common::request_resource(device, nullptr, descriptor_pools[thread_index], descriptor_set_layout);
+	auto &descriptor_pool = request_frame_resource(descriptor_pool_counters, descriptor_pools[thread_index], descriptor_set_layout);
 	if (descriptor_management_strategy == DescriptorManagementStrategy::StoreInCache)
 	{
 		// The bindings we want to update before binding, if empty we update all bindings
@@ -478,15 +594,23 @@ inline vk::DescriptorSet RenderFrame<bindingType>::request_descriptor_set_impl(v
 		// Request a descriptor set from the render frame, and write the buffer infos and image infos of all the specified bindings
 		assert(thread_index < descriptor_sets.size());
 		auto &descriptor_set =
-		    vkb::common::request_resource(device, nullptr, descriptor_sets[thread_index], descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+		    request_frame_resource(descriptor_set_counters, descriptor_sets[thread_index], descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
 		descriptor_set.update({bindings_to_update.begin(), bindings_to_update.end()});
 		return descriptor_set.get_handle();
 	}
 	else
 	{
 		// Request a descriptor pool, allocate a descriptor set, write buffer and image data to it
+		descriptor_set_counters.miss();
+
+		vkb::Timer timer;
+		timer.start();
+
 		vkb::core::HPPDescriptorSet descriptor_set{device, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos};
 		descriptor_set.apply_writes();
+
+		descriptor_set_counters.created(timer.stop<vkb::Timer::Milliseconds>());
+
 		return descriptor_set.get_handle();
 	}
 }
@@ -498,6 +622,11 @@ inline void RenderFrame<bindingType>::reset()
 
 	fence_pool.reset();
 
+	// Cached objects last requested in the previous use of this frame are no longer in use by the GPU
+	auto &resource_cache = device.get_resource_cache();
+	resource_cache.release_frame(resource_cache_frame);
+	resource_cache_frame = resource_cache.begin_frame();
+
 	for (auto &command_pools_per_queue : command_pools)
 	{
 		for (auto &command_pool : command_pools_per_queue.second)
@@ -515,6 +644,19 @@ inline void RenderFrame<bindingType>::reset()
 		}
 	}
 
+	for (auto &buffer_arenas_per_usage : buffer_arenas)
+	{
+		for (auto &buffer_arena : buffer_arenas_per_usage.second)
+		{
+			buffer_arena.reset();
+		}
+	}
+
+	for (auto &shared_buffer_pool : shared_buffer_pools)
+	{
+		shared_buffer_pool.second.reset();
+	}
+
 	semaphore_pool.reset();
 
 	if (descriptor_management_strategy == DescriptorManagementStrategy::CreateDirectly)
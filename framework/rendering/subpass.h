@@ -349,15 +349,16 @@ void Subpass<bindingType>::allocate_lights(const std::vector<sg::Light *> &scene
 		}
 	}
 
-	T light_info;
+	auto &render_frame          = render_context.get_active_frame();
+	lighting_state.light_buffer = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eUniformBuffer, sizeof(T));
+
+	auto &light_info = lighting_state.light_buffer.template map<T>()[0];
 
 	std::copy(lighting_state.directional_lights.begin(), lighting_state.directional_lights.end(), light_info.directional_lights);
 	std::copy(lighting_state.point_lights.begin(), lighting_state.point_lights.end(), light_info.point_lights);
 	std::copy(lighting_state.spot_lights.begin(), lighting_state.spot_lights.end(), light_info.spot_lights);
 
-	auto &render_frame          = render_context.get_active_frame();
-	lighting_state.light_buffer = render_frame.allocate_buffer(vk::BufferUsageFlagBits::eUniformBuffer, sizeof(T));
-	lighting_state.light_buffer.update(light_info);
+	lighting_state.light_buffer.flush();
 }
 
 template <vkb::BindingType bindingType>
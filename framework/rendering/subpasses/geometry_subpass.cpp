@@ -16,6 +16,10 @@
  */
 
 #include "rendering/subpasses/geometry_subpass.h"
+
+#include <algorithm>
+#include <map>
+
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "rendering/render_context.h"
@@ -27,6 +31,7 @@
 #include "scene_graph/components/texture.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
+#include "timer.h"
 
 namespace vkb
 {
@@ -46,7 +51,7 @@ void GeometrySubpass::prepare()
 	{
 		for (auto &sub_mesh : mesh->get_submeshes())
 		{
-			auto &variant     = sub_mesh->get_shader_variant();
+			auto &variant     = get_shader_variant(*sub_mesh);
 			auto &vert_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
 			auto &frag_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
 		}
@@ -87,18 +92,31 @@ void GeometrySubpass::get_sorted_nodes(std::multimap<float, std::pair<sg::Node *
 
 void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 {
+	Timer timer;
+	timer.start();
+
 	std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> opaque_nodes;
 	std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> transparent_nodes;
 
 	get_sorted_nodes(opaque_nodes, transparent_nodes);
 
+	object_index = 0;
+
+	if (per_frame_object_data)
+	{
+		update_object_data(command_buffer, opaque_nodes, transparent_nodes);
+	}
+
 	// Draw opaque objects in front-to-back order
 	{
 		ScopedDebugLabel opaque_debug_label{command_buffer, "Opaque objects"};
 
 		for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
 		{
-			update_uniform(command_buffer, *node_it->second.first, thread_index);
+			if (!per_frame_object_data)
+			{
+				update_uniform(command_buffer, *node_it->second.first, thread_index);
+			}
 
 			// Invert the front face if the mesh was flipped
 			const auto &scale      = node_it->second.first->get_transform().get_scale();
@@ -106,6 +124,11 @@ void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 			VkFrontFace front_face = flipped ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
 			draw_submesh(command_buffer, *node_it->second.second, front_face);
+
+			if (per_frame_object_data)
+			{
+				object_index++;
+			}
 		}
 	}
 
@@ -132,34 +155,115 @@ void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 
 		for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
 		{
-			update_uniform(command_buffer, *node_it->second.first, thread_index);
+			if (!per_frame_object_data)
+			{
+				update_uniform(command_buffer, *node_it->second.first, thread_index);
+			}
 
 			draw_submesh(command_buffer, *node_it->second.second);
+
+			if (per_frame_object_data)
+			{
+				object_index++;
+			}
 		}
 	}
+
+	object_index = 0;
+
+	draw_stats.draw_count = to_u32(opaque_nodes.size() + transparent_nodes.size());
+	draw_stats.cpu_time   = timer.stop<Timer::Milliseconds>();
 }
 
 void GeometrySubpass::update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, size_t thread_index)
 {
-	GlobalUniform global_uniform;
-
-	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
-
 	auto &render_frame = get_render_context().get_active_frame();
 
 	auto &transform = node.get_transform();
 
 	auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GlobalUniform), thread_index);
 
+	auto &global_uniform = allocation.map<GlobalUniform>()[0];
+
+	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+
 	global_uniform.model = transform.get_world_matrix();
 
 	global_uniform.camera_position = glm::vec3(glm::inverse(camera.get_view())[3]);
 
-	allocation.update(global_uniform);
+	allocation.flush();
 
 	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 1, 0);
 }
 
+void GeometrySubpass::update_object_data(vkb::core::CommandBufferC                                        &command_buffer,
+                                         const std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &opaque_nodes,
+                                         const std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &transparent_nodes)
+{
+	size_t object_count = opaque_nodes.size() + transparent_nodes.size();
+	if (object_count == 0)
+	{
+		return;
+	}
+
+	auto &render_frame = get_render_context().get_active_frame();
+
+	// The camera data is shared by all the objects, their model matrix is read from the object data instead
+	auto global_allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GlobalUniform), thread_index);
+
+	auto &global_uniform = global_allocation.map<GlobalUniform>()[0];
+
+	global_uniform.camera_view_proj = camera.get_pre_rotation() * vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+
+	global_uniform.model = glm::mat4(1.0f);
+
+	global_uniform.camera_position = glm::vec3(glm::inverse(camera.get_view())[3]);
+
+	global_allocation.flush();
+
+	command_buffer.bind_buffer(global_allocation.get_buffer(), global_allocation.get_offset(), global_allocation.get_size(), 0, 1, 0);
+
+	// Model matrices in the order the objects are drawn in
+	auto object_allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, object_count * sizeof(glm::mat4), thread_index);
+
+	auto models = object_allocation.map<glm::mat4>(object_count);
+
+	size_t index = 0;
+	for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
+	{
+		models[index++] = node_it->second.first->get_transform().get_world_matrix();
+	}
+	for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
+	{
+		models[index++] = node_it->second.first->get_transform().get_world_matrix();
+	}
+
+	object_allocation.flush();
+
+	command_buffer.bind_buffer(object_allocation.get_buffer(), object_allocation.get_offset(), object_allocation.get_size(), 1, 0, 0);
+}
+
+const ShaderVariant &GeometrySubpass::get_shader_variant(sg::SubMesh &sub_mesh)
+{
+	if (!per_frame_object_data)
+	{
+		return sub_mesh.get_shader_variant();
+	}
+
+	auto &sub_mesh_variant = sub_mesh.get_shader_variant();
+
+	auto variant_it = object_data_variants.find(sub_mesh_variant.get_id());
+	if (variant_it == object_data_variants.end())
+	{
+		ShaderVariant variant = sub_mesh_variant;
+		variant.add_define("PER_FRAME_OBJECT_DATA");
+
+		variant_it = object_data_variants.emplace(sub_mesh_variant.get_id(), std::move(variant)).first;
+	}
+
+	return variant_it->second;
+}
+
 void GeometrySubpass::draw_submesh(vkb::core::CommandBufferC &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face)
 {
 	auto &device = command_buffer.get_device();
@@ -172,8 +276,10 @@ void GeometrySubpass::draw_submesh(vkb::core::CommandBufferC &command_buffer, sg
 	multisample_state.rasterization_samples = get_sample_count();
 	command_buffer.set_multisample_state(multisample_state);
 
-	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), sub_mesh.get_shader_variant());
-	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), sub_mesh.get_shader_variant());
+	auto &variant = get_shader_variant(sub_mesh);
+
+	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
 
 	std::vector<ShaderModule *> shader_modules{&vert_shader_module, &frag_shader_module};
 
@@ -200,47 +306,68 @@ void GeometrySubpass::draw_submesh(vkb::core::CommandBufferC &command_buffer, sg
 
 	auto vertex_input_resources = pipeline_layout.get_resources(ShaderResourceType::Input, VK_SHADER_STAGE_VERTEX_BIT);
 
+	// Visit the attributes by location, so that each vertex buffer gets the lowest location reading from it as binding
+	std::sort(vertex_input_resources.begin(), vertex_input_resources.end(),
+	          [](const ShaderResource &a, const ShaderResource &b) { return a.location < b.location; });
+
 	VertexInputState vertex_input_state;
 
+	// Vertex buffers by binding, attributes interleaved in the same buffer range share a binding
+	std::map<uint32_t, std::pair<const vkb::core::BufferC *, VkDeviceSize>> vertex_bindings;
+
 	for (auto &input_resource : vertex_input_resources)
 	{
-		sg::VertexAttribute attribute;
+		sg::VertexAttribute       attribute;
+		const vkb::core::BufferC *buffer = nullptr;
+		VkDeviceSize              offset = 0;
 
-		if (!sub_mesh.get_attribute(input_resource.name, attribute))
+		if (!sub_mesh.get_attribute(input_resource.name, attribute) ||
+		    !sub_mesh.get_vertex_buffer(input_resource.name, buffer, offset))
 		{
 			continue;
 		}
 
+		auto binding_it = std::find_if(vertex_bindings.begin(), vertex_bindings.end(),
+		                               [&](const auto &binding) { return binding.second.first == buffer && binding.second.second == offset; });
+
+		if (binding_it == vertex_bindings.end())
+		{
+			binding_it = vertex_bindings.emplace(input_resource.location, std::make_pair(buffer, offset)).first;
+
+			VkVertexInputBindingDescription vertex_binding{};
+			vertex_binding.binding = input_resource.location;
+			vertex_binding.stride  = attribute.stride;
+
+			vertex_input_state.bindings.push_back(vertex_binding);
+		}
+
 		VkVertexInputAttributeDescription vertex_attribute{};
-		vertex_attribute.binding  = input_resource.location;
+		vertex_attribute.binding  = binding_it->first;
 		vertex_attribute.format   = attribute.format;
 		vertex_attribute.location = input_resource.location;
 		vertex_attribute.offset   = attribute.offset;
 
 		vertex_input_state.attributes.push_back(vertex_attribute);
-
-		VkVertexInputBindingDescription vertex_binding{};
-		vertex_binding.binding = input_resource.location;
-		vertex_binding.stride  = attribute.stride;
-
-		vertex_input_state.bindings.push_back(vertex_binding);
 	}
 
 	command_buffer.set_vertex_input_state(vertex_input_state);
 
-	// Find submesh vertex buffers matching the shader input attribute names
-	for (auto &input_resource : vertex_input_resources)
+	// Bind the vertex buffers with one call per range of consecutive bindings
+	auto binding_it = vertex_bindings.begin();
+	while (binding_it != vertex_bindings.end())
 	{
-		const auto &buffer_iter = sub_mesh.vertex_buffers.find(input_resource.name);
+		uint32_t first_binding = binding_it->first;
 
-		if (buffer_iter != sub_mesh.vertex_buffers.end())
-		{
-			std::vector<std::reference_wrapper<const vkb::core::BufferC>> buffers;
-			buffers.emplace_back(std::ref(buffer_iter->second));
+		std::vector<std::reference_wrapper<const vkb::core::BufferC>> buffers;
+		std::vector<VkDeviceSize>                                     offsets;
 
-			// Bind vertex buffers only for the attribute locations defined
-			command_buffer.bind_vertex_buffers(input_resource.location, std::move(buffers), {0});
+		for (; binding_it != vertex_bindings.end() && binding_it->first == first_binding + buffers.size(); ++binding_it)
+		{
+			buffers.emplace_back(std::cref(*binding_it->second.first));
+			offsets.push_back(binding_it->second.second);
 		}
+
+		command_buffer.bind_vertex_buffers(first_binding, buffers, offsets);
 	}
 
 	draw_submesh_command(command_buffer, sub_mesh);
@@ -302,16 +429,20 @@ void GeometrySubpass::draw_submesh_command(vkb::core::CommandBufferC &command_bu
 	// Draw submesh indexed if indices exists
 	if (sub_mesh.vertex_indices != 0)
 	{
+		const vkb::core::BufferC *index_buffer = nullptr;
+		VkDeviceSize              index_offset = 0;
+		sub_mesh.get_index_buffer(index_buffer, index_offset);
+
 		// Bind index buffer of submesh
-		command_buffer.bind_index_buffer(*sub_mesh.index_buffer, sub_mesh.index_offset, sub_mesh.index_type);
+		command_buffer.bind_index_buffer(*index_buffer, index_offset, sub_mesh.index_type);
 
-		// Draw submesh using indexed data
-		command_buffer.draw_indexed(sub_mesh.vertex_indices, 1, 0, 0, 0);
+		// Draw submesh using indexed data, the first instance selects the object data if it is stored per frame
+		command_buffer.draw_indexed(sub_mesh.vertex_indices, 1, 0, 0, object_index);
 	}
 	else
 	{
 		// Draw submesh using vertices only
-		command_buffer.draw(sub_mesh.vertices_count, 1, 0, 0);
+		command_buffer.draw(sub_mesh.vertices_count, 1, 0, object_index);
 	}
 }
 
@@ -319,4 +450,14 @@ void GeometrySubpass::set_thread_index(uint32_t index)
 {
 	thread_index = index;
 }
+
+void GeometrySubpass::set_per_frame_object_data(bool enabled)
+{
+	per_frame_object_data = enabled;
+}
+
+const GeometrySubpass::DrawStats &GeometrySubpass::get_draw_stats() const
+{
+	return draw_stats;
+}
 }        // namespace vkb
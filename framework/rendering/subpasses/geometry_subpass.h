@@ -95,9 +95,43 @@ class GeometrySubpass : public vkb::rendering::SubpassC
 	 */
 	void set_thread_index(uint32_t index);
 
+	/**
+	 * @brief Selects how the model matrix of each object reaches the vertex shader
+	 * @param enabled If false a GlobalUniform is allocated and bound for every draw.
+	 *        If true the camera data is written once per call to draw, and the model matrices of all the objects
+	 *        are packed in a single storage buffer, indexed by the instance index. The vertex shader must then read
+	 *        them from set 1, binding 0 when PER_FRAME_OBJECT_DATA is defined, as base.vert does.
+	 */
+	void set_per_frame_object_data(bool enabled);
+
+	/**
+	 * @brief Number of objects drawn and CPU time spent recording them by the last call to draw
+	 */
+	struct DrawStats
+	{
+		uint32_t draw_count{0};
+
+		/// In milliseconds
+		double cpu_time{0.0};
+	};
+
+	const DrawStats &get_draw_stats() const;
+
   protected:
 	virtual void update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, size_t thread_index);
 
+	/**
+	 * @brief Writes the camera data and the model matrices of all the objects, in draw order, and binds them
+	 */
+	void update_object_data(vkb::core::CommandBufferC                                        &command_buffer,
+	                        const std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &opaque_nodes,
+	                        const std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &transparent_nodes);
+
+	/**
+	 * @brief The shader variant of a submesh, with PER_FRAME_OBJECT_DATA defined when the object data is stored per frame
+	 */
+	const ShaderVariant &get_shader_variant(sg::SubMesh &sub_mesh);
+
 	void draw_submesh(vkb::core::CommandBufferC &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE);
 
 	virtual void prepare_pipeline_state(vkb::core::CommandBufferC &command_buffer, VkFrontFace front_face, bool double_sided_material);
@@ -125,6 +159,16 @@ class GeometrySubpass : public vkb::rendering::SubpassC
 	uint32_t thread_index{0};
 
 	vkb::RasterizationState base_rasterization_state{};
+
+	bool per_frame_object_data{false};
+
+	/// Index of the current object in the object data, used as the first instance of its draw
+	uint32_t object_index{0};
+
+	/// Variants with PER_FRAME_OBJECT_DATA defined, keyed by the id of the submesh variant they extend
+	std::unordered_map<size_t, ShaderVariant> object_data_variants;
+
+	DrawStats draw_stats;
 };
 
 }        // namespace vkb
@@ -82,8 +82,10 @@ void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 	rasterization_state.cull_mode = VK_CULL_MODE_FRONT_BIT;
 	command_buffer.set_rasterization_state(rasterization_state);
 
-	// Populate uniform values
-	LightUniform light_uniform;
+	// Allocate a buffer using the buffer pool from the active frame and populate the uniform values in place
+	auto &render_frame  = get_render_context().get_active_frame();
+	auto  allocation    = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform));
+	auto &light_uniform = allocation.map<LightUniform>()[0];
 
 	// Inverse resolution
 	light_uniform.inv_resolution.x = 1.0f / render_target.get_extent().width;
@@ -92,10 +94,7 @@ void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 	// Inverse view projection
 	light_uniform.inv_view_proj = glm::inverse(vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view());
 
-	// Allocate a buffer using the buffer pool from the active frame to store uniform values and bind it
-	auto &render_frame = get_render_context().get_active_frame();
-	auto  allocation   = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform));
-	allocation.update(light_uniform);
+	allocation.flush();
 	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 3, 0);
 
 	// Draw full screen triangle triangle
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,32 +19,283 @@
 
 #include "common/resource_caching.h"
 #include "core/device.h"
+#include "timer.h"
 
 namespace vkb
 {
 namespace
 {
+/**
+ * @brief Requests an object whose creation touches shared state, e.g. a descriptor pool.
+ *        Hits only take a shared lock, creation is serialized behind the exclusive lock.
+ */
 template <class T, class... A>
-T &request_resource(Device &device, ResourceRecord &recorder, std::mutex &resource_mutex, std::unordered_map<std::size_t, T> &resources, A &... args)
+T &request_resource(Device &device, ResourceRecord &recorder, std::shared_mutex &resource_mutex, ResourceCacheUsage &usage, uint64_t frame, std::unordered_map<Hash128, T> &resources, A &... args)
 {
-	std::lock_guard<std::mutex> guard(resource_mutex);
+	Hash128 hash = hash_params(args...);
+
+	{
+		std::shared_lock<std::shared_mutex> guard(resource_mutex);
+
+		auto res_it = resources.find(hash);
+
+		if (res_it != resources.end())
+		{
+			usage.hit(hash, frame);
+			return res_it->second;
+		}
+	}
+
+	usage.counters.miss();
+
+	std::lock_guard<std::shared_mutex> guard(resource_mutex);
+
+	size_t resource_count = resources.size();
+
+	Timer timer;
+	timer.start();
 
 	auto &res = request_resource(device, &recorder, resources, args...);
 
+	if (resources.size() != resource_count)
+	{
+		usage.created(hash, frame, timer.stop<Timer::Milliseconds>());
+	}
+	else
+	{
+		usage.touch(hash, frame);
+	}
+
 	return res;
 }
+
+/**
+ * @brief Requests an object that can be built without touching shared state other than the cache.
+ *        Hits only take a shared lock. On a miss the object is built outside of the lock, and the build
+ *        is published as an in-flight future, so that requesters of the same object wait for it instead
+ *        of building it again while requesters of other objects are not blocked.
+ */
+template <class T, class... A>
+T &request_resource_concurrent(Device &device, ResourceRecord &recorder, std::mutex &recorder_mutex, std::shared_mutex &resource_mutex, ResourceCacheUsage &usage, uint64_t frame,
+                               std::unordered_map<Hash128, std::shared_future<void>> &builds, std::unordered_map<Hash128, T> &resources, A &... args)
+{
+	Hash128 hash = hash_params(args...);
+
+	{
+		std::shared_lock<std::shared_mutex> guard(resource_mutex);
+
+		auto res_it = resources.find(hash);
+
+		if (res_it != resources.end())
+		{
+			usage.hit(hash, frame);
+			return res_it->second;
+		}
+	}
+
+	usage.counters.miss();
+
+	std::promise<void>       build_promise;
+	std::shared_future<void> build;
+	bool                     is_builder{false};
+
+	{
+		std::lock_guard<std::shared_mutex> guard(resource_mutex);
+
+		auto res_it = resources.find(hash);
+
+		if (res_it != resources.end())
+		{
+			usage.touch(hash, frame);
+			return res_it->second;
+		}
+
+		auto build_it = builds.find(hash);
+
+		if (build_it != builds.end())
+		{
+			build = build_it->second;
+		}
+		else
+		{
+			build = build_promise.get_future().share();
+			builds.emplace(hash, build);
+			is_builder = true;
+		}
+	}
+
+	if (!is_builder)
+	{
+		// Rethrows if the build failed
+		build.get();
+
+		{
+			std::shared_lock<std::shared_mutex> guard(resource_mutex);
+
+			auto res_it = resources.find(hash);
+
+			if (res_it != resources.end())
+			{
+				usage.touch(hash, frame);
+				return res_it->second;
+			}
+		}
+
+		// The object was evicted before this request could stamp it, build it again
+		return request_resource_concurrent(device, recorder, recorder_mutex, resource_mutex, usage, frame, builds, resources, args...);
+	}
+
+	LOGD("Building cache object ({})", typeid(T).name());
+
+	try
+	{
+		Timer timer;
+		timer.start();
+
+		T resource(device, args...);
+
+		double creation_time = timer.stop<Timer::Milliseconds>();
+
+		std::unique_lock<std::shared_mutex> guard(resource_mutex);
+
+		auto res_ins_it = resources.emplace(hash, std::move(resource));
+
+		builds.erase(hash);
+
+		// Record before the object becomes visible, so that objects depending on it are always recorded after it.
+		// The object may already exist if it was created through a path that does not publish its builds.
+		if (res_ins_it.second)
+		{
+			usage.created(hash, frame, creation_time);
+
+			std::lock_guard<std::mutex> recorder_guard(recorder_mutex);
+
+			if (usage.recorded.insert(hash).second)
+			{
+				RecordHelper<T, A...> record_helper;
+
+				size_t index = record_helper.record(recorder, args...);
+				record_helper.index(recorder, index, res_ins_it.first->second);
+			}
+		}
+
+		guard.unlock();
+
+		build_promise.set_value();
+
+		return res_ins_it.first->second;
+	}
+	catch (...)
+	{
+		{
+			std::lock_guard<std::shared_mutex> guard(resource_mutex);
+			builds.erase(hash);
+		}
+
+		build_promise.set_exception(std::current_exception());
+		throw;
+	}
+}
+
+template <class T>
+size_t get_resource_count(std::shared_mutex &resource_mutex, const std::unordered_map<Hash128, T> &resources)
+{
+	std::shared_lock<std::shared_mutex> guard(resource_mutex);
+
+	return resources.size();
+}
+
+/**
+ * @brief Destroys the least recently used objects beyond the budget of their type.
+ *        Only objects that were not requested after the released frame are candidates, others may still be in use.
+ *        Objects stamped with frame 0 were requested before the first frame began, e.g. while preparing a sample,
+ *        and are kept until they are requested again.
+ */
+template <class T, class P, class F>
+void evict_resources(std::shared_mutex &resource_mutex, ResourceCacheUsage &usage, std::unordered_map<Hash128, T> &resources, uint64_t released_frame, P can_evict, F on_evict)
+{
+	size_t budget = usage.budget.load(std::memory_order_relaxed);
+
+	if (budget == 0)
+	{
+		return;
+	}
+
+	std::lock_guard<std::shared_mutex> guard(resource_mutex);
+
+	if (resources.size() <= budget)
+	{
+		return;
+	}
+
+	std::vector<std::pair<uint64_t, Hash128>> candidates;
+
+	for (auto &stamp : usage.last_used)
+	{
+		uint64_t frame = stamp.second.load(std::memory_order_relaxed);
+
+		if (frame == 0 || frame > released_frame)
+		{
+			continue;
+		}
+
+		auto res_it = resources.find(stamp.first);
+
+		if (res_it != resources.end() && can_evict(res_it->second))
+		{
+			candidates.emplace_back(frame, stamp.first);
+		}
+	}
+
+	size_t eviction_count = std::min(resources.size() - budget, candidates.size());
+
+	std::nth_element(candidates.begin(), candidates.begin() + eviction_count, candidates.end(),
+	                 [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+	for (size_t i = 0; i < eviction_count; ++i)
+	{
+		auto &key = candidates[i].second;
+
+		auto res_it = resources.find(key);
+
+		if (res_it != resources.end())
+		{
+			on_evict(key, res_it->second);
+			resources.erase(res_it);
+			usage.evictions.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		usage.last_used.erase(key);
+	}
+}
 }        // namespace
 
 ResourceCache::ResourceCache(Device &device) :
     device{device}
 {
+	recorder.set_device_properties(device.get_gpu().get_properties());
+	replayer.set_device_properties(device.get_gpu().get_properties());
 }
 
-void ResourceCache::warmup(const std::vector<uint8_t> &data)
+void ResourceCache::warmup(const std::vector<uint8_t> &data, uint32_t thread_count)
 {
-	recorder.set_data(data);
+	{
+		std::lock_guard<std::mutex> recorder_guard(recorder_mutex);
+
+		recorder.reset();
 
-	replayer.play(*this, recorder);
+		for (auto &type_usage : usage)
+		{
+			type_usage.recorded.clear();
+		}
+	}
+
+	replayer.play(*this, data, thread_count);
+}
+
+const ResourceReplayStats &ResourceCache::get_warmup_stats() const
+{
+	return replayer.get_stats();
 }
 
 std::vector<uint8_t> ResourceCache::serialize()
@@ -60,110 +311,173 @@ void ResourceCache::set_pipeline_cache(VkPipelineCache new_pipeline_cache)
 ShaderModule &ResourceCache::request_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const ShaderVariant &shader_variant)
 {
 	std::string entry_point{"main"};
-	return request_resource(device, recorder, shader_module_mutex, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
+	return request_resource_concurrent(device, recorder, recorder_mutex, shader_module_mutex, get_usage(ResourceType::ShaderModule), current_frame, shader_module_builds, state.shader_modules, stage, glsl_source, entry_point, shader_variant);
 }
 
 PipelineLayout &ResourceCache::request_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
-	return request_resource(device, recorder, pipeline_layout_mutex, state.pipeline_layouts, shader_modules);
+	return request_resource_concurrent(device, recorder, recorder_mutex, pipeline_layout_mutex, get_usage(ResourceType::PipelineLayout), current_frame, pipeline_layout_builds, state.pipeline_layouts, shader_modules);
 }
 
 DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const uint32_t                     set_index,
                                                                   const std::vector<ShaderModule *> &shader_modules,
                                                                   const std::vector<ShaderResource> &set_resources)
 {
-	return request_resource(device, recorder, descriptor_set_layout_mutex, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
+	return request_resource_concurrent(device, recorder, recorder_mutex, descriptor_set_layout_mutex, get_usage(ResourceType::DescriptorSetLayout), current_frame, descriptor_set_layout_builds, state.descriptor_set_layouts, set_index, shader_modules, set_resources);
 }
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(PipelineState &pipeline_state)
 {
-	return request_resource(device, recorder, graphics_pipeline_mutex, state.graphics_pipelines, pipeline_cache, pipeline_state);
+	return request_resource_concurrent(device, recorder, recorder_mutex, graphics_pipeline_mutex, get_usage(ResourceType::GraphicsPipeline), current_frame, graphics_pipeline_builds, state.graphics_pipelines, pipeline_cache, pipeline_state);
 }
 
 ComputePipeline &ResourceCache::request_compute_pipeline(PipelineState &pipeline_state)
 {
-	return request_resource(device, recorder, compute_pipeline_mutex, state.compute_pipelines, pipeline_cache, pipeline_state);
+	return request_resource_concurrent(device, recorder, recorder_mutex, compute_pipeline_mutex, get_usage(ResourceType::ComputePipeline), current_frame, compute_pipeline_builds, state.compute_pipelines, pipeline_cache, pipeline_state);
 }
 
 DescriptorSet &ResourceCache::request_descriptor_set(DescriptorSetLayout &descriptor_set_layout, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
 {
-	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, state.descriptor_pools, descriptor_set_layout);
-	return request_resource(device, recorder, descriptor_set_mutex, state.descriptor_sets, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, get_usage(ResourceType::DescriptorPool), current_frame, state.descriptor_pools, descriptor_set_layout);
+
+	Hash128  key   = hash_params(descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+	uint64_t frame = current_frame;
+
+	auto &set_usage = get_usage(ResourceType::DescriptorSet);
+
+	{
+		std::shared_lock<std::shared_mutex> guard(descriptor_set_mutex);
+
+		auto res_it = state.descriptor_sets.find(key);
+
+		if (res_it != state.descriptor_sets.end())
+		{
+			set_usage.hit(key, frame);
+			return res_it->second;
+		}
+	}
+
+	set_usage.counters.miss();
+
+	std::lock_guard<std::shared_mutex> guard(descriptor_set_mutex);
+
+	// Sets can only be evicted from pools created while a budget is set
+	descriptor_pool.set_free_descriptor_sets(set_usage.budget.load(std::memory_order_relaxed) != 0);
+
+	size_t descriptor_set_count = state.descriptor_sets.size();
+
+	Timer timer;
+	timer.start();
+
+	auto &descriptor_set = request_resource(device, &recorder, state.descriptor_sets, descriptor_set_layout, descriptor_pool, buffer_infos, image_infos);
+
+	if (state.descriptor_sets.size() != descriptor_set_count)
+	{
+		set_usage.created(key, frame, timer.stop<Timer::Milliseconds>());
+		index_descriptor_set(key, descriptor_set);
+	}
+	else
+	{
+		set_usage.touch(key, frame);
+	}
+
+	return descriptor_set;
 }
 
 RenderPass &ResourceCache::request_render_pass(const std::vector<Attachment> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
-	return request_resource(device, recorder, render_pass_mutex, state.render_passes, attachments, load_store_infos, subpasses);
+	return request_resource_concurrent(device, recorder, recorder_mutex, render_pass_mutex, get_usage(ResourceType::RenderPass), current_frame, render_pass_builds, state.render_passes, attachments, load_store_infos, subpasses);
 }
 
 Framebuffer &ResourceCache::request_framebuffer(const RenderTarget &render_target, const RenderPass &render_pass)
 {
-	return request_resource(device, recorder, framebuffer_mutex, state.framebuffers, render_target, render_pass);
+	return request_resource(device, recorder, framebuffer_mutex, get_usage(ResourceType::Framebuffer), current_frame, state.framebuffers, render_target, render_pass);
 }
 
 void ResourceCache::clear_pipelines()
 {
 	state.graphics_pipelines.clear();
+	get_usage(ResourceType::GraphicsPipeline).last_used.clear();
 	state.compute_pipelines.clear();
+	get_usage(ResourceType::ComputePipeline).last_used.clear();
 }
 
 void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views)
 {
-	// Find descriptor sets referring to the old image view
-	std::vector<VkWriteDescriptorSet> set_updates;
-	std::set<size_t>                  matches;
+	std::lock_guard<std::shared_mutex> guard(descriptor_set_mutex);
+
+	Timer timer;
+	timer.start();
+
+	// Find descriptor sets referring to the old image views
+	std::unordered_map<VkImageView, VkImageView> view_updates;
+	std::unordered_set<Hash128>                  matches;
 
 	for (size_t i = 0; i < old_views.size(); ++i)
 	{
-		auto &old_view = old_views[i];
-		auto &new_view = new_views[i];
+		view_updates[old_views[i].get_handle()] = new_views[i].get_handle();
+
+		auto index_it = image_view_descriptor_sets.find(old_views[i].get_handle());
 
-		for (auto &kd_pair : state.descriptor_sets)
+		if (index_it != image_view_descriptor_sets.end())
 		{
-			auto &key            = kd_pair.first;
-			auto &descriptor_set = kd_pair.second;
+			matches.insert(index_it->second.begin(), index_it->second.end());
+			image_view_descriptor_sets.erase(index_it);
+		}
+	}
 
-			auto &image_infos = descriptor_set.get_image_infos();
+	std::vector<VkWriteDescriptorSet> set_updates;
+
+	auto &set_usage = get_usage(ResourceType::DescriptorSet);
+
+	for (auto &key : matches)
+	{
+		auto set_it = state.descriptor_sets.find(key);
 
-			for (auto &ba_pair : image_infos)
+		if (set_it == state.descriptor_sets.end())
+		{
+			continue;
+		}
+
+		auto &descriptor_set = set_it->second;
+
+		for (auto &ba_pair : descriptor_set.get_image_infos())
+		{
+			auto &binding = ba_pair.first;
+			auto &array   = ba_pair.second;
+
+			for (auto &ai_pair : array)
 			{
-				auto &binding = ba_pair.first;
-				auto &array   = ba_pair.second;
+				auto &array_element = ai_pair.first;
+				auto &image_info    = ai_pair.second;
+
+				auto view_it = view_updates.find(image_info.imageView);
 
-				for (auto &ai_pair : array)
+				if (view_it == view_updates.end())
 				{
-					auto &array_element = ai_pair.first;
-					auto &image_info    = ai_pair.second;
-
-					if (image_info.imageView == old_view.get_handle())
-					{
-						// Save key to remove old descriptor set
-						matches.insert(key);
-
-						// Update image info with new view
-						image_info.imageView = new_view.get_handle();
-
-						// Save struct for writing the update later
-						{
-							VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
-
-							if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
-							{
-								write_descriptor_set.dstBinding      = binding;
-								write_descriptor_set.descriptorType  = binding_info->descriptorType;
-								write_descriptor_set.pImageInfo      = &image_info;
-								write_descriptor_set.dstSet          = descriptor_set.get_handle();
-								write_descriptor_set.dstArrayElement = array_element;
-								write_descriptor_set.descriptorCount = 1;
-
-								set_updates.push_back(write_descriptor_set);
-							}
-							else
-							{
-								LOGE("Shader layout set does not use image binding at #{}", binding);
-							}
-						}
-					}
+					continue;
+				}
+
+				// Update image info with new view
+				image_info.imageView = view_it->second;
+
+				// Save struct for writing the update later
+				if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
+				{
+					VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+
+					write_descriptor_set.dstBinding      = binding;
+					write_descriptor_set.descriptorType  = binding_info->descriptorType;
+					write_descriptor_set.pImageInfo      = &image_info;
+					write_descriptor_set.dstSet          = descriptor_set.get_handle();
+					write_descriptor_set.dstArrayElement = array_element;
+					write_descriptor_set.descriptorCount = 1;
+
+					set_updates.push_back(write_descriptor_set);
+				}
+				else
+				{
+					LOGE("Shader layout set does not use image binding at #{}", binding);
 				}
 			}
 		}
@@ -175,41 +489,216 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 		                       0, nullptr);
 	}
 
-	// Delete old entries (moved out descriptor sets)
-	for (auto &match : matches)
+	// Re-key the updated descriptor sets, so that requests using the new views find them
+	for (auto &key : matches)
 	{
-		// Move out of the map
-		auto it             = state.descriptor_sets.find(match);
-		auto descriptor_set = std::move(it->second);
-		state.descriptor_sets.erase(match);
+		auto set_it = state.descriptor_sets.find(key);
+
+		if (set_it == state.descriptor_sets.end())
+		{
+			continue;
+		}
+
+		auto descriptor_set = std::move(set_it->second);
+		state.descriptor_sets.erase(set_it);
+
+		unindex_descriptor_set(key, descriptor_set);
+
+		uint64_t stamp    = 0;
+		auto     stamp_it = set_usage.last_used.find(key);
 
-		// Generate new key
-		size_t new_key = 0U;
-		hash_param(new_key, descriptor_set.get_layout(), descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+		if (stamp_it != set_usage.last_used.end())
+		{
+			stamp = stamp_it->second;
+			set_usage.last_used.erase(stamp_it);
+		}
+
+		// Generate the key request_descriptor_set would compute for the updated bindings
+		auto   &descriptor_pool = state.descriptor_pools.at(hash_params(descriptor_set.get_layout()));
+		Hash128 new_key         = hash_params(descriptor_set.get_layout(), descriptor_pool, descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+
+		auto res_ins_it = state.descriptor_sets.emplace(new_key, std::move(descriptor_set));
 
-		// Add (key, resource) to the cache
-		state.descriptor_sets.emplace(new_key, std::move(descriptor_set));
+		if (res_ins_it.second)
+		{
+			index_descriptor_set(new_key, res_ins_it.first->second);
+			set_usage.last_used[new_key].store(stamp);
+		}
 	}
+
+	descriptor_set_update_stats.set_count        = matches.size();
+	descriptor_set_update_stats.descriptor_count = set_updates.size();
+	descriptor_set_update_stats.update_time      = timer.stop<Timer::Milliseconds>();
+}
+
+const DescriptorSetUpdateStats &ResourceCache::get_descriptor_set_update_stats() const
+{
+	return descriptor_set_update_stats;
 }
 
 void ResourceCache::clear_framebuffers()
 {
 	state.framebuffers.clear();
+	get_usage(ResourceType::Framebuffer).last_used.clear();
 }
 
 void ResourceCache::clear()
 {
 	state.shader_modules.clear();
+	get_usage(ResourceType::ShaderModule).last_used.clear();
 	state.pipeline_layouts.clear();
+	get_usage(ResourceType::PipelineLayout).last_used.clear();
 	state.descriptor_sets.clear();
+	get_usage(ResourceType::DescriptorSet).last_used.clear();
+	image_view_descriptor_sets.clear();
 	state.descriptor_set_layouts.clear();
+	get_usage(ResourceType::DescriptorSetLayout).last_used.clear();
 	state.render_passes.clear();
+	get_usage(ResourceType::RenderPass).last_used.clear();
 	clear_pipelines();
 	clear_framebuffers();
+
+	// Records refer to the shader modules, layouts and render passes by address, so the objects built again are recorded again
+	std::lock_guard<std::mutex> recorder_guard(recorder_mutex);
+
+	for (auto &type_usage : usage)
+	{
+		type_usage.recorded.clear();
+	}
 }
 
 const ResourceCacheState &ResourceCache::get_internal_state() const
 {
 	return state;
 }
+
+void ResourceCache::set_budget(ResourceType type, size_t budget)
+{
+	if (type != ResourceType::DescriptorSet && type != ResourceType::Framebuffer &&
+	    type != ResourceType::GraphicsPipeline && type != ResourceType::ComputePipeline)
+	{
+		throw std::runtime_error("Only descriptor sets, framebuffers and pipelines can be evicted from the resource cache");
+	}
+
+	get_usage(type).budget = budget;
+}
+
+uint64_t ResourceCache::begin_frame()
+{
+	return ++current_frame;
+}
+
+void ResourceCache::release_frame(uint64_t frame)
+{
+	uint64_t released = released_frame;
+	while (released < frame && !released_frame.compare_exchange_weak(released, frame))
+	{
+	}
+	released = std::max(released, frame);
+
+	auto always       = [](auto &) { return true; };
+	auto destroy_only = [](const Hash128 &, auto &) {};
+
+	// The record keeps the pipelines, only their addresses are dropped from it
+	auto unset_recorded = [this](const Hash128 &, auto &pipeline) {
+		std::lock_guard<std::mutex> recorder_guard(recorder_mutex);
+		recorder.unset_pipeline(pipeline);
+	};
+
+	evict_resources(graphics_pipeline_mutex, get_usage(ResourceType::GraphicsPipeline), state.graphics_pipelines, released, always, unset_recorded);
+	evict_resources(compute_pipeline_mutex, get_usage(ResourceType::ComputePipeline), state.compute_pipelines, released, always, unset_recorded);
+	evict_resources(framebuffer_mutex, get_usage(ResourceType::Framebuffer), state.framebuffers, released, always, destroy_only);
+
+	// Descriptor sets are not freed on destruction, return them to their pool.
+	// Sets allocated before the budget was set come from pools that cannot free them and are kept.
+	evict_resources(
+	    descriptor_set_mutex, get_usage(ResourceType::DescriptorSet), state.descriptor_sets, released,
+	    [this](DescriptorSet &descriptor_set) {
+		    return state.descriptor_pools.at(hash_params(descriptor_set.get_layout())).can_free(descriptor_set.get_handle());
+	    },
+	    [this](const Hash128 &key, DescriptorSet &descriptor_set) {
+		    unindex_descriptor_set(key, descriptor_set);
+		    state.descriptor_pools.at(hash_params(descriptor_set.get_layout())).free(descriptor_set.get_handle());
+	    });
+}
+
+ResourceCacheStats ResourceCache::get_stats(ResourceType type)
+{
+	auto &type_usage = get_usage(type);
+
+	ResourceCacheStats stats;
+	stats.counters  = type_usage.counters.get_stats();
+	stats.evictions = type_usage.evictions;
+	stats.budget    = type_usage.budget;
+
+	switch (type)
+	{
+		case ResourceType::ShaderModule:
+			stats.size = get_resource_count(shader_module_mutex, state.shader_modules);
+			break;
+		case ResourceType::PipelineLayout:
+			stats.size = get_resource_count(pipeline_layout_mutex, state.pipeline_layouts);
+			break;
+		case ResourceType::RenderPass:
+			stats.size = get_resource_count(render_pass_mutex, state.render_passes);
+			break;
+		case ResourceType::GraphicsPipeline:
+			stats.size = get_resource_count(graphics_pipeline_mutex, state.graphics_pipelines);
+			break;
+		case ResourceType::DescriptorSetLayout:
+			stats.size = get_resource_count(descriptor_set_layout_mutex, state.descriptor_set_layouts);
+			break;
+		case ResourceType::ComputePipeline:
+			stats.size = get_resource_count(compute_pipeline_mutex, state.compute_pipelines);
+			break;
+		case ResourceType::DescriptorPool:
+			stats.size = get_resource_count(descriptor_set_mutex, state.descriptor_pools);
+			break;
+		case ResourceType::DescriptorSet:
+			stats.size = get_resource_count(descriptor_set_mutex, state.descriptor_sets);
+			break;
+		case ResourceType::Framebuffer:
+			stats.size = get_resource_count(framebuffer_mutex, state.framebuffers);
+			break;
+	}
+
+	return stats;
+}
+
+ResourceCacheUsage &ResourceCache::get_usage(ResourceType type)
+{
+	return usage[static_cast<size_t>(type)];
+}
+
+void ResourceCache::index_descriptor_set(const Hash128 &key, DescriptorSet &descriptor_set)
+{
+	for (auto &binding_set : descriptor_set.get_image_infos())
+	{
+		for (auto &binding_element : binding_set.second)
+		{
+			image_view_descriptor_sets[binding_element.second.imageView].insert(key);
+		}
+	}
+}
+
+void ResourceCache::unindex_descriptor_set(const Hash128 &key, DescriptorSet &descriptor_set)
+{
+	for (auto &binding_set : descriptor_set.get_image_infos())
+	{
+		for (auto &binding_element : binding_set.second)
+		{
+			auto index_it = image_view_descriptor_sets.find(binding_element.second.imageView);
+
+			if (index_it != image_view_descriptor_sets.end())
+			{
+				index_it->second.erase(key);
+
+				if (index_it->second.empty())
+				{
+					image_view_descriptor_sets.erase(index_it);
+				}
+			}
+		}
+	}
+}
 }        // namespace vkb
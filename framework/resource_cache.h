@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,10 +17,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <future>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "common/cache_counters.h"
 #include "common/helpers.h"
 #include "core/descriptor_pool.h"
 #include "core/descriptor_set.h"
@@ -45,23 +51,106 @@ class ImageView;
  */
 struct ResourceCacheState
 {
-	std::unordered_map<std::size_t, ShaderModule> shader_modules;
+	std::unordered_map<Hash128, ShaderModule> shader_modules;
 
-	std::unordered_map<std::size_t, PipelineLayout> pipeline_layouts;
+	std::unordered_map<Hash128, PipelineLayout> pipeline_layouts;
 
-	std::unordered_map<std::size_t, DescriptorSetLayout> descriptor_set_layouts;
+	std::unordered_map<Hash128, DescriptorSetLayout> descriptor_set_layouts;
 
-	std::unordered_map<std::size_t, DescriptorPool> descriptor_pools;
+	std::unordered_map<Hash128, DescriptorPool> descriptor_pools;
 
-	std::unordered_map<std::size_t, RenderPass> render_passes;
+	std::unordered_map<Hash128, RenderPass> render_passes;
 
-	std::unordered_map<std::size_t, GraphicsPipeline> graphics_pipelines;
+	std::unordered_map<Hash128, GraphicsPipeline> graphics_pipelines;
 
-	std::unordered_map<std::size_t, ComputePipeline> compute_pipelines;
+	std::unordered_map<Hash128, ComputePipeline> compute_pipelines;
 
-	std::unordered_map<std::size_t, DescriptorSet> descriptor_sets;
+	std::unordered_map<Hash128, DescriptorSet> descriptor_sets;
 
-	std::unordered_map<std::size_t, Framebuffer> framebuffers;
+	std::unordered_map<Hash128, Framebuffer> framebuffers;
+};
+
+/**
+ * @brief Cost of the last ResourceCache::update_descriptor_sets call
+ */
+struct DescriptorSetUpdateStats
+{
+	/// Number of descriptor sets referring to one of the old image views
+	size_t set_count{0};
+
+	/// Number of descriptors rewritten
+	size_t descriptor_count{0};
+
+	/// Time spent updating and re-keying the descriptor sets, in milliseconds
+	double update_time{0.0};
+};
+
+/**
+ * @brief Counters of one type of cached object, see ResourceCache::get_stats
+ */
+struct ResourceCacheStats
+{
+	CacheStats counters;
+
+	/// Objects evicted to stay within the budget
+	uint64_t evictions{0};
+
+	/// Number of objects currently cached
+	size_t size{0};
+
+	/// Maximum number of cached objects, 0 if unbounded
+	size_t budget{0};
+};
+
+/**
+ * @brief Usage tracking of one type of cached object
+ *
+ * The frame stamps are guarded by the lock of the corresponding resource map. Objects are stamped
+ * whether a budget is set or not, so that a budget set later never evicts an object still in use.
+ */
+struct ResourceCacheUsage
+{
+	/// @brief Counts a hit and stamps the object, only requires a shared lock
+	void hit(const Hash128 &key, uint64_t frame)
+	{
+		counters.hit();
+		touch(key, frame);
+	}
+
+	/// @brief Stamps an object, only requires a shared lock as the stamp itself is atomic
+	void touch(const Hash128 &key, uint64_t frame)
+	{
+		auto stamp_it = last_used.find(key);
+
+		if (stamp_it != last_used.end())
+		{
+			// Concurrent hits may race, the stamp must never move back to an earlier frame
+			uint64_t stamp = stamp_it->second.load(std::memory_order_relaxed);
+			while (stamp < frame && !stamp_it->second.compare_exchange_weak(stamp, frame, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+
+	/// @brief Counts the creation of an object, requires an exclusive lock as the object is added to the stamps
+	void created(const Hash128 &key, uint64_t frame, double creation_time)
+	{
+		counters.created(creation_time);
+
+		last_used[key].store(frame, std::memory_order_relaxed);
+	}
+
+	CacheCounters counters;
+
+	std::atomic<uint64_t> evictions{0};
+
+	std::atomic<size_t> budget{0};
+
+	/// Frame each cached object was last requested in
+	std::unordered_map<Hash128, std::atomic<uint64_t>> last_used;
+
+	/// Keys already written to the record, guarded by the recorder mutex. An evicted object built again is not recorded twice.
+	std::unordered_set<Hash128> recorded;
 };
 
 /**
@@ -70,11 +159,24 @@ struct ResourceCacheState
  * There is only one cache for all these objects, with several unordered_map of hash indices
  * and objects. For every object requested, there is a templated version on request_resource.
  * Some objects may need building if they are not found in the cache.
+ * Objects are keyed by a 128-bit hash of their creation parameters. Each key also holds a check word
+ * from an independent hash lane, compared on every lookup, so that a collision of the 128-bit hash
+ * between two different sets of parameters does not return the wrong object.
+ *
+ * Requests are thread-safe. A request for an object that is already cached only takes a shared lock.
+ * Objects that do not depend on shared state are built outside of any lock, and concurrent requests
+ * for the same object wait for the build in flight rather than building it again.
  *
  * The resource cache is also linked with ResourceRecord and ResourceReplay. Replay can warm-up
  * the cache on app startup by creating all necessary objects.
  * The cache holds pointers to objects and has a mapping from such pointers to hashes.
- * It can only be destroyed in bulk, single elements cannot be removed.
+ *
+ * By default the cache only grows and is destroyed in bulk. Descriptor sets, framebuffers and pipelines
+ * can be bounded with set_budget: objects are stamped with the frame they were last requested in, and once
+ * that frame is released, i.e. its fences have signaled, the least recently used ones beyond the budget
+ * are destroyed. References to objects of a bounded type must not be kept beyond the frame they were requested in.
+ * An evicted object that is requested again is rebuilt but not recorded again, so the record stays bounded by the distinct objects.
+ * Objects requested before the first frame began, e.g. while preparing a sample, are kept until they are requested again.
  */
 class ResourceCache
 {
@@ -89,7 +191,15 @@ class ResourceCache
 
 	ResourceCache &operator=(ResourceCache &&) = delete;
 
-	void warmup(const std::vector<uint8_t> &data);
+	/**
+	 * @brief Creates every object of a serialized record
+	 * @param data The serialized record
+	 * @param thread_count Number of worker threads, 0 uses the hardware concurrency and 1 replays serially
+	 */
+	void warmup(const std::vector<uint8_t> &data, uint32_t thread_count = 0);
+
+	/// @brief Timings of the last warmup, comparing wall-clock and serial build time
+	const ResourceReplayStats &get_warmup_stats() const;
 
 	std::vector<uint8_t> serialize();
 
@@ -125,13 +235,46 @@ class ResourceCache
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views);
 
+	/// @brief Cost of the last update_descriptor_sets call, e.g. on swapchain recreation
+	const DescriptorSetUpdateStats &get_descriptor_set_update_stats() const;
+
 	void clear_framebuffers();
 
 	void clear();
 
 	const ResourceCacheState &get_internal_state() const;
 
+	/**
+	 * @brief Bounds the number of cached objects of a type
+	 * @param type One of DescriptorSet, Framebuffer, GraphicsPipeline or ComputePipeline,
+	 *        other objects are referenced by cached objects and cannot be evicted
+	 * @param budget Maximum number of objects, 0 for unbounded.
+	 *        A descriptor set budget only applies to sets allocated after it is set.
+	 */
+	void set_budget(ResourceType type, size_t budget);
+
+	/**
+	 * @brief Starts a new frame
+	 * @return The frame number objects requested from now on are stamped with
+	 */
+	uint64_t begin_frame();
+
+	/**
+	 * @brief Evicts the least recently used objects of bounded types that were not requested after a frame
+	 * @param frame A frame number returned by begin_frame, the fences of every submission of that frame
+	 *        must have signaled. Earlier frames are assumed to be complete as well, as they were submitted before.
+	 */
+	void release_frame(uint64_t frame);
+
+	ResourceCacheStats get_stats(ResourceType type);
+
   private:
+	ResourceCacheUsage &get_usage(ResourceType type);
+
+	void index_descriptor_set(const Hash128 &key, DescriptorSet &descriptor_set);
+
+	void unindex_descriptor_set(const Hash128 &key, DescriptorSet &descriptor_set);
+
 	Device &device;
 
 	ResourceRecord recorder;
@@ -142,20 +285,46 @@ class ResourceCache
 
 	ResourceCacheState state;
 
-	std::mutex descriptor_set_mutex;
+	// Keys of the cached descriptor sets referring to each image view, guarded by descriptor_set_mutex
+	std::unordered_map<VkImageView, std::unordered_set<Hash128>> image_view_descriptor_sets;
+
+	DescriptorSetUpdateStats descriptor_set_update_stats;
+
+	std::array<ResourceCacheUsage, RESOURCE_TYPE_COUNT> usage;
+
+	std::atomic<uint64_t> current_frame{0};
+
+	std::atomic<uint64_t> released_frame{0};
+
+	std::mutex recorder_mutex;
+
+	std::shared_mutex descriptor_set_mutex;
+
+	std::shared_mutex pipeline_layout_mutex;
+
+	std::shared_mutex shader_module_mutex;
+
+	std::shared_mutex descriptor_set_layout_mutex;
+
+	std::shared_mutex graphics_pipeline_mutex;
+
+	std::shared_mutex render_pass_mutex;
+
+	std::shared_mutex compute_pipeline_mutex;
 
-	std::mutex pipeline_layout_mutex;
+	std::shared_mutex framebuffer_mutex;
 
-	std::mutex shader_module_mutex;
+	// Objects being built outside of their resource lock, requesters of the same object wait on these
+	std::unordered_map<Hash128, std::shared_future<void>> pipeline_layout_builds;
 
-	std::mutex descriptor_set_layout_mutex;
+	std::unordered_map<Hash128, std::shared_future<void>> shader_module_builds;
 
-	std::mutex graphics_pipeline_mutex;
+	std::unordered_map<Hash128, std::shared_future<void>> descriptor_set_layout_builds;
 
-	std::mutex render_pass_mutex;
+	std::unordered_map<Hash128, std::shared_future<void>> graphics_pipeline_builds;
 
-	std::mutex compute_pipeline_mutex;
+	std::unordered_map<Hash128, std::shared_future<void>> render_pass_builds;
 
-	std::mutex framebuffer_mutex;
+	std::unordered_map<Hash128, std::shared_future<void>> compute_pipeline_builds;
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,11 @@
 
 #include "resource_record.h"
 
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "core/descriptor_set_layout.h"
 #include "core/pipeline.h"
 #include "core/pipeline_layout.h"
 #include "core/render_pass.h"
@@ -27,122 +32,285 @@ namespace vkb
 {
 namespace
 {
-inline void write_subpass_info(std::ostringstream &os, const std::vector<SubpassInfo> &value)
+constexpr size_t RECORD_ALIGNMENT = 8;
+
+uint64_t checksum(const uint8_t *data, size_t size)
 {
-	write(os, value.size());
-	for (const SubpassInfo &item : value)
+	// FNV-1a, stable across runs and platforms
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < size; ++i)
 	{
-		write(os, item.input_attachments);
-		write(os, item.output_attachments);
+		hash ^= data[i];
+		hash *= 0x100000001b3ULL;
 	}
+	return hash;
 }
 
-inline void write_processes(std::ostringstream &os, const std::vector<std::string> &value)
+size_t align_up(size_t value, size_t alignment)
 {
-	write(os, value.size());
-	for (const std::string &item : value)
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+void append_bytes(std::vector<uint8_t> &bytes, const T *elements, size_t count)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Records may only hold trivially copyable types");
+
+	auto begin = reinterpret_cast<const uint8_t *>(elements);
+	bytes.insert(bytes.end(), begin, begin + count * sizeof(T));
+}
+}        // namespace
+
+namespace record
+{
+View::View(const uint8_t *data, size_t size) :
+    data{data}
+{
+	if (data == nullptr || size < sizeof(Header))
+	{
+		return;
+	}
+
+	auto &header = get_header();
+
+	if (header.magic != MAGIC || header.version != VERSION)
 	{
-		write(os, item);
+		return;
 	}
+
+	if (!in_bounds(sizeof(Header), static_cast<uint64_t>(header.entry_count) * sizeof(Entry), size) ||
+	    !in_bounds(header.data_offset, header.data_size, size) ||
+	    !in_bounds(header.string_table_offset, header.string_table_size, size) ||
+	    header.data_offset % RECORD_ALIGNMENT != 0)
+	{
+		return;
+	}
+
+	if (header.checksum != checksum(data + sizeof(Header), size - sizeof(Header)))
+	{
+		return;
+	}
+
+	data_section      = data + header.data_offset;
+	data_size         = header.data_size;
+	string_table      = reinterpret_cast<const char *>(data + header.string_table_offset);
+	string_table_size = header.string_table_size;
+	valid             = true;
+}
+
+bool View::is_valid() const
+{
+	return valid;
 }
-}        // namespace
 
-void ResourceRecord::set_data(const std::vector<uint8_t> &data)
+const Header &View::get_header() const
 {
-	stream.str(std::string{data.begin(), data.end()});
+	return *reinterpret_cast<const Header *>(data);
 }
 
-std::vector<uint8_t> ResourceRecord::get_data()
+const Entry *View::get_entries() const
 {
-	std::string str = stream.str();
+	return reinterpret_cast<const Entry *>(data + sizeof(Header));
+}
+
+std::string_view View::get_string(const StringRef &string) const
+{
+	if (!in_bounds(string.offset, string.size, string_table_size))
+	{
+		return {};
+	}
+
+	return {string_table + string.offset, string.size};
+}
+
+bool View::in_bounds(uint64_t offset, uint64_t size, uint64_t limit)
+{
+	return offset <= limit && size <= limit - offset;
+}
+}        // namespace record
+
+void ResourceRecord::set_device_properties(const VkPhysicalDeviceProperties &properties)
+{
+	header.vendor_id      = properties.vendorID;
+	header.device_id      = properties.deviceID;
+	header.driver_version = properties.driverVersion;
+	std::memcpy(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+}
 
-	return std::vector<uint8_t>{str.begin(), str.end()};
+void ResourceRecord::reset()
+{
+	entries.clear();
+	data.clear();
+	string_table.clear();
+	string_refs.clear();
+
+	shader_module_count         = 0;
+	pipeline_layout_count       = 0;
+	descriptor_set_layout_count = 0;
+	render_pass_count           = 0;
+	graphics_pipeline_count     = 0;
+	compute_pipeline_count      = 0;
+
+	shader_module_to_index.clear();
+	pipeline_layout_to_index.clear();
+	descriptor_set_layout_to_index.clear();
+	render_pass_to_index.clear();
+	graphics_pipeline_to_index.clear();
+	compute_pipeline_to_index.clear();
 }
 
-const std::ostringstream &ResourceRecord::get_stream()
+std::vector<uint8_t> ResourceRecord::get_data() const
 {
-	return stream;
+	record::Header blob_header = header;
+
+	blob_header.magic               = record::MAGIC;
+	blob_header.version             = record::VERSION;
+	blob_header.entry_count         = to_u32(entries.size());
+	blob_header.data_offset         = to_u32(align_up(sizeof(record::Header) + entries.size() * sizeof(record::Entry), RECORD_ALIGNMENT));
+	blob_header.data_size           = to_u32(data.size());
+	blob_header.string_table_offset = to_u32(blob_header.data_offset + data.size());
+	blob_header.string_table_size   = to_u32(string_table.size());
+
+	std::vector<uint8_t> blob;
+	blob.reserve(blob_header.string_table_offset + string_table.size());
+
+	append_bytes(blob, &blob_header, 1);
+	append_bytes(blob, entries.data(), entries.size());
+	blob.resize(blob_header.data_offset, 0);
+	append_bytes(blob, data.data(), data.size());
+	append_bytes(blob, string_table.data(), string_table.size());
+
+	auto checksum_value = checksum(blob.data() + sizeof(record::Header), blob.size() - sizeof(record::Header));
+	std::memcpy(blob.data() + offsetof(record::Header, checksum), &checksum_value, sizeof(checksum_value));
+
+	return blob;
 }
 
 size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
 {
-	shader_module_indices.push_back(shader_module_indices.size());
+	std::vector<record::StringRef> processes;
+	for (auto &process : shader_variant.get_processes())
+	{
+		processes.push_back(add_string(process));
+	}
 
-	write(stream, ResourceType::ShaderModule, stage, glsl_source.get_source(), entry_point, shader_variant.get_preamble());
+	record::ShaderModuleRecord shader_module{};
+	shader_module.stage       = stage;
+	shader_module.source      = add_string(glsl_source.get_source());
+	shader_module.entry_point = add_string(entry_point);
+	shader_module.preamble    = add_string(shader_variant.get_preamble());
+	shader_module.processes   = add_array(processes);
 
-	write_processes(stream, shader_variant.get_processes());
+	add_record(ResourceType::ShaderModule, shader_module);
 
-	return shader_module_indices.back();
+	return shader_module_count++;
 }
 
 size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
-	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
-
-	std::vector<size_t> shader_indices(shader_modules.size());
-	std::transform(shader_modules.begin(), shader_modules.end(), shader_indices.begin(),
-	               [this](ShaderModule *shader_module) { return shader_module_to_index.at(shader_module); });
+	record::PipelineLayoutRecord pipeline_layout{};
+	pipeline_layout.shader_modules = add_shader_module_indices(shader_modules);
 
-	write(stream,
-	      ResourceType::PipelineLayout,
-	      shader_indices);
+	add_record(ResourceType::PipelineLayout, pipeline_layout);
 
-	return pipeline_layout_indices.back();
+	return pipeline_layout_count++;
 }
 
-size_t ResourceRecord::register_render_pass(const std::vector<Attachment> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
+size_t ResourceRecord::register_descriptor_set_layout(const uint32_t set_index, const std::vector<ShaderModule *> &shader_modules, const std::vector<ShaderResource> &set_resources)
 {
-	render_pass_indices.push_back(render_pass_indices.size());
+	std::vector<record::ShaderResourceRecord> resources;
+	resources.reserve(set_resources.size());
 
-	write(stream,
-	      ResourceType::RenderPass,
-	      attachments,
-	      load_store_infos);
+	for (auto &resource : set_resources)
+	{
+		resources.push_back({resource.stages,
+		                     resource.type,
+		                     resource.mode,
+		                     resource.set,
+		                     resource.binding,
+		                     resource.location,
+		                     resource.input_attachment_index,
+		                     resource.vec_size,
+		                     resource.columns,
+		                     resource.array_size,
+		                     resource.offset,
+		                     resource.size,
+		                     resource.constant_id,
+		                     resource.qualifiers,
+		                     add_string(resource.name)});
+	}
 
-	write_subpass_info(stream, subpasses);
+	record::DescriptorSetLayoutRecord descriptor_set_layout{};
+	descriptor_set_layout.set_index      = set_index;
+	descriptor_set_layout.shader_modules = add_shader_module_indices(shader_modules);
+	descriptor_set_layout.resources      = add_array(resources);
 
-	return render_pass_indices.back();
+	add_record(ResourceType::DescriptorSetLayout, descriptor_set_layout);
+
+	return descriptor_set_layout_count++;
 }
 
-size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cache*/, PipelineState &pipeline_state)
+size_t ResourceRecord::register_render_pass(const std::vector<Attachment> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
-	graphics_pipeline_indices.push_back(graphics_pipeline_indices.size());
+	std::vector<record::SubpassRecord> subpass_records;
+	subpass_records.reserve(subpasses.size());
 
-	auto &pipeline_layout = pipeline_state.get_pipeline_layout();
-	auto  render_pass     = pipeline_state.get_render_pass();
+	for (auto &subpass : subpasses)
+	{
+		subpass_records.push_back({add_array(subpass.input_attachments),
+		                           add_array(subpass.output_attachments),
+		                           add_array(subpass.color_resolve_attachments),
+		                           subpass.disable_depth_stencil_attachment ? VK_TRUE : VK_FALSE,
+		                           subpass.depth_stencil_resolve_attachment,
+		                           subpass.depth_stencil_resolve_mode,
+		                           add_string(subpass.debug_name)});
+	}
 
-	write(stream,
-	      ResourceType::GraphicsPipeline,
-	      pipeline_layout_to_index.at(&pipeline_layout),
-	      render_pass_to_index.at(render_pass),
-	      pipeline_state.get_subpass_index());
+	record::RenderPassRecord render_pass{};
+	render_pass.attachments      = add_array(attachments);
+	render_pass.load_store_infos = add_array(load_store_infos);
+	render_pass.subpasses        = add_array(subpass_records);
 
-	auto &specialization_constant_state = pipeline_state.get_specialization_constant_state().get_specialization_constant_state();
+	add_record(ResourceType::RenderPass, render_pass);
 
-	write(stream,
-	      specialization_constant_state);
+	return render_pass_count++;
+}
 
+size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cache*/, PipelineState &pipeline_state)
+{
 	auto &vertex_input_state = pipeline_state.get_vertex_input_state();
+	auto &color_blend_state  = pipeline_state.get_color_blend_state();
+
+	record::GraphicsPipelineRecord graphics_pipeline{};
+	graphics_pipeline.pipeline_layout          = to_u32(pipeline_layout_to_index.at(&pipeline_state.get_pipeline_layout()));
+	graphics_pipeline.render_pass              = to_u32(render_pass_to_index.at(pipeline_state.get_render_pass()));
+	graphics_pipeline.subpass_index            = pipeline_state.get_subpass_index();
+	graphics_pipeline.specialization_constants = add_specialization_constants(pipeline_state);
+	graphics_pipeline.vertex_bindings          = add_array(vertex_input_state.bindings);
+	graphics_pipeline.vertex_attributes        = add_array(vertex_input_state.attributes);
+	graphics_pipeline.input_assembly_state     = pipeline_state.get_input_assembly_state();
+	graphics_pipeline.rasterization_state      = pipeline_state.get_rasterization_state();
+	graphics_pipeline.viewport_state           = pipeline_state.get_viewport_state();
+	graphics_pipeline.multisample_state        = pipeline_state.get_multisample_state();
+	graphics_pipeline.depth_stencil_state      = pipeline_state.get_depth_stencil_state();
+	graphics_pipeline.logic_op_enable          = color_blend_state.logic_op_enable;
+	graphics_pipeline.logic_op                 = color_blend_state.logic_op;
+	graphics_pipeline.color_blend_attachments  = add_array(color_blend_state.attachments);
+
+	add_record(ResourceType::GraphicsPipeline, graphics_pipeline);
+
+	return graphics_pipeline_count++;
+}
 
-	write(stream,
-	      vertex_input_state.attributes,
-	      vertex_input_state.bindings);
-
-	write(stream,
-	      pipeline_state.get_input_assembly_state(),
-	      pipeline_state.get_rasterization_state(),
-	      pipeline_state.get_viewport_state(),
-	      pipeline_state.get_multisample_state(),
-	      pipeline_state.get_depth_stencil_state());
-
-	auto &color_blend_state = pipeline_state.get_color_blend_state();
+size_t ResourceRecord::register_compute_pipeline(VkPipelineCache /*pipeline_cache*/, PipelineState &pipeline_state)
+{
+	record::ComputePipelineRecord compute_pipeline{};
+	compute_pipeline.pipeline_layout          = to_u32(pipeline_layout_to_index.at(&pipeline_state.get_pipeline_layout()));
+	compute_pipeline.specialization_constants = add_specialization_constants(pipeline_state);
 
-	write(stream,
-	      color_blend_state.logic_op,
-	      color_blend_state.logic_op_enable,
-	      color_blend_state.attachments);
+	add_record(ResourceType::ComputePipeline, compute_pipeline);
 
-	return graphics_pipeline_indices.back();
+	return compute_pipeline_count++;
 }
 
 void ResourceRecord::set_shader_module(size_t index, const ShaderModule &shader_module)
@@ -155,6 +323,11 @@ void ResourceRecord::set_pipeline_layout(size_t index, const PipelineLayout &pip
 	pipeline_layout_to_index[&pipeline_layout] = index;
 }
 
+void ResourceRecord::set_descriptor_set_layout(size_t index, const DescriptorSetLayout &descriptor_set_layout)
+{
+	descriptor_set_layout_to_index[&descriptor_set_layout] = index;
+}
+
 void ResourceRecord::set_render_pass(size_t index, const RenderPass &render_pass)
 {
 	render_pass_to_index[&render_pass] = index;
@@ -165,4 +338,76 @@ void ResourceRecord::set_graphics_pipeline(size_t index, const GraphicsPipeline
 	graphics_pipeline_to_index[&graphics_pipeline] = index;
 }
 
+void ResourceRecord::set_compute_pipeline(size_t index, const ComputePipeline &compute_pipeline)
+{
+	compute_pipeline_to_index[&compute_pipeline] = index;
+}
+
+void ResourceRecord::unset_pipeline(const GraphicsPipeline &graphics_pipeline)
+{
+	graphics_pipeline_to_index.erase(&graphics_pipeline);
+}
+
+void ResourceRecord::unset_pipeline(const ComputePipeline &compute_pipeline)
+{
+	compute_pipeline_to_index.erase(&compute_pipeline);
+}
+
+template <class T>
+uint32_t ResourceRecord::add_record(ResourceType type, const T &value)
+{
+	auto array = add_array(&value, 1);
+	entries.push_back({type, array.offset});
+	return array.offset;
+}
+
+template <class T>
+record::ArrayRef ResourceRecord::add_array(const T *elements, size_t count)
+{
+	static_assert(alignof(T) <= RECORD_ALIGNMENT, "Record element alignment is not supported");
+
+	data.resize(align_up(data.size(), alignof(T)), 0);
+
+	record::ArrayRef array{to_u32(data.size()), to_u32(count)};
+	append_bytes(data, elements, count);
+
+	return array;
+}
+
+record::StringRef ResourceRecord::add_string(const std::string &value)
+{
+	// Shader sources are shared between many variants, so strings are only stored once
+	auto it = string_refs.find(value);
+	if (it != string_refs.end())
+	{
+		return it->second;
+	}
+
+	record::StringRef string{to_u32(string_table.size()), to_u32(value.size())};
+	string_table.append(value);
+	string_refs.emplace(value, string);
+
+	return string;
+}
+
+record::ArrayRef ResourceRecord::add_shader_module_indices(const std::vector<ShaderModule *> &shader_modules)
+{
+	std::vector<uint32_t> shader_indices(shader_modules.size());
+	std::transform(shader_modules.begin(), shader_modules.end(), shader_indices.begin(),
+	               [this](ShaderModule *shader_module) { return to_u32(shader_module_to_index.at(shader_module)); });
+
+	return add_array(shader_indices);
+}
+
+record::ArrayRef ResourceRecord::add_specialization_constants(const PipelineState &pipeline_state)
+{
+	std::vector<record::SpecializationConstantRecord> constants;
+
+	for (auto &constant : pipeline_state.get_specialization_constant_state().get_specialization_constant_state())
+	{
+		constants.push_back({constant.first, add_array(constant.second)});
+	}
+
+	return add_array(constants);
+}
 }        // namespace vkb
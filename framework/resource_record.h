@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2020, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,76 +17,424 @@
 
 #pragma once
 
+#include <string_view>
 #include <vector>
 
 #include "rendering/pipeline_state.h"
 
 namespace vkb
 {
+class ComputePipeline;
+class DescriptorSetLayout;
 class GraphicsPipeline;
 class PipelineLayout;
 class RenderPass;
 class ShaderModule;
 
-enum class ResourceType
+enum class ResourceType : uint32_t
 {
 	ShaderModule,
 	PipelineLayout,
 	RenderPass,
-	GraphicsPipeline
+	GraphicsPipeline,
+	DescriptorSetLayout,
+	ComputePipeline,
+	// Not recorded, only tracked by the ResourceCache
+	DescriptorPool,
+	DescriptorSet,
+	Framebuffer
 };
 
+constexpr size_t RESOURCE_TYPE_COUNT = static_cast<size_t>(ResourceType::Framebuffer) + 1;
+
+/**
+ * @brief Binary layout of a serialized ResourceRecord
+ *
+ * The blob is position independent and every structure is naturally aligned, so it can be
+ * used in place from a memory-mapped file. It is laid out as:
+ * - a Header
+ * - Header::entry_count Entry structures, one per recorded object in creation order
+ * - a data section holding the fixed-size per-type records and the arrays they reference
+ * - a string table holding de-duplicated strings, mostly shader sources
+ */
+namespace record
+{
+constexpr uint32_t MAGIC   = 0x52424B56;        // "VKBR"
+constexpr uint32_t VERSION = 1;
+
+/// A string in the string table
+struct StringRef
+{
+	uint32_t offset;
+
+	uint32_t size;
+};
+
+/// An array of fixed-size elements in the data section
+struct ArrayRef
+{
+	uint32_t offset;
+
+	uint32_t count;
+};
+
+struct Header
+{
+	uint32_t magic;
+
+	uint32_t version;
+
+	uint32_t vendor_id;
+
+	uint32_t device_id;
+
+	uint32_t driver_version;
+
+	uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+
+	uint32_t entry_count;
+
+	uint32_t data_offset;
+
+	uint32_t data_size;
+
+	uint32_t string_table_offset;
+
+	uint32_t string_table_size;
+
+	/// Checksum of everything following the header
+	uint64_t checksum;
+};
+
+struct Entry
+{
+	ResourceType type;
+
+	/// Offset of the type-specific record in the data section
+	uint32_t offset;
+};
+
+struct ShaderResourceRecord
+{
+	VkShaderStageFlags stages;
+
+	ShaderResourceType type;
+
+	ShaderResourceMode mode;
+
+	uint32_t set;
+
+	uint32_t binding;
+
+	uint32_t location;
+
+	uint32_t input_attachment_index;
+
+	uint32_t vec_size;
+
+	uint32_t columns;
+
+	uint32_t array_size;
+
+	uint32_t offset;
+
+	uint32_t size;
+
+	uint32_t constant_id;
+
+	uint32_t qualifiers;
+
+	StringRef name;
+};
+
+struct SpecializationConstantRecord
+{
+	uint32_t constant_id;
+
+	/// Array of uint8_t
+	ArrayRef data;
+};
+
+struct SubpassRecord
+{
+	/// Arrays of uint32_t
+	ArrayRef input_attachments;
+
+	ArrayRef output_attachments;
+
+	ArrayRef color_resolve_attachments;
+
+	VkBool32 disable_depth_stencil_attachment;
+
+	uint32_t depth_stencil_resolve_attachment;
+
+	VkResolveModeFlagBits depth_stencil_resolve_mode;
+
+	StringRef debug_name;
+};
+
+struct ShaderModuleRecord
+{
+	VkShaderStageFlagBits stage;
+
+	StringRef source;
+
+	StringRef entry_point;
+
+	StringRef preamble;
+
+	/// Array of StringRef
+	ArrayRef processes;
+};
+
+struct PipelineLayoutRecord
+{
+	/// Array of uint32_t shader module indices
+	ArrayRef shader_modules;
+};
+
+struct DescriptorSetLayoutRecord
+{
+	uint32_t set_index;
+
+	/// Array of uint32_t shader module indices
+	ArrayRef shader_modules;
+
+	/// Array of ShaderResourceRecord
+	ArrayRef resources;
+};
+
+struct RenderPassRecord
+{
+	/// Array of Attachment
+	ArrayRef attachments;
+
+	/// Array of LoadStoreInfo
+	ArrayRef load_store_infos;
+
+	/// Array of SubpassRecord
+	ArrayRef subpasses;
+};
+
+struct GraphicsPipelineRecord
+{
+	uint32_t pipeline_layout;
+
+	uint32_t render_pass;
+
+	uint32_t subpass_index;
+
+	/// Array of SpecializationConstantRecord
+	ArrayRef specialization_constants;
+
+	/// Array of VkVertexInputBindingDescription
+	ArrayRef vertex_bindings;
+
+	/// Array of VkVertexInputAttributeDescription
+	ArrayRef vertex_attributes;
+
+	InputAssemblyState input_assembly_state;
+
+	RasterizationState rasterization_state;
+
+	ViewportState viewport_state;
+
+	MultisampleState multisample_state;
+
+	DepthStencilState depth_stencil_state;
+
+	VkBool32 logic_op_enable;
+
+	VkLogicOp logic_op;
+
+	/// Array of ColorBlendAttachmentState
+	ArrayRef color_blend_attachments;
+};
+
+struct ComputePipelineRecord
+{
+	uint32_t pipeline_layout;
+
+	/// Array of SpecializationConstantRecord
+	ArrayRef specialization_constants;
+};
+
+/**
+ * @brief Read-only view over a serialized record, records are accessed in place without copying
+ */
+class View
+{
+  public:
+	/**
+	 * @brief Validates the header, section bounds and checksum of a serialized record
+	 * @param data Pointer to the serialized record, must stay valid while the view is used
+	 * @param size Size of the serialized record in bytes
+	 */
+	View(const uint8_t *data, size_t size);
+
+	bool is_valid() const;
+
+	const Header &get_header() const;
+
+	const Entry *get_entries() const;
+
+	/// @return The type-specific record of an entry, or nullptr if it is out of bounds
+	template <class T>
+	const T *get_record(const Entry &entry) const
+	{
+		return get_array<T>({entry.offset, 1});
+	}
+
+	/// @return A pointer to the first element, or nullptr if the array is out of bounds
+	template <class T>
+	const T *get_array(const ArrayRef &array) const
+	{
+		if (array.offset % alignof(T) != 0 || !in_bounds(array.offset, static_cast<uint64_t>(array.count) * sizeof(T), data_size))
+		{
+			return nullptr;
+		}
+
+		return reinterpret_cast<const T *>(data_section + array.offset);
+	}
+
+	template <class T>
+	std::vector<T> copy_array(const ArrayRef &array) const
+	{
+		auto elements = get_array<T>(array);
+		return elements ? std::vector<T>{elements, elements + array.count} : std::vector<T>{};
+	}
+
+	std::string_view get_string(const StringRef &string) const;
+
+  private:
+	static bool in_bounds(uint64_t offset, uint64_t size, uint64_t limit);
+
+	const uint8_t *data{nullptr};
+
+	const uint8_t *data_section{nullptr};
+
+	const char *string_table{nullptr};
+
+	uint64_t data_size{0};
+
+	uint64_t string_table_size{0};
+
+	bool valid{false};
+};
+}        // namespace record
+
 /**
- * @brief Writes Vulkan objects in a memory stream.
+ * @brief Writes Vulkan objects in a compact, versioned binary record.
  */
 class ResourceRecord
 {
   public:
-	void set_data(const std::vector<uint8_t> &data);
+	/**
+	 * @brief Sets the device identity stored in the header of the serialized record
+	 */
+	void set_device_properties(const VkPhysicalDeviceProperties &properties);
 
-	std::vector<uint8_t> get_data();
+	/**
+	 * @brief Discards everything recorded so far
+	 */
+	void reset();
 
-	const std::ostringstream &get_stream();
+	/**
+	 * @brief Serializes the record, see vkb::record for the layout
+	 */
+	std::vector<uint8_t> get_data() const;
 
 	size_t register_shader_module(VkShaderStageFlagBits stage,
-	                              const ShaderSource &  glsl_source,
-	                              const std::string &   entry_point,
-	                              const ShaderVariant & shader_variant);
+	                              const ShaderSource   &glsl_source,
+	                              const std::string    &entry_point,
+	                              const ShaderVariant  &shader_variant);
 
 	size_t register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules);
 
-	size_t register_render_pass(const std::vector<Attachment> &   attachments,
+	size_t register_descriptor_set_layout(const uint32_t                     set_index,
+	                                      const std::vector<ShaderModule *> &shader_modules,
+	                                      const std::vector<ShaderResource> &set_resources);
+
+	size_t register_render_pass(const std::vector<Attachment>    &attachments,
 	                            const std::vector<LoadStoreInfo> &load_store_infos,
-	                            const std::vector<SubpassInfo> &  subpasses);
+	                            const std::vector<SubpassInfo>   &subpasses);
 
 	size_t register_graphics_pipeline(VkPipelineCache pipeline_cache,
-	                                  PipelineState & pipeline_state);
+	                                  PipelineState  &pipeline_state);
+
+	size_t register_compute_pipeline(VkPipelineCache pipeline_cache,
+	                                 PipelineState  &pipeline_state);
 
 	void set_shader_module(size_t index, const ShaderModule &shader_module);
 
 	void set_pipeline_layout(size_t index, const PipelineLayout &pipeline_layout);
 
+	void set_descriptor_set_layout(size_t index, const DescriptorSetLayout &descriptor_set_layout);
+
 	void set_render_pass(size_t index, const RenderPass &render_pass);
 
 	void set_graphics_pipeline(size_t index, const GraphicsPipeline &graphics_pipeline);
 
+	void set_compute_pipeline(size_t index, const ComputePipeline &compute_pipeline);
+
+	/**
+	 * @brief Forgets the address of a pipeline that is destroyed, its record is kept
+	 */
+	void unset_pipeline(const GraphicsPipeline &graphics_pipeline);
+
+	void unset_pipeline(const ComputePipeline &compute_pipeline);
+
   private:
-	std::ostringstream stream;
+	template <class T>
+	uint32_t add_record(ResourceType type, const T &value);
+
+	template <class T>
+	record::ArrayRef add_array(const T *elements, size_t count);
+
+	template <class T>
+	record::ArrayRef add_array(const std::vector<T> &elements)
+	{
+		return add_array(elements.data(), elements.size());
+	}
+
+	record::StringRef add_string(const std::string &value);
+
+	record::ArrayRef add_shader_module_indices(const std::vector<ShaderModule *> &shader_modules);
+
+	record::ArrayRef add_specialization_constants(const PipelineState &pipeline_state);
 
-	std::vector<size_t> shader_module_indices;
+	record::Header header{};
 
-	std::vector<size_t> pipeline_layout_indices;
+	std::vector<record::Entry> entries;
 
-	std::vector<size_t> render_pass_indices;
+	std::vector<uint8_t> data;
 
-	std::vector<size_t> graphics_pipeline_indices;
+	std::string string_table;
+
+	std::unordered_map<std::string, record::StringRef> string_refs;
+
+	size_t shader_module_count{0};
+
+	size_t pipeline_layout_count{0};
+
+	size_t descriptor_set_layout_count{0};
+
+	size_t render_pass_count{0};
+
+	size_t graphics_pipeline_count{0};
+
+	size_t compute_pipeline_count{0};
 
 	std::unordered_map<const ShaderModule *, size_t> shader_module_to_index;
 
 	std::unordered_map<const PipelineLayout *, size_t> pipeline_layout_to_index;
 
+	std::unordered_map<const DescriptorSetLayout *, size_t> descriptor_set_layout_to_index;
+
 	std::unordered_map<const RenderPass *, size_t> render_pass_to_index;
 
 	std::unordered_map<const GraphicsPipeline *, size_t> graphics_pipeline_to_index;
+
+	std::unordered_map<const ComputePipeline *, size_t> compute_pipeline_to_index;
 };
 }        // namespace vkb
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -19,202 +19,556 @@
 
 #include "common/vk_common.h"
 #include "core/util/logging.hpp"
+#include "glsl_compiler.h"
 #include "rendering/pipeline_state.h"
 #include "resource_cache.h"
+#include "shader_include_cache.h"
+#include "spirv_cache.h"
+#include "spirv_reflection.h"
+#include "timer.h"
+
+#include <cstring>
+#include <ctpl_stl.h>
+#include <numeric>
+#include <thread>
 
 namespace vkb
 {
 namespace
 {
-inline void read_subpass_info(std::istringstream &is, std::vector<SubpassInfo> &value)
+std::vector<ShaderModule *> get_shader_modules(const record::View &view, const record::ArrayRef &shader_indices, const std::vector<ShaderModule *> &shader_modules)
 {
-	std::size_t size;
-	read(is, size);
-	value.resize(size);
-	for (SubpassInfo &subpass : value)
+	auto indices = view.get_array<uint32_t>(shader_indices);
+
+	std::vector<ShaderModule *> shader_stages(shader_indices.count);
+	std::transform(indices, indices + shader_indices.count, shader_stages.begin(),
+	               [&](uint32_t shader_index) { return shader_modules[shader_index]; });
+
+	return shader_stages;
+}
+
+ShaderVariant get_shader_variant(const record::View &view, const record::ShaderModuleRecord &shader_module)
+{
+	std::vector<std::string> processes;
+	auto                     process_refs = view.get_array<record::StringRef>(shader_module.processes);
+	for (uint32_t i = 0; i < shader_module.processes.count; ++i)
 	{
-		read(is, subpass.input_attachments);
-		read(is, subpass.output_attachments);
+		processes.emplace_back(view.get_string(process_refs[i]));
 	}
+
+	return ShaderVariant(std::string{view.get_string(shader_module.preamble)}, std::move(processes));
 }
 
-inline void read_processes(std::istringstream &is, std::vector<std::string> &value)
+void set_specialization_constants(const record::View &view, const record::ArrayRef &constants, PipelineState &pipeline_state)
 {
-	std::size_t size;
-	read(is, size);
-	value.resize(size);
-	for (std::string &item : value)
+	auto constant_records = view.get_array<record::SpecializationConstantRecord>(constants);
+
+	for (uint32_t i = 0; i < constants.count; ++i)
 	{
-		read(is, item);
+		pipeline_state.set_specialization_constant(constant_records[i].constant_id, view.copy_array<uint8_t>(constant_records[i].data));
 	}
 }
 }        // namespace
 
-ResourceReplay::ResourceReplay()
+void ResourceReplay::set_device_properties(const VkPhysicalDeviceProperties &properties)
 {
-	stream_resources[ResourceType::ShaderModule]     = std::bind(&ResourceReplay::create_shader_module, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::PipelineLayout]   = std::bind(&ResourceReplay::create_pipeline_layout, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::RenderPass]       = std::bind(&ResourceReplay::create_render_pass, this, std::placeholders::_1, std::placeholders::_2);
-	stream_resources[ResourceType::GraphicsPipeline] = std::bind(&ResourceReplay::create_graphics_pipeline, this, std::placeholders::_1, std::placeholders::_2);
+	device_properties = properties;
 }
 
-void ResourceReplay::play(ResourceCache &resource_cache, ResourceRecord &recorder)
+void ResourceReplay::play(ResourceCache &resource_cache, const std::vector<uint8_t> &data, uint32_t thread_count)
 {
-	std::istringstream stream{recorder.get_stream().str()};
+	Timer timer;
+	timer.start();
 
-	while (true)
+	stats = {};
+
+	jobs.clear();
+	shader_module_jobs.clear();
+	shader_module_records.clear();
+	pipeline_layout_jobs.clear();
+	render_pass_jobs.clear();
+
+	if (data.empty())
 	{
-		// Read command id
-		ResourceType resource_type;
-		read(stream, resource_type);
+		return;
+	}
+
+	record::View view{data.data(), data.size()};
+
+	if (!view.is_valid())
+	{
+		LOGW("Resource cache record is invalid or was written by an incompatible version, skipping warmup.");
+		return;
+	}
+
+	auto &header = view.get_header();
+
+	if (header.vendor_id != device_properties.vendorID || header.device_id != device_properties.deviceID ||
+	    header.driver_version != device_properties.driverVersion ||
+	    std::memcmp(header.pipeline_cache_uuid, device_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+	{
+		// The record only describes objects, so it is still valid, but any matching pipeline cache data is not
+		LOGW("Resource cache record was written on a different device or driver.");
+	}
+
+	auto entries = view.get_entries();
+
+	for (uint32_t entry_index = 0; entry_index < header.entry_count; ++entry_index)
+	{
+		auto &entry = entries[entry_index];
+
+		bool parsed = false;
+
+		switch (entry.type)
+		{
+			case ResourceType::ShaderModule:
+				parsed = create_shader_module(view, entry);
+				break;
+			case ResourceType::PipelineLayout:
+				parsed = create_pipeline_layout(view, entry);
+				break;
+			case ResourceType::DescriptorSetLayout:
+				parsed = create_descriptor_set_layout(view, entry);
+				break;
+			case ResourceType::RenderPass:
+				parsed = create_render_pass(view, entry);
+				break;
+			case ResourceType::GraphicsPipeline:
+				parsed = create_graphics_pipeline(view, entry);
+				break;
+			case ResourceType::ComputePipeline:
+				parsed = create_compute_pipeline(view, entry);
+				break;
+			default:
+				LOGE("Replay command not supported.");
+				parsed = true;
+				break;
+		}
+
+		if (!parsed)
+		{
+			LOGE("Resource cache record entry #{} is malformed, skipping warmup.", entry_index);
+			jobs.clear();
+			return;
+		}
+	}
+
+	shader_modules.assign(shader_module_jobs.size(), nullptr);
+	pipeline_layouts.assign(pipeline_layout_jobs.size(), nullptr);
+	render_passes.assign(render_pass_jobs.size(), nullptr);
+
+	// Group jobs by dependency level, dependencies always precede their dependents in the record
+	std::vector<std::vector<size_t>> levels;
+	for (size_t job_index = 0; job_index < jobs.size(); ++job_index)
+	{
+		auto &job = jobs[job_index];
+		for (size_t dependency : job.dependencies)
+		{
+			assert(dependency < job_index);
+			job.level = std::max(job.level, jobs[dependency].level + 1);
+		}
 
-		if (stream.eof())
+		if (job.level >= levels.size())
 		{
-			break;
+			levels.resize(job.level + 1);
 		}
+		levels[job.level].push_back(job_index);
+	}
+
+	stats.object_count = jobs.size();
+	stats.level_count  = levels.size();
+	stats.parse_time   = timer.stop<Timer::Milliseconds>();
+
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+	stats.thread_count = thread_count;
+
+	if (SPIRVCache::is_enabled())
+	{
+		compile_shader_modules(view, thread_count);
+	}
 
-		// Find command function for the given command id
-		auto cmd_it = stream_resources.find(resource_type);
+	std::vector<double> job_times(jobs.size(), 0.0);
 
-		// Check if command replayer supports the given command
-		if (cmd_it != stream_resources.end())
+	auto run_job = [&](size_t job_index) {
+		Timer job_timer;
+		job_timer.start();
+
+		jobs[job_index].create(resource_cache);
+
+		job_times[job_index] = job_timer.stop<Timer::Milliseconds>();
+	};
+
+	timer.start();
+
+	if (thread_count == 1)
+	{
+		// Serial replay keeps the original record order
+		for (size_t job_index = 0; job_index < jobs.size(); ++job_index)
 		{
-			// Run command function
-			cmd_it->second(resource_cache, stream);
+			run_job(job_index);
 		}
-		else
+	}
+	else
+	{
+		ctpl::thread_pool thread_pool(static_cast<int>(thread_count));
+
+		for (auto &level : levels)
 		{
-			LOGE("Replay command not supported.");
+			std::vector<std::future<void>> futures;
+			futures.reserve(level.size());
+
+			for (size_t job_index : level)
+			{
+				futures.push_back(thread_pool.push([&run_job, job_index](size_t) { run_job(job_index); }));
+			}
+
+			// The next level may only start once all of its dependencies exist
+			for (auto &future : futures)
+			{
+				future.get();
+			}
 		}
 	}
+
+	jobs.clear();
+
+	stats.build_time        = timer.stop<Timer::Milliseconds>();
+	stats.serial_build_time = std::accumulate(job_times.begin(), job_times.end(), 0.0);
+
+	LOGI("Resource cache warmup: {} objects in {} levels, parsed in {:.2f} ms, {} shaders compiled in {:.2f} ms, built in {:.2f} ms across {} threads (serial estimate {:.2f} ms)",
+	     stats.object_count, stats.level_count, stats.parse_time, stats.compiled_shader_count, stats.shader_compile_time, stats.build_time, stats.thread_count, stats.serial_build_time);
 }
 
-void ResourceReplay::create_shader_module(ResourceCache &resource_cache, std::istringstream &stream)
+const ResourceReplayStats &ResourceReplay::get_stats() const
 {
-	VkShaderStageFlagBits    stage{};
-	std::string              glsl_source;
-	std::string              entry_point;
-	std::string              preamble;
-	std::vector<std::string> processes;
+	return stats;
+}
 
-	read(stream,
-	     stage,
-	     glsl_source,
-	     entry_point,
-	     preamble);
+size_t ResourceReplay::add_job(std::function<void(ResourceCache &)> &&create, std::vector<size_t> &&dependencies)
+{
+	jobs.push_back({std::move(create), std::move(dependencies)});
+	return jobs.size() - 1;
+}
+
+void ResourceReplay::compile_shader_modules(const record::View &view, uint32_t thread_count)
+{
+	Timer timer;
+	timer.start();
 
-	read_processes(stream, processes);
+	std::vector<GLSLCompileJob>  compile_jobs;
+	std::vector<SPIRVCache::Key> cache_keys;
 
-	ShaderSource shader_source{};
-	shader_source.set_source(std::move(glsl_source));
-	ShaderVariant shader_variant(std::move(preamble), std::move(processes));
+	for (auto shader_module : shader_module_records)
+	{
+		GLSLCompileJob compile_job;
+		compile_job.stage          = shader_module->stage;
+		compile_job.shader_variant = get_shader_variant(view, *shader_module);
 
-	auto &shader_module = resource_cache.request_shader_module(stage, shader_source, shader_variant);
+		std::vector<ShaderInclude> include_dependencies;
+		compile_job.glsl_source = ShaderIncludeCache::expand(std::string{view.get_string(shader_module->source)}, include_dependencies);
+
+		// The key must match the one computed by the ShaderModule constructor, which compiles with the "main" entry point
+		auto cache_key = SPIRVCache::compute_key(compile_job.stage, compile_job.glsl_source, compile_job.entry_point, compile_job.shader_variant);
+
+		if (!SPIRVCache::contains(cache_key))
+		{
+			compile_jobs.push_back(std::move(compile_job));
+			cache_keys.push_back(cache_key);
+		}
+	}
+
+	if (compile_jobs.empty())
+	{
+		return;
+	}
 
-	shader_modules.push_back(&shader_module);
+	GLSLCompiler glsl_compiler;
+
+	auto results = glsl_compiler.compile_batch(compile_jobs, thread_count);
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		auto &result = results[i];
+
+		// A failed job is not cached, the ShaderModule constructor compiles it again and reports the error
+		if (!result.success)
+		{
+			LOGW("Warmup shader compilation failed: {}", result.info_log);
+			continue;
+		}
+
+		std::vector<ShaderResource> resources;
+		SPIRVReflection             spirv_reflection;
+
+		if (spirv_reflection.reflect_shader_resources(compile_jobs[i].stage, result.spirv, resources, compile_jobs[i].shader_variant))
+		{
+			SPIRVCache::store(cache_keys[i], result.spirv, resources);
+		}
+	}
+
+	stats.compiled_shader_count = compile_jobs.size();
+	stats.shader_compile_time   = timer.stop<Timer::Milliseconds>();
 }
 
-void ResourceReplay::create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream)
+bool ResourceReplay::get_shader_module_dependencies(const record::View &view, const record::ArrayRef &shader_indices, std::vector<size_t> &dependencies)
 {
-	std::vector<size_t> shader_indices;
+	auto indices = view.get_array<uint32_t>(shader_indices);
+	if (!indices)
+	{
+		return false;
+	}
 
-	read(stream,
-	     shader_indices);
+	for (uint32_t i = 0; i < shader_indices.count; ++i)
+	{
+		if (indices[i] >= shader_module_jobs.size())
+		{
+			return false;
+		}
+		dependencies.push_back(shader_module_jobs[indices[i]]);
+	}
 
-	std::vector<ShaderModule *> shader_stages(shader_indices.size());
-	std::transform(shader_indices.begin(),
-	               shader_indices.end(),
-	               shader_stages.begin(),
-	               [&](size_t shader_index) {
-		               assert(shader_index < shader_modules.size());
-		               return shader_modules[shader_index];
-	               });
+	return true;
+}
+
+bool ResourceReplay::create_shader_module(const record::View &view, const record::Entry &entry)
+{
+	auto shader_module = view.get_record<record::ShaderModuleRecord>(entry);
+
+	if (!shader_module)
+	{
+		return false;
+	}
+
+	if (!view.get_array<record::StringRef>(shader_module->processes))
+	{
+		return false;
+	}
 
-	auto &pipeline_layout = resource_cache.request_pipeline_layout(shader_stages);
+	size_t slot = shader_module_jobs.size();
 
-	pipeline_layouts.push_back(&pipeline_layout);
+	shader_module_records.push_back(shader_module);
+
+	shader_module_jobs.push_back(add_job(
+	    [this, view, shader_module, slot](ResourceCache &resource_cache) {
+		    ShaderSource shader_source{};
+		    shader_source.set_source(std::string{view.get_string(shader_module->source)});
+		    ShaderVariant shader_variant = get_shader_variant(view, *shader_module);
+
+		    shader_modules[slot] = &resource_cache.request_shader_module(shader_module->stage, shader_source, shader_variant);
+	    },
+	    {}));
+
+	return true;
 }
 
-void ResourceReplay::create_render_pass(ResourceCache &resource_cache, std::istringstream &stream)
+bool ResourceReplay::create_pipeline_layout(const record::View &view, const record::Entry &entry)
 {
-	std::vector<Attachment>    attachments;
-	std::vector<LoadStoreInfo> load_store_infos;
-	std::vector<SubpassInfo>   subpasses;
+	auto pipeline_layout = view.get_record<record::PipelineLayoutRecord>(entry);
+
+	if (!pipeline_layout)
+	{
+		return false;
+	}
 
-	read(stream,
-	     attachments,
-	     load_store_infos);
+	std::vector<size_t> dependencies;
+	if (!get_shader_module_dependencies(view, pipeline_layout->shader_modules, dependencies))
+	{
+		return false;
+	}
 
-	read_subpass_info(stream, subpasses);
+	size_t slot = pipeline_layout_jobs.size();
 
-	auto &render_pass = resource_cache.request_render_pass(attachments, load_store_infos, subpasses);
+	pipeline_layout_jobs.push_back(add_job(
+	    [this, view, pipeline_layout, slot](ResourceCache &resource_cache) {
+		    auto shader_stages = get_shader_modules(view, pipeline_layout->shader_modules, shader_modules);
 
-	render_passes.push_back(&render_pass);
+		    pipeline_layouts[slot] = &resource_cache.request_pipeline_layout(shader_stages);
+	    },
+	    std::move(dependencies)));
+
+	return true;
+}
+
+bool ResourceReplay::create_descriptor_set_layout(const record::View &view, const record::Entry &entry)
+{
+	auto descriptor_set_layout = view.get_record<record::DescriptorSetLayoutRecord>(entry);
+
+	if (!descriptor_set_layout)
+	{
+		return false;
+	}
+
+	std::vector<size_t> dependencies;
+	if (!get_shader_module_dependencies(view, descriptor_set_layout->shader_modules, dependencies) ||
+	    !view.get_array<record::ShaderResourceRecord>(descriptor_set_layout->resources))
+	{
+		return false;
+	}
+
+	add_job(
+	    [this, view, descriptor_set_layout](ResourceCache &resource_cache) {
+		    auto shader_stages = get_shader_modules(view, descriptor_set_layout->shader_modules, shader_modules);
+
+		    auto resource_records = view.get_array<record::ShaderResourceRecord>(descriptor_set_layout->resources);
+
+		    std::vector<ShaderResource> set_resources(descriptor_set_layout->resources.count);
+		    for (uint32_t i = 0; i < descriptor_set_layout->resources.count; ++i)
+		    {
+			    auto &resource_record = resource_records[i];
+			    auto &resource        = set_resources[i];
+
+			    resource.stages                 = resource_record.stages;
+			    resource.type                   = resource_record.type;
+			    resource.mode                   = resource_record.mode;
+			    resource.set                    = resource_record.set;
+			    resource.binding                = resource_record.binding;
+			    resource.location               = resource_record.location;
+			    resource.input_attachment_index = resource_record.input_attachment_index;
+			    resource.vec_size               = resource_record.vec_size;
+			    resource.columns                = resource_record.columns;
+			    resource.array_size             = resource_record.array_size;
+			    resource.offset                 = resource_record.offset;
+			    resource.size                   = resource_record.size;
+			    resource.constant_id            = resource_record.constant_id;
+			    resource.qualifiers             = resource_record.qualifiers;
+			    resource.name                   = view.get_string(resource_record.name);
+		    }
+
+		    resource_cache.request_descriptor_set_layout(descriptor_set_layout->set_index, shader_stages, set_resources);
+	    },
+	    std::move(dependencies));
+
+	return true;
+}
+
+bool ResourceReplay::create_render_pass(const record::View &view, const record::Entry &entry)
+{
+	auto render_pass = view.get_record<record::RenderPassRecord>(entry);
+
+	if (!render_pass)
+	{
+		return false;
+	}
+
+	if (!view.get_array<Attachment>(render_pass->attachments) ||
+	    !view.get_array<LoadStoreInfo>(render_pass->load_store_infos) ||
+	    !view.get_array<record::SubpassRecord>(render_pass->subpasses))
+	{
+		return false;
+	}
+
+	size_t slot = render_pass_jobs.size();
+
+	render_pass_jobs.push_back(add_job(
+	    [this, view, render_pass, slot](ResourceCache &resource_cache) {
+		    auto attachments      = view.copy_array<Attachment>(render_pass->attachments);
+		    auto load_store_infos = view.copy_array<LoadStoreInfo>(render_pass->load_store_infos);
+		    auto subpass_records  = view.get_array<record::SubpassRecord>(render_pass->subpasses);
+
+		    std::vector<SubpassInfo> subpasses(render_pass->subpasses.count);
+		    for (uint32_t i = 0; i < render_pass->subpasses.count; ++i)
+		    {
+			    auto &subpass_record = subpass_records[i];
+			    auto &subpass        = subpasses[i];
+
+			    subpass.input_attachments                = view.copy_array<uint32_t>(subpass_record.input_attachments);
+			    subpass.output_attachments               = view.copy_array<uint32_t>(subpass_record.output_attachments);
+			    subpass.color_resolve_attachments        = view.copy_array<uint32_t>(subpass_record.color_resolve_attachments);
+			    subpass.disable_depth_stencil_attachment = subpass_record.disable_depth_stencil_attachment == VK_TRUE;
+			    subpass.depth_stencil_resolve_attachment = subpass_record.depth_stencil_resolve_attachment;
+			    subpass.depth_stencil_resolve_mode       = subpass_record.depth_stencil_resolve_mode;
+			    subpass.debug_name                       = view.get_string(subpass_record.debug_name);
+		    }
+
+		    render_passes[slot] = &resource_cache.request_render_pass(attachments, load_store_infos, subpasses);
+	    },
+	    {}));
+
+	return true;
 }
 
-void ResourceReplay::create_graphics_pipeline(ResourceCache &resource_cache, std::istringstream &stream)
+bool ResourceReplay::create_graphics_pipeline(const record::View &view, const record::Entry &entry)
 {
-	size_t   pipeline_layout_index{};
-	size_t   render_pass_index{};
-	uint32_t subpass_index{};
+	auto graphics_pipeline = view.get_record<record::GraphicsPipelineRecord>(entry);
 
-	read(stream,
-	     pipeline_layout_index,
-	     render_pass_index,
-	     subpass_index);
+	if (!graphics_pipeline)
+	{
+		return false;
+	}
 
-	std::map<uint32_t, std::vector<uint8_t>> specialization_constant_state{};
-	read(stream,
-	     specialization_constant_state);
+	if (graphics_pipeline->pipeline_layout >= pipeline_layout_jobs.size() ||
+	    graphics_pipeline->render_pass >= render_pass_jobs.size() ||
+	    !view.get_array<record::SpecializationConstantRecord>(graphics_pipeline->specialization_constants))
+	{
+		return false;
+	}
 
-	VertexInputState vertex_input_state{};
+	std::vector<size_t> dependencies{pipeline_layout_jobs[graphics_pipeline->pipeline_layout], render_pass_jobs[graphics_pipeline->render_pass]};
 
-	read(stream,
-	     vertex_input_state.attributes,
-	     vertex_input_state.bindings);
+	add_job(
+	    [this, view, graphics_pipeline](ResourceCache &resource_cache) {
+		    PipelineState pipeline_state{};
+		    pipeline_state.set_pipeline_layout(*pipeline_layouts[graphics_pipeline->pipeline_layout]);
+		    pipeline_state.set_render_pass(*render_passes[graphics_pipeline->render_pass]);
 
-	InputAssemblyState input_assembly_state{};
-	RasterizationState rasterization_state{};
-	ViewportState      viewport_state{};
-	MultisampleState   multisample_state{};
-	DepthStencilState  depth_stencil_state{};
+		    set_specialization_constants(view, graphics_pipeline->specialization_constants, pipeline_state);
 
-	read(stream,
-	     input_assembly_state,
-	     rasterization_state,
-	     viewport_state,
-	     multisample_state,
-	     depth_stencil_state);
+		    VertexInputState vertex_input_state{};
+		    vertex_input_state.bindings   = view.copy_array<VkVertexInputBindingDescription>(graphics_pipeline->vertex_bindings);
+		    vertex_input_state.attributes = view.copy_array<VkVertexInputAttributeDescription>(graphics_pipeline->vertex_attributes);
 
-	ColorBlendState color_blend_state{};
+		    ColorBlendState color_blend_state{};
+		    color_blend_state.logic_op_enable = graphics_pipeline->logic_op_enable;
+		    color_blend_state.logic_op        = graphics_pipeline->logic_op;
+		    color_blend_state.attachments     = view.copy_array<ColorBlendAttachmentState>(graphics_pipeline->color_blend_attachments);
 
-	read(stream,
-	     color_blend_state.logic_op,
-	     color_blend_state.logic_op_enable,
-	     color_blend_state.attachments);
+		    pipeline_state.set_subpass_index(graphics_pipeline->subpass_index);
+		    pipeline_state.set_vertex_input_state(vertex_input_state);
+		    pipeline_state.set_input_assembly_state(graphics_pipeline->input_assembly_state);
+		    pipeline_state.set_rasterization_state(graphics_pipeline->rasterization_state);
+		    pipeline_state.set_viewport_state(graphics_pipeline->viewport_state);
+		    pipeline_state.set_multisample_state(graphics_pipeline->multisample_state);
+		    pipeline_state.set_depth_stencil_state(graphics_pipeline->depth_stencil_state);
+		    pipeline_state.set_color_blend_state(color_blend_state);
 
-	PipelineState pipeline_state{};
-	assert(pipeline_layout_index < pipeline_layouts.size());
-	pipeline_state.set_pipeline_layout(*pipeline_layouts[pipeline_layout_index]);
-	assert(render_pass_index < render_passes.size());
-	pipeline_state.set_render_pass(*render_passes[render_pass_index]);
+		    resource_cache.request_graphics_pipeline(pipeline_state);
+	    },
+	    std::move(dependencies));
 
-	for (auto &item : specialization_constant_state)
+	return true;
+}
+
+bool ResourceReplay::create_compute_pipeline(const record::View &view, const record::Entry &entry)
+{
+	auto compute_pipeline = view.get_record<record::ComputePipelineRecord>(entry);
+
+	if (!compute_pipeline)
+	{
+		return false;
+	}
+
+	if (compute_pipeline->pipeline_layout >= pipeline_layout_jobs.size() ||
+	    !view.get_array<record::SpecializationConstantRecord>(compute_pipeline->specialization_constants))
 	{
-		pipeline_state.set_specialization_constant(item.first, item.second);
+		return false;
 	}
 
-	pipeline_state.set_subpass_index(subpass_index);
-	pipeline_state.set_vertex_input_state(vertex_input_state);
-	pipeline_state.set_input_assembly_state(input_assembly_state);
-	pipeline_state.set_rasterization_state(rasterization_state);
-	pipeline_state.set_viewport_state(viewport_state);
-	pipeline_state.set_multisample_state(multisample_state);
-	pipeline_state.set_depth_stencil_state(depth_stencil_state);
-	pipeline_state.set_color_blend_state(color_blend_state);
+	std::vector<size_t> dependencies{pipeline_layout_jobs[compute_pipeline->pipeline_layout]};
+
+	add_job(
+	    [this, view, compute_pipeline](ResourceCache &resource_cache) {
+		    PipelineState pipeline_state{};
+		    pipeline_state.set_pipeline_layout(*pipeline_layouts[compute_pipeline->pipeline_layout]);
+
+		    set_specialization_constants(view, compute_pipeline->specialization_constants, pipeline_state);
 
-	auto &graphics_pipeline = resource_cache.request_graphics_pipeline(pipeline_state);
+		    resource_cache.request_compute_pipeline(pipeline_state);
+	    },
+	    std::move(dependencies));
 
-	graphics_pipelines.push_back(&graphics_pipeline);
+	return true;
 }
 }        // namespace vkb
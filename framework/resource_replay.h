@@ -1,4 +1,4 @@
-/* Copyright (c) 2019, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -24,28 +24,106 @@ namespace vkb
 class ResourceCache;
 
 /**
- * @brief Reads Vulkan objects from a memory stream and creates them in the resource cache.
+ * @brief Timings of the last ResourceReplay::play call
+ */
+struct ResourceReplayStats
+{
+	/// Number of worker threads used to build the objects
+	uint32_t thread_count{0};
+
+	/// Number of objects replayed
+	size_t object_count{0};
+
+	/// Number of dependency levels, objects within a level are built concurrently
+	size_t level_count{0};
+
+	/// Time spent reading the record, in milliseconds
+	double parse_time{0.0};
+
+	/// Number of shader modules compiled as one batch before the build, modules found in the SPIR-V cache are not compiled
+	size_t compiled_shader_count{0};
+
+	/// Wall-clock time spent compiling and reflecting that batch, in milliseconds
+	double shader_compile_time{0.0};
+
+	/// Wall-clock time spent building all objects, in milliseconds
+	double build_time{0.0};
+
+	/// Sum of the build time of every object, i.e. the cost of a serial replay, in milliseconds
+	double serial_build_time{0.0};
+};
+
+/**
+ * @brief Reads Vulkan objects from a serialized record and creates them in the resource cache.
+ *
+ * The record is first parsed into a dependency graph: shader modules and render passes have no
+ * dependencies, pipeline layouts and descriptor set layouts depend on their shader modules and
+ * pipelines depend on their pipeline layout and render pass. Objects are then built level by level,
+ * with every object of a level built concurrently on a worker pool. Records are read in place from
+ * the serialized data, which must outlive the call to play.
+ *
+ * When the SPIR-V cache is enabled, the shader modules missing from it are first compiled together with
+ * GLSLCompiler::compile_batch and stored in the cache, so that creating them only loads their SPIR-V.
  */
 class ResourceReplay
 {
   public:
-	ResourceReplay();
+	/**
+	 * @brief Sets the device identity that serialized records are expected to come from
+	 */
+	void set_device_properties(const VkPhysicalDeviceProperties &properties);
 
-	void play(ResourceCache &resource_cache, ResourceRecord &recorder);
+	/**
+	 * @brief Creates every object of the record in the resource cache
+	 * @param resource_cache The cache to warm up
+	 * @param data The serialized record, see vkb::record for the layout
+	 * @param thread_count Number of worker threads, 0 uses the hardware concurrency and 1 replays serially
+	 */
+	void play(ResourceCache &resource_cache, const std::vector<uint8_t> &data, uint32_t thread_count = 0);
+
+	const ResourceReplayStats &get_stats() const;
 
   protected:
-	void create_shader_module(ResourceCache &resource_cache, std::istringstream &stream);
+	bool create_shader_module(const record::View &view, const record::Entry &entry);
+
+	bool create_pipeline_layout(const record::View &view, const record::Entry &entry);
 
-	void create_pipeline_layout(ResourceCache &resource_cache, std::istringstream &stream);
+	bool create_descriptor_set_layout(const record::View &view, const record::Entry &entry);
 
-	void create_render_pass(ResourceCache &resource_cache, std::istringstream &stream);
+	bool create_render_pass(const record::View &view, const record::Entry &entry);
 
-	void create_graphics_pipeline(ResourceCache &resource_cache, std::istringstream &stream);
+	bool create_graphics_pipeline(const record::View &view, const record::Entry &entry);
+
+	bool create_compute_pipeline(const record::View &view, const record::Entry &entry);
 
   private:
-	using ResourceFunc = std::function<void(ResourceCache &, std::istringstream &)>;
+	/// A deferred object creation, with the jobs it depends on
+	struct ReplayJob
+	{
+		std::function<void(ResourceCache &)> create;
+
+		std::vector<size_t> dependencies;
+
+		size_t level{0};
+	};
+
+	size_t add_job(std::function<void(ResourceCache &)> &&create, std::vector<size_t> &&dependencies);
+
+	void compile_shader_modules(const record::View &view, uint32_t thread_count);
+
+	bool get_shader_module_dependencies(const record::View &view, const record::ArrayRef &shader_indices, std::vector<size_t> &dependencies);
+
+	VkPhysicalDeviceProperties device_properties{};
+
+	std::vector<ReplayJob> jobs;
+
+	std::vector<size_t> shader_module_jobs;
+
+	std::vector<const record::ShaderModuleRecord *> shader_module_records;
+
+	std::vector<size_t> pipeline_layout_jobs;
 
-	std::unordered_map<ResourceType, ResourceFunc> stream_resources;
+	std::vector<size_t> render_pass_jobs;
 
 	std::vector<ShaderModule *> shader_modules;
 
@@ -53,6 +131,6 @@ class ResourceReplay
 
 	std::vector<const RenderPass *> render_passes;
 
-	std::vector<const GraphicsPipeline *> graphics_pipelines;
+	ResourceReplayStats stats;
 };
 }        // namespace vkb
@@ -0,0 +1,798 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "common/helpers.h"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "gltf_loader.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t SCENE_CACHE_MAGIC   = 0x434e4353;        // "SCNC"
+constexpr uint32_t SCENE_CACHE_VERSION = 2;
+
+constexpr size_t HEADER_SIZE = 2 * sizeof(uint32_t) + 2 * sizeof(Hash128);
+
+/// Appends values to a blob, vectors are stored as their size followed by their elements
+class BlobWriter
+{
+  public:
+	template <class T>
+	void write(const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+		write(&value, sizeof(T));
+	}
+
+	void write(const void *src, size_t size)
+	{
+		auto bytes = reinterpret_cast<const uint8_t *>(src);
+		data.insert(data.end(), bytes, bytes + size);
+	}
+
+	void write(const std::string &value)
+	{
+		write(static_cast<uint64_t>(value.size()));
+		write(value.data(), value.size());
+	}
+
+	template <class T>
+	void write(const std::vector<T> &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+		write(static_cast<uint64_t>(value.size()));
+		write(value.data(), value.size() * sizeof(T));
+	}
+
+	std::vector<uint8_t> data;
+};
+
+/// Bounds-checked reader over a mapped blob, the counterpart of BlobWriter
+class BlobReader
+{
+  public:
+	BlobReader(std::span<const uint8_t> data, size_t offset) :
+	    data{data}, offset{offset}
+	{}
+
+	template <class T>
+	bool read(T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+		return read(&value, sizeof(T));
+	}
+
+	bool read(void *dst, size_t size)
+	{
+		if (size > data.size() - offset)
+		{
+			return false;
+		}
+
+		std::memcpy(dst, data.data() + offset, size);
+		offset += size;
+		return true;
+	}
+
+	bool read(std::string &value)
+	{
+		uint64_t size{};
+		if (!read(size) || size > data.size() - offset)
+		{
+			return false;
+		}
+
+		value.resize(size);
+		return read(value.data(), value.size());
+	}
+
+	template <class T>
+	bool read(std::vector<T> &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+		uint64_t size{};
+		if (!read(size) || size > (data.size() - offset) / sizeof(T))
+		{
+			return false;
+		}
+
+		value.resize(size);
+		return read(value.data(), value.size() * sizeof(T));
+	}
+
+	/// Reads a byte vector as a view into the blob rather than a copy
+	bool read(std::span<const uint8_t> &value)
+	{
+		uint64_t size{};
+		if (!read(size) || size > data.size() - offset)
+		{
+			return false;
+		}
+
+		value = data.subspan(offset, size);
+		offset += size;
+		return true;
+	}
+
+	/// Reads an element count, bounded by the remaining size so that a corrupted count can't exhaust memory
+	bool read_count(uint64_t &count)
+	{
+		return read(count) && count <= data.size() - offset;
+	}
+
+	bool at_end() const
+	{
+		return offset == data.size();
+	}
+
+  private:
+	std::span<const uint8_t> data;
+
+	size_t offset;
+};
+
+Hash128 get_checksum(const uint8_t *data, size_t size)
+{
+	Hasher hasher;
+	hasher.update(data, size);
+	return hasher.get_hash();
+}
+
+/// Hashes the metadata of the source files, so that checking them only takes a stat of each file
+Hash128 get_source_hash(const std::vector<std::string> &sources)
+{
+	auto fs = vkb::filesystem::get();
+
+	Hasher hasher;
+
+	for (auto &source : sources)
+	{
+		auto stat = fs->stat_file(source);
+
+		hasher.update(source);
+		hasher.update(stat.is_file);
+		hasher.update(static_cast<uint64_t>(stat.size));
+		hasher.update(stat.last_write_time);
+	}
+
+	return hasher.get_hash();
+}
+
+void write_strings(BlobWriter &writer, const std::vector<std::string> &values)
+{
+	writer.write(static_cast<uint64_t>(values.size()));
+	for (auto &value : values)
+	{
+		writer.write(value);
+	}
+}
+
+bool read_strings(BlobReader &reader, std::vector<std::string> &values)
+{
+	uint64_t count{};
+
+	bool valid = reader.read_count(count);
+
+	values.resize(valid ? count : 0);
+	for (auto &value : values)
+	{
+		valid = valid && reader.read(value);
+	}
+
+	return valid;
+}
+
+void write_parameters(BlobWriter &writer, const tinygltf::ParameterMap &parameters)
+{
+	writer.write(static_cast<uint64_t>(parameters.size()));
+	for (auto &[name, parameter] : parameters)
+	{
+		writer.write(name);
+		writer.write(parameter.bool_value);
+		writer.write(parameter.has_number_value);
+		writer.write(parameter.number_value);
+		writer.write(parameter.string_value);
+		writer.write(parameter.number_array);
+
+		writer.write(static_cast<uint64_t>(parameter.json_double_value.size()));
+		for (auto &[key, value] : parameter.json_double_value)
+		{
+			writer.write(key);
+			writer.write(value);
+		}
+	}
+}
+
+bool read_parameters(BlobReader &reader, tinygltf::ParameterMap &parameters)
+{
+	uint64_t count{};
+
+	bool valid = reader.read_count(count);
+
+	for (uint64_t i = 0; valid && i < count; ++i)
+	{
+		std::string         name;
+		tinygltf::Parameter parameter;
+		uint64_t            value_count{};
+
+		valid = reader.read(name) && reader.read(parameter.bool_value) && reader.read(parameter.has_number_value) &&
+		        reader.read(parameter.number_value) && reader.read(parameter.string_value) && reader.read(parameter.number_array) &&
+		        reader.read_count(value_count);
+
+		for (uint64_t j = 0; valid && j < value_count; ++j)
+		{
+			std::string key;
+			double      value{};
+
+			valid = reader.read(key) && reader.read(value);
+
+			parameter.json_double_value[key] = value;
+		}
+
+		parameters[name] = std::move(parameter);
+	}
+
+	return valid;
+}
+
+/// Writes the parts of the model the scene graph is built from, the buffers, accessors and image data are not needed once processed
+void write_model(BlobWriter &writer, const tinygltf::Model &model)
+{
+	write_strings(writer, model.extensionsUsed);
+	write_strings(writer, model.extensionsRequired);
+
+	writer.write(static_cast<uint64_t>(model.images.size()));
+	for (auto &gltf_image : model.images)
+	{
+		writer.write(gltf_image.name);
+		writer.write(gltf_image.uri);
+	}
+
+	writer.write(static_cast<uint64_t>(model.samplers.size()));
+	for (auto &gltf_sampler : model.samplers)
+	{
+		writer.write(gltf_sampler.name);
+		writer.write(gltf_sampler.minFilter);
+		writer.write(gltf_sampler.magFilter);
+		writer.write(gltf_sampler.wrapS);
+		writer.write(gltf_sampler.wrapT);
+	}
+
+	writer.write(static_cast<uint64_t>(model.textures.size()));
+	for (auto &gltf_texture : model.textures)
+	{
+		writer.write(gltf_texture.name);
+		writer.write(gltf_texture.source);
+		writer.write(gltf_texture.sampler);
+	}
+
+	writer.write(static_cast<uint64_t>(model.materials.size()));
+	for (auto &gltf_material : model.materials)
+	{
+		writer.write(gltf_material.name);
+		write_parameters(writer, gltf_material.values);
+		write_parameters(writer, gltf_material.additionalValues);
+	}
+
+	writer.write(static_cast<uint64_t>(model.meshes.size()));
+	for (auto &gltf_mesh : model.meshes)
+	{
+		writer.write(gltf_mesh.name);
+
+		writer.write(static_cast<uint64_t>(gltf_mesh.primitives.size()));
+		for (auto &gltf_primitive : gltf_mesh.primitives)
+		{
+			writer.write(gltf_primitive.indices);
+			writer.write(gltf_primitive.material);
+		}
+	}
+
+	writer.write(static_cast<uint64_t>(model.cameras.size()));
+	for (auto &gltf_camera : model.cameras)
+	{
+		writer.write(gltf_camera.name);
+		writer.write(gltf_camera.type);
+		writer.write(gltf_camera.perspective.aspectRatio);
+		writer.write(gltf_camera.perspective.yfov);
+		writer.write(gltf_camera.perspective.znear);
+		writer.write(gltf_camera.perspective.zfar);
+	}
+
+	writer.write(static_cast<uint64_t>(model.nodes.size()));
+	for (auto &gltf_node : model.nodes)
+	{
+		writer.write(gltf_node.name);
+		writer.write(gltf_node.translation);
+		writer.write(gltf_node.rotation);
+		writer.write(gltf_node.scale);
+		writer.write(gltf_node.matrix);
+		writer.write(gltf_node.mesh);
+		writer.write(gltf_node.camera);
+		writer.write(gltf_node.children);
+
+		// The light of the node is the only extension the loader reads
+		int  light     = -1;
+		auto extension = gltf_node.extensions.find(KHR_LIGHTS_PUNCTUAL_EXTENSION);
+		if (extension != gltf_node.extensions.end() && extension->second.Has("light"))
+		{
+			light = extension->second.Get("light").Get<int>();
+		}
+		writer.write(light);
+	}
+
+	writer.write(static_cast<uint64_t>(model.animations.size()));
+	for (auto &gltf_animation : model.animations)
+	{
+		writer.write(gltf_animation.name);
+
+		writer.write(static_cast<uint64_t>(gltf_animation.channels.size()));
+		for (auto &gltf_channel : gltf_animation.channels)
+		{
+			writer.write(gltf_channel.sampler);
+			writer.write(gltf_channel.target_node);
+			writer.write(gltf_channel.target_path);
+		}
+	}
+
+	writer.write(static_cast<uint64_t>(model.scenes.size()));
+	for (auto &gltf_scene : model.scenes)
+	{
+		writer.write(gltf_scene.name);
+		writer.write(gltf_scene.nodes);
+	}
+
+	writer.write(model.defaultScene);
+}
+
+/// Reads back the model written by write_model, the element counts are bounded by the remaining size of the blob
+bool read_model(BlobReader &reader, tinygltf::Model &model)
+{
+	uint64_t count{};
+
+	bool valid = read_strings(reader, model.extensionsUsed) && read_strings(reader, model.extensionsRequired) && reader.read_count(count);
+
+	model.images.resize(valid ? count : 0);
+	for (auto &gltf_image : model.images)
+	{
+		valid = valid && reader.read(gltf_image.name) && reader.read(gltf_image.uri);
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.samplers.resize(valid ? count : 0);
+	for (auto &gltf_sampler : model.samplers)
+	{
+		valid = valid && reader.read(gltf_sampler.name) && reader.read(gltf_sampler.minFilter) && reader.read(gltf_sampler.magFilter) &&
+		        reader.read(gltf_sampler.wrapS) && reader.read(gltf_sampler.wrapT);
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.textures.resize(valid ? count : 0);
+	for (auto &gltf_texture : model.textures)
+	{
+		valid = valid && reader.read(gltf_texture.name) && reader.read(gltf_texture.source) && reader.read(gltf_texture.sampler);
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.materials.resize(valid ? count : 0);
+	for (auto &gltf_material : model.materials)
+	{
+		valid = valid && reader.read(gltf_material.name) && read_parameters(reader, gltf_material.values) &&
+		        read_parameters(reader, gltf_material.additionalValues);
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.meshes.resize(valid ? count : 0);
+	for (auto &gltf_mesh : model.meshes)
+	{
+		uint64_t primitive_count{};
+
+		valid = valid && reader.read(gltf_mesh.name) && reader.read_count(primitive_count);
+
+		gltf_mesh.primitives.resize(valid ? primitive_count : 0);
+		for (auto &gltf_primitive : gltf_mesh.primitives)
+		{
+			valid = valid && reader.read(gltf_primitive.indices) && reader.read(gltf_primitive.material);
+		}
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.cameras.resize(valid ? count : 0);
+	for (auto &gltf_camera : model.cameras)
+	{
+		valid = valid && reader.read(gltf_camera.name) && reader.read(gltf_camera.type) &&
+		        reader.read(gltf_camera.perspective.aspectRatio) && reader.read(gltf_camera.perspective.yfov) &&
+		        reader.read(gltf_camera.perspective.znear) && reader.read(gltf_camera.perspective.zfar);
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.nodes.resize(valid ? count : 0);
+	for (auto &gltf_node : model.nodes)
+	{
+		int light = -1;
+
+		valid = valid && reader.read(gltf_node.name) && reader.read(gltf_node.translation) && reader.read(gltf_node.rotation) &&
+		        reader.read(gltf_node.scale) && reader.read(gltf_node.matrix) && reader.read(gltf_node.mesh) &&
+		        reader.read(gltf_node.camera) && reader.read(gltf_node.children) && reader.read(light);
+
+		if (valid && light >= 0)
+		{
+			gltf_node.extensions[KHR_LIGHTS_PUNCTUAL_EXTENSION] = tinygltf::Value(tinygltf::Value::Object{{"light", tinygltf::Value(light)}});
+		}
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.animations.resize(valid ? count : 0);
+	for (auto &gltf_animation : model.animations)
+	{
+		uint64_t channel_count{};
+
+		valid = valid && reader.read(gltf_animation.name) && reader.read_count(channel_count);
+
+		gltf_animation.channels.resize(valid ? channel_count : 0);
+		for (auto &gltf_channel : gltf_animation.channels)
+		{
+			valid = valid && reader.read(gltf_channel.sampler) && reader.read(gltf_channel.target_node) && reader.read(gltf_channel.target_path);
+		}
+	}
+
+	valid = valid && reader.read_count(count);
+
+	model.scenes.resize(valid ? count : 0);
+	for (auto &gltf_scene : model.scenes)
+	{
+		valid = valid && reader.read(gltf_scene.name) && reader.read(gltf_scene.nodes);
+	}
+
+	return valid && reader.read(model.defaultScene);
+}
+
+void write_animation_samplers(BlobWriter &writer, const std::vector<sg::AnimationSampler> &samplers)
+{
+	writer.write(static_cast<uint64_t>(samplers.size()));
+	for (auto &sampler : samplers)
+	{
+		writer.write(sampler.type);
+		writer.write(sampler.inputs);
+		writer.write(sampler.outputs);
+	}
+}
+
+bool read_animation_samplers(BlobReader &reader, std::vector<sg::AnimationSampler> &samplers)
+{
+	uint64_t count{};
+
+	bool valid = reader.read_count(count);
+
+	samplers.resize(valid ? count : 0);
+	for (auto &sampler : samplers)
+	{
+		valid = valid && reader.read(sampler.type) && reader.read(sampler.inputs) && reader.read(sampler.outputs);
+	}
+
+	return valid;
+}
+
+void write_image(BlobWriter &writer, const SceneCache::Image &image)
+{
+	writer.write(image.name);
+	writer.write(image.format);
+	writer.write(image.layers);
+	writer.write(image.mipmaps);
+
+	writer.write(static_cast<uint64_t>(image.offsets.size()));
+	for (auto &layer_offsets : image.offsets)
+	{
+		writer.write(layer_offsets);
+	}
+
+	writer.write(image.data);
+}
+
+bool read_image(BlobReader &reader, SceneCache::Image &image)
+{
+	uint64_t layer_count{};
+
+	bool valid = reader.read(image.name) && reader.read(image.format) && reader.read(image.layers) &&
+	             reader.read(image.mipmaps) && reader.read_count(layer_count);
+
+	image.offsets.resize(valid ? layer_count : 0);
+	for (auto &layer_offsets : image.offsets)
+	{
+		valid = valid && reader.read(layer_offsets);
+	}
+
+	valid = valid && reader.read(image.mapped_data);
+
+	// Every mip level has to be within the image data
+	return valid && !image.mipmaps.empty() &&
+	       std::ranges::all_of(image.mipmaps, [&image](const sg::Mipmap &mipmap) { return mipmap.offset < image.mapped_data.size(); });
+}
+
+void write_primitive(BlobWriter &writer, const SceneCache::Primitive &primitive)
+{
+	writer.write(static_cast<uint64_t>(primitive.streams.size()));
+	for (auto &stream : primitive.streams)
+	{
+		writer.write(stream.name);
+		writer.write(stream.data);
+
+		writer.write(static_cast<uint64_t>(stream.attribute_names.size()));
+		for (auto &attribute_name : stream.attribute_names)
+		{
+			writer.write(attribute_name);
+		}
+	}
+
+	writer.write(static_cast<uint64_t>(primitive.attributes.size()));
+	for (auto &attribute : primitive.attributes)
+	{
+		writer.write(attribute.first);
+		writer.write(attribute.second);
+	}
+
+	writer.write(primitive.index_data);
+	writer.write(primitive.index_type);
+	writer.write(primitive.vertex_indices);
+	writer.write(primitive.vertices_count);
+
+	writer.write(primitive.meshlets.meshlets);
+	writer.write(primitive.meshlets.bounds);
+	writer.write(primitive.meshlets.vertices);
+	writer.write(primitive.meshlets.triangles);
+}
+
+bool read_primitive(BlobReader &reader, SceneCache::Primitive &primitive)
+{
+	uint64_t stream_count{};
+
+	bool valid = reader.read_count(stream_count);
+
+	primitive.streams.resize(valid ? stream_count : 0);
+	for (auto &stream : primitive.streams)
+	{
+		uint64_t attribute_name_count{};
+
+		valid = valid && reader.read(stream.name) && reader.read(stream.data) && reader.read_count(attribute_name_count);
+
+		stream.attribute_names.resize(valid ? attribute_name_count : 0);
+		for (auto &attribute_name : stream.attribute_names)
+		{
+			valid = valid && reader.read(attribute_name);
+		}
+	}
+
+	uint64_t attribute_count{};
+
+	valid = valid && reader.read_count(attribute_count);
+
+	for (uint64_t i = 0; valid && i < attribute_count; ++i)
+	{
+		std::string         name;
+		sg::VertexAttribute attribute;
+
+		valid = reader.read(name) && reader.read(attribute);
+
+		primitive.attributes[name] = attribute;
+	}
+
+	return valid && reader.read(primitive.index_data) && reader.read(primitive.index_type) &&
+	       reader.read(primitive.vertex_indices) && reader.read(primitive.vertices_count) &&
+	       reader.read(primitive.meshlets.meshlets) && reader.read(primitive.meshlets.bounds) &&
+	       reader.read(primitive.meshlets.vertices) && reader.read(primitive.meshlets.triangles);
+}
+}        // namespace
+
+bool SceneCache::load(const Hash128 &key, tinygltf::Model &model, Entry &entry)
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_entry_path(key);
+
+	if (!fs->is_file(path))
+	{
+		return false;
+	}
+
+	filesystem::MappedFilePtr file;
+
+	try
+	{
+		file = fs->map_file(path);
+	}
+	catch (const std::exception &e)
+	{
+		// The entry may have been replaced between stat and read
+		LOGW("Failed to read scene cache entry {}: {}", path, e.what());
+		return false;
+	}
+
+	// The entry is decoded straight from the mapping, the image pixels are left in it
+	auto data = file->get_data();
+
+	BlobReader reader{data, 0};
+
+	uint32_t magic{};
+	uint32_t version{};
+	Hash128  stored_key{};
+	Hash128  checksum{};
+
+	bool valid = reader.read(magic) && reader.read(version) && reader.read(stored_key) && reader.read(checksum);
+
+	valid = valid && magic == SCENE_CACHE_MAGIC && version == SCENE_CACHE_VERSION && stored_key == key;
+
+	Entry   cached;
+	Hash128 source_hash{};
+
+	valid = valid && read_strings(reader, cached.sources) && reader.read(source_hash);
+
+	// The key only covers the glTF file, the buffer and image files it references are checked here,
+	// before the whole entry is checksummed
+	if (valid && source_hash != get_source_hash(cached.sources))
+	{
+		LOGI("Scene cache entry {} is stale, its source files changed", path);
+		return false;
+	}
+
+	valid = valid && checksum == get_checksum(data.data() + HEADER_SIZE, data.size() - HEADER_SIZE);
+
+	tinygltf::Model cached_model;
+
+	valid = valid && read_model(reader, cached_model);
+
+	uint64_t light_count{};
+	valid = valid && reader.read_count(light_count);
+
+	cached.lights.resize(valid ? light_count : 0);
+	for (auto &light : cached.lights)
+	{
+		valid = valid && reader.read(light.name) && reader.read(light.type) && reader.read(light.properties);
+	}
+
+	uint64_t animation_count{};
+	valid = valid && reader.read_count(animation_count);
+
+	cached.animation_samplers.resize(valid ? animation_count : 0);
+	for (auto &samplers : cached.animation_samplers)
+	{
+		valid = valid && read_animation_samplers(reader, samplers);
+	}
+
+	uint64_t image_count{};
+	valid = valid && reader.read_count(image_count);
+
+	cached.images.resize(valid ? image_count : 0);
+	for (auto &image : cached.images)
+	{
+		valid = valid && read_image(reader, image);
+	}
+
+	uint64_t primitive_count{};
+	valid = valid && reader.read_count(primitive_count);
+
+	cached.primitives.resize(valid ? primitive_count : 0);
+	for (auto &primitive : cached.primitives)
+	{
+		valid = valid && read_primitive(reader, primitive);
+	}
+
+	// Every image, primitive and animation of the model has its processed data
+	size_t model_primitive_count = 0;
+	for (auto &gltf_mesh : cached_model.meshes)
+	{
+		model_primitive_count += gltf_mesh.primitives.size();
+	}
+
+	valid = valid && cached.images.size() == cached_model.images.size() && cached.primitives.size() == model_primitive_count &&
+	        cached.animation_samplers.size() == cached_model.animations.size();
+
+	if (!valid || !reader.at_end())
+	{
+		LOGW("Discarding invalid scene cache entry {}", path);
+		return false;
+	}
+
+	cached.file = std::move(file);
+
+	model = std::move(cached_model);
+	entry = std::move(cached);
+
+	return true;
+}
+
+void SceneCache::store(const Hash128 &key, const tinygltf::Model &model, const Entry &entry)
+{
+	BlobWriter writer;
+
+	// The header is filled in once the payload checksum is known
+	writer.data.resize(HEADER_SIZE);
+
+	write_strings(writer, entry.sources);
+	writer.write(get_source_hash(entry.sources));
+
+	write_model(writer, model);
+
+	writer.write(static_cast<uint64_t>(entry.lights.size()));
+	for (auto &light : entry.lights)
+	{
+		writer.write(light.name);
+		writer.write(light.type);
+		writer.write(light.properties);
+	}
+
+	writer.write(static_cast<uint64_t>(entry.animation_samplers.size()));
+	for (auto &samplers : entry.animation_samplers)
+	{
+		write_animation_samplers(writer, samplers);
+	}
+
+	writer.write(static_cast<uint64_t>(entry.images.size()));
+	for (auto &image : entry.images)
+	{
+		write_image(writer, image);
+	}
+
+	writer.write(static_cast<uint64_t>(entry.primitives.size()));
+	for (auto &primitive : entry.primitives)
+	{
+		write_primitive(writer, primitive);
+	}
+
+	auto checksum = get_checksum(writer.data.data() + HEADER_SIZE, writer.data.size() - HEADER_SIZE);
+
+	std::ostringstream header;
+	write(header, SCENE_CACHE_MAGIC, SCENE_CACHE_VERSION, key, checksum);
+
+	std::string header_data = header.str();
+	assert(header_data.size() == HEADER_SIZE);
+	std::ranges::copy(header_data, writer.data.begin());
+
+	auto path = get_entry_path(key);
+
+	try
+	{
+		vkb::filesystem::get()->write_file_atomic(path, writer.data);
+
+		LOGI("Stored scene cache entry {} ({} KB)", path, writer.data.size() / 1024);
+	}
+	catch (const std::exception &e)
+	{
+		LOGW("Failed to write scene cache entry {}: {}", path, e.what());
+	}
+}
+
+std::string SceneCache::get_entry_path(const Hash128 &key)
+{
+	auto path = vkb::filesystem::get()->temp_directory() / "scene_cache" / fmt::format("{:016x}{:016x}{:016x}.scene", key.high, key.low, key.check);
+	return path.string();
+}
+}        // namespace vkb
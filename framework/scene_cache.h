@@ -0,0 +1,157 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define TINYGLTF_NO_STB_IMAGE
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#define TINYGLTF_NO_EXTERNAL_IMAGE
+#include <tiny_gltf.h>
+
+#include "common/vk_common.h"
+#include "core/util/hash.hpp"
+#include "filesystem/filesystem.hpp"
+#include "geometry/meshlet_builder.h"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/scripts/animation.h"
+
+namespace vkb
+{
+/**
+ * @brief Persistent cache of the processed data of a glTF scene
+ *
+ * An entry holds everything the scene graph is built from, so that a warm load doesn't parse the glTF file:
+ * the nodes, transforms, materials, textures, samplers, cameras and scenes of the model, the lights and the
+ * animation data, the vertex and index data of every primitive after format conversion, vertex layout,
+ * optimization and meshlet generation, and the pixels of every image after decoding and mip generation.
+ *
+ * The caller keys an entry on the metadata of the glTF file and on the loader options. The entry records
+ * the files the scene was read from and a hash of their metadata, which is checked on load, so that an
+ * entry whose glTF, buffer or image files changed since it was written is a miss.
+ *
+ * Entries are stored as single files in the temporary directory, written to a unique file then renamed
+ * into place. Every entry is validated on load, a mismatch is treated as a miss.
+ *
+ * A loaded entry keeps its file mapped, and the image pixels are left in the mapping for the uploads to
+ * stage them from it. The vertex and index data are copied out of the mapping once, into the vectors the
+ * scene buffers are created from.
+ */
+class SceneCache
+{
+  public:
+	/// Vertex data bound as a single vertex buffer, holding one or several interleaved attributes
+	struct Stream
+	{
+		std::string name;
+
+		std::vector<uint8_t> data;
+
+		std::vector<std::string> attribute_names;
+	};
+
+	struct Primitive
+	{
+		std::vector<Stream> streams;
+
+		std::unordered_map<std::string, sg::VertexAttribute> attributes;
+
+		std::vector<uint8_t> index_data;
+
+		VkIndexType index_type{VK_INDEX_TYPE_UINT16};
+
+		uint32_t vertex_indices{0};
+
+		uint32_t vertices_count{0};
+
+		MeshletData meshlets;
+	};
+
+	struct Image
+	{
+		std::string name;
+
+		VkFormat format{VK_FORMAT_UNDEFINED};
+
+		uint32_t layers{1};
+
+		std::vector<sg::Mipmap> mipmaps;
+
+		std::vector<std::vector<VkDeviceSize>> offsets;
+
+		/// The pixels written by store
+		std::vector<uint8_t> data;
+
+		/// The pixels read by load, within the mapping of the entry
+		std::span<const uint8_t> mapped_data;
+	};
+
+	struct Light
+	{
+		std::string name;
+
+		sg::LightType type{sg::LightType::Directional};
+
+		sg::LightProperties properties;
+	};
+
+	/// The data of an entry besides the glTF model
+	struct Entry
+	{
+		/// The paths of the files the scene was read from
+		std::vector<std::string> sources;
+
+		std::vector<Light> lights;
+
+		/// The samplers of each animation of the model, read from its accessors
+		std::vector<std::vector<sg::AnimationSampler>> animation_samplers;
+
+		std::vector<Image> images;
+
+		std::vector<Primitive> primitives;
+
+		/// The mapping of a loaded entry, which has to outlive the uses of the mapped image data
+		filesystem::MappedFilePtr file;
+	};
+
+	/**
+	 * @brief Loads a cached entry
+	 * @param key The key of the entry
+	 * @param[out] model The cached parts of the glTF model
+	 * @param[out] entry The rest of the cached data
+	 * @return True if a valid entry was found whose sources are unchanged, false otherwise
+	 */
+	static bool load(const Hash128 &key, tinygltf::Model &model, Entry &entry);
+
+	/**
+	 * @brief Stores an entry, replacing any previous entry with the same key
+	 * @param key The key of the entry
+	 * @param model The glTF model, it is stored without its buffers, accessors and image data
+	 * @param entry The processed data of the scene
+	 */
+	static void store(const Hash128 &key, const tinygltf::Model &model, const Entry &entry);
+
+  private:
+	static std::string get_entry_path(const Hash128 &key);
+};
+}        // namespace vkb
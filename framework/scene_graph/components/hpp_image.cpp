@@ -18,6 +18,7 @@
 #include "hpp_image.h"
 
 #include "common/hpp_utils.h"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
@@ -49,7 +50,9 @@ std::unique_ptr<vkb::scene_graph::components::HPPImage> HPPImage::load(const std
 {
 	std::unique_ptr<vkb::scene_graph::components::HPPImage> image{nullptr};
 
-	auto data = fs::read_asset(uri);
+	// Decode straight from the mapped file, the mapping is released once the image is decoded
+	auto file = fs::map_asset(uri);
+	auto data = file->get_data();
 
 	// Get extension
 	auto extension = get_extension(uri);
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,6 +18,7 @@
 #include "image.h"
 
 #include <mutex>
+#include <utility>
 
 #include "common/error.h"
 
@@ -25,6 +26,7 @@
 #include <stb_image_resize.h>
 
 #include "common/utils.h"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
@@ -170,6 +172,11 @@ void Image::clear_data()
 	data.shrink_to_fit();
 }
 
+std::vector<uint8_t> Image::take_data()
+{
+	return std::exchange(data, {});
+}
+
 VkFormat Image::get_format() const
 {
 	return format;
@@ -359,9 +366,15 @@ void Image::coerce_format_to_srgb()
 std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri,
                                    ContentType content_type)
 {
-	std::unique_ptr<Image> image{nullptr};
+	// Decode straight from the mapped file, the mapping is released once the image is decoded
+	auto file = fs::map_asset(uri);
 
-	auto data = fs::read_asset(uri);
+	return load(name, uri, file->get_data(), content_type);
+}
+
+std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri, std::span<const uint8_t> data, ContentType content_type)
+{
+	std::unique_ptr<Image> image{nullptr};
 
 	// Get extension
 	auto extension = get_extension(uri);
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <typeinfo>
 #include <vector>
@@ -74,6 +75,15 @@ class Image : public Component
 
 	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, ContentType content_type);
 
+	/**
+	 * @brief Decodes an image file which was already read to memory
+	 * @param name The name of the image
+	 * @param uri The path of the image file, its extension selects the decoder
+	 * @param data The content of the image file
+	 * @param content_type The type of content held in the image
+	 */
+	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, std::span<const uint8_t> data, ContentType content_type);
+
 	virtual ~Image() = default;
 
 	virtual std::type_index get_type() override;
@@ -82,6 +92,9 @@ class Image : public Component
 
 	void clear_data();
 
+	/// Moves the data out, leaving the image without data as clear_data does
+	std::vector<uint8_t> take_data();
+
 	VkFormat get_format() const;
 
 	const VkExtent3D &get_extent() const;
@@ -178,7 +178,7 @@ Astc::Astc(const Image &image) :
 	decode(blockdim, mip_it->extent, data_ptr, size);
 }
 
-Astc::Astc(const std::string &name, const std::vector<uint8_t> &data) :
+Astc::Astc(const std::string &name, std::span<const uint8_t> data) :
     Image{name}
 {
 	init();
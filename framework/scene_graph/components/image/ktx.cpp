@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  * Copyright (c) 2019-2024, Sascha Willems
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -65,7 +65,7 @@ static ktx_error_code_e KTX_APIENTRY optimal_tiling_callback(int          mip_le
 	return KTX_SUCCESS;
 }
 
-Ktx::Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type) :
+Ktx::Ktx(const std::string &name, std::span<const uint8_t> data, ContentType content_type) :
     Image{name}
 {
 	auto data_buffer = reinterpret_cast<const ktx_uint8_t *>(data.data());
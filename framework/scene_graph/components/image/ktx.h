@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "scene_graph/components/image.h"
 
 namespace vkb
@@ -26,7 +28,7 @@ namespace sg
 class Ktx : public Image
 {
   public:
-	Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type);
+	Ktx(const std::string &name, std::span<const uint8_t> data, ContentType content_type);
 
 	virtual ~Ktx() = default;
 };
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2021, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -54,6 +54,52 @@ bool SubMesh::get_attribute(const std::string &attribute_name, VertexAttribute &
 	return true;
 }
 
+bool SubMesh::get_vertex_buffer(const std::string &name, const vkb::core::BufferC *&buffer, VkDeviceSize &offset) const
+{
+	auto buffer_it = vertex_buffers.find(name);
+
+	if (buffer_it != vertex_buffers.end())
+	{
+		buffer = &buffer_it->second;
+		offset = 0;
+
+		return true;
+	}
+
+	auto range_it = shared_vertex_buffers.find(name);
+
+	if (range_it != shared_vertex_buffers.end())
+	{
+		buffer = range_it->second.buffer.get();
+		offset = range_it->second.offset;
+
+		return true;
+	}
+
+	return false;
+}
+
+bool SubMesh::get_index_buffer(const vkb::core::BufferC *&buffer, VkDeviceSize &offset) const
+{
+	if (shared_index_buffer.buffer)
+	{
+		buffer = shared_index_buffer.buffer.get();
+		offset = shared_index_buffer.offset + index_offset;
+
+		return true;
+	}
+
+	if (index_buffer)
+	{
+		buffer = index_buffer.get();
+		offset = index_offset;
+
+		return true;
+	}
+
+	return false;
+}
+
 void SubMesh::set_material(const Material &new_material)
 {
 	material = &new_material;
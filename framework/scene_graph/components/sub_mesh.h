@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2024, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -43,6 +43,16 @@ struct VertexAttribute
 	std::uint32_t offset = 0;
 };
 
+/**
+ * @brief A range of a buffer holding the data of several submeshes
+ */
+struct SharedBufferRange
+{
+	std::shared_ptr<vkb::core::BufferC> buffer;
+
+	VkDeviceSize offset = 0;
+};
+
 class SubMesh : public Component
 {
   public:
@@ -64,6 +74,34 @@ class SubMesh : public Component
 
 	std::unique_ptr<vkb::core::BufferC> index_buffer;
 
+	/// Vertex data stored in buffers shared with other submeshes, used for the attributes missing from vertex_buffers
+	std::unordered_map<std::string, SharedBufferRange> shared_vertex_buffers;
+
+	/// Index data stored in a buffer shared with other submeshes, used instead of index_buffer when set
+	SharedBufferRange shared_index_buffer;
+
+	/// Meshlet storage buffers named "meshlets", "meshlet_bounds", "meshlet_vertices" and "meshlet_triangles", see MeshletData
+	std::unordered_map<std::string, vkb::core::BufferC> meshlet_buffers;
+
+	std::uint32_t meshlet_count = 0;
+
+	/**
+	 * @brief Finds the buffer holding the data of a vertex attribute
+	 * @param name The name of the attribute
+	 * @param[out] buffer The buffer, owned by the submesh or shared with other submeshes
+	 * @param[out] offset The offset of the attribute data in the buffer
+	 * @return Whether the submesh has data for the attribute
+	 */
+	bool get_vertex_buffer(const std::string &name, const vkb::core::BufferC *&buffer, VkDeviceSize &offset) const;
+
+	/**
+	 * @brief Finds the buffer holding the index data, index_offset included
+	 * @param[out] buffer The buffer, owned by the submesh or shared with other submeshes
+	 * @param[out] offset The offset of the index data in the buffer
+	 * @return Whether the submesh has index data
+	 */
+	bool get_index_buffer(const vkb::core::BufferC *&buffer, VkDeviceSize &offset) const;
+
 	void set_attribute(const std::string &name, const VertexAttribute &attribute);
 
 	bool get_attribute(const std::string &name, VertexAttribute &attribute) const;
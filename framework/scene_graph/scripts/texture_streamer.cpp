@@ -0,0 +1,171 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "texture_streamer.h"
+
+#include "common/helpers.h"
+#include "core/device.h"
+#include "core/image.h"
+#include "core/util/logging.hpp"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/sampler.h"
+#include "scene_graph/components/texture.h"
+#include "staging_uploader.h"
+
+namespace vkb
+{
+namespace sg
+{
+TextureStreamer::TextureStreamer(Device &device, uint32_t thread_count) :
+    Script{"TextureStreamer"},
+    device{device},
+    thread_pool{static_cast<int>(thread_count)}
+{
+	timer.start();
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	// The decode functions may still be using the device
+	thread_pool.stop(true);
+}
+
+size_t TextureStreamer::add_image(DecodeFunction &&decode)
+{
+	StreamedImage streamed_image;
+	streamed_image.decoded = thread_pool.push([decode = std::move(decode)](size_t) { return decode(); });
+
+	images.push_back(std::move(streamed_image));
+
+	return images.size() - 1;
+}
+
+void TextureStreamer::add_texture(size_t image_index, Texture &texture, Sampler *nearest_sampler)
+{
+	assert(image_index < images.size());
+	images[image_index].textures.emplace_back(&texture, nearest_sampler);
+}
+
+void TextureStreamer::update(float delta_time)
+{
+	// Scripts are updated before the frame is recorded, the first frame was submitted once the second update runs
+	if (time_to_first_frame == 0.0 && first_frame_recorded)
+	{
+		time_to_first_frame = timer.elapsed();
+		LOGI("Time to first frame while streaming {} images: {} seconds.", images.size(), vkb::to_string(time_to_first_frame));
+	}
+
+	first_frame_recorded = true;
+
+	if (is_complete())
+	{
+		return;
+	}
+
+	auto &uploader = device.get_staging_uploader();
+
+	bool recorded_uploads = false;
+
+	for (auto &streamed_image : images)
+	{
+		if (streamed_image.complete)
+		{
+			continue;
+		}
+
+		// Upload the images decoded since the last frame
+		if (streamed_image.decoded.valid() && streamed_image.decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			streamed_image.image = streamed_image.decoded.get();
+
+			auto &image   = *streamed_image.image;
+			auto &mipmaps = image.get_mipmaps();
+
+			std::vector<VkBufferImageCopy> buffer_copy_regions(mipmaps.size());
+
+			for (size_t i = 0; i < mipmaps.size(); ++i)
+			{
+				auto &copy_region = buffer_copy_regions[i];
+
+				copy_region.bufferOffset              = mipmaps[i].offset;
+				copy_region.imageSubresource          = image.get_vk_image_view().get_subresource_layers();
+				copy_region.imageSubresource.mipLevel = mipmaps[i].level;
+				copy_region.imageExtent               = mipmaps[i].extent;
+			}
+
+			streamed_image.upload_value = uploader.upload_image(image.get_data(),
+			                                                    image.get_vk_image(),
+			                                                    buffer_copy_regions,
+			                                                    image.get_vk_image_view().get_subresource_range(),
+			                                                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			                                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+			image.clear_data();
+
+			recorded_uploads = true;
+		}
+		// Switch the textures once the upload completed, the draws of the next frames then use the new image view
+		else if (streamed_image.image && uploader.is_complete(streamed_image.upload_value))
+		{
+			auto linear_filtering = device.get_gpu().get_format_properties(streamed_image.image->get_format()).optimalTilingFeatures &
+			                        VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+			// The descriptor sets of the placeholders stay cached for the textures still waiting, see the class description
+			for (auto &[texture, nearest_sampler] : streamed_image.textures)
+			{
+				texture->set_image(*streamed_image.image);
+
+				if (nearest_sampler && !linear_filtering)
+				{
+					texture->set_sampler(*nearest_sampler);
+				}
+			}
+
+			streamed_image.complete = true;
+			completed_count++;
+		}
+	}
+
+	// Submit the uploads now rather than when the staging ring fills up
+	if (recorded_uploads)
+	{
+		uploader.flush();
+	}
+
+	if (is_complete())
+	{
+		time_to_full_quality = timer.stop();
+		LOGI("Time to full quality after streaming {} images: {} seconds.", images.size(), vkb::to_string(time_to_full_quality));
+	}
+}
+
+bool TextureStreamer::is_complete() const
+{
+	return completed_count == images.size();
+}
+
+double TextureStreamer::get_time_to_first_frame() const
+{
+	return time_to_first_frame;
+}
+
+double TextureStreamer::get_time_to_full_quality() const
+{
+	return time_to_full_quality;
+}
+}        // namespace sg
+}        // namespace vkb
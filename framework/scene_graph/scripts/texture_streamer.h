@@ -0,0 +1,134 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ctpl_stl.h>
+
+#include "scene_graph/script.h"
+#include "timer.h"
+
+namespace vkb
+{
+class Device;
+
+namespace sg
+{
+class Image;
+class Sampler;
+class Texture;
+
+/**
+ * @brief Streams the images of a scene in while it is rendered
+ *
+ * Textures start bound to small placeholder images. The images are decoded on worker threads, then uploaded
+ * through the device staging uploader from update, so between frames. A texture is switched to its image once
+ * the upload completed, draws recorded afterwards then bind the new image view.
+ *
+ * The descriptor sets referring to a placeholder are not updated with ResourceCache::update_descriptor_sets, as the
+ * placeholders are shared by every texture still waiting for its image. Draws recorded after a switch request a
+ * descriptor set with the new image view instead, created once and then found in the cache.
+ *
+ * The streamer owns the streamed images, it must be kept alive as long as the textures using them.
+ */
+class TextureStreamer : public Script
+{
+  public:
+	/**
+	 * @brief Decodes an image and creates its Vulkan image, called on a worker thread
+	 */
+	using DecodeFunction = std::function<std::unique_ptr<Image>()>;
+
+	TextureStreamer(Device &device, uint32_t thread_count);
+
+	virtual ~TextureStreamer();
+
+	/**
+	 * @brief Starts decoding an image
+	 * @return The index of the image
+	 */
+	size_t add_image(DecodeFunction &&decode);
+
+	/**
+	 * @brief Switches a texture to a streamed image once it is uploaded
+	 * @param image_index The index of the image returned by add_image
+	 * @param texture The texture, bound to a placeholder image until then
+	 * @param nearest_sampler If not null, the sampler used instead of the texture sampler
+	 *        if the image format does not support linear filtering
+	 */
+	void add_texture(size_t image_index, Texture &texture, Sampler *nearest_sampler = nullptr);
+
+	/**
+	 * @brief Uploads the decoded images, and switches the textures to the uploaded ones
+	 */
+	virtual void update(float delta_time) override;
+
+	/**
+	 * @return Whether every image was streamed in
+	 */
+	bool is_complete() const;
+
+	/**
+	 * @return The time from the creation of the streamer to the submission of the first frame, in seconds
+	 */
+	double get_time_to_first_frame() const;
+
+	/**
+	 * @return The time from the creation of the streamer to the switch of the last texture, in seconds
+	 */
+	double get_time_to_full_quality() const;
+
+  private:
+	struct StreamedImage
+	{
+		std::future<std::unique_ptr<Image>> decoded;
+
+		std::unique_ptr<Image> image;
+
+		/// The value of the upload batch, 0 until the image is uploaded
+		uint64_t upload_value{0};
+
+		std::vector<std::pair<Texture *, Sampler *>> textures;
+
+		bool complete{false};
+	};
+
+	Device &device;
+
+	ctpl::thread_pool thread_pool;
+
+	std::vector<StreamedImage> images;
+
+	size_t completed_count{0};
+
+	Timer timer;
+
+	/// Whether the first frame was recorded, and so submitted by the next update
+	bool first_frame_recorded{false};
+
+	double time_to_first_frame{0.0};
+
+	double time_to_full_quality{0.0};
+};
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,60 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace vkb
+{
+/**
+ * @brief Layout of the vertex data of the loaded meshes
+ */
+enum class VertexLayout
+{
+	/// Each attribute in its own vertex buffer
+	Separate,
+
+	/// All attributes interleaved in a single vertex buffer
+	Interleaved,
+
+	/// Positions in their own vertex buffer for depth only passes, the other attributes interleaved in a second one
+	SeparatePosition
+};
+
+/**
+ * @brief GLTFLoader options of the scenes loaded by VulkanSample::load_scene
+ *
+ * The platform passes the options set on the command line by the scene loading plugin to each sample it starts,
+ * through ApplicationOptions::scene_load_options.
+ */
+struct SceneLoadOptions
+{
+	/// See GLTFLoader::set_mesh_arenas
+	bool mesh_arenas{false};
+
+	/// See GLTFLoader::set_vertex_layout
+	VertexLayout vertex_layout{VertexLayout::Separate};
+
+	/// See GLTFLoader::set_mesh_optimization
+	bool mesh_optimization{false};
+
+	/// See GLTFLoader::set_scene_cache
+	bool scene_cache{false};
+
+	/// See GLTFLoader::set_texture_streaming
+	bool texture_streaming{false};
+};
+}        // namespace vkb
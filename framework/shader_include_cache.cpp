@@ -0,0 +1,225 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shader_include_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "filesystem/filesystem.hpp"
+#include "filesystem/legacy.h"
+
+namespace vkb
+{
+namespace
+{
+/// Text followed by an optional #include directive
+struct IncludeChunk
+{
+	std::string text;
+
+	std::string include_path;
+};
+
+struct IncludeFile
+{
+	size_t size{0};
+
+	uint64_t last_write_time{0};
+
+	std::vector<IncludeChunk> chunks;
+};
+
+using IncludeFileMap = std::unordered_map<std::string, std::shared_ptr<const IncludeFile>>;
+
+std::shared_mutex include_files_mutex;
+
+IncludeFileMap include_files;
+
+std::vector<IncludeChunk> parse(const std::string &source)
+{
+	std::vector<IncludeChunk> chunks(1);
+
+	size_t begin = 0;
+	while (begin < source.size())
+	{
+		size_t end = std::min(source.find('\n', begin), source.size());
+
+		std::string_view line{source.data() + begin, end - begin};
+
+		if (line.starts_with("#include \""))
+		{
+			// Include paths are relative to the base shader directory
+			auto   include_path = line.substr(10);
+			size_t last_quote   = include_path.find('"');
+			if (last_quote != std::string_view::npos)
+			{
+				include_path = include_path.substr(0, last_quote);
+			}
+
+			chunks.back().include_path = include_path;
+			chunks.emplace_back();
+		}
+		else
+		{
+			chunks.back().text.append(line);
+			chunks.back().text.push_back('\n');
+		}
+
+		begin = end + 1;
+	}
+
+	return chunks;
+}
+
+std::string get_full_path(const std::string &path)
+{
+	return fs::path::get(fs::path::Type::Shaders) + path;
+}
+
+std::shared_ptr<const IncludeFile> get_include_file(const std::string &path)
+{
+	auto full_path = get_full_path(path);
+	auto stat      = vkb::filesystem::get()->stat_file(full_path);
+
+	{
+		std::shared_lock<std::shared_mutex> lock(include_files_mutex);
+
+		auto it = include_files.find(path);
+		if (it != include_files.end() && it->second->size == stat.size && it->second->last_write_time == stat.last_write_time)
+		{
+			return it->second;
+		}
+	}
+
+	// Stat before reading, a write racing with the read is then detected by the next lookup
+	auto file             = std::make_shared<IncludeFile>();
+	file->size            = stat.size;
+	file->last_write_time = stat.last_write_time;
+	file->chunks          = parse(vkb::filesystem::get()->read_file_string(full_path));
+
+	std::unique_lock<std::shared_mutex> lock(include_files_mutex);
+
+	include_files[path] = file;
+
+	return file;
+}
+
+/// Looks up every file included by the chunks once, so that an expansion sees a single version of each file
+void resolve(const std::vector<IncludeChunk> &chunks, IncludeFileMap &resolved, std::vector<ShaderInclude> &dependencies)
+{
+	for (auto &chunk : chunks)
+	{
+		if (chunk.include_path.empty() || resolved.count(chunk.include_path) > 0)
+		{
+			continue;
+		}
+
+		auto file = get_include_file(chunk.include_path);
+
+		resolved[chunk.include_path] = file;
+		dependencies.push_back({chunk.include_path, file->size, file->last_write_time});
+
+		resolve(file->chunks, resolved, dependencies);
+	}
+}
+
+size_t get_expanded_size(const std::vector<IncludeChunk> &chunks, const IncludeFileMap &resolved, std::vector<const IncludeFile *> &include_stack)
+{
+	size_t size = 0;
+
+	for (auto &chunk : chunks)
+	{
+		size += chunk.text.size();
+
+		if (!chunk.include_path.empty())
+		{
+			auto file = resolved.at(chunk.include_path).get();
+
+			if (std::ranges::find(include_stack, file) != include_stack.end())
+			{
+				throw std::runtime_error("Recursive shader include: " + chunk.include_path);
+			}
+
+			include_stack.push_back(file);
+			size += get_expanded_size(file->chunks, resolved, include_stack);
+			include_stack.pop_back();
+		}
+	}
+
+	return size;
+}
+
+void append_expanded(const std::vector<IncludeChunk> &chunks, const IncludeFileMap &resolved, std::vector<uint8_t> &bytes)
+{
+	for (auto &chunk : chunks)
+	{
+		bytes.insert(bytes.end(), chunk.text.begin(), chunk.text.end());
+
+		if (!chunk.include_path.empty())
+		{
+			append_expanded(resolved.at(chunk.include_path)->chunks, resolved, bytes);
+		}
+	}
+}
+}        // namespace
+
+std::vector<uint8_t> ShaderIncludeCache::expand(const std::string &source, std::vector<ShaderInclude> &dependencies)
+{
+	auto chunks = parse(source);
+
+	IncludeFileMap resolved;
+	dependencies.clear();
+	resolve(chunks, resolved, dependencies);
+
+	std::vector<const IncludeFile *> include_stack;
+
+	std::vector<uint8_t> bytes;
+	bytes.reserve(get_expanded_size(chunks, resolved, include_stack));
+
+	append_expanded(chunks, resolved, bytes);
+
+	return bytes;
+}
+
+bool ShaderIncludeCache::is_modified(const std::vector<ShaderInclude> &dependencies)
+{
+	for (auto &dependency : dependencies)
+	{
+		auto stat = vkb::filesystem::get()->stat_file(get_full_path(dependency.path));
+
+		if (!stat.is_file || stat.size != dependency.size || stat.last_write_time != dependency.last_write_time)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ShaderIncludeCache::clear()
+{
+	std::unique_lock<std::shared_mutex> lock(include_files_mutex);
+
+	include_files.clear();
+}
+}        // namespace vkb
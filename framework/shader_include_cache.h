@@ -0,0 +1,66 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief A file included by a shader source, as it was on disk when the source was expanded
+ */
+struct ShaderInclude
+{
+	/// Path relative to the base shader directory
+	std::string path;
+
+	size_t size{0};
+
+	uint64_t last_write_time{0};
+};
+
+/**
+ * @brief Process-wide cache of the files included by shader sources
+ *
+ * Each included file is read and split into text and #include directives once. Later expansions
+ * only stat the file, an entry whose size or modification time changed is read again.
+ * The cache can be used from any thread.
+ */
+class ShaderIncludeCache
+{
+  public:
+	/**
+	 * @brief Replaces every #include "path" line of a shader source by the expanded included file
+	 * @param source The shader source
+	 * @param[out] dependencies Every file included directly or indirectly, once each
+	 * @return The expanded source, every line is terminated by a newline
+	 */
+	static std::vector<uint8_t> expand(const std::string &source, std::vector<ShaderInclude> &dependencies);
+
+	/**
+	 * @brief Checks whether a file changed on disk since a source including it was expanded
+	 * @param dependencies The dependencies recorded by expand
+	 * @return True if any of the files was modified or removed
+	 */
+	static bool is_modified(const std::vector<ShaderInclude> &dependencies);
+
+	static void clear();
+};
+}        // namespace vkb
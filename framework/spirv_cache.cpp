@@ -0,0 +1,378 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "spirv_cache.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "common/helpers.h"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "glsl_compiler.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t SPIRV_CACHE_MAGIC   = 0x43565053;        // "SPVC"
+constexpr uint32_t SPIRV_CACHE_VERSION = 1;
+
+constexpr uint64_t FNV_PRIME         = 0x100000001b3ULL;
+constexpr uint64_t FNV_OFFSET_BASIS  = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PAYLOAD_SEED  = 0x9e3779b97f4a7c15ULL;
+constexpr size_t   RESOURCE_U32_SIZE = 14;
+
+/// FNV-1a is stable across runs and platforms, unlike std::hash
+uint64_t stable_hash(uint64_t seed, const uint8_t *data, size_t size)
+{
+	uint64_t state = seed;
+	for (size_t i = 0; i < size; ++i)
+	{
+		state ^= data[i];
+		state *= FNV_PRIME;
+	}
+	return state;
+}
+
+/// Serializes the key material of a compilation job, which is stored in its entry and compared on load
+struct KeyMaterialWriter
+{
+	std::vector<uint8_t> &material;
+
+	void update(const void *data, size_t size)
+	{
+		auto bytes = reinterpret_cast<const uint8_t *>(data);
+		material.insert(material.end(), bytes, bytes + size);
+	}
+
+	template <class T>
+	void update(const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+		update(&value, sizeof(T));
+	}
+
+	void update(const std::string &value)
+	{
+		update(static_cast<uint64_t>(value.size()));
+		update(value.data(), value.size());
+	}
+};
+
+void write_key_material(KeyMaterialWriter &writer, VkShaderStageFlagBits stage, const std::vector<uint8_t> &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
+{
+	glslang::EShTargetLanguage        target_language;
+	glslang::EShTargetLanguageVersion target_language_version;
+	GLSLCompiler::get_target_environment(target_language, target_language_version);
+
+	writer.update(SPIRV_CACHE_VERSION);
+	writer.update(static_cast<uint32_t>(stage));
+	writer.update(static_cast<uint32_t>(target_language));
+	writer.update(static_cast<uint32_t>(target_language_version));
+	writer.update(entry_point);
+	writer.update(shader_variant.get_preamble());
+
+	writer.update(static_cast<uint64_t>(shader_variant.get_processes().size()));
+	for (auto &process : shader_variant.get_processes())
+	{
+		writer.update(process);
+	}
+
+	// Runtime array sizes only affect reflection, but reflection is part of the cached output
+	std::vector<std::pair<std::string, size_t>> runtime_array_sizes{shader_variant.get_runtime_array_sizes().begin(),
+	                                                                shader_variant.get_runtime_array_sizes().end()};
+	std::sort(runtime_array_sizes.begin(), runtime_array_sizes.end());
+
+	writer.update(static_cast<uint64_t>(runtime_array_sizes.size()));
+	for (auto &runtime_array_size : runtime_array_sizes)
+	{
+		writer.update(runtime_array_size.first);
+		writer.update(static_cast<uint64_t>(runtime_array_size.second));
+	}
+
+	writer.update(static_cast<uint64_t>(glsl_source.size()));
+	writer.update(glsl_source.data(), glsl_source.size());
+}
+
+/// Bounds-checked reader over a loaded cache entry
+class EntryReader
+{
+  public:
+	EntryReader(const std::vector<uint8_t> &data) :
+	    data{data}
+	{}
+
+	template <class T>
+	bool read(T &value)
+	{
+		return read(&value, sizeof(T));
+	}
+
+	bool read(void *dst, size_t size)
+	{
+		if (size > data.size() - offset)
+		{
+			return false;
+		}
+
+		std::copy_n(data.data() + offset, size, reinterpret_cast<uint8_t *>(dst));
+		offset += size;
+		return true;
+	}
+
+	size_t get_offset() const
+	{
+		return offset;
+	}
+
+	bool at_end() const
+	{
+		return offset == data.size();
+	}
+
+  private:
+	const std::vector<uint8_t> &data;
+
+	size_t offset{0};
+};
+
+uint64_t payload_checksum(const uint8_t *data, size_t size)
+{
+	return stable_hash(FNV_PAYLOAD_SEED, data, size);
+}
+}        // namespace
+
+std::atomic<bool>     SPIRVCache::enabled{true};
+std::atomic<uint64_t> SPIRVCache::hits{0};
+std::atomic<uint64_t> SPIRVCache::misses{0};
+std::atomic<uint64_t> SPIRVCache::writes{0};
+std::atomic<uint64_t> SPIRVCache::rejected{0};
+
+void SPIRVCache::set_enabled(bool enabled_)
+{
+	enabled = enabled_;
+}
+
+bool SPIRVCache::is_enabled()
+{
+	return enabled;
+}
+
+SPIRVCache::Key SPIRVCache::compute_key(VkShaderStageFlagBits stage, const std::vector<uint8_t> &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
+{
+	Key key;
+
+	KeyMaterialWriter writer{key.material};
+	write_key_material(writer, stage, glsl_source, entry_point, shader_variant);
+
+	key.address = stable_hash(FNV_OFFSET_BASIS, key.material.data(), key.material.size());
+
+	return key;
+}
+
+bool SPIRVCache::load(const Key &key, std::vector<uint32_t> &spirv, std::vector<ShaderResource> &resources)
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_entry_path(key);
+
+	if (!fs->is_file(path))
+	{
+		misses++;
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+
+	try
+	{
+		data = fs->read_file_binary(path);
+	}
+	catch (const std::exception &e)
+	{
+		// The entry may have been replaced between stat and read
+		LOGW("Failed to read SPIR-V cache entry {}: {}", path, e.what());
+		misses++;
+		return false;
+	}
+
+	EntryReader reader{data};
+
+	uint32_t magic{};
+	uint32_t version{};
+	uint64_t address{};
+	uint64_t material_size{};
+	uint64_t spirv_size{};
+	uint64_t resource_count{};
+	uint64_t checksum{};
+
+	bool valid = reader.read(magic) && reader.read(version) && reader.read(address) && reader.read(material_size) &&
+	             reader.read(spirv_size) && reader.read(resource_count) && reader.read(checksum);
+
+	valid = valid && magic == SPIRV_CACHE_MAGIC && version == SPIRV_CACHE_VERSION && address == key.address &&
+	        material_size == key.material.size() &&
+	        checksum == payload_checksum(data.data() + reader.get_offset(), data.size() - reader.get_offset());
+
+	// The whole key material is compared, so that a job whose key hash collides with the entry's is a miss
+	std::vector<uint8_t> stored_material;
+
+	if (valid)
+	{
+		stored_material.resize(material_size);
+		valid = reader.read(stored_material.data(), stored_material.size()) && stored_material == key.material;
+	}
+
+	std::vector<uint32_t>       cached_spirv;
+	std::vector<ShaderResource> cached_resources;
+
+	if (valid && spirv_size <= data.size() / sizeof(uint32_t))
+	{
+		cached_spirv.resize(spirv_size);
+		valid = reader.read(cached_spirv.data(), cached_spirv.size() * sizeof(uint32_t));
+	}
+	else
+	{
+		valid = false;
+	}
+
+	for (uint64_t i = 0; valid && i < resource_count; ++i)
+	{
+		std::array<uint32_t, RESOURCE_U32_SIZE> fields{};
+		uint32_t                                name_size{};
+
+		valid = reader.read(fields.data(), fields.size() * sizeof(uint32_t)) && reader.read(name_size);
+
+		ShaderResource resource{};
+		resource.name.resize(valid ? name_size : 0);
+		valid = valid && reader.read(resource.name.data(), resource.name.size());
+
+		resource.stages                 = fields[0];
+		resource.type                   = static_cast<ShaderResourceType>(fields[1]);
+		resource.mode                   = static_cast<ShaderResourceMode>(fields[2]);
+		resource.set                    = fields[3];
+		resource.binding                = fields[4];
+		resource.location               = fields[5];
+		resource.input_attachment_index = fields[6];
+		resource.vec_size               = fields[7];
+		resource.columns                = fields[8];
+		resource.array_size             = fields[9];
+		resource.offset                 = fields[10];
+		resource.size                   = fields[11];
+		resource.constant_id            = fields[12];
+		resource.qualifiers             = fields[13];
+
+		cached_resources.push_back(std::move(resource));
+	}
+
+	if (!valid || !reader.at_end())
+	{
+		LOGW("Discarding invalid SPIR-V cache entry {}", path);
+		rejected++;
+		misses++;
+		return false;
+	}
+
+	spirv     = std::move(cached_spirv);
+	resources = std::move(cached_resources);
+
+	hits++;
+	return true;
+}
+
+bool SPIRVCache::contains(const Key &key)
+{
+	return vkb::filesystem::get()->is_file(get_entry_path(key));
+}
+
+void SPIRVCache::store(const Key &key, const std::vector<uint32_t> &spirv, const std::vector<ShaderResource> &resources)
+{
+	std::ostringstream payload;
+
+	payload.write(reinterpret_cast<const char *>(key.material.data()), key.material.size());
+	payload.write(reinterpret_cast<const char *>(spirv.data()), spirv.size() * sizeof(uint32_t));
+
+	for (auto &resource : resources)
+	{
+		std::array<uint32_t, RESOURCE_U32_SIZE> fields{
+		    resource.stages,
+		    static_cast<uint32_t>(resource.type),
+		    static_cast<uint32_t>(resource.mode),
+		    resource.set,
+		    resource.binding,
+		    resource.location,
+		    resource.input_attachment_index,
+		    resource.vec_size,
+		    resource.columns,
+		    resource.array_size,
+		    resource.offset,
+		    resource.size,
+		    resource.constant_id,
+		    resource.qualifiers};
+
+		payload.write(reinterpret_cast<const char *>(fields.data()), fields.size() * sizeof(uint32_t));
+		write(payload, to_u32(resource.name.size()));
+		payload.write(resource.name.data(), resource.name.size());
+	}
+
+	std::string payload_data = payload.str();
+
+	std::ostringstream entry;
+	write(entry,
+	      SPIRV_CACHE_MAGIC,
+	      SPIRV_CACHE_VERSION,
+	      key.address,
+	      static_cast<uint64_t>(key.material.size()),
+	      static_cast<uint64_t>(spirv.size()),
+	      static_cast<uint64_t>(resources.size()),
+	      payload_checksum(reinterpret_cast<const uint8_t *>(payload_data.data()), payload_data.size()));
+	entry.write(payload_data.data(), payload_data.size());
+
+	std::string entry_data = entry.str();
+
+	auto path = get_entry_path(key);
+
+	try
+	{
+		vkb::filesystem::get()->write_file_atomic(path, std::vector<uint8_t>{entry_data.begin(), entry_data.end()});
+
+		writes++;
+	}
+	catch (const std::exception &e)
+	{
+		LOGW("Failed to write SPIR-V cache entry {}: {}", path, e.what());
+	}
+}
+
+SPIRVCache::Stats SPIRVCache::get_stats()
+{
+	return {hits, misses, writes, rejected};
+}
+
+void SPIRVCache::reset_stats()
+{
+	hits     = 0;
+	misses   = 0;
+	writes   = 0;
+	rejected = 0;
+}
+
+std::string SPIRVCache::get_entry_path(const Key &key)
+{
+	auto path = vkb::filesystem::get()->temp_directory() / "spirv_cache" / fmt::format("{:016x}.spvc", key.address);
+	return path.string();
+}
+}        // namespace vkb
@@ -0,0 +1,122 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/shader_module.h"
+
+namespace vkb
+{
+/**
+ * @brief Persistent, content-addressed cache of compiled SPIR-V and its reflected resources
+ *
+ * An entry is keyed on everything that affects the output of GLSLCompiler and SPIRVReflection:
+ * the preprocessed GLSL source, the variant preamble, processes and runtime array sizes,
+ * the shader stage, the entry point and the glslang target environment.
+ *
+ * Entries are stored as individual files in the temporary directory. A writer always writes
+ * to a uniquely named file and renames it into place, so concurrent readers either see a
+ * complete entry or none at all. Every entry is validated on load, a mismatch is treated as a miss.
+ */
+class SPIRVCache
+{
+  public:
+	/// The key material of a compilation job, and its hash which addresses the entry on disk
+	struct Key
+	{
+		uint64_t address{0};
+
+		/// Stored in the entry and compared on load, so that colliding addresses are a miss
+		std::vector<uint8_t> material;
+	};
+
+	struct Stats
+	{
+		uint64_t hits{0};
+
+		uint64_t misses{0};
+
+		uint64_t writes{0};
+
+		uint64_t rejected{0};
+	};
+
+	/**
+	 * @brief Enables or disables the cache for every ShaderModule created afterwards
+	 */
+	static void set_enabled(bool enabled);
+
+	static bool is_enabled();
+
+	/**
+	 * @brief Computes the key of a compilation job
+	 * @param stage The Vulkan shader stage flag
+	 * @param glsl_source The preprocessed GLSL source code
+	 * @param entry_point The entrypoint function name of the shader stage
+	 * @param shader_variant The shader variant
+	 */
+	static Key compute_key(VkShaderStageFlagBits       stage,
+	                       const std::vector<uint8_t> &glsl_source,
+	                       const std::string          &entry_point,
+	                       const ShaderVariant        &shader_variant);
+
+	/**
+	 * @brief Loads a cached entry
+	 * @param key The key of the entry
+	 * @param[out] spirv The cached SPIR-V code
+	 * @param[out] resources The cached reflected shader resources
+	 * @return True if a valid entry was found, false otherwise
+	 */
+	static bool load(const Key &key, std::vector<uint32_t> &spirv, std::vector<ShaderResource> &resources);
+
+	/**
+	 * @brief Checks whether an entry exists, without reading or validating it
+	 * @param key The key of the entry
+	 */
+	static bool contains(const Key &key);
+
+	/**
+	 * @brief Stores an entry, replacing any previous entry with the same key
+	 * @param key The key of the entry
+	 * @param spirv The compiled SPIR-V code
+	 * @param resources The reflected shader resources
+	 */
+	static void store(const Key &key, const std::vector<uint32_t> &spirv, const std::vector<ShaderResource> &resources);
+
+	static Stats get_stats();
+
+	static void reset_stats();
+
+  private:
+	static std::string get_entry_path(const Key &key);
+
+	static std::atomic<bool> enabled;
+
+	static std::atomic<uint64_t> hits;
+
+	static std::atomic<uint64_t> misses;
+
+	static std::atomic<uint64_t> writes;
+
+	static std::atomic<uint64_t> rejected;
+};
+}        // namespace vkb
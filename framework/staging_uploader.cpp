@@ -0,0 +1,604 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "staging_uploader.h"
+
+#include <cstring>
+#include <numeric>
+
+#include "common/vk_initializers.h"
+#include "core/device.h"
+#include "core/image.h"
+
+namespace vkb
+{
+namespace
+{
+/// Copy offsets must be multiples of 4 and of the texel block size, which is at most 32 bytes and may be 3, 6, 12 or 24 bytes
+constexpr VkDeviceSize COPY_OFFSET_ALIGNMENT = 96;
+
+bool is_timeline_semaphore_enabled(const PhysicalDevice &gpu)
+{
+	if (auto *features = gpu.get_requested_extension_features<VkPhysicalDeviceTimelineSemaphoreFeaturesKHR>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR))
+	{
+		return features->timelineSemaphore;
+	}
+
+	if (auto *features = gpu.get_requested_extension_features<VkPhysicalDeviceVulkan12Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES))
+	{
+		return features->timelineSemaphore;
+	}
+
+	return false;
+}
+}        // namespace
+
+StagingUploader::StagingUploader(Device &device, VkDeviceSize ring_size) :
+    device{device},
+    ring{vkb::core::BufferBuilderC(ring_size)
+             .with_usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+             .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+             .with_debug_name("StagingUploader ring")
+             .build(device)}
+{
+	graphics_queue = &device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	transfer_queue = graphics_queue;
+
+	// A family supporting transfers but neither graphics nor compute is backed by dedicated copy hardware
+	const auto &queue_family_properties = device.get_gpu().get_queue_family_properties();
+	for (uint32_t queue_family_index = 0U; queue_family_index < to_u32(queue_family_properties.size()); ++queue_family_index)
+	{
+		VkQueueFlags queue_flags = queue_family_properties[queue_family_index].queueFlags;
+
+		if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+		{
+			transfer_queue = &device.get_queue(queue_family_index, 0);
+			break;
+		}
+	}
+
+	auto &limits   = device.get_gpu().get_properties().limits;
+	ring_alignment = std::lcm(COPY_OFFSET_ALIGNMENT, std::max<VkDeviceSize>(limits.optimalBufferCopyOffsetAlignment, 1));
+	batch_size     = ring_size / 4;
+
+	graphics_command_pool = device.create_command_pool(graphics_queue->get_family_index(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+	if (uses_dedicated_transfer_queue())
+	{
+		transfer_command_pool = device.create_command_pool(transfer_queue->get_family_index(), VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+		LOGI("Staging uploads use the dedicated transfer queue family {}", transfer_queue->get_family_index());
+	}
+
+	if (is_timeline_semaphore_enabled(device.get_gpu()))
+	{
+		VkSemaphoreTypeCreateInfo type_info{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+		type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		type_info.initialValue  = 0;
+
+		VkSemaphoreCreateInfo semaphore_info{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+		semaphore_info.pNext = &type_info;
+
+		VK_CHECK(vkCreateSemaphore(device.get_handle(), &semaphore_info, nullptr, &timeline_semaphore));
+
+		// A device enabling the feature through the Vulkan 1.2 features only has the core entry points
+		if (device.is_enabled(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+		{
+			get_semaphore_counter_value = vkGetSemaphoreCounterValueKHR;
+			wait_semaphores             = vkWaitSemaphoresKHR;
+		}
+		else
+		{
+			get_semaphore_counter_value = vkGetSemaphoreCounterValue;
+			wait_semaphores             = vkWaitSemaphores;
+		}
+	}
+}
+
+StagingUploader::~StagingUploader()
+{
+	wait_idle();
+
+	for (auto &batch : free_batches)
+	{
+		vkDestroyFence(device.get_handle(), batch->fence, nullptr);
+		vkDestroySemaphore(device.get_handle(), batch->transfer_semaphore, nullptr);
+	}
+
+	vkDestroySemaphore(device.get_handle(), timeline_semaphore, nullptr);
+
+	// Destroying the pools frees the command buffers of the batches
+	vkDestroyCommandPool(device.get_handle(), graphics_command_pool, nullptr);
+	vkDestroyCommandPool(device.get_handle(), transfer_command_pool, nullptr);
+}
+
+uint64_t StagingUploader::upload_buffer(std::span<const uint8_t> data, vkb::core::BufferC &buffer, VkDeviceSize offset, VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask)
+{
+	if (data.empty())
+	{
+		return submitted_value;
+	}
+
+	auto [staging_buffer, staging_offset] = stage(data);
+
+	auto &batch = get_recording_batch();
+
+	VkBufferCopy copy_region{staging_offset, offset, data.size()};
+	vkCmdCopyBuffer(batch.transfer_command_buffer, staging_buffer, buffer.get_handle(), 1, &copy_region);
+
+	VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+	barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask       = dst_access_mask;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.buffer              = buffer.get_handle();
+	barrier.offset              = offset;
+	barrier.size                = data.size();
+
+	add_release_barrier(barrier, dst_stage_mask);
+
+	return end_upload(data.size());
+}
+
+uint64_t StagingUploader::upload_image(std::span<const uint8_t>              data,
+                                       const vkb::core::Image               &image,
+                                       const std::vector<VkBufferImageCopy> &regions,
+                                       const VkImageSubresourceRange        &subresource_range,
+                                       VkImageLayout                         final_layout,
+                                       VkPipelineStageFlags                  dst_stage_mask,
+                                       VkAccessFlags                         dst_access_mask)
+{
+	if (data.empty())
+	{
+		return submitted_value;
+	}
+
+	auto [staging_buffer, staging_offset] = stage(data);
+
+	auto &batch = get_recording_batch();
+
+	VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+	barrier.srcAccessMask       = 0;
+	barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image               = image.get_handle();
+	barrier.subresourceRange    = subresource_range;
+
+	vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	std::vector<VkBufferImageCopy> staging_regions = regions;
+	for (auto &region : staging_regions)
+	{
+		region.bufferOffset += staging_offset;
+	}
+
+	vkCmdCopyBufferToImage(batch.transfer_command_buffer,
+	                       staging_buffer,
+	                       image.get_handle(),
+	                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+	                       to_u32(staging_regions.size()),
+	                       staging_regions.data());
+
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = dst_access_mask;
+	barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout     = final_layout;
+
+	add_release_barrier(barrier, dst_stage_mask);
+
+	return end_upload(data.size());
+}
+
+uint64_t StagingUploader::flush()
+{
+	if (!recording_batch)
+	{
+		return submitted_value;
+	}
+
+	auto batch = std::move(recording_batch);
+
+	batch->ring_end = ring_head;
+	batch->value    = ++submitted_value;
+
+	VK_CHECK(vkEndCommandBuffer(batch->transfer_command_buffer));
+
+	VkSubmitInfo transfer_submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+	transfer_submit_info.commandBufferCount = 1;
+	transfer_submit_info.pCommandBuffers    = &batch->transfer_command_buffer;
+
+	// The last submission of the batch signals the fence, or twice the value on the timeline semaphore
+	VkSubmitInfo *last_submit_info = &transfer_submit_info;
+
+	VkSubmitInfo acquire_submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+
+	uint64_t transfer_value = 2 * batch->value - 1;
+	uint64_t final_value    = 2 * batch->value;
+
+	VkTimelineSemaphoreSubmitInfo transfer_timeline_info = initializers::timeline_semaphore_submit_info(0, nullptr, 1, &transfer_value);
+	VkTimelineSemaphoreSubmitInfo final_timeline_info    = initializers::timeline_semaphore_submit_info(0, nullptr, 1, &final_value);
+
+	VkSemaphore transfer_semaphore = uses_timeline_semaphore() ? timeline_semaphore : batch->transfer_semaphore;
+
+	if (uses_dedicated_transfer_queue())
+	{
+		VK_CHECK(vkEndCommandBuffer(batch->acquire_command_buffer));
+
+		transfer_submit_info.signalSemaphoreCount = 1;
+		transfer_submit_info.pSignalSemaphores    = &transfer_semaphore;
+
+		if (uses_timeline_semaphore())
+		{
+			transfer_submit_info.pNext = &transfer_timeline_info;
+		}
+
+		VK_CHECK(transfer_queue->submit({transfer_submit_info}, VK_NULL_HANDLE));
+
+		acquire_submit_info.waitSemaphoreCount = 1;
+		acquire_submit_info.pWaitSemaphores    = &transfer_semaphore;
+		acquire_submit_info.pWaitDstStageMask  = &batch->acquire_stage_mask;
+		acquire_submit_info.commandBufferCount = 1;
+		acquire_submit_info.pCommandBuffers    = &batch->acquire_command_buffer;
+
+		// The acquire submission waits for the value signaled by the copies
+		final_timeline_info.waitSemaphoreValueCount = 1;
+		final_timeline_info.pWaitSemaphoreValues    = &transfer_value;
+
+		last_submit_info = &acquire_submit_info;
+	}
+
+	if (uses_timeline_semaphore())
+	{
+		last_submit_info->signalSemaphoreCount = 1;
+		last_submit_info->pSignalSemaphores    = &timeline_semaphore;
+		last_submit_info->pNext                = &final_timeline_info;
+	}
+
+	VK_CHECK(graphics_queue->submit({*last_submit_info}, batch->fence));
+
+	submitted_batches.push_back(std::move(batch));
+
+	return submitted_value;
+}
+
+bool StagingUploader::is_complete(uint64_t value)
+{
+	retire_completed();
+
+	return completed_value >= value;
+}
+
+void StagingUploader::wait(uint64_t value)
+{
+	if (value > submitted_value)
+	{
+		flush();
+	}
+
+	while (completed_value < value && !submitted_batches.empty())
+	{
+		retire_oldest();
+	}
+}
+
+void StagingUploader::wait_idle()
+{
+	wait(flush());
+}
+
+bool StagingUploader::has_pending_uploads() const
+{
+	return recording_batch || !submitted_batches.empty();
+}
+
+bool StagingUploader::uses_dedicated_transfer_queue() const
+{
+	return transfer_queue != graphics_queue;
+}
+
+bool StagingUploader::uses_timeline_semaphore() const
+{
+	return timeline_semaphore != VK_NULL_HANDLE;
+}
+
+std::pair<VkBuffer, VkDeviceSize> StagingUploader::stage(std::span<const uint8_t> data)
+{
+	VkDeviceSize size = (data.size() + ring_alignment - 1) / ring_alignment * ring_alignment;
+
+	if (size > ring.get_size())
+	{
+		auto &batch = get_recording_batch();
+
+		batch.dedicated_buffers.push_back(vkb::core::BufferC::create_staging_buffer(device, data.size(), data.data()));
+
+		return {batch.dedicated_buffers.back().get_handle(), 0};
+	}
+
+	VkDeviceSize offset = 0;
+
+	// Ring space is only released by completed batches
+	while (!try_allocate(size, offset))
+	{
+		if (recording_batch)
+		{
+			flush();
+		}
+		else
+		{
+			retire_oldest();
+		}
+	}
+
+	std::memcpy(ring.map() + offset, data.data(), data.size());
+	ring.flush(offset, data.size());
+
+	return {ring.get_handle(), offset};
+}
+
+bool StagingUploader::try_allocate(VkDeviceSize size, VkDeviceSize &offset)
+{
+	if (ring_used == 0)
+	{
+		ring_head = 0;
+		ring_tail = 0;
+	}
+
+	VkDeviceSize ring_size = ring.get_size();
+
+	// The allocated bytes are charged to the batch recording the copy, and released once it completed
+	VkDeviceSize allocated_size = 0;
+
+	if (ring_used == 0 || ring_head > ring_tail)
+	{
+		if (ring_head + size <= ring_size)
+		{
+			offset         = ring_head;
+			allocated_size = size;
+		}
+		else if (size <= ring_tail)
+		{
+			// Wrap around, the end of the ring is reused once the tail wrapped around as well
+			offset         = 0;
+			allocated_size = ring_size - ring_head + size;
+		}
+	}
+	else if (ring_head + size <= ring_tail)
+	{
+		// The head is behind the tail, or caught up with it if the whole ring is in use
+		offset         = ring_head;
+		allocated_size = size;
+	}
+
+	if (allocated_size == 0)
+	{
+		return false;
+	}
+
+	ring_head = offset + size;
+	ring_used += allocated_size;
+
+	get_recording_batch().ring_bytes += allocated_size;
+
+	return true;
+}
+
+StagingUploader::Batch &StagingUploader::get_recording_batch()
+{
+	if (recording_batch)
+	{
+		return *recording_batch;
+	}
+
+	if (!free_batches.empty())
+	{
+		recording_batch = std::move(free_batches.back());
+		free_batches.pop_back();
+	}
+	else
+	{
+		recording_batch = std::make_unique<Batch>();
+
+		VkCommandBufferAllocateInfo allocate_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+		allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocate_info.commandBufferCount = 1;
+
+		if (!uses_timeline_semaphore())
+		{
+			VkFenceCreateInfo fence_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+			VK_CHECK(vkCreateFence(device.get_handle(), &fence_info, nullptr, &recording_batch->fence));
+		}
+
+		if (uses_dedicated_transfer_queue())
+		{
+			allocate_info.commandPool = transfer_command_pool;
+			VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &recording_batch->transfer_command_buffer));
+
+			allocate_info.commandPool = graphics_command_pool;
+			VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &recording_batch->acquire_command_buffer));
+
+			if (!uses_timeline_semaphore())
+			{
+				VkSemaphoreCreateInfo semaphore_info{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+				VK_CHECK(vkCreateSemaphore(device.get_handle(), &semaphore_info, nullptr, &recording_batch->transfer_semaphore));
+			}
+		}
+		else
+		{
+			allocate_info.commandPool = graphics_command_pool;
+			VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &recording_batch->transfer_command_buffer));
+		}
+	}
+
+	recording_batch->acquire_stage_mask = 0;
+	recording_batch->ring_bytes         = 0;
+	recording_batch->recorded_size      = 0;
+
+	// Command buffers are implicitly reset when they begin, as their pools allow resetting them individually
+	VkCommandBufferBeginInfo begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	VK_CHECK(vkBeginCommandBuffer(recording_batch->transfer_command_buffer, &begin_info));
+
+	if (recording_batch->acquire_command_buffer != VK_NULL_HANDLE)
+	{
+		VK_CHECK(vkBeginCommandBuffer(recording_batch->acquire_command_buffer, &begin_info));
+	}
+
+	return *recording_batch;
+}
+
+void StagingUploader::add_release_barrier(const VkBufferMemoryBarrier &barrier, VkPipelineStageFlags dst_stage_mask)
+{
+	auto &batch = *recording_batch;
+
+	if (!uses_dedicated_transfer_queue())
+	{
+		vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+		return;
+	}
+
+	// The release and acquire barriers of a queue family ownership transfer have to match
+	VkBufferMemoryBarrier release = barrier;
+	release.dstAccessMask         = 0;
+	release.srcQueueFamilyIndex   = transfer_queue->get_family_index();
+	release.dstQueueFamilyIndex   = graphics_queue->get_family_index();
+
+	vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &release, 0, nullptr);
+
+	VkBufferMemoryBarrier acquire = release;
+	acquire.srcAccessMask         = 0;
+	acquire.dstAccessMask         = barrier.dstAccessMask;
+
+	// The acquire submission waits for the copies at the stages accessing the resources
+	vkCmdPipelineBarrier(batch.acquire_command_buffer, dst_stage_mask, dst_stage_mask, 0, 0, nullptr, 1, &acquire, 0, nullptr);
+
+	batch.acquire_stage_mask |= dst_stage_mask;
+}
+
+void StagingUploader::add_release_barrier(const VkImageMemoryBarrier &barrier, VkPipelineStageFlags dst_stage_mask)
+{
+	auto &batch = *recording_batch;
+
+	if (!uses_dedicated_transfer_queue())
+	{
+		vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		return;
+	}
+
+	// The layout transition is performed once, as part of the ownership transfer
+	VkImageMemoryBarrier release = barrier;
+	release.dstAccessMask        = 0;
+	release.srcQueueFamilyIndex  = transfer_queue->get_family_index();
+	release.dstQueueFamilyIndex  = graphics_queue->get_family_index();
+
+	vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &release);
+
+	VkImageMemoryBarrier acquire = release;
+	acquire.srcAccessMask        = 0;
+	acquire.dstAccessMask        = barrier.dstAccessMask;
+
+	vkCmdPipelineBarrier(batch.acquire_command_buffer, dst_stage_mask, dst_stage_mask, 0, 0, nullptr, 0, nullptr, 1, &acquire);
+
+	batch.acquire_stage_mask |= dst_stage_mask;
+}
+
+uint64_t StagingUploader::end_upload(VkDeviceSize size)
+{
+	uint64_t value = submitted_value + 1;
+
+	recording_batch->recorded_size += size;
+
+	// Submit full batches right away so that the copies overlap with the preparation of the next data
+	if (recording_batch->recorded_size >= batch_size)
+	{
+		flush();
+	}
+
+	return value;
+}
+
+uint64_t StagingUploader::get_timeline_value()
+{
+	uint64_t counter_value = 0;
+	VK_CHECK(get_semaphore_counter_value(device.get_handle(), timeline_semaphore, &counter_value));
+
+	// Odd values only tell that the copies of the next batch completed
+	return counter_value / 2;
+}
+
+void StagingUploader::retire_completed()
+{
+	if (uses_timeline_semaphore())
+	{
+		// A single query covers every batch that completed
+		uint64_t timeline_value = get_timeline_value();
+
+		while (!submitted_batches.empty() && submitted_batches.front()->value <= timeline_value)
+		{
+			retire_oldest();
+		}
+
+		return;
+	}
+
+	while (!submitted_batches.empty() && vkGetFenceStatus(device.get_handle(), submitted_batches.front()->fence) == VK_SUCCESS)
+	{
+		retire_oldest();
+	}
+}
+
+void StagingUploader::retire_oldest()
+{
+	assert(!submitted_batches.empty() && "No batch to retire");
+
+	auto batch = std::move(submitted_batches.front());
+	submitted_batches.pop_front();
+
+	if (uses_timeline_semaphore())
+	{
+		uint64_t final_value = 2 * batch->value;
+
+		VkSemaphoreWaitInfo wait_info{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+		wait_info.semaphoreCount = 1;
+		wait_info.pSemaphores    = &timeline_semaphore;
+		wait_info.pValues        = &final_value;
+
+		VK_CHECK(wait_semaphores(device.get_handle(), &wait_info, std::numeric_limits<uint64_t>::max()));
+	}
+	else
+	{
+		VK_CHECK(vkWaitForFences(device.get_handle(), 1, &batch->fence, VK_TRUE, std::numeric_limits<uint64_t>::max()));
+		VK_CHECK(vkResetFences(device.get_handle(), 1, &batch->fence));
+	}
+
+	completed_value = batch->value;
+
+	// Batches only using dedicated buffers may complete after the ring was rewound
+	if (batch->ring_bytes != 0)
+	{
+		ring_tail = batch->ring_end;
+		ring_used -= batch->ring_bytes;
+	}
+
+	batch->dedicated_buffers.clear();
+
+	free_batches.push_back(std::move(batch));
+}
+}        // namespace vkb
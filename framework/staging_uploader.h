@@ -0,0 +1,249 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <span>
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "core/buffer.h"
+
+namespace vkb
+{
+class Device;
+class Queue;
+
+namespace core
+{
+class Image;
+}
+
+/**
+ * @brief Uploads buffer and image data to device local memory without stalling the CPU
+ *
+ * Data is copied to a persistently mapped staging ring buffer and the copies are recorded in batches.
+ * A batch is submitted once it holds a quarter of the ring, or when flush is called, so the CPU keeps
+ * preparing the next data while the GPU copies the previous batch. Ring space is only reclaimed once
+ * the batch that used it completed, the CPU only waits when the ring is full.
+ *
+ * The copies are submitted to a dedicated transfer queue when the device exposes one. Ownership of the
+ * destination resources is then released by the transfer queue and acquired by the graphics queue, in
+ * a second submission that waits on the copies. Destination images must be copied as whole mip levels,
+ * which transfer queues support regardless of their image transfer granularity.
+ *
+ * Each batch gets a value, which can be polled or waited on. When the device enabled timeline semaphores,
+ * the submissions of a batch signal a timeline semaphore: the copies signal twice the value minus one,
+ * which the acquire submission waits on, and the last submission signals twice the value. Otherwise each
+ * batch signals a fence, and a binary semaphore between the copies and the acquire submission.
+ *
+ * The last submission of a batch goes to the graphics queue and makes the copies available to the stages
+ * given with each upload, so later graphics submissions need no semaphore to use the uploaded data.
+ *
+ * The uploader submits to the graphics queue, it must be used from the thread submitting to that queue.
+ */
+class StagingUploader
+{
+  public:
+	static constexpr VkDeviceSize DEFAULT_RING_SIZE = 32 * 1024 * 1024;
+
+	StagingUploader(Device &device, VkDeviceSize ring_size = DEFAULT_RING_SIZE);
+
+	StagingUploader(const StagingUploader &) = delete;
+
+	StagingUploader(StagingUploader &&) = delete;
+
+	~StagingUploader();
+
+	StagingUploader &operator=(const StagingUploader &) = delete;
+
+	StagingUploader &operator=(StagingUploader &&) = delete;
+
+	/**
+	 * @brief Records a copy of data into a buffer
+	 * @param data The data to copy, it can be released as soon as the function returns
+	 * @param buffer The destination buffer, it needs the transfer destination usage
+	 * @param offset The offset in the destination buffer
+	 * @param dst_stage_mask The pipeline stages which will access the buffer on the graphics queue
+	 * @param dst_access_mask The accesses made to the buffer on the graphics queue
+	 * @return The value of the batch containing the copy
+	 */
+	uint64_t upload_buffer(std::span<const uint8_t> data,
+	                       vkb::core::BufferC      &buffer,
+	                       VkDeviceSize             offset          = 0,
+	                       VkPipelineStageFlags     dst_stage_mask  = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+	                       VkAccessFlags            dst_access_mask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT);
+
+	/**
+	 * @brief Records a copy of data into an image, and transitions the image to its final layout
+	 * @param data The data to copy, it can be released as soon as the function returns
+	 * @param image The destination image, its previous content is discarded
+	 * @param regions The copy regions, their buffer offsets are relative to the start of data
+	 * @param subresource_range The subresources of the image written by the copy
+	 * @param final_layout The layout of the image once the batch completed
+	 * @param dst_stage_mask The pipeline stages which will access the image on the graphics queue
+	 * @param dst_access_mask The accesses made to the image on the graphics queue
+	 * @return The value of the batch containing the copy
+	 */
+	uint64_t upload_image(std::span<const uint8_t>              data,
+	                      const vkb::core::Image               &image,
+	                      const std::vector<VkBufferImageCopy> &regions,
+	                      const VkImageSubresourceRange        &subresource_range,
+	                      VkImageLayout                         final_layout    = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+	                      VkPipelineStageFlags                  dst_stage_mask  = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+	                      VkAccessFlags                         dst_access_mask = VK_ACCESS_SHADER_READ_BIT);
+
+	/**
+	 * @brief Submits the copies recorded so far
+	 * @return The value of the batch, or of the last submitted batch if nothing was recorded
+	 */
+	uint64_t flush();
+
+	/**
+	 * @return Whether the batch with the given value completed
+	 */
+	bool is_complete(uint64_t value);
+
+	/**
+	 * @brief Waits on the CPU for the batch with the given value to complete, submitting it if needed
+	 */
+	void wait(uint64_t value);
+
+	/**
+	 * @brief Submits the recorded copies and waits for every batch to complete
+	 */
+	void wait_idle();
+
+	/**
+	 * @return Whether copies were recorded or submitted and did not complete yet
+	 */
+	bool has_pending_uploads() const;
+
+	/**
+	 * @return Whether the copies are submitted to a queue family other than the graphics one
+	 */
+	bool uses_dedicated_transfer_queue() const;
+
+	/**
+	 * @return Whether batches are tracked with a timeline semaphore rather than with fences
+	 */
+	bool uses_timeline_semaphore() const;
+
+  private:
+	struct Batch
+	{
+		VkCommandBuffer transfer_command_buffer{VK_NULL_HANDLE};
+
+		/// Acquires the resources on the graphics queue, only used with a dedicated transfer queue
+		VkCommandBuffer acquire_command_buffer{VK_NULL_HANDLE};
+
+		/// Signaled by the copies, and waited on by the acquire submission, only used without a timeline semaphore
+		VkSemaphore transfer_semaphore{VK_NULL_HANDLE};
+
+		/// Only used without a timeline semaphore
+		VkFence fence{VK_NULL_HANDLE};
+
+		VkPipelineStageFlags acquire_stage_mask{0};
+
+		uint64_t value{0};
+
+		/// Ring offset following the last allocation of the batch
+		VkDeviceSize ring_end{0};
+
+		/// Ring bytes allocated for the batch, including the end of the ring skipped when wrapping around
+		VkDeviceSize ring_bytes{0};
+
+		VkDeviceSize recorded_size{0};
+
+		/// Staging buffers for uploads larger than the ring
+		std::vector<vkb::core::BufferC> dedicated_buffers;
+	};
+
+	/**
+	 * @brief Copies data to staging memory, submitting or waiting for batches if the ring is full
+	 * @return The staging buffer and the offset of the copied data
+	 */
+	std::pair<VkBuffer, VkDeviceSize> stage(std::span<const uint8_t> data);
+
+	bool try_allocate(VkDeviceSize size, VkDeviceSize &offset);
+
+	Batch &get_recording_batch();
+
+	void add_release_barrier(const VkBufferMemoryBarrier &barrier, VkPipelineStageFlags dst_stage_mask);
+
+	void add_release_barrier(const VkImageMemoryBarrier &barrier, VkPipelineStageFlags dst_stage_mask);
+
+	/**
+	 * @brief Accounts for an upload recorded in the current batch, and submits the batch once it is full
+	 * @return The value of the batch containing the upload
+	 */
+	uint64_t end_upload(VkDeviceSize size);
+
+	/**
+	 * @return The value of the last batch that completed on the GPU, which may not be retired yet
+	 */
+	uint64_t get_timeline_value();
+
+	void retire_completed();
+
+	void retire_oldest();
+
+	Device &device;
+
+	const Queue *graphics_queue{nullptr};
+
+	const Queue *transfer_queue{nullptr};
+
+	VkCommandPool graphics_command_pool{VK_NULL_HANDLE};
+
+	VkCommandPool transfer_command_pool{VK_NULL_HANDLE};
+
+	/// Signaled by every batch, see the class description for its values
+	VkSemaphore timeline_semaphore{VK_NULL_HANDLE};
+
+	/// The core or extension entry points, depending on how timeline semaphores were enabled
+	PFN_vkGetSemaphoreCounterValue get_semaphore_counter_value{nullptr};
+
+	PFN_vkWaitSemaphores wait_semaphores{nullptr};
+
+	vkb::core::BufferC ring;
+
+	VkDeviceSize ring_alignment{1};
+
+	VkDeviceSize ring_head{0};
+
+	VkDeviceSize ring_tail{0};
+
+	/// Ring bytes allocated by batches which did not complete yet, which tells a full ring from an empty one
+	VkDeviceSize ring_used{0};
+
+	/// Size of the batches submitted automatically
+	VkDeviceSize batch_size{0};
+
+	std::unique_ptr<Batch> recording_batch;
+
+	std::deque<std::unique_ptr<Batch>> submitted_batches;
+
+	std::vector<std::unique_ptr<Batch>> free_batches;
+
+	uint64_t submitted_value{0};
+
+	/// Value of the last retired batch
+	uint64_t completed_value{0};
+};
+}        // namespace vkb
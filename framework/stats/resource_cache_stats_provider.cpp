@@ -0,0 +1,211 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resource_cache_stats_provider.h"
+
+#include "common/strings.h"
+#include "core/device.h"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+namespace
+{
+const std::set<StatIndex> supported_stats{StatIndex::resource_cache_hits,
+                                          StatIndex::resource_cache_misses,
+                                          StatIndex::resource_cache_creation_time,
+                                          StatIndex::shader_module_creation_time,
+                                          StatIndex::pipeline_creation_time,
+                                          StatIndex::frame_descriptor_set_hits,
+                                          StatIndex::frame_descriptor_set_misses,
+                                          StatIndex::frame_descriptor_set_creation_time};
+
+std::string to_json(const CacheStats &stats)
+{
+	std::vector<std::string> histogram;
+	for (auto count : stats.creation_time_histogram)
+	{
+		histogram.push_back(std::to_string(count));
+	}
+
+	return fmt::format("\"hits\": {}, \"misses\": {}, \"creations\": {}, \"creation_time_ms\": {:.3f}, \"creation_time_histogram\": [{}]",
+	                   stats.hits, stats.misses, stats.creations, stats.creation_time, join(histogram, ", "));
+}
+}        // namespace
+
+ResourceCacheStatsProvider::ResourceCacheStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context) :
+    render_context{render_context}
+{
+	for (auto index : supported_stats)
+	{
+		if (requested_stats.erase(index) > 0)
+		{
+			available_stats.insert(index);
+		}
+	}
+
+	if (!available_stats.empty())
+	{
+		previous_totals = get_totals();
+	}
+}
+
+ResourceCacheStatsProvider::~ResourceCacheStatsProvider()
+{
+	if (!available_stats.empty())
+	{
+		write_report();
+	}
+}
+
+bool ResourceCacheStatsProvider::is_available(StatIndex index) const
+{
+	return available_stats.count(index) > 0;
+}
+
+StatsProvider::Counters ResourceCacheStatsProvider::sample(float delta_time)
+{
+	Counters res;
+
+	if (available_stats.empty())
+	{
+		return res;
+	}
+
+	auto totals = get_totals();
+
+	for (auto &total : totals)
+	{
+		// Render frames may have been recreated since the last sample, which resets their counters
+		res[total.first].result = std::max(0.0, total.second - previous_totals[total.first]);
+	}
+
+	previous_totals = std::move(totals);
+
+	return res;
+}
+
+std::unordered_map<StatIndex, double, StatIndexHash> ResourceCacheStatsProvider::get_totals()
+{
+	auto &resource_cache = render_context.get_device().get_resource_cache();
+
+	CacheStats cache_stats;
+	CacheStats shader_module_stats;
+	CacheStats pipeline_stats;
+
+	for (size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+	{
+		auto type     = static_cast<ResourceType>(i);
+		auto counters = resource_cache.get_stats(type).counters;
+
+		cache_stats += counters;
+
+		if (type == ResourceType::ShaderModule)
+		{
+			shader_module_stats += counters;
+		}
+		else if (type == ResourceType::GraphicsPipeline || type == ResourceType::ComputePipeline)
+		{
+			pipeline_stats += counters;
+		}
+	}
+
+	CacheStats frame_descriptor_set_stats;
+	for (auto &frame : render_context.get_render_frames())
+	{
+		frame_descriptor_set_stats += frame->get_descriptor_set_stats();
+	}
+
+	return {{StatIndex::resource_cache_hits, static_cast<double>(cache_stats.hits)},
+	        {StatIndex::resource_cache_misses, static_cast<double>(cache_stats.misses)},
+	        {StatIndex::resource_cache_creation_time, cache_stats.creation_time},
+	        {StatIndex::shader_module_creation_time, shader_module_stats.creation_time},
+	        {StatIndex::pipeline_creation_time, pipeline_stats.creation_time},
+	        {StatIndex::frame_descriptor_set_hits, static_cast<double>(frame_descriptor_set_stats.hits)},
+	        {StatIndex::frame_descriptor_set_misses, static_cast<double>(frame_descriptor_set_stats.misses)},
+	        {StatIndex::frame_descriptor_set_creation_time, frame_descriptor_set_stats.creation_time}};
+}
+
+std::string ResourceCacheStatsProvider::get_report(const std::array<ResourceCacheStats, RESOURCE_TYPE_COUNT> &resource_stats,
+                                                   const CacheStats                                        &frame_descriptor_pool_stats,
+                                                   const CacheStats                                        &frame_descriptor_set_stats)
+{
+	std::vector<std::string> upper_bounds;
+	for (size_t i = 0; i + 1 < CREATION_TIME_BUCKET_COUNT; ++i)
+	{
+		upper_bounds.push_back(std::to_string(uint64_t{1} << i));
+	}
+
+	std::vector<std::string> resource_types;
+	for (size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+	{
+		auto &stats = resource_stats[i];
+
+		resource_types.push_back(fmt::format("\t\t\"{}\": {{{}, \"evictions\": {}, \"size\": {}, \"budget\": {}}}",
+		                                     to_string(static_cast<ResourceType>(i)), to_json(stats.counters), stats.evictions, stats.size, stats.budget));
+	}
+
+	// Bucket i of a histogram counts creations faster than the i-th upper bound, the last bucket counts the rest
+	return fmt::format("{{\n"
+	                   "\t\"creation_time_histogram_upper_bounds_us\": [{}],\n"
+	                   "\t\"resource_cache\": {{\n{}\n\t}},\n"
+	                   "\t\"frame_caches\": {{\n"
+	                   "\t\t\"DescriptorPool\": {{{}}},\n"
+	                   "\t\t\"DescriptorSet\": {{{}}}\n"
+	                   "\t}}\n"
+	                   "}}\n",
+	                   join(upper_bounds, ", "),
+	                   join(resource_types, ",\n"),
+	                   to_json(frame_descriptor_pool_stats),
+	                   to_json(frame_descriptor_set_stats));
+}
+
+void ResourceCacheStatsProvider::write_report()
+{
+	auto &resource_cache = render_context.get_device().get_resource_cache();
+
+	std::array<ResourceCacheStats, RESOURCE_TYPE_COUNT> resource_stats;
+	for (size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i)
+	{
+		resource_stats[i] = resource_cache.get_stats(static_cast<ResourceType>(i));
+	}
+
+	CacheStats frame_descriptor_pool_stats;
+	CacheStats frame_descriptor_set_stats;
+	for (auto &frame : render_context.get_render_frames())
+	{
+		frame_descriptor_pool_stats += frame->get_descriptor_pool_stats();
+		frame_descriptor_set_stats += frame->get_descriptor_set_stats();
+	}
+
+	auto report = get_report(resource_stats, frame_descriptor_pool_stats, frame_descriptor_set_stats);
+
+	auto path = vkb::filesystem::get()->temp_directory() / "resource_cache_stats.json";
+
+	try
+	{
+		vkb::filesystem::get()->write_file(path, report);
+		LOGI("Resource cache stats written to {}", path.string());
+	}
+	catch (const std::exception &e)
+	{
+		LOGW("Failed to write resource cache stats to {}: {}", path.string(), e.what());
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,86 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "resource_cache.h"
+#include "stats_provider.h"
+#include <array>
+#include <set>
+
+namespace vkb
+{
+class RenderContext;
+
+/**
+ * @brief Samples the counters of the device ResourceCache and of the per-frame descriptor caches
+ *
+ * Counts are reported per sample, i.e. per frame when polling, and creation times in milliseconds.
+ * If any of its stats was requested, the provider writes the per-type counters and creation time
+ * histograms to resource_cache_stats.json in the temporary directory when it is destroyed.
+ */
+class ResourceCacheStatsProvider : public StatsProvider
+{
+  public:
+	/**
+	 * @brief Constructs a ResourceCacheStatsProvider
+	 * @param requested_stats Set of stats to be collected. Supported stats will be removed from the set.
+	 * @param render_context The RenderContext, its device owns the resource cache
+	 */
+	ResourceCacheStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context);
+
+	/**
+	 * @brief Writes the JSON report
+	 */
+	~ResourceCacheStatsProvider() override;
+
+	/**
+	 * @brief Checks if this provider can supply the given enabled stat
+	 * @param index The stat index
+	 * @return True if the stat is available, false otherwise
+	 */
+	bool is_available(StatIndex index) const override;
+
+	/**
+	 * @brief Retrieve a new sample set
+	 * @param delta_time Time since last sample
+	 */
+	Counters sample(float delta_time) override;
+
+	/**
+	 * @brief Formats the JSON report written by the provider
+	 * @param resource_stats The stats of each type of the resource cache, indexed by ResourceType
+	 * @param frame_descriptor_pool_stats The descriptor pool counters summed over the render frames
+	 * @param frame_descriptor_set_stats The descriptor set counters summed over the render frames
+	 */
+	static std::string get_report(const std::array<ResourceCacheStats, RESOURCE_TYPE_COUNT> &resource_stats,
+	                              const CacheStats                                        &frame_descriptor_pool_stats,
+	                              const CacheStats                                        &frame_descriptor_set_stats);
+
+  private:
+	/// @brief Totals of the available stats since the caches were created
+	std::unordered_map<StatIndex, double, StatIndexHash> get_totals();
+
+	void write_report();
+
+	RenderContext &render_context;
+
+	std::set<StatIndex> available_stats;
+
+	std::unordered_map<StatIndex, double, StatIndexHash> previous_totals;
+};
+}        // namespace vkb
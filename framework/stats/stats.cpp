@@ -29,6 +29,7 @@
 #endif
 #include "core/allocated.h"
 #include "rendering/render_context.h"
+#include "resource_cache_stats_provider.h"
 #include "vulkan_stats_provider.h"
 
 namespace vkb
@@ -71,6 +72,7 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<ResourceCacheStatsProvider>(stats, render_context));
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 #endif
@@ -358,6 +360,22 @@ const char *to_string(StatIndex index)
 			return "External Read Bytes (MiB/s)";
 		case StatIndex::gpu_ext_write_bytes:
 			return "External Write Bytes (MiB/s)";
+		case StatIndex::resource_cache_hits:
+			return "Resource Cache Hits (/frame)";
+		case StatIndex::resource_cache_misses:
+			return "Resource Cache Misses (/frame)";
+		case StatIndex::resource_cache_creation_time:
+			return "Resource Cache Creation Time (ms)";
+		case StatIndex::shader_module_creation_time:
+			return "Shader Module Creation Time (ms)";
+		case StatIndex::pipeline_creation_time:
+			return "Pipeline Creation Time (ms)";
+		case StatIndex::frame_descriptor_set_hits:
+			return "Frame Descriptor Set Hits (/frame)";
+		case StatIndex::frame_descriptor_set_misses:
+			return "Frame Descriptor Set Misses (/frame)";
+		case StatIndex::frame_descriptor_set_creation_time:
+			return "Frame Descriptor Set Creation Time (ms)";
 		default:
 			return nullptr;
 	}
@@ -1,4 +1,4 @@
-/* Copyright (c) 2018-2022, Arm Limited and Contributors
+/* Copyright (c) 2018-2025, Arm Limited and Contributors
  * Copyright (c) 2020-2022, Broadcom Inc.
  *
  * SPDX-License-Identifier: Apache-2.0
@@ -63,6 +63,15 @@ enum class StatIndex
 	gpu_ext_read_bytes,
 	gpu_ext_write_bytes,
 	gpu_tex_cycles,
+
+	resource_cache_hits,
+	resource_cache_misses,
+	resource_cache_creation_time,
+	shader_module_creation_time,
+	pipeline_creation_time,
+	frame_descriptor_set_hits,
+	frame_descriptor_set_misses,
+	frame_descriptor_set_creation_time,
 };
 
 struct StatIndexHash
@@ -1,4 +1,4 @@
-/* Copyright (c) 2020-2023, Broadcom Inc. and Contributors
+/* Copyright (c) 2020-2025, Broadcom Inc. and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -54,6 +54,15 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     {StatIndex::gpu_ext_write_stalls,  {"External Write Stalls",                       "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::gpu_ext_read_bytes,    {"External Read Bytes",                         "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
     {StatIndex::gpu_ext_write_bytes,   {"External Write Bytes",                        "{:4.1f} MiB/s", 1.0f / (1024.0f * 1024.0f)}},
+
+    {StatIndex::resource_cache_hits,                {"Resource Cache Hits",                "{:4.0f}/frame"}},
+    {StatIndex::resource_cache_misses,              {"Resource Cache Misses",              "{:4.1f}/frame"}},
+    {StatIndex::resource_cache_creation_time,       {"Resource Cache Creation Time",       "{:3.1f} ms"}},
+    {StatIndex::shader_module_creation_time,        {"Shader Module Creation Time",        "{:3.1f} ms"}},
+    {StatIndex::pipeline_creation_time,             {"Pipeline Creation Time",             "{:3.1f} ms"}},
+    {StatIndex::frame_descriptor_set_hits,          {"Frame Descriptor Set Hits",          "{:4.0f}/frame"}},
+    {StatIndex::frame_descriptor_set_misses,        {"Frame Descriptor Set Misses",        "{:4.1f}/frame"}},
+    {StatIndex::frame_descriptor_set_creation_time, {"Frame Descriptor Set Creation Time", "{:3.1f} ms"}},
     // clang-format on
 };
 
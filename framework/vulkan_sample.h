@@ -284,12 +284,25 @@ class VulkanSample : public vkb::Application
 	bool                                  has_scene();
 
 	/**
-	 * @brief Loads the scene
+	 * @brief Loads the scene, with the loader options given on the command line
 	 *
 	 * @param path The path of the glTF file
 	 */
 	void load_scene(const std::string &path);
 
+	/**
+	 * @brief Loads the scene
+	 *
+	 * @param path The path of the glTF file
+	 * @param options The loader options
+	 */
+	void load_scene(const std::string &path, const vkb::SceneLoadOptions &options);
+
+	/**
+	 * @brief The loader options given on the command line, for samples that adjust them before calling load_scene
+	 */
+	const vkb::SceneLoadOptions &get_scene_load_options() const;
+
 	/**
 	 * @brief Additional sample initialization
 	 */
@@ -408,6 +421,11 @@ class VulkanSample : public vkb::Application
 	 */
 	std::unique_ptr<vkb::scene_graph::HPPScene> scene;
 
+	/**
+	 * @brief The loader options of load_scene, from the ApplicationOptions of prepare
+	 */
+	vkb::SceneLoadOptions scene_load_options;
+
 	std::unique_ptr<vkb::HPPGui> gui;
 
 	std::unique_ptr<vkb::stats::HPPStats> stats;
@@ -1003,8 +1021,21 @@ inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event
 
 template <vkb::BindingType bindingType>
 inline void VulkanSample<bindingType>::load_scene(const std::string &path)
+{
+	load_scene(path, scene_load_options);
+}
+
+template <vkb::BindingType bindingType>
+inline const vkb::SceneLoadOptions &VulkanSample<bindingType>::get_scene_load_options() const
+{
+	return scene_load_options;
+}
+
+template <vkb::BindingType bindingType>
+inline void VulkanSample<bindingType>::load_scene(const std::string &path, const vkb::SceneLoadOptions &options)
 {
 	vkb::HPPGLTFLoader loader(*device);
+	loader.set_options(options);
 
 	scene = loader.read_scene_from_file(path);
 
@@ -1023,6 +1054,8 @@ inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options
 		return false;
 	}
 
+	scene_load_options = options.scene_load_options;
+
 	LOGI("Initializing Vulkan sample");
 
 	// initialize C++-Bindings default dispatcher, first step
@@ -1102,6 +1135,26 @@ inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options
 		request_gpu_features(reinterpret_cast<vkb::PhysicalDevice &>(gpu));
 	}
 
+	// The staging uploader tracks its batches with a timeline semaphore when the device supports them.
+	// A sample requesting the Vulkan 1.2 features has to request timelineSemaphore there instead.
+	{
+		auto &c_gpu = reinterpret_cast<vkb::PhysicalDevice &>(gpu);
+
+		bool requested = std::ranges::any_of(device_extensions,
+		                                     [](auto const &extension) { return strcmp(extension.first, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0; });
+
+		if (c_gpu.is_extension_supported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) &&
+		    !c_gpu.get_requested_extension_features<VkPhysicalDeviceVulkan12Features>(VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES))
+		{
+			if (!requested)
+			{
+				add_device_extension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, /*optional=*/true);
+			}
+
+			REQUEST_OPTIONAL_FEATURE(c_gpu, VkPhysicalDeviceTimelineSemaphoreFeaturesKHR, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR, timelineSemaphore);
+		}
+	}
+
 	// Creating vulkan device, specifying the swapchain extension always
 	// If using VK_EXT_headless_surface, we still create and use a swap-chain
 	{
@@ -93,7 +93,10 @@ bool ExtendedDynamicState2::prepare(const vkb::ApplicationOptions &options)
  */
 void ExtendedDynamicState2::load_assets()
 {
-	load_scene("scenes/primitives/primitives.gltf");
+	// The draws bind the positions and normals as buffers of their own, so the attributes must not be interleaved
+	auto scene_options          = get_scene_load_options();
+	scene_options.vertex_layout = vkb::VertexLayout::Separate;
+	load_scene("scenes/primitives/primitives.gltf", scene_options);
 
 	std::vector<SceneNode>       scene_elements;
 	std::vector<vkb::sg::Node *> node_scene_list = {&(get_scene().get_root_node())};
@@ -888,9 +891,17 @@ void ExtendedDynamicState2::draw_from_scene(VkCommandBuffer command_buffer, std:
 {
 	for (int i = 0; i < scene_node.size(); ++i)
 	{
-		const auto &vertex_buffer_pos    = scene_node[i].sub_mesh->vertex_buffers.at("position");
-		const auto &vertex_buffer_normal = scene_node[i].sub_mesh->vertex_buffers.at("normal");
-		auto       &index_buffer         = scene_node[i].sub_mesh->index_buffer;
+		// The buffers may be shared with other submeshes when the scene is loaded with --mesh-arenas
+		const vkb::core::BufferC *vertex_buffer_pos    = nullptr;
+		const vkb::core::BufferC *vertex_buffer_normal = nullptr;
+		const vkb::core::BufferC *index_buffer         = nullptr;
+		VkDeviceSize              offset_pos           = 0;
+		VkDeviceSize              offset_normal        = 0;
+		VkDeviceSize              offset_index         = 0;
+
+		scene_node[i].sub_mesh->get_vertex_buffer("position", vertex_buffer_pos, offset_pos);
+		scene_node[i].sub_mesh->get_vertex_buffer("normal", vertex_buffer_normal, offset_normal);
+		scene_node[i].sub_mesh->get_index_buffer(index_buffer, offset_index);
 
 		if (scene_node[i].name != "Geosphere")
 		{
@@ -916,10 +927,9 @@ void ExtendedDynamicState2::draw_from_scene(VkCommandBuffer command_buffer, std:
 		                   sizeof(push_const_block),
 		                   &push_const_block);
 
-		VkDeviceSize offsets[1] = {0};
-		vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffer_pos.get(), offsets);
-		vkCmdBindVertexBuffers(command_buffer, 1, 1, vertex_buffer_normal.get(), offsets);
-		vkCmdBindIndexBuffer(command_buffer, index_buffer->get_handle(), 0, scene_node[i].sub_mesh->index_type);
+		vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffer_pos->get(), &offset_pos);
+		vkCmdBindVertexBuffers(command_buffer, 1, 1, vertex_buffer_normal->get(), &offset_normal);
+		vkCmdBindIndexBuffer(command_buffer, index_buffer->get_handle(), offset_index, scene_node[i].sub_mesh->index_type);
 
 		vkCmdDrawIndexed(command_buffer, scene_node[i].sub_mesh->vertex_indices, 1, 0, 0, 0);
 	}
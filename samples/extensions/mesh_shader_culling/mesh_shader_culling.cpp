@@ -1,4 +1,4 @@
-/* Copyright (c) 2023-2024, Holochip Corporation
+/* Copyright (c) 2023-2025, Holochip Corporation
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -20,6 +20,9 @@
 
 #include "mesh_shader_culling.h"
 
+#include "gltf_loader.h"
+#include "scene_graph/components/sub_mesh.h"
+
 MeshShaderCulling::MeshShaderCulling()
 {
 	title = "Mesh shader culling";
@@ -42,6 +45,12 @@ MeshShaderCulling::~MeshShaderCulling()
 		vkDestroyPipeline(get_device().get_handle(), pipeline, nullptr);
 		vkDestroyPipelineLayout(get_device().get_handle(), pipeline_layout, nullptr);
 		vkDestroyDescriptorSetLayout(get_device().get_handle(), descriptor_set_layout, nullptr);
+		vkDestroyPipeline(get_device().get_handle(), model_pipeline, nullptr);
+		vkDestroyPipelineLayout(get_device().get_handle(), model_pipeline_layout, nullptr);
+		vkDestroyDescriptorSetLayout(get_device().get_handle(), model_descriptor_set_layout, nullptr);
+
+		model_uniform_buffer.reset();
+		model_scene.reset();
 
 		if (query_pool != VK_NULL_HANDLE)
 		{
@@ -101,16 +110,30 @@ void MeshShaderCulling::build_command_buffers()
 		VkRect2D scissor = vkb::initializers::rect2D(static_cast<int32_t>(width), static_cast<int32_t>(height), 0, 0);
 		vkCmdSetScissor(draw_cmd_buffers[i], 0, 1, &scissor);
 
-		vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
-		vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-
-		// Mesh shaders need the vkCmdDrawMeshTasksExt
-		uint32_t N = density_level == 0 ? 4 : (density_level == 1 ? 6 : (density_level == 2 ? 8 : 2));
-		// dispatch N * N task shader workgroups
-		uint32_t num_workgroups_x = N;
-		uint32_t num_workgroups_y = N;
+		uint32_t num_workgroups_x = 1;
+		uint32_t num_workgroups_y = 1;
 		uint32_t num_workgroups_z = 1;
 
+		if (draw_model)
+		{
+			vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, model_pipeline_layout, 0, 1, &model_descriptor_set, 0, nullptr);
+			vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, model_pipeline);
+
+			// Each task shader workgroup culls 32 meshlets, see meshletsPerTaskWorkgroup
+			num_workgroups_x = (model_submesh->meshlet_count + 31) / 32;
+		}
+		else
+		{
+			vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
+			vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+			// Mesh shaders need the vkCmdDrawMeshTasksExt
+			uint32_t N = density_level == 0 ? 4 : (density_level == 1 ? 6 : (density_level == 2 ? 8 : 2));
+			// dispatch N * N task shader workgroups
+			num_workgroups_x = N;
+			num_workgroups_y = N;
+		}
+
 		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
 		{
 			// Begin pipeline statistics query
@@ -135,10 +158,12 @@ void MeshShaderCulling::build_command_buffers()
 
 void MeshShaderCulling::setup_descriptor_pool()
 {
+	// The model set also holds the culling uniform buffer, the model uniform buffer and the meshlet and position buffers
 	std::vector<VkDescriptorPoolSize> pool_sizes = {
-	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1)};
+	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3),
+	    vkb::initializers::descriptor_pool_size(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5)};
 
-	uint32_t number_of_descriptor_sets = 1;
+	uint32_t number_of_descriptor_sets = 2;
 
 	VkDescriptorPoolCreateInfo descriptor_pool_create_info =
 	    vkb::initializers::descriptor_pool_create_info(static_cast<uint32_t>(pool_sizes.size()),
@@ -164,6 +189,29 @@ void MeshShaderCulling::setup_descriptor_set_layout()
 	    vkb::initializers::pipeline_layout_create_info(&descriptor_set_layout, 1);
 
 	VK_CHECK(vkCreatePipelineLayout(get_device().get_handle(), &pipeline_layout_create_info, nullptr, &pipeline_layout));
+
+	if (!model_submesh)
+	{
+		return;
+	}
+
+	std::vector<VkDescriptorSetLayoutBinding> model_set_layout_bindings = {
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_TASK_BIT_EXT, 0),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT, 1),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_MESH_BIT_EXT, 2),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_TASK_BIT_EXT, 3),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_MESH_BIT_EXT, 4),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_MESH_BIT_EXT, 5),
+	    vkb::initializers::descriptor_set_layout_binding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_MESH_BIT_EXT, 6)};
+
+	descriptor_layout_create_info =
+	    vkb::initializers::descriptor_set_layout_create_info(model_set_layout_bindings.data(), static_cast<uint32_t>(model_set_layout_bindings.size()));
+
+	VK_CHECK(vkCreateDescriptorSetLayout(get_device().get_handle(), &descriptor_layout_create_info, nullptr, &model_descriptor_set_layout));
+
+	pipeline_layout_create_info = vkb::initializers::pipeline_layout_create_info(&model_descriptor_set_layout, 1);
+
+	VK_CHECK(vkCreatePipelineLayout(get_device().get_handle(), &pipeline_layout_create_info, nullptr, &model_pipeline_layout));
 }
 
 void MeshShaderCulling::setup_descriptor_sets()
@@ -183,6 +231,34 @@ void MeshShaderCulling::setup_descriptor_sets()
 	                                            &uniform_buffer_descriptor)};
 
 	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(write_descriptor_sets.size()), write_descriptor_sets.data(), 0, nullptr);
+
+	if (!model_submesh)
+	{
+		return;
+	}
+
+	// Model descriptor set
+	alloc_info = vkb::initializers::descriptor_set_allocate_info(descriptor_pool, &model_descriptor_set_layout, 1);
+
+	VK_CHECK(vkAllocateDescriptorSets(get_device().get_handle(), &alloc_info, &model_descriptor_set));
+
+	VkDescriptorBufferInfo model_uniform_buffer_descriptor = create_descriptor(*model_uniform_buffer);
+	VkDescriptorBufferInfo meshlets_descriptor             = create_descriptor(model_submesh->meshlet_buffers.at("meshlets"));
+	VkDescriptorBufferInfo meshlet_bounds_descriptor       = create_descriptor(model_submesh->meshlet_buffers.at("meshlet_bounds"));
+	VkDescriptorBufferInfo meshlet_vertices_descriptor     = create_descriptor(model_submesh->meshlet_buffers.at("meshlet_vertices"));
+	VkDescriptorBufferInfo meshlet_triangles_descriptor    = create_descriptor(model_submesh->meshlet_buffers.at("meshlet_triangles"));
+	VkDescriptorBufferInfo positions_descriptor            = create_descriptor(model_submesh->vertex_buffers.at("position"));
+
+	write_descriptor_sets = {
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0, &uniform_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, &model_uniform_buffer_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &meshlets_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &meshlet_bounds_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4, &meshlet_vertices_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5, &meshlet_triangles_descriptor),
+	    vkb::initializers::write_descriptor_set(model_descriptor_set, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 6, &positions_descriptor)};
+
+	vkUpdateDescriptorSets(get_device().get_handle(), static_cast<uint32_t>(write_descriptor_sets.size()), write_descriptor_sets.data(), 0, nullptr);
 }
 
 void MeshShaderCulling::prepare_pipelines()
@@ -243,6 +319,25 @@ void MeshShaderCulling::prepare_pipelines()
 	pipeline_create_info.pStages             = shader_stages.data();
 
 	VK_CHECK(vkCreateGraphicsPipelines(get_device().get_handle(), pipeline_cache, 1, &pipeline_create_info, nullptr, &pipeline));
+
+	if (!model_submesh)
+	{
+		return;
+	}
+
+	// The model is depth tested, with a reversed depth range
+	depth_stencil_state = vkb::initializers::pipeline_depth_stencil_state_create_info(VK_TRUE, VK_TRUE, VK_COMPARE_OP_GREATER);
+
+	shader_stages.clear();
+	shader_stages.push_back(load_shader("mesh_shader_culling/mesh_shader_culling_meshlets.task", VK_SHADER_STAGE_TASK_BIT_EXT));
+	shader_stages.push_back(load_shader("mesh_shader_culling/mesh_shader_culling_meshlets.mesh", VK_SHADER_STAGE_MESH_BIT_EXT));
+	shader_stages.push_back(load_shader("mesh_shader_culling/mesh_shader_culling.frag", VK_SHADER_STAGE_FRAGMENT_BIT));
+
+	pipeline_create_info.layout     = model_pipeline_layout;
+	pipeline_create_info.stageCount = static_cast<uint32_t>(shader_stages.size());
+	pipeline_create_info.pStages    = shader_stages.data();
+
+	VK_CHECK(vkCreateGraphicsPipelines(get_device().get_handle(), pipeline_cache, 1, &pipeline_create_info, nullptr, &model_pipeline));
 }
 
 void MeshShaderCulling::prepare_uniform_buffers()
@@ -251,12 +346,73 @@ void MeshShaderCulling::prepare_uniform_buffers()
 	                                                      sizeof(ubo_cull),
 	                                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 	                                                      VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+	if (model_submesh)
+	{
+		model_uniform_buffer = std::make_unique<vkb::core::BufferC>(get_device(),
+		                                                            sizeof(ubo_model),
+		                                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		                                                            VMA_MEMORY_USAGE_CPU_TO_GPU);
+	}
+
 	update_uniform_buffers();
 }
 
 void MeshShaderCulling::update_uniform_buffers()
 {
 	uniform_buffer->convert_and_update(ubo_cull);
+
+	if (model_uniform_buffer)
+	{
+		// The model is viewed from a fixed camera, the culling circle moves over it
+		ubo_model.projection      = glm::perspective(glm::radians(60.0f), static_cast<float>(width) / static_cast<float>(height), 256.0f, 0.1f);
+		ubo_model.camera_position = glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+		ubo_model.view            = glm::lookAt(glm::vec3(ubo_model.camera_position), glm::vec3(0.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+		ubo_model.cone_culling    = cone_culling ? 1 : 0;
+
+		model_uniform_buffer->convert_and_update(ubo_model);
+	}
+}
+
+void MeshShaderCulling::load_assets()
+{
+	// Build the meshlets within the mesh shader outputs of the device, and of the model shaders
+	VkPhysicalDeviceMeshShaderPropertiesEXT mesh_shader_properties{};
+	mesh_shader_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+	VkPhysicalDeviceProperties2 device_properties{};
+	device_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+	device_properties.pNext = &mesh_shader_properties;
+	vkGetPhysicalDeviceProperties2(get_device().get_gpu().get_handle(), &device_properties);
+
+	// Matches maxMeshletVertices and maxMeshletTriangles of meshlet_shared.h
+	meshlet_limits = vkb::MeshletLimits::from_device(mesh_shader_properties, 64, 124);
+
+	vkb::GLTFLoader loader{get_device()};
+	loader.set_meshlet_generation(true, meshlet_limits);
+
+	// The mesh shader reads the positions from the vertex buffer
+	model_scene = loader.read_scene_from_file("scenes/teapot.gltf", -1, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+	if (model_scene)
+	{
+		for (auto *submesh : model_scene->get_components<vkb::sg::SubMesh>())
+		{
+			vkb::sg::VertexAttribute position;
+			if (submesh->meshlet_count > 0 && submesh->get_attribute("position", position) && position.format == VK_FORMAT_R32G32B32_SFLOAT)
+			{
+				model_submesh             = submesh;
+				ubo_model.meshlet_count   = submesh->meshlet_count;
+				ubo_model.position_offset = position.offset / sizeof(float);
+				ubo_model.position_stride = position.stride / sizeof(float);
+				break;
+			}
+		}
+	}
+
+	if (!model_submesh)
+	{
+		LOGW("No meshlets were built for the model, only the generated grid can be drawn");
+	}
 }
 
 void MeshShaderCulling::draw()
@@ -295,6 +451,7 @@ bool MeshShaderCulling::prepare(const vkb::ApplicationOptions &options)
 		setup_query_result_buffer();
 	}
 
+	load_assets();
 	prepare_uniform_buffers();
 	setup_descriptor_set_layout();
 	prepare_pipelines();
@@ -337,6 +494,20 @@ void MeshShaderCulling::on_update_ui_overlay(vkb::Drawer &drawer)
 			update_uniform_buffers();
 		}
 
+		if (model_submesh)
+		{
+			drawer.checkbox("Draw model meshlets", &draw_model);
+
+			if (draw_model)
+			{
+				if (drawer.checkbox("Normal cone culling", &cone_culling))
+				{
+					update_uniform_buffers();
+				}
+				drawer.text("Meshlets: %d (max %d vertices, %d triangles)", model_submesh->meshlet_count, meshlet_limits.max_vertices, meshlet_limits.max_triangles);
+			}
+		}
+
 		if (get_device().get_gpu().get_features().pipelineStatisticsQuery)
 		{
 			if (drawer.header("Pipeline statistics"))
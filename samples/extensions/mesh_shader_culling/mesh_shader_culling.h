@@ -1,4 +1,4 @@
-/* Copyright (c) 2023-2024, Holochip Corporation
+/* Copyright (c) 2023-2025, Holochip Corporation
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -21,7 +21,9 @@
 #pragma once
 
 #include "api_vulkan_sample.h"
+#include "geometry/meshlet_builder.h"
 #include "glsl_compiler.h"
+#include "scene_graph/scene.h"
 
 class MeshShaderCulling : public ApiVulkanSample
 {
@@ -34,6 +36,19 @@ class MeshShaderCulling : public ApiVulkanSample
 	VkDescriptorSet       descriptor_set        = VK_NULL_HANDLE;
 	VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
 
+	// Meshlets of a model built by the GLTFLoader, culled with their bounds in the task shader
+	bool                                draw_model     = false;
+	bool                                cone_culling   = true;
+	vkb::MeshletLimits                  meshlet_limits = {};
+	std::unique_ptr<vkb::sg::Scene>     model_scene{};
+	vkb::sg::SubMesh                   *model_submesh = nullptr;
+	std::unique_ptr<vkb::core::BufferC> model_uniform_buffer{};
+
+	VkPipeline            model_pipeline              = VK_NULL_HANDLE;
+	VkPipelineLayout      model_pipeline_layout       = VK_NULL_HANDLE;
+	VkDescriptorSet       model_descriptor_set        = VK_NULL_HANDLE;
+	VkDescriptorSetLayout model_descriptor_set_layout = VK_NULL_HANDLE;
+
 	// Pipeline statistics
 	struct
 	{
@@ -51,6 +66,16 @@ class MeshShaderCulling : public ApiVulkanSample
 		float cull_radius     = 1.0f;
 		float meshlet_density = 2.0f;
 	} ubo_cull{};
+	struct ModelUBO
+	{
+		glm::mat4 projection;
+		glm::mat4 view;
+		glm::vec4 camera_position;
+		uint32_t  meshlet_count;
+		uint32_t  cone_culling;
+		uint32_t  position_offset;
+		uint32_t  position_stride;
+	} ubo_model{};
 	MeshShaderCulling();
 	~MeshShaderCulling() override;
 	void request_gpu_features(vkb::PhysicalDevice &gpu) override;
@@ -59,6 +84,7 @@ class MeshShaderCulling : public ApiVulkanSample
 	void setup_descriptor_set_layout();
 	void setup_descriptor_sets();
 	void prepare_pipelines();
+	void load_assets();
 	void prepare_uniform_buffers();
 	void update_uniform_buffers();
 	void draw();
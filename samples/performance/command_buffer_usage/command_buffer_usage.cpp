@@ -28,6 +28,7 @@
 #include "gui.h"
 
 #include "stats/stats.h"
+#include "timer.h"
 
 CommandBufferUsage::CommandBufferUsage()
 {
@@ -97,7 +98,9 @@ bool CommandBufferUsage::prepare(const vkb::ApplicationOptions &options)
 
 void CommandBufferUsage::prepare_render_context()
 {
-	max_thread_count = std::max(std::thread::hardware_concurrency(), MIN_THREAD_COUNT);
+	// Recording defaults to one thread per core, the frames are prepared for more so that thread counts can be compared
+	gui_thread_count = static_cast<int>(std::max(std::thread::hardware_concurrency(), MIN_THREAD_COUNT));
+	max_thread_count = std::max(std::thread::hardware_concurrency(), MAX_COMPARED_THREAD_COUNT);
 	get_render_context().prepare(max_thread_count);
 }
 
@@ -114,7 +117,7 @@ void CommandBufferUsage::update(float delta_time)
 	use_secondary_command_buffers = subpass_state.secondary_cmd_buf_count > 0;
 
 	// If there are not enough command buffers to keep all threads busy, use fewer threads
-	subpass_state.thread_count = std::min(subpass_state.secondary_cmd_buf_count, max_thread_count);
+	subpass_state.thread_count = std::min(subpass_state.secondary_cmd_buf_count, vkb::to_u32(gui_thread_count));
 
 	subpass_state.command_buffer_reset_mode = static_cast<vkb::CommandBufferResetMode>(gui_command_buffer_reset_mode);
 
@@ -128,23 +131,62 @@ void CommandBufferUsage::update(float delta_time)
 
 	auto primary_command_buffer = render_context.begin(subpass_state.command_buffer_reset_mode);
 
+	// With a shared pool, all recording threads sub-allocate their uniforms from the same blocks
+	render_context.get_active_frame().set_buffer_allocation_strategy(gui_shared_buffer_pool ?
+	                                                                     vkb::rendering::BufferAllocationStrategy::MultipleAllocationsPerSharedBuffer :
+	                                                                     vkb::rendering::BufferAllocationStrategy::MultipleAllocationsPerBuffer);
+
 	update_stats(delta_time);
 
 	primary_command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	get_stats().begin_sampling(*primary_command_buffer);
 
+	vkb::Timer record_timer;
+	record_timer.start();
+
 	draw(*primary_command_buffer, render_context.get_active_frame().get_render_target());
 
+	double record_time = record_timer.stop<vkb::Timer::Milliseconds>();
+
 	get_stats().end_sampling(*primary_command_buffer);
 	primary_command_buffer->end();
 
 	render_context.submit(primary_command_buffer);
+
+	bool recorded_in_threads = use_secondary_command_buffers && subpass_state.multi_threading;
+	log_allocation_comparison(recorded_in_threads ? subpass_state.thread_count : 1, record_time);
+}
+
+void CommandBufferUsage::log_allocation_comparison(uint32_t thread_count, double record_time)
+{
+	// Start over whenever the settings change, so that every line covers a single configuration
+	if (allocation_comparison.thread_count != thread_count || allocation_comparison.shared_buffer_pool != gui_shared_buffer_pool)
+	{
+		allocation_comparison                    = {};
+		allocation_comparison.thread_count       = thread_count;
+		allocation_comparison.shared_buffer_pool = gui_shared_buffer_pool;
+	}
+
+	allocation_comparison.record_time += record_time;
+
+	if (++allocation_comparison.frame_count == COMPARISON_FRAME_COUNT)
+	{
+		// Per-thread pools keep the blocks of threads no longer in use, compare them with increasing thread counts
+		LOGI("{} buffer pools, {} recording threads: {:.3f} ms recording per frame, {} KB of transient buffers per frame",
+		     gui_shared_buffer_pool ? "Shared" : "Per-thread",
+		     thread_count,
+		     allocation_comparison.record_time / COMPARISON_FRAME_COUNT,
+		     get_render_context().get_active_frame().get_buffer_memory_size() / 1024);
+
+		allocation_comparison.frame_count = 0;
+		allocation_comparison.record_time = 0.0;
+	}
 }
 
 void CommandBufferUsage::draw_gui()
 {
 	const bool landscape = camera->get_aspect_ratio() > 1.0f;
-	uint32_t   lines     = landscape ? 3 : 5;
+	uint32_t   lines     = landscape ? 4 : 6;
 
 	const auto &subpass = static_cast<ForwardSubpassSecondary *>(get_render_pipeline().get_active_subpass().get());
 
@@ -162,6 +204,15 @@ void CommandBufferUsage::draw_gui()
 		    ImGui::SameLine();
 		    ImGui::Text("(%d threads)", subpass->get_state().thread_count);
 
+		    // Thread count and buffer allocation strategy, the log compares their recording time and memory
+		    ImGui::PushItemWidth(ImGui::GetWindowWidth() * 0.35f);
+		    ImGui::SliderInt("##threads", &gui_thread_count, 1, max_thread_count, "Threads: %d");
+		    ImGui::PopItemWidth();
+		    ImGui::SameLine();
+		    ImGui::Checkbox("Shared buffer pool", &gui_shared_buffer_pool);
+		    ImGui::SameLine();
+		    ImGui::Text("%llu KB", static_cast<unsigned long long>(get_render_context().get_active_frame().get_buffer_memory_size() / 1024));
+
 		    // Buffer management options
 		    ImGui::RadioButton(
 		        "Allocate and free", &gui_command_buffer_reset_mode, static_cast<int>(vkb::CommandBufferResetMode::AlwaysAllocate));
@@ -148,9 +148,37 @@ class CommandBufferUsage : public vkb::VulkanSampleC
 
 	bool gui_multi_threading{false};
 
+	int gui_thread_count{0};
+
+	bool gui_shared_buffer_pool{false};
+
 	const uint32_t MIN_THREAD_COUNT{4};
 
+	// Upper bound of the thread count slider, to compare the buffer allocation strategies from 1 to 32 threads
+	const uint32_t MAX_COMPARED_THREAD_COUNT{32};
+
 	uint32_t max_thread_count{0};
+
+	/**
+	 * @brief Recording time and transient buffer memory of the current threading and buffer allocation settings,
+	 *        logged every COMPARISON_FRAME_COUNT frames
+	 */
+	struct AllocationComparison
+	{
+		uint32_t thread_count{0};
+
+		bool shared_buffer_pool{false};
+
+		uint32_t frame_count{0};
+
+		double record_time{0.0};
+	};
+
+	static constexpr uint32_t COMPARISON_FRAME_COUNT{300};
+
+	AllocationComparison allocation_comparison;
+
+	void log_allocation_comparison(uint32_t thread_count, double record_time);
 };
 
 std::unique_ptr<vkb::VulkanSampleC> create_command_buffer_usage();
@@ -500,8 +500,12 @@ void ConstantData::BufferArraySubpass::draw_submesh_command(vkb::core::CommandBu
 	 */
 	if (sub_mesh.vertex_indices != 0)
 	{
+		const vkb::core::BufferC *index_buffer = nullptr;
+		VkDeviceSize              index_offset = 0;
+		sub_mesh.get_index_buffer(index_buffer, index_offset);
+
 		// Bind index buffer of submesh
-		command_buffer.bind_index_buffer(*sub_mesh.index_buffer, sub_mesh.index_offset, sub_mesh.index_type);
+		command_buffer.bind_index_buffer(*index_buffer, index_offset, sub_mesh.index_type);
 
 		command_buffer.draw_indexed(sub_mesh.vertex_indices, 1, 0, 0, instance_index++);
 	}
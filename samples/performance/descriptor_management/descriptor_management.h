@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <array>
+
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/forward_subpass.h"
 #include "scene_graph/components/perspective_camera.h"
 #include "vulkan_sample.h"
 
@@ -51,13 +54,48 @@ class DescriptorManagement : public vkb::VulkanSampleC
 
 	RadioButtonGroup buffer_allocation{
 	    "Single large VkBuffer",
+	    {"Disabled", "Enabled", "Per frame"},
+	    0};
+
+	RadioButtonGroup object_data{
+	    "Per-frame object data",
 	    {"Disabled", "Enabled"},
 	    0};
 
-	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation};
+	std::vector<RadioButtonGroup *> radio_buttons = {&descriptor_caching, &buffer_allocation, &object_data};
 
 	vkb::sg::PerspectiveCamera *camera{nullptr};
 
+	vkb::ForwardSubpass *scene_subpass{nullptr};
+
+	/**
+	 * @brief CPU time per draw of a per-frame object data mode, accumulated over COMPARISON_FRAME_COUNT frames
+	 */
+	struct DrawTimes
+	{
+		double cpu_time{0.0};
+
+		uint64_t draw_count{0};
+
+		uint32_t frame_count{0};
+
+		/// Result of the last complete measurement, 0 if there is none for the current settings
+		double cpu_time_per_draw{0.0};
+	};
+
+	static constexpr uint32_t COMPARISON_FRAME_COUNT{300};
+
+	/// Indexed by the per-frame object data option
+	std::array<DrawTimes, 2> object_data_draw_times;
+
+	/// Descriptor set caching and buffer allocation options the draw times were measured with
+	std::pair<int, int> draw_times_settings{-1, -1};
+
+	/**
+	 * @brief Logs the CPU time per draw of the current per-frame object data mode, and how it compares to the other mode
+	 */
+	void log_draw_times();
+
 	virtual void draw_gui() override;
 };
 
@@ -297,7 +297,12 @@ bool MultiDrawIndirect::prepare(const vkb::ApplicationOptions &options)
 void MultiDrawIndirect::load_scene()
 {
 	const std::string scene_path = "scenes/vokselia/";
-	ApiVulkanSample::load_scene(scene_path + "vokselia.gltf");
+
+	// The mesh data is read back on the host, from host visible buffers holding a single attribute each
+	auto scene_options          = get_scene_load_options();
+	scene_options.mesh_arenas   = false;
+	scene_options.vertex_layout = vkb::VertexLayout::Separate;
+	ApiVulkanSample::load_scene(scene_path + "vokselia.gltf", scene_options);
 
 	assert(has_scene());
 	for (auto &&mesh : get_scene().get_components<vkb::sg::Mesh>())
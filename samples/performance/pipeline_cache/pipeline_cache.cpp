@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2024, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -182,8 +182,12 @@ void PipelineCache::draw_gui()
 		    {
 			    ImGui::Text("Pipeline rebuild frame time: N/A");
 		    }
+
+		    auto &warmup_stats = get_device().get_resource_cache().get_warmup_stats();
+		    ImGui::Text("Cache warmup: %.1f ms across %u threads (serial: %.1f ms)",
+		                warmup_stats.build_time, warmup_stats.thread_count, warmup_stats.serial_build_time);
 	    },
-	    /* lines = */ 2);
+	    /* lines = */ 3);
 }
 
 void PipelineCache::update(float delta_time)
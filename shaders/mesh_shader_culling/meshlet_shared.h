@@ -0,0 +1,58 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Data of the meshlets built by the GLTFLoader, see vkb::MeshletData
+
+// Output limits of the mesh shader, the meshlets are built with the same vkb::MeshletLimits
+const uint maxMeshletVertices  = 64;
+const uint maxMeshletTriangles = 124;
+
+// One task shader invocation culls one meshlet
+const uint meshletsPerTaskWorkgroup = 32;
+
+struct MeshletDescription
+{
+	uint vertex_offset;
+	uint triangle_offset;
+	uint vertex_count;
+	uint triangle_count;
+};
+
+struct MeshletBounds
+{
+	vec3  center;
+	float radius;
+	vec3  cone_axis;
+	float cone_cutoff;
+};
+
+// Indices of the meshlets that passed the culling in a task shader workgroup
+struct MeshletPayload
+{
+	uint meshlet_indices[meshletsPerTaskWorkgroup];
+};
+
+layout(binding = 1) uniform ModelUBO
+{
+	mat4 projection;
+	mat4 view;
+	vec4 camera_position;
+	uint meshlet_count;
+	uint cone_culling;
+	uint position_offset;
+	uint position_stride;
+} model_ubo;
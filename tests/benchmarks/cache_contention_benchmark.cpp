@@ -0,0 +1,203 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "headless_device.h"
+#include "pipeline_variants.h"
+#include "timer.h"
+
+/*
+ * Measures the latency of graphics pipeline cache hits on recording threads, while another thread compiles new pipelines:
+ * - exclusive: every request holds one mutex for the whole lookup or creation, as the resource cache did before
+ * - shared: the locking of the resource cache, hits take a shared lock and pipelines are built outside of it
+ *
+ * Usage: vkb__cache_contention_benchmark [hit threads] [compiled pipelines]
+ */
+namespace
+{
+struct HitLatency
+{
+	double mean{0.0};
+
+	double p99{0.0};
+
+	double max{0.0};
+
+	size_t count{0};
+};
+
+HitLatency get_latency(std::vector<double> &samples)
+{
+	HitLatency latency;
+
+	if (samples.empty())
+	{
+		return latency;
+	}
+
+	std::sort(samples.begin(), samples.end());
+
+	double total = 0.0;
+	for (double sample : samples)
+	{
+		total += sample;
+	}
+
+	latency.count = samples.size();
+	latency.mean  = total / static_cast<double>(samples.size());
+	latency.p99   = samples[samples.size() * 99 / 100];
+	latency.max   = samples.back();
+
+	return latency;
+}
+
+/**
+ * @brief Runs the hit threads until the compile thread has created its pipelines
+ * @param exclusive Whether every request is serialized behind a single mutex
+ * @param first_pipeline Index of the first pipeline variant to compile, variants compiled by a previous run would be hits
+ * @return The latency of the hits in microseconds
+ */
+HitLatency run(vkb::ResourceCache &cache, const vkb::PipelineState &hit_state, bool exclusive, uint32_t hit_thread_count, uint32_t first_pipeline, uint32_t pipeline_count, double &compile_time)
+{
+	std::mutex        exclusive_mutex;
+	std::atomic<bool> compiling{true};
+
+	std::vector<std::vector<double>> thread_samples(hit_thread_count);
+	std::vector<std::thread>         hit_threads;
+
+	for (uint32_t i = 0; i < hit_thread_count; ++i)
+	{
+		hit_threads.emplace_back([&, i]() {
+			auto  pipeline_state = hit_state;
+			auto &samples        = thread_samples[i];
+
+			samples.reserve(1 << 20);
+
+			vkb::Timer timer;
+
+			while (compiling.load(std::memory_order_relaxed))
+			{
+				timer.start();
+
+				if (exclusive)
+				{
+					std::lock_guard<std::mutex> guard(exclusive_mutex);
+					cache.request_graphics_pipeline(pipeline_state);
+				}
+				else
+				{
+					cache.request_graphics_pipeline(pipeline_state);
+				}
+
+				samples.push_back(timer.stop<vkb::Timer::Microseconds>());
+			}
+		});
+	}
+
+	vkb::Timer compile_timer;
+	compile_timer.start();
+
+	auto pipeline_state = hit_state;
+
+	for (uint32_t i = 0; i < pipeline_count; ++i)
+	{
+		vkb::set_pipeline_variant(pipeline_state, first_pipeline + i);
+
+		if (exclusive)
+		{
+			std::lock_guard<std::mutex> guard(exclusive_mutex);
+			cache.request_graphics_pipeline(pipeline_state);
+		}
+		else
+		{
+			cache.request_graphics_pipeline(pipeline_state);
+		}
+	}
+
+	compile_time = compile_timer.stop<vkb::Timer::Milliseconds>();
+
+	compiling = false;
+
+	for (auto &thread : hit_threads)
+	{
+		thread.join();
+	}
+
+	std::vector<double> samples;
+	for (auto &thread_sample : thread_samples)
+	{
+		samples.insert(samples.end(), thread_sample.begin(), thread_sample.end());
+	}
+
+	return get_latency(samples);
+}
+
+void print_latency(const char *locking, const HitLatency &latency, double compile_time)
+{
+	std::cout << locking << " lock: " << latency.count << " hits while compiling for " << compile_time << " ms, hit latency "
+	          << latency.mean << " us mean, " << latency.p99 << " us p99, " << latency.max << " us max" << std::endl;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	uint32_t hit_thread_count = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 4;
+	uint32_t pipeline_count   = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 64;
+
+	// One variant is the hit pipeline, and each run compiles its own variants
+	if (hit_thread_count == 0 || pipeline_count == 0 || 2 * pipeline_count >= vkb::PIPELINE_VARIANT_COUNT)
+	{
+		std::cerr << "Usage: " << argv[0] << " [hit threads] [compiled pipelines, at most " << (vkb::PIPELINE_VARIANT_COUNT - 1) / 2 << "]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		vkb::HeadlessDevice headless_device{"cache_contention_benchmark"};
+
+		auto &cache = headless_device.get_device().get_resource_cache();
+
+		auto hit_state = vkb::create_base_pipeline_state(cache);
+
+		cache.request_graphics_pipeline(hit_state);
+
+		double exclusive_compile_time = 0.0;
+		double shared_compile_time    = 0.0;
+
+		auto exclusive = run(cache, hit_state, true, hit_thread_count, 1, pipeline_count, exclusive_compile_time);
+		auto shared    = run(cache, hit_state, false, hit_thread_count, 1 + pipeline_count, pipeline_count, shared_compile_time);
+
+		std::cout << hit_thread_count << " hit threads, " << pipeline_count << " pipelines compiled per run" << std::endl;
+
+		print_latency("exclusive", exclusive, exclusive_compile_time);
+		print_latency("shared", shared, shared_compile_time);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
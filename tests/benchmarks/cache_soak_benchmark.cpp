@@ -0,0 +1,124 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "headless_device.h"
+#include "pipeline_variants.h"
+
+/*
+ * Cycles more graphics pipelines than the budget of the resource cache over many frames, so that pipelines
+ * are evicted and built again, and checks that neither the cache nor its serialized record keep growing.
+ *
+ * Usage: vkb__cache_soak_benchmark [budget] [pipelines] [cycles]
+ */
+namespace
+{
+constexpr uint64_t FRAMES_IN_FLIGHT = 2;
+
+constexpr uint32_t REQUESTS_PER_FRAME = 4;
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	uint32_t budget         = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 16;
+	uint32_t pipeline_count = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 48;
+	uint32_t cycle_count    = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 8;
+
+	if (budget == 0 || pipeline_count <= budget || pipeline_count > vkb::PIPELINE_VARIANT_COUNT || cycle_count < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " [budget] [pipelines, more than the budget and at most " << vkb::PIPELINE_VARIANT_COUNT << "] [cycles, at least 2]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		vkb::HeadlessDevice headless_device{"cache_soak_benchmark"};
+
+		auto &cache = headless_device.get_device().get_resource_cache();
+
+		cache.set_budget(vkb::ResourceType::GraphicsPipeline, budget);
+
+		auto pipeline_state = vkb::create_base_pipeline_state(cache);
+
+		// Pipelines of the frames not released yet are never evicted
+		size_t max_size = budget + FRAMES_IN_FLIGHT * REQUESTS_PER_FRAME;
+
+		size_t   record_size = 0;
+		size_t   peak_size   = 0;
+		uint32_t index       = 0;
+
+		for (uint32_t cycle = 0; cycle < cycle_count; ++cycle)
+		{
+			for (uint32_t request = 0; request < pipeline_count;)
+			{
+				uint64_t frame = cache.begin_frame();
+
+				for (uint32_t i = 0; i < REQUESTS_PER_FRAME && request < pipeline_count; ++i, ++request)
+				{
+					vkb::set_pipeline_variant(pipeline_state, index);
+					cache.request_graphics_pipeline(pipeline_state);
+
+					index = (index + 1) % pipeline_count;
+				}
+
+				// Nothing is submitted, the frames are complete as soon as they are out of flight
+				if (frame > FRAMES_IN_FLIGHT)
+				{
+					cache.release_frame(frame - FRAMES_IN_FLIGHT);
+				}
+
+				size_t size = cache.get_stats(vkb::ResourceType::GraphicsPipeline).size;
+				peak_size   = std::max(peak_size, size);
+
+				if (size > max_size)
+				{
+					std::cerr << "Cache holds " << size << " pipelines in cycle " << cycle << ", more than " << max_size << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+
+			// Every pipeline has been recorded once by the end of the first cycle
+			size_t size = cache.serialize().size();
+
+			if (cycle == 0)
+			{
+				record_size = size;
+			}
+			else if (size != record_size)
+			{
+				std::cerr << "Record grew from " << record_size << " to " << size << " bytes in cycle " << cycle << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		auto stats = cache.get_stats(vkb::ResourceType::GraphicsPipeline);
+
+		std::cout << pipeline_count << " pipelines cycled " << cycle_count << " times with a budget of " << budget << std::endl;
+		std::cout << "peak size " << peak_size << ", evictions " << stats.evictions << ", record " << record_size << " bytes" << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
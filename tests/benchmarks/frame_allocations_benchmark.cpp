@@ -0,0 +1,232 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "buffer_pool.h"
+#include "common/glm_common.h"
+#include "core/command_pool.h"
+#include "headless_device.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "timer.h"
+
+/*
+ * Counts the heap allocations made while recording the per-draw uniform writes of a frame, as GeometrySubpass and
+ * Subpass::allocate_lights do, with a counting operator new:
+ * - copy: the uniforms are built on the stack and written with BufferAllocation::update(to_bytes(value)),
+ *         the path the framework used before BufferAllocation::map
+ * - map: the uniforms are written in place through BufferAllocation::map, then flushed
+ *
+ * Allocations of the command buffer itself, e.g. of its binding state, are counted as well and are the same for both.
+ *
+ * Usage: vkb__frame_allocations_benchmark [draws per frame] [frames]
+ */
+namespace
+{
+std::atomic<bool> counting{false};
+
+std::atomic<size_t> allocation_count{0};
+
+std::atomic<size_t> allocated_bytes{0};
+}        // namespace
+
+void *operator new(std::size_t size)
+{
+	if (counting.load(std::memory_order_relaxed))
+	{
+		allocation_count.fetch_add(1, std::memory_order_relaxed);
+		allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	if (void *memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t /*size*/) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+enum class WriteMode
+{
+	Copy,
+	Map
+};
+
+struct FrameAllocations
+{
+	double allocations{0.0};
+
+	double bytes{0.0};
+
+	double recording_time{0.0};
+};
+
+void write_uniform(vkb::BufferAllocationC &allocation, WriteMode mode, const glm::mat4 &model, const glm::mat4 &view_proj)
+{
+	if (mode == WriteMode::Copy)
+	{
+		vkb::GlobalUniform global_uniform;
+		global_uniform.model            = model;
+		global_uniform.camera_view_proj = view_proj;
+		global_uniform.camera_position  = glm::vec3(model[3]);
+
+		allocation.update(vkb::to_bytes(global_uniform));
+	}
+	else
+	{
+		auto &global_uniform            = allocation.map<vkb::GlobalUniform>()[0];
+		global_uniform.model            = model;
+		global_uniform.camera_view_proj = view_proj;
+		global_uniform.camera_position  = glm::vec3(model[3]);
+
+		allocation.flush();
+	}
+}
+
+void write_lights(vkb::BufferAllocationC &allocation, WriteMode mode)
+{
+	vkb::rendering::Light light{};
+	light.color = glm::vec4(1.0f);
+
+	if (mode == WriteMode::Copy)
+	{
+		vkb::ForwardLights light_info{};
+		std::fill(std::begin(light_info.point_lights), std::end(light_info.point_lights), light);
+
+		allocation.update(vkb::to_bytes(light_info));
+	}
+	else
+	{
+		auto &light_info = allocation.map<vkb::ForwardLights>()[0];
+		std::fill(std::begin(light_info.point_lights), std::end(light_info.point_lights), light);
+
+		allocation.flush();
+	}
+}
+
+FrameAllocations run(vkb::Device &device, WriteMode mode, uint32_t draw_count, uint32_t frame_count)
+{
+	vkb::core::CommandPoolC command_pool{device, device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0).get_family_index(), nullptr, 0, vkb::CommandBufferResetMode::ResetIndividually};
+
+	auto command_buffer = command_pool.request_command_buffer();
+
+	VkDeviceSize block_size = (draw_count + 1) * 2 * (sizeof(vkb::GlobalUniform) + sizeof(vkb::ForwardLights));
+
+	vkb::BufferBlockC uniform_block{device, block_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU};
+
+	glm::mat4 view_proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 256.0f);
+
+	FrameAllocations result;
+
+	vkb::Timer timer;
+
+	for (uint32_t frame = 0; frame < frame_count; ++frame)
+	{
+		uniform_block.reset();
+		command_buffer->reset(vkb::CommandBufferResetMode::ResetIndividually);
+
+		size_t allocations_before = allocation_count;
+		size_t bytes_before       = allocated_bytes;
+
+		timer.start();
+		counting = true;
+
+		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+		auto light_allocation = uniform_block.allocate(sizeof(vkb::ForwardLights));
+		write_lights(light_allocation, mode);
+		command_buffer->bind_buffer(light_allocation.get_buffer(), light_allocation.get_offset(), light_allocation.get_size(), 0, 4, 0);
+
+		for (uint32_t draw = 0; draw < draw_count; ++draw)
+		{
+			auto allocation = uniform_block.allocate(sizeof(vkb::GlobalUniform));
+
+			write_uniform(allocation, mode, glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(draw), 0.0f, 0.0f)), view_proj);
+
+			command_buffer->bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 1, 0);
+		}
+
+		command_buffer->end();
+
+		counting = false;
+		result.recording_time += timer.stop<vkb::Timer::Microseconds>();
+
+		result.allocations += static_cast<double>(allocation_count - allocations_before);
+		result.bytes += static_cast<double>(allocated_bytes - bytes_before);
+	}
+
+	result.allocations /= frame_count;
+	result.bytes /= frame_count;
+	result.recording_time /= frame_count;
+
+	return result;
+}
+
+void print_allocations(const char *mode, const FrameAllocations &allocations)
+{
+	std::cout << mode << ": " << allocations.allocations << " allocations and " << allocations.bytes << " bytes per frame, "
+	          << allocations.recording_time << " us recording" << std::endl;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	uint32_t draw_count  = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+	uint32_t frame_count = argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 100;
+
+	if (draw_count == 0 || frame_count == 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [draws per frame] [frames]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		vkb::HeadlessDevice headless_device{"frame_allocations_benchmark"};
+
+		auto copy = run(headless_device.get_device(), WriteMode::Copy, draw_count, frame_count);
+		auto map  = run(headless_device.get_device(), WriteMode::Map, draw_count, frame_count);
+
+		std::cout << draw_count << " draws per frame, " << frame_count << " frames" << std::endl;
+
+		print_allocations("update(to_bytes(value))", copy);
+		print_allocations("map<T>() and flush()", map);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Benchmark failed: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,325 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "common/resource_caching.h"
+#include "timer.h"
+
+// The field hashes of the former std::hash<vkb::PipelineState>, which the resource cache no longer uses
+namespace std
+{
+template <>
+struct hash<VkVertexInputAttributeDescription>
+{
+	std::size_t operator()(const VkVertexInputAttributeDescription &vertex_attrib) const
+	{
+		std::size_t result = 0;
+
+		vkb::hash_combine(result, vertex_attrib.binding);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkFormat>::type>(vertex_attrib.format));
+		vkb::hash_combine(result, vertex_attrib.location);
+		vkb::hash_combine(result, vertex_attrib.offset);
+
+		return result;
+	}
+};
+
+template <>
+struct hash<VkVertexInputBindingDescription>
+{
+	std::size_t operator()(const VkVertexInputBindingDescription &vertex_binding) const
+	{
+		std::size_t result = 0;
+
+		vkb::hash_combine(result, vertex_binding.binding);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkVertexInputRate>::type>(vertex_binding.inputRate));
+		vkb::hash_combine(result, vertex_binding.stride);
+
+		return result;
+	}
+};
+
+template <>
+struct hash<vkb::StencilOpState>
+{
+	std::size_t operator()(const vkb::StencilOpState &stencil) const
+	{
+		std::size_t result = 0;
+
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(stencil.compare_op));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.depth_fail_op));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.fail_op));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkStencilOp>::type>(stencil.pass_op));
+
+		return result;
+	}
+};
+
+template <>
+struct hash<vkb::ColorBlendAttachmentState>
+{
+	std::size_t operator()(const vkb::ColorBlendAttachmentState &color_blend_attachment) const
+	{
+		std::size_t result = 0;
+
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendOp>::type>(color_blend_attachment.alpha_blend_op));
+		vkb::hash_combine(result, color_blend_attachment.blend_enable);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendOp>::type>(color_blend_attachment.color_blend_op));
+		vkb::hash_combine(result, color_blend_attachment.color_write_mask);
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.dst_alpha_blend_factor));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.dst_color_blend_factor));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.src_alpha_blend_factor));
+		vkb::hash_combine(result, static_cast<std::underlying_type<VkBlendFactor>::type>(color_blend_attachment.src_color_blend_factor));
+
+		return result;
+	}
+};
+}        // namespace std
+
+/*
+ * Compares the cost of the per-draw graphics pipeline lookup of the resource cache:
+ * - before: a size_t key built with a std::hash call and a hash_combine per field, as std::hash<vkb::PipelineState> did before the cache maps were keyed by Hash128
+ * - after: a Hash128 key built by vkb::Hasher over the packed state, as hash_param(PipelineState) does
+ *
+ * The pipeline layout, render pass and shader modules need a device, so they are stood in for by handles and ids.
+ *
+ * Usage: vkb__hash_benchmark [lookup count]
+ */
+namespace
+{
+struct DrawState
+{
+	uint64_t pipeline_layout;
+
+	uint64_t render_pass;
+
+	std::vector<size_t> shader_ids;
+
+	uint32_t subpass_index{0};
+
+	vkb::VertexInputState vertex_input_state;
+
+	vkb::InputAssemblyState input_assembly_state;
+
+	vkb::ViewportState viewport_state;
+
+	vkb::RasterizationState rasterization_state;
+
+	vkb::MultisampleState multisample_state;
+
+	vkb::DepthStencilState depth_stencil_state;
+
+	vkb::ColorBlendState color_blend_state;
+};
+
+std::vector<DrawState> create_draw_states(size_t count)
+{
+	std::vector<DrawState> draw_states(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto &state = draw_states[i];
+
+		// A handful of materials, each drawn with a few vertex layouts and blend modes
+		state.pipeline_layout = 0x1000 + (i % 8) * 0x40;
+		state.render_pass     = 0x8000;
+		state.shader_ids      = {2 * (i % 8), 2 * (i % 8) + 1};
+
+		uint32_t attribute_count = 2 + static_cast<uint32_t>(i % 3);
+		for (uint32_t location = 0; location < attribute_count; ++location)
+		{
+			state.vertex_input_state.bindings.push_back({location, location == 0 ? 12u : 8u, VK_VERTEX_INPUT_RATE_VERTEX});
+			state.vertex_input_state.attributes.push_back({location, location, location == 0 ? VK_FORMAT_R32G32B32_SFLOAT : VK_FORMAT_R32G32_SFLOAT, 0});
+		}
+
+		state.rasterization_state.cull_mode = (i / 24) % 2 ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+
+		state.color_blend_state.attachments.resize(1);
+		state.color_blend_state.attachments[0].blend_enable = static_cast<VkBool32>((i / 48) % 2);
+	}
+
+	return draw_states;
+}
+
+size_t hash_combine_key(const DrawState &state)
+{
+	size_t result = 0;
+
+	vkb::hash_combine(result, state.pipeline_layout);
+	vkb::hash_combine(result, state.render_pass);
+	vkb::hash_combine(result, state.subpass_index);
+
+	for (auto shader_id : state.shader_ids)
+	{
+		vkb::hash_combine(result, shader_id);
+	}
+
+	for (auto &attribute : state.vertex_input_state.attributes)
+	{
+		vkb::hash_combine(result, attribute);
+	}
+
+	for (auto &binding : state.vertex_input_state.bindings)
+	{
+		vkb::hash_combine(result, binding);
+	}
+
+	vkb::hash_combine(result, state.input_assembly_state.primitive_restart_enable);
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkPrimitiveTopology>::type>(state.input_assembly_state.topology));
+
+	vkb::hash_combine(result, state.viewport_state.viewport_count);
+	vkb::hash_combine(result, state.viewport_state.scissor_count);
+
+	vkb::hash_combine(result, state.rasterization_state.cull_mode);
+	vkb::hash_combine(result, state.rasterization_state.depth_bias_enable);
+	vkb::hash_combine(result, state.rasterization_state.depth_clamp_enable);
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkFrontFace>::type>(state.rasterization_state.front_face));
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkPolygonMode>::type>(state.rasterization_state.polygon_mode));
+	vkb::hash_combine(result, state.rasterization_state.rasterizer_discard_enable);
+
+	vkb::hash_combine(result, state.multisample_state.alpha_to_coverage_enable);
+	vkb::hash_combine(result, state.multisample_state.alpha_to_one_enable);
+	vkb::hash_combine(result, state.multisample_state.min_sample_shading);
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkSampleCountFlagBits>::type>(state.multisample_state.rasterization_samples));
+	vkb::hash_combine(result, state.multisample_state.sample_shading_enable);
+	vkb::hash_combine(result, state.multisample_state.sample_mask);
+
+	vkb::hash_combine(result, state.depth_stencil_state.back);
+	vkb::hash_combine(result, state.depth_stencil_state.depth_bounds_test_enable);
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkCompareOp>::type>(state.depth_stencil_state.depth_compare_op));
+	vkb::hash_combine(result, state.depth_stencil_state.depth_test_enable);
+	vkb::hash_combine(result, state.depth_stencil_state.depth_write_enable);
+	vkb::hash_combine(result, state.depth_stencil_state.front);
+	vkb::hash_combine(result, state.depth_stencil_state.stencil_test_enable);
+
+	vkb::hash_combine(result, static_cast<std::underlying_type<VkLogicOp>::type>(state.color_blend_state.logic_op));
+	vkb::hash_combine(result, state.color_blend_state.logic_op_enable);
+
+	for (auto &attachment : state.color_blend_state.attachments)
+	{
+		vkb::hash_combine(result, attachment);
+	}
+
+	return result;
+}
+
+vkb::Hash128 hasher_key(const DrawState &state)
+{
+	vkb::Hasher hasher;
+
+	hasher.update(state.pipeline_layout);
+	hasher.update(state.render_pass);
+	hasher.update(state.subpass_index);
+	hasher.update(state.shader_ids.data(), state.shader_ids.size() * sizeof(size_t));
+
+	auto &vertex_input_state = state.vertex_input_state;
+	hasher.update(vertex_input_state.attributes.data(), vertex_input_state.attributes.size() * sizeof(VkVertexInputAttributeDescription));
+	hasher.update(vertex_input_state.bindings.data(), vertex_input_state.bindings.size() * sizeof(VkVertexInputBindingDescription));
+
+	hasher.update(state.input_assembly_state);
+	hasher.update(state.viewport_state);
+	hasher.update(state.rasterization_state);
+	hasher.update(state.multisample_state);
+	hasher.update(state.depth_stencil_state);
+
+	auto &color_blend_state = state.color_blend_state;
+	hasher.update(color_blend_state.logic_op_enable);
+	hasher.update(color_blend_state.logic_op);
+	hasher.update(color_blend_state.attachments.data(), color_blend_state.attachments.size() * sizeof(vkb::ColorBlendAttachmentState));
+
+	return hasher.get_hash();
+}
+
+/**
+ * @brief Looks up the draw states in turn, as a frame requesting the pipeline of each draw does
+ * @return The time per lookup in nanoseconds
+ */
+template <class K, class F>
+double time_lookups(const std::vector<DrawState> &draw_states, size_t lookup_count, F key_function, size_t &distinct_keys)
+{
+	std::unordered_map<K, size_t> pipelines;
+
+	for (size_t i = 0; i < draw_states.size(); ++i)
+	{
+		pipelines.emplace(key_function(draw_states[i]), i);
+	}
+
+	distinct_keys = pipelines.size();
+
+	size_t found = 0;
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (size_t i = 0; i < lookup_count; ++i)
+	{
+		auto it = pipelines.find(key_function(draw_states[i % draw_states.size()]));
+		found += it != pipelines.end() ? it->second : 0;
+	}
+
+	double elapsed = timer.stop<vkb::Timer::Nanoseconds>();
+
+	// Keeps the lookups from being optimized out
+	if (found == 0)
+	{
+		std::cerr << "No pipeline found" << std::endl;
+	}
+
+	return elapsed / static_cast<double>(lookup_count);
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	size_t lookup_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	if (lookup_count == 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [lookup count]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	auto draw_states = create_draw_states(96);
+
+	// Keys only compare equal if their check words match, a collision of the 128-bit hash yields two entries
+	vkb::Hash128 key      = hasher_key(draw_states[0]);
+	vkb::Hash128 collided = key;
+	collided.check ^= 1;
+
+	std::unordered_map<vkb::Hash128, size_t> collision_map{{key, 0}, {collided, 1}};
+	if (collision_map.size() != 2 || collision_map.at(key) != 0)
+	{
+		std::cerr << "Keys with a different check word were merged" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	size_t hash_combine_keys = 0;
+	size_t hasher_keys       = 0;
+
+	double hash_combine_time = time_lookups<size_t>(draw_states, lookup_count, hash_combine_key, hash_combine_keys);
+	double hasher_time       = time_lookups<vkb::Hash128>(draw_states, lookup_count, hasher_key, hasher_keys);
+
+	std::cout << draw_states.size() << " draw states, " << lookup_count << " lookups" << std::endl;
+	std::cout << "hash_combine key: " << hash_combine_time << " ns per lookup, " << hash_combine_keys << " distinct keys" << std::endl;
+	std::cout << "Hasher key:       " << hasher_time << " ns per lookup, " << hasher_keys << " distinct keys" << std::endl;
+
+	return hasher_keys == draw_states.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "core/device.h"
+#include "core/instance.h"
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+/**
+ * @brief An instance and a device on the first GPU, without a surface, for benchmarks that do not present.
+ *        Assets and shaders are read relative to the working directory, benchmarks are run from the root of the repository.
+ */
+class HeadlessDevice
+{
+  public:
+	explicit HeadlessDevice(const std::string &application_name)
+	{
+		filesystem::init();
+
+#if defined(_HPP_VULKAN_LIBRARY)
+		static vk::detail::DynamicLoader dl(_HPP_VULKAN_LIBRARY);
+#else
+		static vk::detail::DynamicLoader dl;
+#endif
+		VULKAN_HPP_DEFAULT_DISPATCHER.init(dl.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr"));
+
+		VkResult result = volkInitialize();
+		if (result)
+		{
+			throw VulkanException(result, "Failed to initialize volk.");
+		}
+
+		instance = std::make_unique<Instance>(application_name);
+
+		VULKAN_HPP_DEFAULT_DISPATCHER.init(vk::Instance{instance->get_handle()});
+
+		device = std::make_unique<Device>(instance->get_first_gpu(), VK_NULL_HANDLE, std::make_unique<DummyDebugUtils>(), std::unordered_map<const char *, bool>{});
+
+		VULKAN_HPP_DEFAULT_DISPATCHER.init(vk::Device{device->get_handle()});
+	}
+
+	Device &get_device()
+	{
+		return *device;
+	}
+
+  private:
+	std::unique_ptr<Instance> instance;
+
+	std::unique_ptr<Device> device;
+};
+}        // namespace vkb
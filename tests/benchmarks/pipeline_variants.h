@@ -0,0 +1,91 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "rendering/pipeline_state.h"
+#include "rendering/subpasses/forward_subpass.h"
+#include "resource_cache.h"
+
+namespace vkb
+{
+/// Number of pipelines set_pipeline_variant can tell apart
+constexpr uint32_t PIPELINE_VARIANT_COUNT = (MAX_FORWARD_LIGHT_COUNT + 1) * (MAX_FORWARD_LIGHT_COUNT + 1) * (MAX_FORWARD_LIGHT_COUNT + 1);
+
+/**
+ * @brief Sets the light count specialization constants of base.frag, so that each index yields a different pipeline
+ */
+inline void set_pipeline_variant(PipelineState &pipeline_state, uint32_t index)
+{
+	uint32_t light_counts = MAX_FORWARD_LIGHT_COUNT + 1;
+
+	pipeline_state.set_specialization_constant(0, to_bytes(index % light_counts));
+	pipeline_state.set_specialization_constant(1, to_bytes((index / light_counts) % light_counts));
+	pipeline_state.set_specialization_constant(2, to_bytes((index / (light_counts * light_counts)) % light_counts));
+}
+
+/**
+ * @brief Creates the state of the base.vert and base.frag pipeline on a single color attachment render pass, as variant 0
+ */
+inline PipelineState create_base_pipeline_state(ResourceCache &cache)
+{
+	ShaderSource vert_source{"base.vert"};
+	ShaderSource frag_source{"base.frag"};
+
+	ShaderVariant variant;
+	variant.add_definitions({"MAX_LIGHT_COUNT " + std::to_string(MAX_FORWARD_LIGHT_COUNT)});
+
+	auto &vert_module = cache.request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, vert_source, variant);
+	auto &frag_module = cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, frag_source, variant);
+
+	auto &pipeline_layout = cache.request_pipeline_layout({&vert_module, &frag_module});
+
+	SubpassInfo subpass{};
+	subpass.output_attachments               = {0};
+	subpass.disable_depth_stencil_attachment = true;
+
+	auto &render_pass = cache.request_render_pass({Attachment{VK_FORMAT_R8G8B8A8_UNORM, VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT}},
+	                                              {LoadStoreInfo{}},
+	                                              {subpass});
+
+	VertexInputState vertex_input_state;
+	vertex_input_state.bindings   = {{0, sizeof(float) * 3, VK_VERTEX_INPUT_RATE_VERTEX},
+	                                 {1, sizeof(float) * 2, VK_VERTEX_INPUT_RATE_VERTEX},
+	                                 {2, sizeof(float) * 3, VK_VERTEX_INPUT_RATE_VERTEX}};
+	vertex_input_state.attributes = {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0},
+	                                 {1, 1, VK_FORMAT_R32G32_SFLOAT, 0},
+	                                 {2, 2, VK_FORMAT_R32G32B32_SFLOAT, 0}};
+
+	ColorBlendState color_blend_state;
+	color_blend_state.attachments.resize(1);
+
+	// The render pass has no depth attachment
+	DepthStencilState depth_stencil_state;
+	depth_stencil_state.depth_test_enable  = VK_FALSE;
+	depth_stencil_state.depth_write_enable = VK_FALSE;
+
+	PipelineState pipeline_state;
+	pipeline_state.set_pipeline_layout(pipeline_layout);
+	pipeline_state.set_render_pass(render_pass);
+	pipeline_state.set_vertex_input_state(vertex_input_state);
+	pipeline_state.set_color_blend_state(color_blend_state);
+	pipeline_state.set_depth_stencil_state(depth_stencil_state);
+	set_pipeline_variant(pipeline_state, 0);
+
+	return pipeline_state;
+}
+}        // namespace vkb
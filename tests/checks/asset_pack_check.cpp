@@ -0,0 +1,313 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "filesystem/filesystem.hpp"
+
+// Private headers of the filesystem component
+#include "lz4_block.hpp"
+#include "pack_filesystem.hpp"
+
+/*
+ * Checks the LZ4 block codec, and that an asset pack serves the files it was created from and rejects a damaged pack
+ */
+namespace
+{
+using vkb::filesystem::Path;
+
+std::vector<uint8_t> create_random_data(size_t size, uint32_t seed)
+{
+	std::mt19937         random{seed};
+	std::vector<uint8_t> data(size);
+	std::ranges::generate(data, [&random]() { return static_cast<uint8_t>(random()); });
+	return data;
+}
+
+/// Text-like data, with matches of various lengths and offsets between runs of literals
+std::vector<uint8_t> create_repetitive_data(size_t size)
+{
+	std::mt19937         random{1};
+	std::vector<uint8_t> data;
+
+	while (data.size() < size)
+	{
+		if (data.size() > 16 && random() % 4 != 0)
+		{
+			size_t length = 4 + random() % 300;
+			size_t offset = 1 + random() % std::min<size_t>(data.size(), 60000);
+			for (size_t i = 0; i < length; ++i)
+			{
+				data.push_back(data[data.size() - offset]);
+			}
+		}
+		else
+		{
+			for (size_t i = random() % 40; i > 0; --i)
+			{
+				data.push_back(static_cast<uint8_t>('a' + random() % 26));
+			}
+		}
+	}
+
+	data.resize(size);
+	return data;
+}
+
+bool round_trips(const std::vector<uint8_t> &data)
+{
+	auto                 block = vkb::filesystem::lz4_compress(data);
+	std::vector<uint8_t> decompressed(data.size());
+
+	return vkb::filesystem::lz4_decompress(block, decompressed) && decompressed == data;
+}
+
+void lz4_round_trip()
+{
+	EXPECT(round_trips({}));
+
+	for (size_t size = 1; size < 40; ++size)
+	{
+		EXPECT(round_trips(create_random_data(size, static_cast<uint32_t>(size))));
+		EXPECT(round_trips(std::vector<uint8_t>(size, 7)));
+	}
+
+	EXPECT(round_trips(create_random_data(100000, 2)));
+	EXPECT(round_trips(std::vector<uint8_t>(100000, 0)));
+	EXPECT(round_trips(create_repetitive_data(300000)));
+
+	// Repetitive data shrinks, random data grows by the block overhead only
+	EXPECT(vkb::filesystem::lz4_compress(create_repetitive_data(300000)).size() < 300000 / 2);
+	EXPECT(vkb::filesystem::lz4_compress(create_random_data(100000, 2)).size() < 100000 + 100000 / 200 + 16);
+}
+
+void lz4_rejects_malformed_blocks()
+{
+	// One literal, a match of 8 bytes at offset 1, then the last literal
+	std::vector<uint8_t> block{0x14, 'a', 0x01, 0x00, 0x10, 'b'};
+
+	std::vector<uint8_t> data(10);
+	EXPECT(vkb::filesystem::lz4_decompress(block, data));
+	EXPECT(data == std::vector<uint8_t>({'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'b'}));
+
+	// The block has to decompress to exactly the given size
+	std::vector<uint8_t> smaller(9);
+	std::vector<uint8_t> larger(11);
+	EXPECT(!vkb::filesystem::lz4_decompress(block, smaller));
+	EXPECT(!vkb::filesystem::lz4_decompress(block, larger));
+
+	// A match before the start of the data, or at offset 0
+	auto bad_offset = block;
+	bad_offset[2]   = 0x02;
+	EXPECT(!vkb::filesystem::lz4_decompress(bad_offset, data));
+	bad_offset[2] = 0x00;
+	EXPECT(!vkb::filesystem::lz4_decompress(bad_offset, data));
+
+	// Truncated in the offset, and a literal length missing its extension bytes
+	EXPECT(!vkb::filesystem::lz4_decompress(std::vector<uint8_t>(block.begin(), block.begin() + 3), data));
+	EXPECT(!vkb::filesystem::lz4_decompress(std::vector<uint8_t>{0xf0}, data));
+
+	// A truncated compressed block loses the end of the data
+	auto original   = create_repetitive_data(10000);
+	auto compressed = vkb::filesystem::lz4_compress(original);
+
+	std::vector<uint8_t> decompressed(original.size());
+	EXPECT(!vkb::filesystem::lz4_decompress(std::span(compressed).first(compressed.size() - 1), decompressed));
+	EXPECT(!vkb::filesystem::lz4_decompress(std::span(compressed).first(compressed.size() / 2), decompressed));
+}
+
+Path get_scratch_directory()
+{
+	return vkb::filesystem::get()->temp_directory() / "asset_pack_check";
+}
+
+Path get_root()
+{
+	return get_scratch_directory() / "data";
+}
+
+/// The files packed from the root, in the order of the pack: the first entry is incompressible so that it is stored in either pack
+std::vector<std::pair<std::string, std::vector<uint8_t>>> get_files()
+{
+	return {{"assets/random.bin", create_random_data(10000, 3)},
+	        {"assets/scenes/empty.gltf", {}},
+	        {"assets/text.txt", create_repetitive_data(50000)},
+	        {"shaders/shader.glsl", create_repetitive_data(3000)}};
+}
+
+/// Writes the files to the root, and a pack of them
+Path create_pack(bool compress)
+{
+	auto fs = vkb::filesystem::get();
+
+	for (auto &[path, data] : get_files())
+	{
+		fs->write_file(get_root() / path, data);
+	}
+
+	// A file outside of the packed directories
+	fs->write_file(get_root() / "loose.txt", std::string{"loose"});
+
+	auto pack_path = get_scratch_directory() / (compress ? "compressed.pack" : "stored.pack");
+	EXPECT(vkb::filesystem::create_asset_pack(get_root(), {"assets", "shaders"}, pack_path, compress) == get_files().size());
+
+	return pack_path;
+}
+
+std::shared_ptr<vkb::filesystem::PackFileSystem> mount(const Path &pack_path)
+{
+	auto base = vkb::filesystem::get();
+
+	// The pack holds paths relative to the data directory, which is the external storage directory
+	base->set_external_storage_directory(get_root().string());
+
+	return std::make_shared<vkb::filesystem::PackFileSystem>(base, pack_path);
+}
+
+template <class Function>
+bool throws(Function &&function)
+{
+	try
+	{
+		function();
+	}
+	catch (const std::exception &)
+	{
+		return true;
+	}
+	return false;
+}
+
+void pack_contents()
+{
+	auto stored_path     = create_pack(false);
+	auto compressed_path = create_pack(true);
+
+	EXPECT(vkb::filesystem::get()->stat_file(compressed_path).size < vkb::filesystem::get()->stat_file(stored_path).size);
+
+	for (auto &pack_path : {stored_path, compressed_path})
+	{
+		auto pack_fs = mount(pack_path);
+
+		for (auto &[relative_path, data] : get_files())
+		{
+			auto path = get_root() / relative_path;
+
+			EXPECT(pack_fs->is_file(path));
+			EXPECT(pack_fs->stat_file(path).size == data.size());
+			EXPECT(pack_fs->read_file_binary(path) == data);
+			EXPECT(std::ranges::equal(pack_fs->map_file(path)->get_data(), data));
+
+			// Chunks of a compressed entry are served from its decompressed content
+			for (size_t offset = 0; offset + 1000 <= data.size(); offset += 1000)
+			{
+				EXPECT(pack_fs->read_chunk(path, offset, 1000) == std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + 1000));
+			}
+
+			EXPECT(pack_fs->read_chunk(path, data.size(), 1).empty());
+		}
+
+		EXPECT(pack_fs->is_directory(get_root() / "assets/scenes"));
+		EXPECT(!pack_fs->is_file(get_root() / "assets/missing.bin"));
+
+		// Paths which are not packed are served by the base file system
+		EXPECT(pack_fs->read_file_string(get_root() / "loose.txt") == "loose");
+	}
+}
+
+void flipped_index_byte()
+{
+	auto fs   = vkb::filesystem::get();
+	auto data = fs->read_file_binary(create_pack(true));
+
+	EXPECT(!throws([&]() { mount(get_scratch_directory() / "compressed.pack"); }));
+
+	// The last byte of the index, within the hash of the last entry
+	auto corrupted = data;
+	corrupted.back() ^= 1;
+	fs->write_file(get_scratch_directory() / "corrupted.pack", corrupted);
+	EXPECT(throws([&]() { mount(get_scratch_directory() / "corrupted.pack"); }));
+
+	// The header
+	corrupted = data;
+	corrupted[0] ^= 1;
+	fs->write_file(get_scratch_directory() / "corrupted.pack", corrupted);
+	EXPECT(throws([&]() { mount(get_scratch_directory() / "corrupted.pack"); }));
+
+	corrupted.assign(data.begin(), data.begin() + 20);
+	fs->write_file(get_scratch_directory() / "corrupted.pack", corrupted);
+	EXPECT(throws([&]() { mount(get_scratch_directory() / "corrupted.pack"); }));
+}
+
+void flipped_data_byte()
+{
+	auto fs    = vkb::filesystem::get();
+	auto files = get_files();
+
+	for (bool compress : {false, true})
+	{
+		auto data = fs->read_file_binary(create_pack(compress));
+
+		// The first entry follows the 48-byte header, the empty file takes no space and the text starts at the next multiple of 16 bytes
+		size_t first_offset = 48;
+		size_t text_offset  = (first_offset + files[0].second.size() + 15) / 16 * 16;
+
+		data[first_offset + 100] ^= 1;
+		data[text_offset + 5] ^= 1;
+		fs->write_file(get_scratch_directory() / "corrupted.pack", data);
+
+		// The index is intact, the entries are checked when they are first read
+		auto pack_fs = mount(get_scratch_directory() / "corrupted.pack");
+
+		auto random_path = get_root() / files[0].first;
+		auto text_path   = get_root() / files[2].first;
+		auto shader_path = get_root() / files[3].first;
+
+		EXPECT(throws([&]() { pack_fs->read_file_binary(random_path); }));
+		EXPECT(throws([&]() { pack_fs->map_file(random_path); }));
+		EXPECT(throws([&]() { pack_fs->read_chunk(text_path, 10, 10); }));
+		EXPECT(throws([&]() { pack_fs->map_file(text_path); }));
+
+		// The other entries are still served
+		EXPECT(pack_fs->read_file_binary(shader_path) == files[3].second);
+	}
+}
+}        // namespace
+
+int main()
+{
+	vkb::filesystem::init();
+
+	vkb::checks::Case cases[] = {
+	    {"lz4_round_trip", lz4_round_trip},
+	    {"lz4_rejects_malformed_blocks", lz4_rejects_malformed_blocks},
+	    {"pack_contents", pack_contents},
+	    {"flipped_index_byte", flipped_index_byte},
+	    {"flipped_data_byte", flipped_data_byte},
+	};
+
+	int result = vkb::checks::run_cases(cases);
+
+	vkb::filesystem::get()->remove(get_scratch_directory());
+
+	return result;
+}
@@ -0,0 +1,185 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "common/cache_counters.h"
+#include "common/strings.h"
+#include "stats/resource_cache_stats_provider.h"
+
+/*
+ * Checks the creation time histogram of CacheCounters and the JSON report of ResourceCacheStatsProvider
+ */
+namespace
+{
+/// Whether braces and brackets are balanced outside of strings, and no value is followed by a dangling comma
+bool is_well_formed(const std::string &json)
+{
+	std::vector<char> scopes;
+	bool              in_string    = false;
+	char              last_visible = 0;
+
+	for (size_t i = 0; i < json.size(); ++i)
+	{
+		char c = json[i];
+
+		if (in_string)
+		{
+			in_string = c != '"' || json[i - 1] == '\\';
+			continue;
+		}
+
+		if (c == ' ' || c == '\t' || c == '\n')
+		{
+			continue;
+		}
+
+		if (c == '"')
+		{
+			in_string = true;
+		}
+		else if (c == '{' || c == '[')
+		{
+			scopes.push_back(c == '{' ? '}' : ']');
+		}
+		else if (c == '}' || c == ']')
+		{
+			if (scopes.empty() || scopes.back() != c || last_visible == ',')
+			{
+				return false;
+			}
+			scopes.pop_back();
+		}
+
+		last_visible = c;
+	}
+
+	return !in_string && scopes.empty() && last_visible == '}';
+}
+
+std::string get_histogram_json(const vkb::CacheStats &stats)
+{
+	std::string json = "[";
+	for (size_t i = 0; i < vkb::CREATION_TIME_BUCKET_COUNT; ++i)
+	{
+		json += (i > 0 ? ", " : "") + std::to_string(stats.creation_time_histogram[i]);
+	}
+	return json + "]";
+}
+
+void histogram_buckets()
+{
+	vkb::CacheCounters counters;
+
+	// Times are in milliseconds, bucket i counts creations faster than 2^i microseconds
+	counters.created(0.0005);
+	counters.created(0.0015);
+	counters.created(0.0035);
+	counters.created(0.0035);
+	counters.created(1.0);
+	counters.created(1000000.0);
+
+	auto stats = counters.get_stats();
+
+	EXPECT(stats.creations == 6);
+	EXPECT(stats.creation_time_histogram[0] == 1);
+	EXPECT(stats.creation_time_histogram[1] == 1);
+	EXPECT(stats.creation_time_histogram[2] == 2);
+	EXPECT(stats.creation_time_histogram[10] == 1);
+	EXPECT(stats.creation_time_histogram[vkb::CREATION_TIME_BUCKET_COUNT - 1] == 1);
+
+	uint64_t bucket_total = 0;
+	for (auto count : stats.creation_time_histogram)
+	{
+		bucket_total += count;
+	}
+	EXPECT(bucket_total == stats.creations);
+
+	EXPECT(stats.creation_time > 1000000.0 && stats.creation_time < 1000001.01);
+}
+
+void sums()
+{
+	vkb::CacheCounters counters;
+	counters.hit();
+	counters.hit();
+	counters.miss();
+	counters.created(0.0015);
+
+	vkb::CacheStats total = counters.get_stats();
+	total += counters.get_stats();
+
+	EXPECT(total.hits == 4);
+	EXPECT(total.misses == 2);
+	EXPECT(total.creations == 2);
+	EXPECT(total.creation_time_histogram[1] == 2);
+}
+
+void json_report()
+{
+	std::array<vkb::ResourceCacheStats, vkb::RESOURCE_TYPE_COUNT> resource_stats;
+
+	vkb::CacheCounters pipeline_counters;
+	pipeline_counters.hit();
+	pipeline_counters.hit();
+	pipeline_counters.hit();
+	pipeline_counters.miss();
+	pipeline_counters.created(0.25);
+
+	auto &pipeline_stats     = resource_stats[static_cast<size_t>(vkb::ResourceType::GraphicsPipeline)];
+	pipeline_stats.counters  = pipeline_counters.get_stats();
+	pipeline_stats.evictions = 7;
+	pipeline_stats.size      = 16;
+	pipeline_stats.budget    = 16;
+
+	vkb::CacheCounters descriptor_set_counters;
+	descriptor_set_counters.miss();
+	descriptor_set_counters.created(1.0);
+
+	auto report = vkb::ResourceCacheStatsProvider::get_report(resource_stats, {}, descriptor_set_counters.get_stats());
+
+	EXPECT(is_well_formed(report));
+
+	// Every type of the cache is reported, along with the frame caches
+	for (size_t i = 0; i < vkb::RESOURCE_TYPE_COUNT; ++i)
+	{
+		EXPECT(report.find("\"" + vkb::to_string(static_cast<vkb::ResourceType>(i)) + "\": {\"hits\"") != std::string::npos);
+	}
+	EXPECT(report.find("\"DescriptorPool\": {\"hits\": 0") != std::string::npos);
+
+	EXPECT(report.find("\"GraphicsPipeline\": {\"hits\": 3, \"misses\": 1, \"creations\": 1, \"creation_time_ms\": 0.250, \"creation_time_histogram\": " +
+	                   get_histogram_json(pipeline_stats.counters) + ", \"evictions\": 7, \"size\": 16, \"budget\": 16}") != std::string::npos);
+	EXPECT(report.find("\"DescriptorSet\": {\"hits\": 0, \"misses\": 1, \"creations\": 1, \"creation_time_ms\": 1.000, \"creation_time_histogram\": " +
+	                   get_histogram_json(descriptor_set_counters.get_stats()) + "}") != std::string::npos);
+
+	// The last bucket has no upper bound
+	EXPECT(report.find("\"creation_time_histogram_upper_bounds_us\": [1, 2, 4, ") != std::string::npos);
+	EXPECT(report.find(", 262144]") != std::string::npos);
+}
+}        // namespace
+
+int main()
+{
+	vkb::checks::Case cases[] = {{"histogram_buckets", histogram_buckets},
+	                             {"sums", sums},
+	                             {"json_report", json_report}};
+
+	return vkb::checks::run_cases(cases);
+}
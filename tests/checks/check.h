@@ -0,0 +1,81 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+/*
+ * Device-free checks are executables run by ctest, they report every failed expectation and exit with a
+ * non-zero code if any failed. A check lists its cases and runs them with run_cases.
+ */
+namespace vkb
+{
+namespace checks
+{
+inline int failure_count = 0;
+
+inline void expect(bool condition, const char *expression, const char *file, int line)
+{
+	if (!condition)
+	{
+		std::cerr << file << ":" << line << ": expected " << expression << std::endl;
+		++failure_count;
+	}
+}
+
+struct Case
+{
+	const char *name;
+
+	void (*run)();
+};
+
+/**
+ * @brief Runs the cases of a check, an exception fails the case that threw it
+ * @return The exit code of the check
+ */
+template <size_t N>
+int run_cases(const Case (&cases)[N])
+{
+	for (auto &check_case : cases)
+	{
+		int previous_failure_count = failure_count;
+
+		try
+		{
+			check_case.run();
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << check_case.name << " threw: " << e.what() << std::endl;
+			++failure_count;
+		}
+
+		std::cout << (failure_count == previous_failure_count ? "passed: " : "FAILED: ") << check_case.name << std::endl;
+	}
+
+	return failure_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}        // namespace checks
+}        // namespace vkb
+
+#define EXPECT(condition) vkb::checks::expect(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
@@ -0,0 +1,141 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "filesystem/filesystem.hpp"
+
+/*
+ * Checks that a mapped file holds the content of the file, for mapped and copied files, and that a mapping outlives the file
+ */
+namespace
+{
+vkb::filesystem::Path get_scratch_directory()
+{
+	return vkb::filesystem::get()->temp_directory() / "map_file_check";
+}
+
+std::vector<uint8_t> create_random_data(size_t size, uint32_t seed)
+{
+	std::mt19937         random{seed};
+	std::vector<uint8_t> data(size);
+	std::ranges::generate(data, [&random]() { return static_cast<uint8_t>(random()); });
+	return data;
+}
+
+void mapped_content()
+{
+	auto fs = vkb::filesystem::get();
+
+	// Sizes around a page and a file of several pages
+	for (size_t size : {1, 4095, 4096, 4097, 1 << 20})
+	{
+		auto path = get_scratch_directory() / "content.bin";
+		auto data = create_random_data(size, static_cast<uint32_t>(size));
+		fs->write_file(path, data);
+
+		auto file = fs->map_file(path);
+		EXPECT(file);
+		EXPECT(std::ranges::equal(file->get_data(), data));
+	}
+}
+
+void copied_content()
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_scratch_directory() / "copied.bin";
+	auto data = create_random_data(10000, 7);
+	fs->write_file(path, data);
+
+	// The default implementation, used by file systems which can't map files, reads the file to memory
+	auto file = fs->vkb::filesystem::FileSystem::map_file(path);
+	EXPECT(std::ranges::equal(file->get_data(), data));
+}
+
+void empty_file()
+{
+	auto fs   = vkb::filesystem::get();
+	auto path = get_scratch_directory() / "empty.bin";
+	fs->write_file(path, std::vector<uint8_t>{});
+
+	// An empty file can't be mapped, it falls back to an empty copy
+	auto file = fs->map_file(path);
+	EXPECT(file);
+	EXPECT(file->get_data().empty());
+}
+
+void missing_file()
+{
+	auto fs = vkb::filesystem::get();
+
+	bool threw = false;
+	try
+	{
+		fs->map_file(get_scratch_directory() / "missing.bin");
+	}
+	catch (const std::exception &)
+	{
+		threw = true;
+	}
+	EXPECT(threw);
+}
+
+void outlives_file()
+{
+#if !defined(_WIN32)
+	// Windows doesn't let a mapped file be replaced or removed
+	auto fs   = vkb::filesystem::get();
+	auto path = get_scratch_directory() / "replaced.bin";
+	auto data = create_random_data(100000, 11);
+	fs->write_file(path, data);
+
+	auto file = fs->map_file(path);
+
+	// A file replaced by write_file_atomic is a new file, the mapping keeps the content of the old one
+	fs->write_file_atomic(path, create_random_data(100000, 12));
+	EXPECT(std::ranges::equal(file->get_data(), data));
+	EXPECT(!std::ranges::equal(fs->map_file(path)->get_data(), data));
+
+	fs->remove(path);
+	EXPECT(!fs->exists(path));
+	EXPECT(std::ranges::equal(file->get_data(), data));
+#endif
+}
+}        // namespace
+
+int main()
+{
+	vkb::filesystem::init();
+
+	vkb::checks::Case cases[] = {
+	    {"mapped_content", mapped_content},
+	    {"copied_content", copied_content},
+	    {"empty_file", empty_file},
+	    {"missing_file", missing_file},
+	    {"outlives_file", outlives_file},
+	};
+
+	int result = vkb::checks::run_cases(cases);
+
+	vkb::filesystem::get()->remove(get_scratch_directory());
+
+	return result;
+}
@@ -0,0 +1,255 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "check.h"
+#include "filesystem/filesystem.hpp"
+#include "geometry/mesh_optimizer.h"
+
+/*
+ * Checks the vertex cache simulation of the mesh optimizer, and the ACMR and ATVR of a shuffled grid after each reordering
+ */
+namespace
+{
+using Triangles = std::vector<std::array<uint32_t, 3>>;
+
+struct Grid
+{
+	std::vector<uint32_t> indices;
+
+	std::vector<glm::vec3> positions;
+};
+
+/// A bumpy grid of size by size quads, its triangles in a random order
+Grid create_shuffled_grid(uint32_t size)
+{
+	Grid grid;
+
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			grid.positions.push_back({static_cast<float>(x), static_cast<float>(y), std::sin(x * 0.7f) * std::cos(y * 0.4f)});
+		}
+	}
+
+	Triangles triangles;
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			uint32_t corner = y * (size + 1) + x;
+			triangles.push_back({corner, corner + 1, corner + size + 1});
+			triangles.push_back({corner + 1, corner + size + 2, corner + size + 1});
+		}
+	}
+
+	std::mt19937 random{42};
+	std::shuffle(triangles.begin(), triangles.end(), random);
+
+	for (auto &triangle : triangles)
+	{
+		grid.indices.insert(grid.indices.end(), triangle.begin(), triangle.end());
+	}
+
+	return grid;
+}
+
+/// The triangles of a list, each rotated to start with its lowest index so that the winding is kept, in sorted order
+Triangles get_sorted_triangles(const std::vector<uint32_t> &indices)
+{
+	Triangles triangles;
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		std::array<uint32_t, 3> triangle{indices[i], indices[i + 1], indices[i + 2]};
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+
+	return triangles;
+}
+
+void analyze_counts()
+{
+	std::vector<uint32_t> indices{0, 1, 2, 3, 4, 5, 0, 1, 2};
+
+	auto stats = vkb::analyze_vertex_cache(indices, 6, 16);
+	EXPECT(stats.triangle_count == 3);
+	EXPECT(stats.referenced_vertex_count == 6);
+	EXPECT(stats.transformed_vertex_count == 6);
+	EXPECT(stats.get_acmr() == 2.0f);
+	EXPECT(stats.get_atvr() == 1.0f);
+
+	// A cache of 3 entries has evicted the first triangle once the second one is transformed
+	stats = vkb::analyze_vertex_cache(indices, 6, 3);
+	EXPECT(stats.transformed_vertex_count == 9);
+	EXPECT(stats.get_acmr() == 3.0f);
+	EXPECT(stats.get_atvr() == 1.5f);
+
+	// A vertex still in the cache is not transformed again
+	stats = vkb::analyze_vertex_cache({0, 1, 2, 2, 1, 3}, 4, 3);
+	EXPECT(stats.transformed_vertex_count == 4);
+}
+
+void vertex_cache_order()
+{
+	auto grid   = create_shuffled_grid(32);
+	auto before = vkb::analyze_vertex_cache(grid.indices, grid.positions.size());
+
+	auto indices = grid.indices;
+	vkb::optimize_vertex_cache(indices, grid.positions.size());
+
+	auto after = vkb::analyze_vertex_cache(indices, grid.positions.size());
+
+	std::cout << "shuffled grid ACMR " << before.get_acmr() << " ATVR " << before.get_atvr()
+	          << ", vertex cache order ACMR " << after.get_acmr() << " ATVR " << after.get_atvr() << std::endl;
+
+	EXPECT(get_sorted_triangles(indices) == get_sorted_triangles(grid.indices));
+
+	// A regular grid is transformed about 1.3 times per vertex with a cache of 16 entries
+	EXPECT(before.get_acmr() > 1.5f);
+	EXPECT(after.get_acmr() < 0.8f);
+	EXPECT(after.get_atvr() < 1.5f);
+}
+
+void overdraw_order()
+{
+	auto grid = create_shuffled_grid(32);
+
+	auto indices = grid.indices;
+	vkb::optimize_vertex_cache(indices, grid.positions.size());
+	auto vertex_cache_stats = vkb::analyze_vertex_cache(indices, grid.positions.size());
+
+	vkb::optimize_overdraw(indices, grid.positions);
+	auto overdraw_stats = vkb::analyze_vertex_cache(indices, grid.positions.size());
+
+	std::cout << "overdraw order ACMR " << overdraw_stats.get_acmr() << " ATVR " << overdraw_stats.get_atvr() << std::endl;
+
+	EXPECT(get_sorted_triangles(indices) == get_sorted_triangles(grid.indices));
+
+	// Clusters are split where the cache misses, so reordering them keeps most of the efficiency
+	EXPECT(overdraw_stats.get_acmr() <= vertex_cache_stats.get_acmr() * 1.1f);
+}
+
+void vertex_fetch_order()
+{
+	auto grid = create_shuffled_grid(16);
+
+	// An unreferenced vertex is moved after the referenced ones
+	grid.positions.push_back({-1.0f, -1.0f, -1.0f});
+	size_t vertex_count = grid.positions.size();
+
+	auto indices = grid.indices;
+	auto remap   = vkb::optimize_vertex_fetch(indices, vertex_count);
+
+	EXPECT(remap.size() == vertex_count);
+	EXPECT(remap.back() == vertex_count - 1);
+
+	auto sorted_remap = remap;
+	std::sort(sorted_remap.begin(), sorted_remap.end());
+	std::vector<uint32_t> identity(vertex_count);
+	std::iota(identity.begin(), identity.end(), 0);
+	EXPECT(sorted_remap == identity);
+
+	// Vertices are numbered in the order they are first referenced
+	uint32_t next_vertex = 0;
+	bool     in_order    = true;
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		EXPECT(indices[i] == remap[grid.indices[i]]);
+		in_order = in_order && indices[i] <= next_vertex;
+		next_vertex = std::max(next_vertex, indices[i] + 1);
+	}
+	EXPECT(in_order);
+
+	// Renumbering leaves the cache behavior unchanged
+	EXPECT(vkb::analyze_vertex_cache(indices, vertex_count).transformed_vertex_count ==
+	       vkb::analyze_vertex_cache(grid.indices, vertex_count).transformed_vertex_count);
+
+	std::vector<uint8_t> data(vertex_count * sizeof(glm::vec3));
+	std::memcpy(data.data(), grid.positions.data(), data.size());
+
+	auto remapped = vkb::remap_vertex_data(data, sizeof(glm::vec3), remap);
+	EXPECT(remapped.size() == data.size());
+
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		EXPECT(std::memcmp(remapped.data() + remap[vertex] * sizeof(glm::vec3), data.data() + vertex * sizeof(glm::vec3), sizeof(glm::vec3)) == 0);
+	}
+}
+
+void optimized_mesh()
+{
+	auto grid = create_shuffled_grid(24);
+
+	auto                  indices = grid.indices;
+	std::vector<uint32_t> remap;
+	EXPECT(vkb::optimize_mesh(indices, grid.positions, remap));
+
+	// Mapping the original triangles through the remap table gives back the optimized ones
+	auto original = grid.indices;
+	for (auto &index : original)
+	{
+		index = remap[index];
+	}
+	EXPECT(get_sorted_triangles(indices) == get_sorted_triangles(original));
+
+	auto before = vkb::analyze_vertex_cache(grid.indices, grid.positions.size());
+	auto after  = vkb::analyze_vertex_cache(indices, grid.positions.size());
+	EXPECT(after.get_acmr() < before.get_acmr() * 0.6f);
+	EXPECT(after.get_atvr() < before.get_atvr() * 0.6f);
+
+	// The second optimization of the same mesh is read from the mesh cache
+	auto                  cached_indices = grid.indices;
+	std::vector<uint32_t> cached_remap;
+	EXPECT(vkb::optimize_mesh(cached_indices, grid.positions, cached_remap));
+	EXPECT(cached_indices == indices);
+	EXPECT(cached_remap == remap);
+
+	// Out of range indices leave the list untouched
+	auto invalid = grid.indices;
+	invalid[4]   = static_cast<uint32_t>(grid.positions.size());
+	auto copy    = invalid;
+	EXPECT(!vkb::optimize_mesh(invalid, grid.positions, remap));
+	EXPECT(invalid == copy);
+}
+}        // namespace
+
+int main()
+{
+	// optimize_mesh persists its results in the temporary directory
+	vkb::filesystem::init();
+
+	vkb::checks::Case cases[] = {{"analyze_counts", analyze_counts},
+	                             {"vertex_cache_order", vertex_cache_order},
+	                             {"overdraw_order", overdraw_order},
+	                             {"vertex_fetch_order", vertex_fetch_order},
+	                             {"optimized_mesh", optimized_mesh}};
+
+	return vkb::checks::run_cases(cases);
+}
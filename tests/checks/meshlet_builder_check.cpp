@@ -0,0 +1,213 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cmath>
+#include <vector>
+
+#include "check.h"
+#include "geometry/meshlet_builder.h"
+
+/*
+ * Checks that build_meshlets respects its limits, keeps every triangle in order, and bounds the meshlets
+ */
+namespace
+{
+struct Grid
+{
+	std::vector<uint32_t> indices;
+
+	std::vector<glm::vec3> positions;
+};
+
+/// A grid of size by size quads, flat in the z = 0 plane and facing +z unless bumpy
+Grid create_grid(uint32_t size, bool bumpy)
+{
+	Grid grid;
+
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			float z = bumpy ? std::sin(x * 0.9f) * std::cos(y * 0.6f) * 4.0f : 0.0f;
+			grid.positions.push_back({static_cast<float>(x), static_cast<float>(y), z});
+		}
+	}
+
+	for (uint32_t y = 0; y < size; ++y)
+	{
+		for (uint32_t x = 0; x < size; ++x)
+		{
+			uint32_t corner = y * (size + 1) + x;
+			grid.indices.insert(grid.indices.end(), {corner, corner + 1, corner + size + 1, corner + 1, corner + size + 2, corner + size + 1});
+		}
+	}
+
+	return grid;
+}
+
+/// Checks the layout of the meshlets against the limits, and rebuilds the triangle list from them
+std::vector<uint32_t> rebuild_indices(const vkb::MeshletData &data, const vkb::MeshletLimits &limits)
+{
+	std::vector<uint32_t> indices;
+
+	EXPECT(data.bounds.size() == data.meshlets.size());
+
+	uint32_t next_vertex_offset = 0;
+
+	for (auto &meshlet : data.meshlets)
+	{
+		EXPECT(meshlet.vertex_count >= 1 && meshlet.vertex_count <= limits.max_vertices);
+		EXPECT(meshlet.triangle_count >= 1 && meshlet.triangle_count <= limits.max_triangles);
+		EXPECT(meshlet.triangle_offset % 4 == 0);
+
+		// Meshlets are packed in order
+		EXPECT(meshlet.vertex_offset == next_vertex_offset);
+		next_vertex_offset += meshlet.vertex_count;
+
+		EXPECT(meshlet.vertex_offset + meshlet.vertex_count <= data.vertices.size());
+		EXPECT(meshlet.triangle_offset + meshlet.triangle_count * 3 <= data.triangles.size());
+
+		for (uint32_t i = 0; i < meshlet.triangle_count * 3; ++i)
+		{
+			uint8_t local_index = data.triangles[meshlet.triangle_offset + i];
+			EXPECT(local_index < meshlet.vertex_count);
+
+			indices.push_back(data.vertices[meshlet.vertex_offset + local_index]);
+		}
+	}
+
+	EXPECT(next_vertex_offset == data.vertices.size());
+
+	return indices;
+}
+
+void limits_and_order()
+{
+	auto grid = create_grid(20, true);
+
+	for (auto limits : {vkb::MeshletLimits{}, vkb::MeshletLimits{16, 8}, vkb::MeshletLimits{64, 16}, vkb::MeshletLimits{3, 1}, vkb::MeshletLimits{256, 256}})
+	{
+		auto data = vkb::build_meshlets(grid.indices, grid.positions, limits);
+
+		EXPECT(rebuild_indices(data, limits) == grid.indices);
+
+		// Each meshlet stops at the first triangle which exceeds a limit, so only the last one can be much smaller
+		for (size_t i = 0; i + 1 < data.meshlets.size(); ++i)
+		{
+			EXPECT(data.meshlets[i].triangle_count == limits.max_triangles || data.meshlets[i].vertex_count + 3 > limits.max_vertices);
+		}
+	}
+
+	// A meshlet of a single triangle is always full
+	vkb::MeshletLimits single{3, 1};
+	auto               data = vkb::build_meshlets(grid.indices, grid.positions, single);
+	EXPECT(data.meshlets.size() == grid.indices.size() / 3);
+	EXPECT(data.get_fill_rate(single).x == 1.0f);
+	EXPECT(data.get_fill_rate(single).y == 1.0f);
+}
+
+void degenerate_triangles()
+{
+	std::vector<glm::vec3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+	std::vector<uint32_t>  indices{0, 0, 1, 0, 1, 2, 2, 2, 2};
+
+	vkb::MeshletLimits limits{3, 4};
+
+	auto data = vkb::build_meshlets(indices, positions, limits);
+
+	// Repeated corners are only counted once against the vertex limit
+	EXPECT(data.meshlets.size() == 1);
+	EXPECT(data.meshlets[0].vertex_count == 3);
+	EXPECT(rebuild_indices(data, limits) == indices);
+}
+
+void culling_bounds()
+{
+	auto grid = create_grid(8, false);
+
+	vkb::MeshletLimits limits{64, 32};
+
+	auto data = vkb::build_meshlets(grid.indices, grid.positions, limits);
+
+	for (size_t i = 0; i < data.meshlets.size(); ++i)
+	{
+		auto &meshlet = data.meshlets[i];
+		auto &bounds  = data.bounds[i];
+
+		for (uint32_t j = 0; j < meshlet.vertex_count; ++j)
+		{
+			EXPECT(glm::distance(bounds.center, grid.positions[data.vertices[meshlet.vertex_offset + j]]) <= bounds.radius + 1e-4f);
+		}
+
+		// Every triangle of the flat grid faces +z
+		EXPECT(std::abs(bounds.cone_axis.z - 1.0f) < 1e-4f);
+		EXPECT(bounds.cone_cutoff < 1e-3f);
+
+		// Back-face culled from below the grid, not from above it
+		auto is_culled = [&bounds](const glm::vec3 &camera) {
+			return glm::dot(bounds.center - camera, bounds.cone_axis) >= bounds.cone_cutoff * glm::length(bounds.center - camera) + bounds.radius;
+		};
+		EXPECT(is_culled(bounds.center - glm::vec3{0.0f, 0.0f, 20.0f}));
+		EXPECT(!is_culled(bounds.center + glm::vec3{0.0f, 0.0f, 20.0f}));
+	}
+
+	// The triangles of a bumpy grid face in several directions, and a closed shape can't be culled
+	auto bumpy      = create_grid(8, true);
+	auto bumpy_data = vkb::build_meshlets(bumpy.indices, bumpy.positions, limits);
+	for (auto &bounds : bumpy_data.bounds)
+	{
+		EXPECT(bounds.cone_cutoff > 0.0f && bounds.cone_cutoff <= 1.0f);
+	}
+
+	std::vector<glm::vec3> tetrahedron{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+	auto                   closed = vkb::build_meshlets({0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3}, tetrahedron, limits);
+	EXPECT(closed.bounds.size() == 1 && closed.bounds[0].cone_cutoff == 1.0f);
+}
+
+void device_limits()
+{
+	VkPhysicalDeviceMeshShaderPropertiesEXT properties{};
+	properties.maxMeshOutputVertices   = 128;
+	properties.maxMeshOutputPrimitives = 256;
+
+	auto limits = vkb::MeshletLimits::from_device(properties);
+	EXPECT(limits.max_vertices == 64 && limits.max_triangles == 124);
+
+	properties.maxMeshOutputVertices   = 32;
+	properties.maxMeshOutputPrimitives = 48;
+
+	limits = vkb::MeshletLimits::from_device(properties);
+	EXPECT(limits.max_vertices == 32 && limits.max_triangles == 48);
+
+	// Meshlet triangles index their vertices with 8 bits
+	properties.maxMeshOutputVertices = 1024;
+
+	limits = vkb::MeshletLimits::from_device(properties, 512, 16);
+	EXPECT(limits.max_vertices == 256 && limits.max_triangles == 16);
+}
+}        // namespace
+
+int main()
+{
+	vkb::checks::Case cases[] = {{"limits_and_order", limits_and_order},
+	                             {"degenerate_triangles", degenerate_triangles},
+	                             {"culling_bounds", culling_bounds},
+	                             {"device_limits", device_limits}};
+
+	return vkb::checks::run_cases(cases);
+}
@@ -0,0 +1,193 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "filesystem/filesystem.hpp"
+
+/*
+ * Checks that a batch of asynchronous reads returns the requested range of each file, and rethrows the errors of its reads
+ */
+namespace
+{
+constexpr size_t FILE_COUNT = 50;
+
+vkb::filesystem::Path get_scratch_directory()
+{
+	return vkb::filesystem::get()->temp_directory() / "read_async_check";
+}
+
+vkb::filesystem::Path get_file_path(size_t index)
+{
+	return get_scratch_directory() / ("file_" + std::to_string(index) + ".bin");
+}
+
+/// The content of a file, of a size varying between files
+std::vector<uint8_t> get_file_data(size_t index)
+{
+	std::mt19937         random{static_cast<uint32_t>(index)};
+	std::vector<uint8_t> data(1000 + index * 997);
+	std::ranges::generate(data, [&random]() { return static_cast<uint8_t>(random()); });
+	return data;
+}
+
+void create_files()
+{
+	for (size_t i = 0; i < FILE_COUNT; ++i)
+	{
+		vkb::filesystem::get()->write_file(get_file_path(i), get_file_data(i));
+	}
+}
+
+/// Expects a read to throw, as the read of a missing file does
+bool throws(std::future<std::vector<uint8_t>> &future)
+{
+	try
+	{
+		future.get();
+	}
+	catch (const std::exception &)
+	{
+		return true;
+	}
+	return false;
+}
+
+void whole_files()
+{
+	std::vector<vkb::filesystem::ReadRequest> requests;
+	for (size_t i = 0; i < FILE_COUNT; ++i)
+	{
+		requests.push_back({get_file_path(i)});
+	}
+
+	auto futures = vkb::filesystem::get()->read_async(requests);
+	EXPECT(futures.size() == FILE_COUNT);
+
+	// Waited for in reverse order, the futures complete in any order
+	for (size_t i = futures.size(); i-- > 0;)
+	{
+		EXPECT(futures[i].get() == get_file_data(i));
+	}
+}
+
+void ranges()
+{
+	std::vector<vkb::filesystem::ReadRequest> requests;
+	for (size_t i = 0; i < FILE_COUNT; ++i)
+	{
+		requests.push_back({get_file_path(i), i * 10, 100});
+		requests.push_back({get_file_path(i), i * 10, vkb::filesystem::ReadRequest::TO_END});
+	}
+
+	auto futures = vkb::filesystem::get()->read_async(requests);
+
+	for (size_t i = 0; i < FILE_COUNT; ++i)
+	{
+		auto data = get_file_data(i);
+		EXPECT(futures[2 * i].get() == std::vector<uint8_t>(data.begin() + i * 10, data.begin() + i * 10 + 100));
+		EXPECT(futures[2 * i + 1].get() == std::vector<uint8_t>(data.begin() + i * 10, data.end()));
+	}
+}
+
+void past_end()
+{
+	auto size = get_file_data(0).size();
+
+	// A range past the end of the file reads nothing, as read_chunk does
+	auto futures = vkb::filesystem::get()->read_async({{get_file_path(0), size - 10, 100},
+	                                                   {get_file_path(0), size + 10, 100},
+	                                                   {get_file_path(0), size, vkb::filesystem::ReadRequest::TO_END},
+	                                                   {get_file_path(0), size + 10, vkb::filesystem::ReadRequest::TO_END}});
+
+	for (auto &future : futures)
+	{
+		EXPECT(future.get().empty());
+	}
+}
+
+void missing_file()
+{
+	// The error of a read is rethrown by its own future, the other reads of the batch complete
+	auto futures = vkb::filesystem::get()->read_async({{get_file_path(0)},
+	                                                   {get_scratch_directory() / "missing.bin"},
+	                                                   {get_scratch_directory() / "missing.bin", 0, 100},
+	                                                   {get_file_path(1)}});
+
+	EXPECT(futures[0].get() == get_file_data(0));
+	EXPECT(throws(futures[1]));
+	EXPECT(throws(futures[2]));
+	EXPECT(futures[3].get() == get_file_data(1));
+}
+
+void concurrent_batches()
+{
+	// Batches queued from several threads share the read threads
+	std::vector<std::future<bool>> batches;
+	for (size_t thread = 0; thread < 4; ++thread)
+	{
+		batches.push_back(std::async(std::launch::async, [thread]() {
+			std::vector<vkb::filesystem::ReadRequest> requests;
+			for (size_t i = thread; i < FILE_COUNT; i += 4)
+			{
+				requests.push_back({get_file_path(i)});
+			}
+
+			auto futures = vkb::filesystem::get()->read_async(requests);
+
+			bool valid = true;
+			for (size_t i = thread, request = 0; i < FILE_COUNT; i += 4, ++request)
+			{
+				valid = valid && futures[request].get() == get_file_data(i);
+			}
+			return valid;
+		}));
+	}
+
+	for (auto &batch : batches)
+	{
+		EXPECT(batch.get());
+	}
+}
+}        // namespace
+
+int main()
+{
+	vkb::filesystem::init();
+
+	create_files();
+
+	vkb::checks::Case cases[] = {
+	    {"whole_files", whole_files},
+	    {"ranges", ranges},
+	    {"past_end", past_end},
+	    {"missing_file", missing_file},
+	    {"concurrent_batches", concurrent_batches},
+	};
+
+	int result = vkb::checks::run_cases(cases);
+
+	vkb::filesystem::get()->remove(get_scratch_directory());
+
+	return result;
+}
@@ -0,0 +1,273 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "check.h"
+#include "core/util/hash.hpp"
+#include "filesystem/filesystem.hpp"
+#include "scene_cache.h"
+
+/*
+ * Checks that a scene cache entry reads back as it was stored, and that a truncated, corrupted or stale entry is a miss
+ */
+namespace
+{
+/// The directory holding the source file of the scene
+vkb::filesystem::Path get_scratch_directory()
+{
+	return vkb::filesystem::get()->temp_directory() / "scene_cache_check";
+}
+
+/// The path SceneCache stores the entry of a key at
+std::string get_entry_path(const vkb::Hash128 &key)
+{
+	auto path = vkb::filesystem::get()->temp_directory() / "scene_cache" / fmt::format("{:016x}{:016x}{:016x}.scene", key.high, key.low, key.check);
+	return path.string();
+}
+
+vkb::Hash128 get_key(const std::string &name)
+{
+	vkb::Hasher hasher;
+	hasher.update(name);
+	return hasher.get_hash();
+}
+
+/// A model of one textured triangle, with the source file it was read from
+void create_scene(tinygltf::Model &model, vkb::SceneCache::Entry &entry)
+{
+	auto fs     = vkb::filesystem::get();
+	auto source = (get_scratch_directory() / "scene.gltf").string();
+
+	fs->write_file(source, std::string{"{}"});
+
+	tinygltf::Image gltf_image;
+	gltf_image.name = "checker";
+	gltf_image.uri  = "checker.ktx";
+	model.images.push_back(gltf_image);
+
+	tinygltf::Primitive gltf_primitive;
+	gltf_primitive.indices  = 0;
+	gltf_primitive.material = 0;
+
+	tinygltf::Mesh gltf_mesh;
+	gltf_mesh.name = "triangle";
+	gltf_mesh.primitives.push_back(gltf_primitive);
+	model.meshes.push_back(gltf_mesh);
+
+	tinygltf::Node gltf_node;
+	gltf_node.name        = "root";
+	gltf_node.mesh        = 0;
+	gltf_node.translation = {1.0, 2.0, 3.0};
+	model.nodes.push_back(gltf_node);
+
+	entry.sources = {source};
+
+	vkb::SceneCache::Image image;
+	image.name    = "checker";
+	image.format  = VK_FORMAT_R8G8B8A8_UNORM;
+	image.mipmaps = {{0, 0, {2, 2, 1}}, {1, 16, {1, 1, 1}}};
+	image.offsets = {{0, 16}};
+	for (uint8_t i = 0; i < 20; ++i)
+	{
+		image.data.push_back(i);
+	}
+	entry.images.push_back(image);
+
+	std::vector<float> positions{0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+
+	vkb::SceneCache::Stream stream;
+	stream.name = "position";
+	stream.data.resize(positions.size() * sizeof(float));
+	std::memcpy(stream.data.data(), positions.data(), stream.data.size());
+	stream.attribute_names = {"position"};
+
+	vkb::SceneCache::Primitive primitive;
+	primitive.streams.push_back(stream);
+	primitive.attributes["position"] = {VK_FORMAT_R32G32B32_SFLOAT, 3 * sizeof(float), 0};
+	primitive.index_data             = {0, 0, 1, 0, 2, 0};
+	primitive.index_type             = VK_INDEX_TYPE_UINT16;
+	primitive.vertex_indices         = 3;
+	primitive.vertices_count         = 3;
+	primitive.meshlets.meshlets      = {{0, 0, 3, 1}};
+	primitive.meshlets.bounds        = {{glm::vec3{0.5f, 0.5f, 0.0f}, 0.75f, glm::vec3{0.0f, 0.0f, 1.0f}, 0.0f}};
+	primitive.meshlets.vertices      = {0, 1, 2};
+	primitive.meshlets.triangles     = {0, 1, 2, 0};
+	entry.primitives.push_back(primitive);
+}
+
+/// Stores the scene under a key and returns the bytes of its entry
+std::vector<uint8_t> store_scene(const vkb::Hash128 &key)
+{
+	tinygltf::Model        model;
+	vkb::SceneCache::Entry entry;
+	create_scene(model, entry);
+
+	vkb::SceneCache::store(key, model, entry);
+
+	return vkb::filesystem::get()->read_file_binary(get_entry_path(key));
+}
+
+bool load_scene(const vkb::Hash128 &key)
+{
+	tinygltf::Model        model;
+	vkb::SceneCache::Entry entry;
+	return vkb::SceneCache::load(key, model, entry);
+}
+
+void round_trip()
+{
+	tinygltf::Model        stored_model;
+	vkb::SceneCache::Entry stored;
+	create_scene(stored_model, stored);
+
+	auto key = get_key("round_trip");
+	vkb::SceneCache::store(key, stored_model, stored);
+
+	tinygltf::Model        model;
+	vkb::SceneCache::Entry entry;
+	EXPECT(vkb::SceneCache::load(key, model, entry));
+	EXPECT(entry.file);
+
+	EXPECT(model.images.size() == 1 && model.images[0].name == "checker" && model.images[0].uri == "checker.ktx");
+	EXPECT(model.meshes.size() == 1 && model.meshes[0].name == "triangle" && model.meshes[0].primitives.size() == 1);
+	EXPECT(model.nodes.size() == 1 && model.nodes[0].name == "root" && model.nodes[0].mesh == 0);
+	EXPECT(model.nodes.size() == 1 && model.nodes[0].translation == stored_model.nodes[0].translation);
+
+	EXPECT(entry.sources == stored.sources);
+
+	EXPECT(entry.images.size() == 1);
+	if (entry.images.size() == 1)
+	{
+		auto &image = entry.images[0];
+		EXPECT(image.name == "checker" && image.format == VK_FORMAT_R8G8B8A8_UNORM && image.layers == 1);
+		EXPECT(image.mipmaps.size() == 2 && image.mipmaps[1].offset == 16 && image.mipmaps[1].extent.width == 1);
+		EXPECT(image.offsets == stored.images[0].offsets);
+
+		// The pixels are left in the mapping of the entry
+		EXPECT(image.data.empty());
+		EXPECT(std::ranges::equal(image.mapped_data, stored.images[0].data));
+	}
+
+	EXPECT(entry.primitives.size() == 1);
+	if (entry.primitives.size() == 1)
+	{
+		auto &primitive = entry.primitives[0];
+		auto &expected  = stored.primitives[0];
+
+		EXPECT(primitive.streams.size() == 1 && primitive.streams[0].name == "position");
+		EXPECT(primitive.streams.size() == 1 && primitive.streams[0].data == expected.streams[0].data);
+		EXPECT(primitive.streams.size() == 1 && primitive.streams[0].attribute_names == expected.streams[0].attribute_names);
+		EXPECT(primitive.attributes.size() == 1 && primitive.attributes["position"].stride == 3 * sizeof(float));
+		EXPECT(primitive.index_data == expected.index_data && primitive.index_type == VK_INDEX_TYPE_UINT16);
+		EXPECT(primitive.vertex_indices == 3 && primitive.vertices_count == 3);
+		EXPECT(primitive.meshlets.meshlets.size() == 1 && primitive.meshlets.meshlets[0].triangle_count == 1);
+		EXPECT(primitive.meshlets.bounds.size() == 1 && primitive.meshlets.bounds[0].radius == 0.75f);
+		EXPECT(primitive.meshlets.vertices == expected.meshlets.vertices);
+		EXPECT(primitive.meshlets.triangles == expected.meshlets.triangles);
+	}
+
+	vkb::filesystem::get()->remove(get_entry_path(key));
+}
+
+void missing_entry()
+{
+	EXPECT(!load_scene(get_key("missing_entry")));
+}
+
+void truncated_entry()
+{
+	auto fs   = vkb::filesystem::get();
+	auto key  = get_key("truncated_entry");
+	auto data = store_scene(key);
+
+	EXPECT(load_scene(key));
+
+	// Cut in the payload, then in the header
+	fs->write_file(get_entry_path(key), std::vector<uint8_t>(data.begin(), data.end() - 1));
+	EXPECT(!load_scene(key));
+
+	fs->write_file(get_entry_path(key), std::vector<uint8_t>(data.begin(), data.begin() + 10));
+	EXPECT(!load_scene(key));
+
+	fs->write_file(get_entry_path(key), std::vector<uint8_t>{});
+	EXPECT(!load_scene(key));
+
+	fs->remove(get_entry_path(key));
+}
+
+void corrupted_entry()
+{
+	auto fs   = vkb::filesystem::get();
+	auto key  = get_key("corrupted_entry");
+	auto data = store_scene(key);
+
+	// A flipped byte of the last meshlet triangle fails the checksum
+	data.back() ^= 1;
+	fs->write_file(get_entry_path(key), data);
+	EXPECT(!load_scene(key));
+
+	// An entry renamed to another key doesn't match it
+	data.back() ^= 1;
+	auto other_key = get_key("other_key");
+	fs->write_file(get_entry_path(other_key), data);
+	EXPECT(!load_scene(other_key));
+
+	fs->remove(get_entry_path(key));
+	fs->remove(get_entry_path(other_key));
+}
+
+void stale_entry()
+{
+	auto fs  = vkb::filesystem::get();
+	auto key = get_key("stale_entry");
+	store_scene(key);
+
+	EXPECT(load_scene(key));
+
+	// A source file changed since the entry was written makes it a miss
+	fs->write_file(get_scratch_directory() / "scene.gltf", std::string{"{\"asset\": {}}"});
+	EXPECT(!load_scene(key));
+
+	fs->remove(get_entry_path(key));
+}
+}        // namespace
+
+int main()
+{
+	vkb::filesystem::init();
+
+	vkb::checks::Case cases[] = {
+	    {"round_trip", round_trip},
+	    {"missing_entry", missing_entry},
+	    {"truncated_entry", truncated_entry},
+	    {"corrupted_entry", corrupted_entry},
+	    {"stale_entry", stale_entry},
+	};
+
+	int result = vkb::checks::run_cases(cases);
+
+	vkb::filesystem::get()->remove(get_scratch_directory());
+
+	return result;
+}